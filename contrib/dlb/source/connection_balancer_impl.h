@@ -43,6 +43,7 @@ public:
   // Only for override, those are never used.
   uint64_t numConnections() const override { return 0; }
   void incNumConnections() override {}
+  const Event::DispatcherLoad& load() const override { return handler_.load(); }
 
 private:
   Envoy::Network::BalancedConnectionHandler& handler_;
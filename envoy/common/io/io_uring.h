@@ -42,9 +42,22 @@ public:
    */
   IoUringSocket& socket() const { return socket_; }
 
+  /**
+   * Returns the flags of the completion being delivered for this request, e.g. whether a
+   * multishot request stays armed or which provided buffer holds the data. Only meaningful within
+   * the completion callback, and always 0 for injected completions.
+   */
+  uint32_t completionFlags() const { return completion_flags_; }
+
+  /**
+   * Sets the flags of the completion about to be delivered for this request.
+   */
+  void setCompletionFlags(uint32_t flags) { completion_flags_ = flags; }
+
 private:
   RequestType type_;
   IoUringSocket& socket_;
+  uint32_t completion_flags_{};
 };
 
 /**
@@ -118,6 +131,15 @@ public:
   virtual IoUringResult prepareReadv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                      off_t offset, Request* user_data) PURE;
 
+  /**
+   * Prepares a multishot recv system call and puts it into the submission queue. The request
+   * stays armed and completes once per received chunk of data, each time into a buffer picked
+   * from the ring registered with registerProvidedBuffers(), until it is canceled or fails.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareRecvMultishot(os_fd_t fd, Request* user_data) PURE;
+
   /**
    * Prepares a writev system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
@@ -147,6 +169,25 @@ public:
    */
   virtual IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) PURE;
 
+  /**
+   * Registers a ring of buffers that the kernel picks from for requests prepared with
+   * prepareRecvMultishot(). Buffers are handed back to the kernel with recycleProvidedBuffer().
+   * @param count the number of buffers in the ring, a power of two no larger than 32768.
+   * @param size the size of each buffer.
+   * @return false if the kernel does not support provided buffer rings.
+   */
+  virtual bool registerProvidedBuffers(uint32_t count, uint32_t size) PURE;
+
+  /**
+   * Returns the memory of the provided buffer with the given id, as reported by a completion.
+   */
+  virtual uint8_t* providedBuffer(uint16_t buffer_id) PURE;
+
+  /**
+   * Hands the provided buffer with the given id back to the kernel for subsequent receives.
+   */
+  virtual void recycleProvidedBuffer(uint16_t buffer_id) PURE;
+
   /**
    * Submits the entries in the submission queue to the kernel using the
    * `io_uring_enter()` system call.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <memory>
 
 #include "source/common/common/assert.h"
 #include "source/common/common/utility.h"
@@ -23,6 +24,11 @@ using InlinedStringVector = absl::InlinedVector<char, 128>;
  */
 using VariantStringOrView = absl::variant<absl::string_view, InlinedStringVector>;
 
+/**
+ * Keeps alive the memory that a borrowed string points into.
+ */
+using BorrowedStorageSharedPtr = std::shared_ptr<const void>;
+
 // This includes the NULL (StringUtil::itoa technically only needs 21).
 inline constexpr size_t MaxIntegerLength{32};
 
@@ -51,6 +57,10 @@ inline const InlinedStringVector& getInVec(const VariantStringOrView& buffer) {
  * 1) A string reference.
  * 2) A string InlinedVector (an optimized interned string for small strings, but allows heap
  * allocation if needed).
+ *
+ * A string reference may also be borrowed, i.e. point into memory kept alive by the string itself,
+ * for instance the buffer a codec parsed the string from. Mutating a borrowed string copies it to
+ * the InlinedVector first and releases the borrowed memory.
  */
 template <class Validator> class UnionStringBase {
 public:
@@ -76,7 +86,13 @@ public:
    */
   explicit UnionStringBase(absl::string_view ref_value) : buffer_(ref_value) { assertValid(); }
 
-  UnionStringBase(UnionStringBase&& move_value) noexcept : buffer_(std::move(move_value.buffer_)) {
+  UnionStringBase(UnionStringBase&& move_value) noexcept
+      : buffer_(std::move(move_value.buffer_)),
+        borrowed_storage_(std::move(move_value.borrowed_storage_)) {
+    if (borrowed_storage_ != nullptr) {
+      // The moved from string must not keep referencing the memory it no longer keeps alive.
+      move_value.buffer_ = InlinedStringVector();
+    }
     move_value.clear();
     // Move constructor does not validate and relies on the source object validating its mutations.
   }
@@ -103,6 +119,7 @@ public:
       // Assigning new_capacity to avoid resizing when appending the new data
       getInVec(buffer_).reserve(new_capacity);
       getInVec(buffer_).assign(prev.begin(), prev.end());
+      borrowed_storage_.reset();
       break;
     }
     case Type::Inline: {
@@ -127,14 +144,18 @@ public:
 
   /**
    * Trim trailing whitespaces from the InlinedString. Only supported by the "Inline" InlinedString
-   * representation.
+   * representation and by borrowed strings, whose reference is shortened.
    */
   void rtrim() {
-    ASSERT(type() == Type::Inline);
+    ASSERT(type() == Type::Inline || isBorrowed());
     absl::string_view original = getStringView();
     absl::string_view rtrimmed = StringUtil::rtrim(original);
     if (original.size() != rtrimmed.size()) {
-      getInVec(buffer_).resize(rtrimmed.size());
+      if (type() == Type::Reference) {
+        buffer_ = rtrimmed;
+      } else {
+        getInVec(buffer_).resize(rtrimmed.size());
+      }
     }
   }
 
@@ -153,11 +174,15 @@ public:
 
   /**
    * Return the string to a default state. Reference strings are not touched. Both inline/dynamic
-   * strings are reset to zero size.
+   * strings are reset to zero size. Borrowed strings release their memory and become empty inline
+   * strings.
    */
   void clear() {
     if (type() == Type::Inline) {
       getInVec(buffer_).clear();
+    } else if (isBorrowed()) {
+      buffer_ = InlinedStringVector();
+      borrowed_storage_.reset();
     }
   }
 
@@ -179,6 +204,8 @@ public:
 
     getInVec(buffer_).reserve(size);
     getInVec(buffer_).assign(data, data + size);
+    // The data may have been borrowed by this string, so it is only released after the copy.
+    borrowed_storage_.reset();
     assertValid();
   }
 
@@ -206,6 +233,7 @@ public:
     }
     ASSERT((getInVec(buffer_).capacity()) > MaxIntegerLength);
     getInVec(buffer_).assign(inner_buffer, inner_buffer + int_length);
+    borrowed_storage_.reset();
   }
 
   /**
@@ -215,6 +243,20 @@ public:
    */
   void setReference(absl::string_view ref_value) {
     buffer_ = ref_value;
+    borrowed_storage_.reset();
+    assertValid();
+  }
+
+  /**
+   * Set the value of the string to a reference into memory that the string keeps alive until it is
+   * mutated or destroyed.
+   * @param ref_value MUST point to data that lives at least as long as `storage`.
+   * @param storage keeps the referenced data alive.
+   */
+  void setBorrowed(absl::string_view ref_value, BorrowedStorageSharedPtr storage) {
+    ASSERT(storage != nullptr);
+    buffer_ = ref_value;
+    borrowed_storage_ = std::move(storage);
     assertValid();
   }
 
@@ -223,6 +265,11 @@ public:
    */
   bool isReference() const { return type() == Type::Reference; }
 
+  /**
+   * @return whether the string is a reference into memory it keeps alive.
+   */
+  bool isBorrowed() const { return borrowed_storage_ != nullptr; }
+
   /**
    * @return the size of the string, not including the null terminator.
    */
@@ -252,6 +299,7 @@ public:
 
     getInVec(buffer_).reserve(view.size());
     getInVec(buffer_).assign(view.data(), view.data() + view.size());
+    borrowed_storage_.reset();
   }
 
   /**
@@ -260,6 +308,11 @@ public:
    */
   Storage& storage() { return buffer_; }
 
+  /**
+   * @return the storage kept alive by a borrowed string, for cross-class move along with storage().
+   */
+  BorrowedStorageSharedPtr& borrowedStorage() { return borrowed_storage_; }
+
 protected:
   enum class Type { Reference, Inline };
 
@@ -282,6 +335,7 @@ protected:
   }
 
   Storage buffer_;
+  BorrowedStorageSharedPtr borrowed_storage_;
 };
 
 class EmptyStringValidator {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -39,8 +40,13 @@ namespace Event {
  * All dispatcher stats. @see stats_macros.h
  */
 #define ALL_DISPATCHER_STATS(HISTOGRAM)                                                            \
+  HISTOGRAM(batch_size, Unspecified)                                                               \
+  HISTOGRAM(deferred_delete_us, Microseconds)                                                      \
+  HISTOGRAM(events_per_wakeup, Unspecified)                                                        \
   HISTOGRAM(loop_duration_us, Microseconds)                                                        \
-  HISTOGRAM(poll_delay_us, Microseconds)
+  HISTOGRAM(poll_delay_us, Microseconds)                                                           \
+  HISTOGRAM(post_callbacks_us, Microseconds)                                                       \
+  HISTOGRAM(scheduled_callbacks_us, Microseconds)
 
 /**
  * Struct definition for all dispatcher stats. @see stats_macros.h
@@ -51,6 +57,20 @@ struct DispatcherStats {
 
 using DispatcherStatsPtr = std::unique_ptr<DispatcherStats>;
 
+/**
+ * Load signals of the thread running a dispatcher. They are written by that thread and may be
+ * read from any other thread, e.g. by a connection balancer comparing workers.
+ */
+struct DispatcherLoad {
+  // The number of HTTP streams being processed by the thread.
+  std::atomic<uint64_t> active_streams_{};
+  // How late the last periodic watchdog touch ran, which grows when the event loop is busy.
+  std::atomic<uint64_t> event_loop_lag_us_{};
+  // The share of wall time the thread spent running on a CPU between the last two periodic
+  // watchdog touches, in permille.
+  std::atomic<uint32_t> cpu_utilization_permille_{};
+};
+
 /**
  * Callback invoked when a dispatcher post() runs.
  */
@@ -176,6 +196,12 @@ public:
    */
   virtual MonotonicTime approximateMonotonicTime() const PURE;
 
+  /**
+   * Returns the load signals of the thread running this dispatcher. The event loop lag and CPU
+   * utilization are only updated while a watchdog is registered.
+   */
+  virtual DispatcherLoad& load() PURE;
+
   /**
    * Initializes stats for this dispatcher. Note that this can't generally be done at construction
    * time, since the main and worker thread dispatchers are constructed before
@@ -557,6 +557,10 @@ struct Http1Settings {
   // If false, only methods from a hard-coded list of known methods are accepted.
   // Only implemented in BalsaParser. http-parser only accepts known methods.
   bool allow_custom_methods_{false};
+
+  // The maximum number of outstanding requests on an upstream connection. Values greater than 1
+  // enable pipelining in the connection pool.
+  uint32_t max_pipelined_requests_{1};
 };
 
 /**
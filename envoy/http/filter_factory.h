@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <vector>
 
 #include "envoy/common/pure.h"
 
@@ -33,6 +35,11 @@ struct FilterContext {
   std::string config_name;
 };
 
+/**
+ * The positions in an HTTP filter chain of the filters to create for a stream, in chain order.
+ */
+using FilterChainTemplate = std::vector<uint32_t>;
+
 /**
  * Additional options for creating HTTP filter chain.
  * TODO(wbpcode): it is possible to add more options to customize HTTP filter chain creation.
@@ -52,6 +59,21 @@ public:
    *         nullopt if no decision can be made explicitly for the filter.
    */
   virtual absl::optional<bool> filterDisabled(absl::string_view config_name) const PURE;
+
+  /**
+   * Get the filters to create from a filter chain. The template is built once per filter chain
+   * and shared by the streams for which filterDisabled() returns the same for every filter.
+   *
+   * @param chain_id supplies the process wide unique identifier of the filter chain.
+   * @param build supplies the function that builds the template from filterDisabled(). It is
+   *        only called the first time the filter chain is used.
+   * @return the template of the filter chain, or nullptr if no template is kept for these
+   *         options, in which case filterDisabled() is checked for every filter.
+   */
+  virtual const FilterChainTemplate*
+  filterChainTemplate(uint64_t, const std::function<FilterChainTemplate()>&) const {
+    return nullptr;
+  }
 };
 
 class EmptyFilterChainOptions : public FilterChainOptions {
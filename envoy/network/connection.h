@@ -144,6 +144,10 @@ public:
     Stats::Counter* bind_errors_;
     // Optional counter. Delayed close timeouts will not be tracked if this is nullptr.
     Stats::Counter* delayed_close_timeouts_;
+    // Optional counters of the writes sent with MSG_ZEROCOPY: the sends the kernel completed
+    // without copying, and the sends whose data got copied after all.
+    Stats::Counter* zero_copy_send_completions_;
+    Stats::Counter* zero_copy_send_fallbacks_;
   };
 
   ~Connection() override = default;
@@ -3,6 +3,10 @@
 #include "envoy/network/listen_socket.h"
 
 namespace Envoy {
+namespace Event {
+struct DispatcherLoad;
+} // namespace Event
+
 namespace Network {
 
 /**
@@ -27,6 +31,12 @@ public:
    */
   virtual void incNumConnections() PURE;
 
+  /**
+   * @return the load signals of the worker running the handler. These may be read from any thread
+   *         and are used by load aware connection balancers.
+   */
+  virtual const Event::DispatcherLoad& load() const PURE;
+
   /**
    * Post a connected socket to this connection handler. This is used for cross-thread connection
    * transfer during the balancing process.
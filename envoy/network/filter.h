@@ -680,6 +680,13 @@ public:
    */
   virtual FilterStatus onReceiveError(Api::IoError::IoErrorCode error_code) PURE;
 
+  /**
+   * Called once all the data packets received in a read event of the UDP listener have been
+   * passed to onData(). Filters that batch work across packets, e.g. upstream writes, should
+   * complete it here.
+   */
+  virtual void onReadComplete() {}
+
 protected:
   /**
    * @param callbacks supplies the read filter callbacks used to interact with the filter manager.
@@ -216,6 +216,12 @@ public:
    */
   virtual uint32_t perConnectionBufferLimitBytes() const PURE;
 
+  /**
+   * @return uint32_t the minimum size of a write to the listener's new connections to be sent with
+   * MSG_ZEROCOPY, or 0 if zero copy sends are disabled.
+   */
+  virtual uint32_t zeroCopySendMinBytes() const PURE;
+
   /**
    * @return std::chrono::milliseconds the time to wait for all listener filters to complete
    *         operation. If the timeout is reached, the accepted socket is closed without a
@@ -405,6 +411,13 @@ public:
    */
   virtual void onReadReady() PURE;
 
+  /**
+   * Called once all the datagrams read in a read event have been delivered via onData(), so
+   * that work batched across them can be completed. Also called after each datagram that another
+   * worker delivered via post().
+   */
+  virtual void onReadComplete() PURE;
+
   /**
    * Called when the underlying socket is ready for write.
    *
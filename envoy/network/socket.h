@@ -104,6 +104,13 @@ private:
 #define ENVOY_SOCKET_SO_REUSEPORT Network::SocketOptionName()
 #endif
 
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+#define ENVOY_SOCKET_SO_ATTACH_REUSEPORT_CBPF                                                      \
+  ENVOY_MAKE_SOCKET_OPTION_NAME(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF)
+#else
+#define ENVOY_SOCKET_SO_ATTACH_REUSEPORT_CBPF Network::SocketOptionName()
+#endif
+
 #ifdef SO_ORIGINAL_DST
 #define ENVOY_SOCKET_SO_ORIGINAL_DST ENVOY_MAKE_SOCKET_OPTION_NAME(SOL_IP, SO_ORIGINAL_DST)
 #else
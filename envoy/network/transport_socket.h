@@ -178,6 +178,13 @@ public:
    */
   virtual IoResult doWrite(Buffer::Instance& buffer, bool end_stream) PURE;
 
+  /**
+   * @return the number of bytes the transport socket has yet to write that are not in the write
+   *         buffer passed to doWrite(), e.g. bytes spliced from another connection. A flushed close
+   *         waits for them to be written.
+   */
+  virtual uint64_t pendingWriteBytes() const { return 0; }
+
   /**
    * Called when underlying transport is established.
    */
@@ -64,6 +64,29 @@ public:
   virtual ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
                                             Server::Configuration::ServerFactoryContext& context,
                                             bool validate_clusters_default) const PURE;
+
+  /**
+   * Create a config object based on a route configuration, reusing the parts of the previous
+   * config object whose configuration did not change. By default the config object is created
+   * from scratch.
+   * @param rc supplies the RouteConfiguration.
+   * @param context supplies the context of the server factory.
+   * @param validate_clusters_default @see createConfig().
+   * @param previous supplies the config object created by the previous update. This may be the
+   *    null config object.
+   * @param reused_bytes is set to the serialized size of the parts of the route configuration
+   *    whose config objects were reused.
+   * @throw EnvoyException if the new config can't be applied of.
+   */
+  virtual ConfigConstSharedPtr
+  createConfigFromPrevious(const Protobuf::Message& rc,
+                           Server::Configuration::ServerFactoryContext& context,
+                           bool validate_clusters_default,
+                           const ConfigConstSharedPtr& /* previous */,
+                           uint64_t& reused_bytes) const {
+    reused_bytes = 0;
+    return createConfig(rc, context, validate_clusters_default);
+  }
 };
 
 } // namespace Rds
@@ -55,6 +55,12 @@ public:
    * @return SystemTime the time of the last update.
    */
   virtual SystemTime lastUpdated() const PURE;
+
+  /**
+   * @return uint64_t the serialized size of the parts of the route configuration whose parsed
+   * config objects were reused from the previous config by the last update.
+   */
+  virtual uint64_t lastUpdateReusedBytes() const PURE;
 };
 
 using RouteConfigUpdatePtr = std::unique_ptr<RouteConfigUpdateReceiver>;
@@ -16,6 +16,7 @@
 #include "envoy/http/codec.h"
 #include "envoy/http/codes.h"
 #include "envoy/http/conn_pool.h"
+#include "envoy/http/filter_factory.h"
 #include "envoy/http/hash_policy.h"
 #include "envoy/rds/config.h"
 #include "envoy/router/internal_redirect.h"
@@ -1234,6 +1235,18 @@ public:
    */
   virtual absl::optional<bool> filterDisabled(absl::string_view config_name) const PURE;
 
+  /**
+   * Get the filters to create from a filter chain for this route, see
+   * Http::FilterChainOptions::filterChainTemplate().
+   * @param chain_id supplies the process wide unique identifier of the filter chain.
+   * @param build supplies the function that builds the template from filterDisabled().
+   * @return the template of the filter chain, or nullptr if the route keeps no templates.
+   */
+  virtual const Http::FilterChainTemplate*
+  filterChainTemplate(uint64_t, const std::function<Http::FilterChainTemplate()>&) const {
+    return nullptr;
+  }
+
   /**
    * This is a helper to get the route's per-filter config if it exists, up along the config
    * hierarchy(Route --> VirtualHost --> RouteConfiguration). Or nullptr if none of them exist.
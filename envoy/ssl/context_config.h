@@ -114,6 +114,12 @@ public:
    */
   virtual const std::string& tlsKeyLogPath() const PURE;
 
+  /**
+   * @return true if the transmit direction of established connections should be offloaded to
+   * kernel TLS when the negotiated parameters allow it.
+   */
+  virtual bool kernelTlsOffload() const PURE;
+
   /**
    * @return the access log manager object reference
    */
@@ -157,6 +157,12 @@ public:
    * @return the const SSL connection data of upstream.
    */
   virtual Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() PURE;
+
+  /**
+   * @return the upstream TCP connection if this upstream proxies the stream over a dedicated TCP
+   *         connection, or an empty OptRef for tunneled upstreams.
+   */
+  virtual OptRef<Network::Connection> tcpConnection() PURE;
 };
 
 using GenericConnPoolPtr = std::unique_ptr<GenericConnPool>;
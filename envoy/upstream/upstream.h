@@ -500,6 +500,13 @@ public:
    * @return true to use host weights to calculate the health of a priority.
    */
   virtual bool weightedPriorityHealth() const PURE;
+
+  /**
+   * @return true if the last update of this host set only added and/or removed hosts, i.e. no host
+   *         that was kept had its weight, health or metadata changed in place. Load balancers
+   *         may then apply the hosts added and removed to their state instead of rebuilding it.
+   */
+  virtual bool membershipUpdateOnly() const PURE;
 };
 
 using HostSetPtr = std::unique_ptr<HostSet>;
@@ -564,6 +571,8 @@ public:
     HostsPerLocalityConstSharedPtr healthy_hosts_per_locality;
     HostsPerLocalityConstSharedPtr degraded_hosts_per_locality;
     HostsPerLocalityConstSharedPtr excluded_hosts_per_locality;
+    // See HostSet::membershipUpdateOnly().
+    bool membership_update_only{false};
   };
 
   /**
@@ -731,6 +740,7 @@ public:
   COUNTER(upstream_rq_0rtt)                                                                        \
   COUNTER(upstream_rq_per_try_timeout)                                                             \
   COUNTER(upstream_rq_per_try_idle_timeout)                                                        \
+  COUNTER(upstream_rq_pipelined)                                                                   \
   COUNTER(upstream_rq_retry)                                                                       \
   COUNTER(upstream_rq_retry_backoff_exponential)                                                   \
   COUNTER(upstream_rq_retry_backoff_ratelimited)                                                   \
@@ -748,7 +758,8 @@ public:
   GAUGE(upstream_rq_active, Accumulate)                                                            \
   GAUGE(upstream_rq_pending_active, Accumulate)                                                    \
   HISTOGRAM(upstream_cx_connect_ms, Milliseconds)                                                  \
-  HISTOGRAM(upstream_cx_length_ms, Milliseconds)
+  HISTOGRAM(upstream_cx_length_ms, Milliseconds)                                                   \
+  HISTOGRAM(upstream_rq_pipeline_depth, Unspecified)
 
 /**
  * All cluster load report stats. These are only use for EDS load reporting and not sent to the
@@ -272,6 +272,33 @@ SliceDataPtr OwnedImpl::extractMutableFrontSlice() {
   }
 }
 
+void OwnedImpl::drainToSlices(uint64_t size, std::vector<Slice>& slices) {
+  ASSERT(size <= length_);
+  while (size != 0 && !slices_.empty()) {
+    Slice& front = slices_.front();
+    const uint64_t slice_size = front.dataSize();
+    if (slice_size == 0) {
+      slices_.pop_front();
+      continue;
+    }
+    const uint64_t drain_size = std::min(slice_size, size);
+    Slice remainder;
+    if (drain_size < slice_size) {
+      remainder = Slice(slice_size - drain_size, account_);
+      remainder.append(front.data() + drain_size, slice_size - drain_size);
+    }
+    front.callAndClearDrainTrackersAndCharges();
+    slices.emplace_back(std::move(front));
+    slices_.pop_front();
+    if (remainder.dataSize() > 0) {
+      slices_.emplace_front(std::move(remainder));
+    }
+    length_ -= drain_size;
+    size -= drain_size;
+  }
+  postProcess();
+}
+
 uint64_t OwnedImpl::length() const {
 #ifndef NDEBUG
   // When running in debug mode, verify that the precomputed length matches the sum
@@ -9,6 +9,7 @@
 #include "envoy/buffer/buffer.h"
 #include "envoy/http/stream_reset_handler.h"
 
+#include "source/common/buffer/slice_storage_pool.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
@@ -57,7 +58,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_(allocateStorage(capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -114,6 +115,7 @@ public:
   Slice& operator=(Slice&& rhs) noexcept {
     if (this != &rhs) {
       callAndClearDrainTrackersAndCharges();
+      releaseStorage();
 
       capacity_ = rhs.capacity_;
       storage_ = std::move(rhs.storage_);
@@ -139,6 +141,7 @@ public:
 
   ~Slice() {
     callAndClearDrainTrackersAndCharges();
+    releaseStorage();
     if (releasor_) {
       releasor_();
     }
@@ -365,10 +368,42 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {allocateStorage(slice_size), static_cast<size_t>(slice_size)};
   }
 
+  /**
+   * Allocate backend storage of exactly the given size, from the slice storage pool installed on
+   * the current thread when there is one and it caches blocks of that size.
+   * @param size the size of the storage in bytes.
+   * @return the new backend storage.
+   */
+  static inline StoragePtr allocateStorage(uint64_t size) {
+    SliceStoragePool* pool = SliceStoragePool::current();
+    if (pool != nullptr && SliceStoragePool::poolable(size)) {
+      return pool->allocate(size);
+    }
+    return StoragePtr{new uint8_t[size]};
+  }
+
+  static_assert(SliceStoragePool::max_block_size_ == default_slice_size_,
+                "slice storage pool must cache default sized slices");
+
 protected:
+  /**
+   * Free the owned backend storage, if any, handing it back to the slice storage pool installed on
+   * the current thread when possible.
+   */
+  void releaseStorage() {
+    if (storage_ == nullptr) {
+      return;
+    }
+    SliceStoragePool* pool = SliceStoragePool::current();
+    if (pool != nullptr && SliceStoragePool::poolable(capacity_)) {
+      pool->release(std::move(storage_), capacity_);
+    }
+    storage_.reset();
+  }
+
   /** Length of the byte array that base_ points to. This is also the offset in bytes from the start
    * of the slice to the end of the Reservable section. */
   uint64_t capacity_ = 0;
@@ -719,6 +754,18 @@ public:
 
   size_t addFragments(absl::Span<const absl::string_view> fragments) override;
 
+  /**
+   * Remove the first `size` bytes from the buffer like drain(), but hand the slices that held them
+   * over to the caller instead of releasing them. This keeps the memory returned by a preceding
+   * getRawSlices() valid for as long as the caller holds on to the slices, e.g. while the kernel
+   * still references it after a MSG_ZEROCOPY send. Drain trackers and account charges of the
+   * handed over slices are released immediately. If `size` ends inside a slice, the rest of that
+   * slice is copied into a new slice at the front of the buffer.
+   * @param size the number of bytes to remove.
+   * @param slices receives the slices that held the removed bytes.
+   */
+  void drainToSlices(uint64_t size, std::vector<Slice>& slices);
+
 protected:
   static constexpr uint64_t default_read_reservation_size_ =
       Reservation::MAX_SLICES_ * Slice::default_slice_size_;
@@ -785,7 +832,7 @@ private:
         storage.mem_ = std::move(free_list_ref_.back());
         free_list_ref_.pop_back();
       } else {
-        storage.mem_.reset(new uint8_t[Slice::default_slice_size_]);
+        storage.mem_ = Slice::allocateStorage(Slice::default_slice_size_);
       }
 
       return storage;
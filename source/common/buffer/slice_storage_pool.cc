@@ -0,0 +1,43 @@
+#include "source/common/buffer/slice_storage_pool.h"
+
+namespace Envoy {
+namespace Buffer {
+
+thread_local SliceStoragePool* SliceStoragePool::current_ = nullptr;
+
+SliceStoragePool::SliceStoragePool(uint64_t max_cached_bytes, SliceStoragePoolStats stats)
+    : max_cached_bytes_(max_cached_bytes), stats_(stats) {}
+
+SliceStoragePool::~SliceStoragePool() {
+  uninstall();
+  setMaxCachedBytes(0);
+}
+
+void SliceStoragePool::install() {
+  ASSERT(current_ == nullptr || current_ == this);
+  current_ = this;
+}
+
+void SliceStoragePool::uninstall() {
+  if (current_ == this) {
+    current_ = nullptr;
+  }
+}
+
+void SliceStoragePool::setMaxCachedBytes(uint64_t max_cached_bytes) {
+  max_cached_bytes_ = max_cached_bytes;
+  // Trim from the largest size class down, as those blocks give back the most memory each.
+  for (uint32_t size_class = num_size_classes_; size_class > 0 && cached_bytes_ > max_cached_bytes_;
+       size_class--) {
+    const uint64_t size = size_class * page_size_;
+    auto& free_list = free_lists_[size_class - 1];
+    while (!free_list.empty() && cached_bytes_ > max_cached_bytes_) {
+      free_list.pop_back();
+      cached_bytes_ -= size;
+      stats_.cached_bytes_.sub(size);
+    }
+  }
+}
+
+} // namespace Buffer
+} // namespace Envoy
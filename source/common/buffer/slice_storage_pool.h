@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "envoy/stats/stats_macros.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * All stats for the slice storage pool. @see stats_macros.h
+ */
+#define ALL_SLICE_STORAGE_POOL_STATS(COUNTER, GAUGE)                                               \
+  COUNTER(hit)                                                                                     \
+  COUNTER(miss)                                                                                    \
+  COUNTER(overflow)                                                                                \
+  GAUGE(cached_bytes, Accumulate)
+
+/**
+ * Struct definition for all slice storage pool stats. @see stats_macros.h
+ */
+struct SliceStoragePoolStats {
+  ALL_SLICE_STORAGE_POOL_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+/**
+ * A freelist of slice backing storage owned by a single thread (in practice, a worker and its
+ * dispatcher). Storage is bucketed in page sized classes up to and including max_block_size_,
+ * which matches Slice::default_slice_size_, so that every storage block allocated for a slice via
+ * Slice::sliceSize() can be recycled without fragmentation. The total amount of cached memory is
+ * bounded by a configurable number of bytes; blocks released beyond that bound are freed.
+ *
+ * Slices consult the pool that is installed on the current thread, if any. When no pool is
+ * installed, slice storage comes straight from the heap, as before.
+ */
+class SliceStoragePool : NonCopyable {
+public:
+  using StoragePtr = std::unique_ptr<uint8_t[]>;
+
+  static constexpr uint64_t page_size_ = 4096;
+  static constexpr uint64_t max_block_size_ = 16384;
+  static constexpr uint32_t num_size_classes_ = max_block_size_ / page_size_;
+
+  SliceStoragePool(uint64_t max_cached_bytes, SliceStoragePoolStats stats);
+  ~SliceStoragePool();
+
+  /**
+   * @return the pool installed on the calling thread, or nullptr if there is none.
+   */
+  static SliceStoragePool* current() { return current_; }
+
+  /**
+   * Make this pool the one used by slices allocated and freed on the calling thread. The pool must
+   * outlive its installation; it is uninstalled automatically on destruction.
+   */
+  void install();
+
+  /**
+   * Uninstall this pool from the calling thread if it is the installed one.
+   */
+  void uninstall();
+
+  /**
+   * @param size the storage size in bytes.
+   * @return whether storage of the given size can be recycled by the pool.
+   */
+  static bool poolable(uint64_t size) {
+    return size != 0 && size <= max_block_size_ && size % page_size_ == 0;
+  }
+
+  /**
+   * Allocate a storage block of the given size, reusing a cached block when one is available.
+   * @param size the storage size in bytes. Must be poolable().
+   */
+  StoragePtr allocate(uint64_t size) {
+    ASSERT(poolable(size));
+    auto& free_list = free_lists_[sizeClass(size)];
+    if (!free_list.empty()) {
+      StoragePtr storage = std::move(free_list.back());
+      free_list.pop_back();
+      cached_bytes_ -= size;
+      stats_.cached_bytes_.sub(size);
+      stats_.hit_.inc();
+      return storage;
+    }
+    stats_.miss_.inc();
+    return StoragePtr{new uint8_t[size]};
+  }
+
+  /**
+   * Return a storage block to the pool. The block is freed if caching it would exceed the limit.
+   * @param storage the storage block, which is consumed.
+   * @param size the size the block was allocated with. Must be poolable().
+   */
+  void release(StoragePtr&& storage, uint64_t size) {
+    ASSERT(poolable(size));
+    if (cached_bytes_ + size > max_cached_bytes_) {
+      stats_.overflow_.inc();
+      storage.reset();
+      return;
+    }
+    free_lists_[sizeClass(size)].push_back(std::move(storage));
+    cached_bytes_ += size;
+    stats_.cached_bytes_.add(size);
+  }
+
+  /**
+   * Change the maximum number of bytes kept in the pool, freeing cached blocks as needed.
+   */
+  void setMaxCachedBytes(uint64_t max_cached_bytes);
+
+  uint64_t maxCachedBytes() const { return max_cached_bytes_; }
+  uint64_t cachedBytes() const { return cached_bytes_; }
+
+private:
+  static uint32_t sizeClass(uint64_t size) { return size / page_size_ - 1; }
+
+  static thread_local SliceStoragePool* current_;
+
+  std::array<std::vector<StoragePtr>, num_size_classes_> free_lists_;
+  uint64_t max_cached_bytes_;
+  uint64_t cached_bytes_{};
+  SliceStoragePoolStats stats_;
+};
+
+using SliceStoragePoolPtr = std::unique_ptr<SliceStoragePool>;
+
+} // namespace Buffer
+} // namespace Envoy
@@ -1,13 +1,17 @@
 #include "source/common/event/dispatcher_impl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <ctime>
 #include <functional>
+#include <iterator>
 #include <string>
 #include <vector>
 
 #include "envoy/api/api.h"
 #include "envoy/common/scope_tracker.h"
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
 #include "envoy/config/overload/v3/overload.pb.h"
 #include "envoy/network/client_connection_factory.h"
 #include "envoy/network/listen_socket.h"
@@ -23,9 +27,11 @@
 #include "source/common/event/scaled_range_timer_manager_impl.h"
 #include "source/common/event/signal_impl.h"
 #include "source/common/event/timer_impl.h"
+#include "source/common/event/timer_wheel.h"
 #include "source/common/filesystem/watcher_impl.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/connection_impl.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
 #include "event2/event.h"
@@ -36,6 +42,20 @@
 
 namespace Envoy {
 namespace Event {
+namespace {
+
+// The CPU time consumed by the calling thread, or zero where it isn't available.
+std::chrono::nanoseconds threadCpuTime() {
+#ifdef CLOCK_THREAD_CPUTIME_ID
+  timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+  }
+#endif
+  return std::chrono::nanoseconds(0);
+}
+
+} // namespace
 
 DispatcherImpl::DispatcherImpl(const std::string& name, Api::Api& api,
                                Event::TimeSystem& time_system)
@@ -60,7 +80,18 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Api::Api& api,
                      watermark_factory != nullptr
                          ? watermark_factory
                          : std::make_shared<Buffer::WatermarkBufferFactory>(
-                               api.bootstrap().overload_manager().buffer_factory_config())) {}
+                               api.bootstrap().overload_manager().buffer_factory_config())) {
+  if (api.bootstrap().has_event_loop_batching()) {
+    const auto& batching = api.bootstrap().event_loop_batching();
+    const auto latency_budget =
+        batching.has_latency_budget()
+            ? std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::seconds(batching.latency_budget().seconds()) +
+                  std::chrono::nanoseconds(batching.latency_budget().nanos()))
+            : std::chrono::microseconds(std::chrono::milliseconds(1));
+    enableBatching(PROTOBUF_GET_WRAPPED_OR_DEFAULT(batching, max_batch_size, 64), latency_budget);
+  }
+}
 
 DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& thread_factory,
                                TimeSource& time_source, Filesystem::Instance& file_system,
@@ -70,6 +101,9 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& t
     : name_(name), thread_factory_(thread_factory), time_source_(time_source),
       file_system_(file_system), buffer_factory_(watermark_factory),
       scheduler_(time_system.createScheduler(base_scheduler_, base_scheduler_)),
+      timer_wheel_(Runtime::runtimeFeatureEnabled("envoy.restart_features.dispatcher_timer_wheel")
+                       ? std::make_unique<TimerWheel>(*scheduler_, *this, time_source_)
+                       : nullptr),
       thread_local_delete_cb_(
           base_scheduler_.createSchedulableCallback([this]() -> void { runThreadLocalDelete(); })),
       deferred_delete_cb_(base_scheduler_.createSchedulableCallback(
@@ -95,6 +129,15 @@ DispatcherImpl::~DispatcherImpl() {
   // ASSERT(deletable_in_dispatcher_thread_.empty())
 }
 
+void DispatcherImpl::enableBatching(uint32_t max_batch_size,
+                                    std::chrono::microseconds latency_budget) {
+  ASSERT(max_batch_size > 0);
+  ASSERT(batch_cb_ == nullptr);
+  max_batch_size_ = max_batch_size;
+  batch_latency_budget_ = latency_budget;
+  batch_cb_ = base_scheduler_.createSchedulableCallback([this]() -> void { runBatch(); });
+}
+
 void DispatcherImpl::registerWatchdog(const Server::WatchDogSharedPtr& watchdog,
                                       std::chrono::milliseconds min_touch_interval) {
   ASSERT(!watchdog_registration_, "Each dispatcher can have at most one registered watchdog.");
@@ -102,6 +145,27 @@ void DispatcherImpl::registerWatchdog(const Server::WatchDogSharedPtr& watchdog,
       std::make_unique<WatchdogRegistration>(watchdog, *scheduler_, min_touch_interval, *this);
 }
 
+void DispatcherImpl::WatchdogRegistration::updateLoad() {
+  // The timer is re-armed for timer_interval_ each time it runs, so it runs late by however long
+  // the event loop was busy with other events.
+  const MonotonicTime now = time_source_.monotonicTime();
+  const auto elapsed = now - last_sample_time_;
+  const auto lag = std::max<std::chrono::nanoseconds>(elapsed - timer_interval_,
+                                                       std::chrono::nanoseconds(0));
+  load_.event_loop_lag_us_.store(
+      std::chrono::duration_cast<std::chrono::microseconds>(lag).count(),
+      std::memory_order_relaxed);
+
+  const std::chrono::nanoseconds cpu_time = threadCpuTime();
+  if (last_cpu_time_.has_value() && elapsed.count() > 0) {
+    const uint64_t permille = (cpu_time - *last_cpu_time_) * 1000 / elapsed;
+    load_.cpu_utilization_permille_.store(std::min<uint64_t>(permille, 1000),
+                                          std::memory_order_relaxed);
+  }
+  last_cpu_time_ = cpu_time;
+  last_sample_time_ = now;
+}
+
 void DispatcherImpl::initializeStats(Stats::Scope& scope,
                                      const absl::optional<std::string>& prefix) {
   const std::string effective_prefix = prefix.has_value() ? *prefix : absl::StrCat(name_, ".");
@@ -136,6 +200,8 @@ void DispatcherImpl::clearDeferredDeleteList() {
 
   touchWatchdog();
   deferred_deleting_ = true;
+  const bool record_stats = stats_ != nullptr;
+  const MonotonicTime start = record_stats ? time_source_.monotonicTime() : MonotonicTime();
 
   // Calling clear() on the vector does not specify which order destructors run in. We want to
   // destroy in FIFO order so just do it manually. This required 2 passes over the vector which is
@@ -146,6 +212,9 @@ void DispatcherImpl::clearDeferredDeleteList() {
 
   to_delete->clear();
   deferred_deleting_ = false;
+  if (record_stats) {
+    recordPhaseDuration(stats_->deferred_delete_us_, start);
+  }
 }
 
 Network::ServerConnectionPtr
@@ -210,6 +279,9 @@ TimerPtr DispatcherImpl::createScaledTimer(ScaledTimerMinimum minimum, TimerCb c
 
 Event::SchedulableCallbackPtr DispatcherImpl::createSchedulableCallback(std::function<void()> cb) {
   ASSERT(isThreadSafe());
+  if (batch_cb_ != nullptr) {
+    return std::make_unique<BatchedSchedulableCallback>(*this, std::move(cb));
+  }
   return base_scheduler_.createSchedulableCallback([this, cb]() {
     touchWatchdog();
     cb();
@@ -217,12 +289,14 @@ Event::SchedulableCallbackPtr DispatcherImpl::createSchedulableCallback(std::fun
 }
 
 TimerPtr DispatcherImpl::createTimerInternal(TimerCb cb) {
-  return scheduler_->createTimer(
-      [this, cb]() {
-        touchWatchdog();
-        cb();
-      },
-      *this);
+  auto wrapped_cb = [this, cb]() {
+    touchWatchdog();
+    cb();
+  };
+  if (timer_wheel_ != nullptr) {
+    return timer_wheel_->createTimer(std::move(wrapped_cb));
+  }
+  return scheduler_->createTimer(std::move(wrapped_cb), *this);
 }
 
 void DispatcherImpl::deferredDelete(DeferredDeletablePtr&& to_delete) {
@@ -232,7 +306,11 @@ void DispatcherImpl::deferredDelete(DeferredDeletablePtr&& to_delete) {
     current_to_delete_->emplace_back(std::move(to_delete));
     ENVOY_LOG(trace, "item added to deferred deletion list (size={})", current_to_delete_->size());
     if (current_to_delete_->size() == 1) {
-      deferred_delete_cb_->scheduleCallbackCurrentIteration();
+      if (batch_cb_ != nullptr) {
+        scheduleBatch();
+      } else {
+        deferred_delete_cb_->scheduleCallbackCurrentIteration();
+      }
     }
   }
 }
@@ -253,7 +331,11 @@ void DispatcherImpl::post(PostCb callback) {
   }
 
   if (do_post) {
-    post_cb_->scheduleCallbackCurrentIteration();
+    if (batch_cb_ != nullptr) {
+      scheduleBatch();
+    } else {
+      post_cb_->scheduleCallbackCurrentIteration();
+    }
   }
 }
 
@@ -352,6 +434,12 @@ void DispatcherImpl::runPostCallbacks() {
     // post_callbacks_ should be empty after the move.
     ASSERT(post_callbacks_.empty());
   }
+  if (callbacks.empty()) {
+    return;
+  }
+  // Stats may be initialized by one of the callbacks.
+  const bool record_stats = stats_ != nullptr;
+  const MonotonicTime start = record_stats ? time_source_.monotonicTime() : MonotonicTime();
   // It is important that the execution and deletion of the callback happen while post_lock_ is not
   // held. Either the invocation or destructor of the callback can call post() on this dispatcher.
   while (!callbacks.empty()) {
@@ -364,6 +452,121 @@ void DispatcherImpl::runPostCallbacks() {
     // callback executes.
     callbacks.pop_front();
   }
+  if (record_stats) {
+    recordPhaseDuration(stats_->post_callbacks_us_, start);
+  }
+}
+
+void DispatcherImpl::recordPhaseDuration(Stats::Histogram& histogram, MonotonicTime start) {
+  histogram.recordValue(std::chrono::duration_cast<std::chrono::microseconds>(
+                            time_source_.monotonicTime() - start)
+                            .count());
+}
+
+void DispatcherImpl::scheduleBatch() { batch_cb_->scheduleCallbackCurrentIteration(); }
+
+void DispatcherImpl::runBatch() {
+  const MonotonicTime deadline = time_source_.monotonicTime() + batch_latency_budget_;
+  uint32_t remaining = max_batch_size_;
+
+  // Deferred deletions run first, as in runPostCallbacks(), and always in full: the objects are
+  // already detached and holding on to them only delays freeing their memory.
+  clearDeferredDeleteList();
+
+  // Take at most a batch worth of posted callbacks. The ones that do not run because the latency
+  // budget is exhausted are put back at the front of the queue, to preserve their order.
+  std::list<PostCb> callbacks;
+  {
+    Thread::LockGuard lock(post_lock_);
+    auto last = post_callbacks_.begin();
+    std::advance(last, std::min<size_t>(remaining, post_callbacks_.size()));
+    callbacks.splice(callbacks.end(), post_callbacks_, post_callbacks_.begin(), last);
+  }
+  MonotonicTime phase_start = time_source_.monotonicTime();
+  if (!callbacks.empty()) {
+    do {
+      touchWatchdog();
+      callbacks.front()();
+      callbacks.pop_front();
+      remaining--;
+    } while (!callbacks.empty() && time_source_.monotonicTime() < deadline);
+    if (!callbacks.empty()) {
+      Thread::LockGuard lock(post_lock_);
+      post_callbacks_.splice(post_callbacks_.begin(), callbacks);
+    }
+    if (stats_ != nullptr) {
+      recordPhaseDuration(stats_->post_callbacks_us_, phase_start);
+    }
+  }
+
+  // Then the schedulable callbacks, with what is left of the batch. Callbacks scheduled while this
+  // runs are appended to the queue and may run in this batch too.
+  if (!batched_callbacks_.empty() && remaining > 0 && time_source_.monotonicTime() < deadline) {
+    phase_start = time_source_.monotonicTime();
+    do {
+      BatchedSchedulableCallback* callback = batched_callbacks_.front();
+      batched_callbacks_.pop_front();
+      callback->queued_ = false;
+      touchWatchdog();
+      // The callback may destroy itself, so it must not be used after this.
+      callback->cb_();
+      remaining--;
+    } while (!batched_callbacks_.empty() && remaining > 0 &&
+             time_source_.monotonicTime() < deadline);
+    if (stats_ != nullptr) {
+      recordPhaseDuration(stats_->scheduled_callbacks_us_, phase_start);
+    }
+  }
+
+  if (stats_ != nullptr) {
+    stats_->batch_size_.recordValue(max_batch_size_ - remaining);
+  }
+
+  bool posts_pending;
+  {
+    Thread::LockGuard lock(post_lock_);
+    posts_pending = !post_callbacks_.empty();
+  }
+  if (posts_pending || !batched_callbacks_.empty() || !current_to_delete_->empty()) {
+    // Leave whatever is left, including work added while the batch ran (which may have activated
+    // the batch again for this iteration), to the next iteration so that pending I/O is handled
+    // first.
+    batch_cb_->cancel();
+    batch_cb_->scheduleCallbackNextIteration();
+  }
+}
+
+DispatcherImpl::BatchedSchedulableCallback::BatchedSchedulableCallback(DispatcherImpl& parent,
+                                                                       std::function<void()> cb)
+    : parent_(parent), cb_(std::move(cb)),
+      next_iteration_cb_(parent.base_scheduler_.createSchedulableCallback([this]() {
+        parent_.touchWatchdog();
+        cb_();
+      })) {}
+
+void DispatcherImpl::BatchedSchedulableCallback::scheduleCallbackCurrentIteration() {
+  ASSERT(parent_.isThreadSafe());
+  if (enabled()) {
+    return;
+  }
+  entry_ = parent_.batched_callbacks_.insert(parent_.batched_callbacks_.end(), this);
+  queued_ = true;
+  parent_.scheduleBatch();
+}
+
+void DispatcherImpl::BatchedSchedulableCallback::scheduleCallbackNextIteration() {
+  if (enabled()) {
+    return;
+  }
+  next_iteration_cb_->scheduleCallbackNextIteration();
+}
+
+void DispatcherImpl::BatchedSchedulableCallback::cancel() {
+  if (queued_) {
+    parent_.batched_callbacks_.erase(entry_);
+    queued_ = false;
+  }
+  next_iteration_cb_->cancel();
 }
 
 void DispatcherImpl::onFatalError(std::ostream& os) const {
@@ -390,6 +593,9 @@ void DispatcherImpl::runFatalActionsOnTrackedObject(
 }
 
 void DispatcherImpl::touchWatchdog() {
+  // Every event the dispatcher runs touches the watchdog first, so this is also where they are
+  // counted.
+  base_scheduler_.countEvent();
   if (watchdog_registration_) {
     watchdog_registration_->touchWatchdog();
   }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <list>
@@ -18,9 +19,11 @@
 #include "source/common/common/thread.h"
 #include "source/common/event/libevent.h"
 #include "source/common/event/libevent_scheduler.h"
+#include "source/common/event/timer_wheel.h"
 #include "source/common/signal/fatal_error_handler.h"
 
 #include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Event {
@@ -55,6 +58,16 @@ public:
    */
   event_base& base() { return base_scheduler_.base(); }
 
+  /**
+   * Coalesce posted callbacks, deferred deletions and the schedulable callbacks created from now on
+   * into bounded batches, run once per iteration of the event loop. Work left over when a batch
+   * reaches one of its limits is carried over to the next iteration. Must be called before the
+   * dispatcher runs.
+   * @param max_batch_size the maximum number of posted and schedulable callbacks run per batch.
+   * @param latency_budget the time after which a batch stops running callbacks.
+   */
+  void enableBatching(uint32_t max_batch_size, std::chrono::microseconds latency_budget);
+
   // Event::Dispatcher
   const std::string& name() override { return name_; }
   void registerWatchdog(const Server::WatchDogSharedPtr& watchdog,
@@ -91,6 +104,7 @@ public:
   void popTrackedObject(const ScopeTrackedObject* expected_object) override;
   bool trackedObjectStackIsEmpty() const override { return tracked_object_stack_.empty(); }
   MonotonicTime approximateMonotonicTime() const override;
+  DispatcherLoad& load() override { return load_; }
   void updateApproximateMonotonicTime() override;
   void shutdown() override;
 
@@ -101,15 +115,19 @@ public:
 
 private:
   // Holds a reference to the watchdog registered with this dispatcher and the timer used to ensure
-  // that the dog is touched periodically.
+  // that the dog is touched periodically. The timer also samples the event loop lag and CPU
+  // utilization of the dispatcher's load.
   class WatchdogRegistration {
   public:
     WatchdogRegistration(const Server::WatchDogSharedPtr& watchdog, Scheduler& scheduler,
                          std::chrono::milliseconds timer_interval, Dispatcher& dispatcher)
-        : watchdog_(watchdog), timer_interval_(timer_interval) {
+        : watchdog_(watchdog), timer_interval_(timer_interval),
+          time_source_(dispatcher.timeSource()), load_(dispatcher.load()),
+          last_sample_time_(time_source_.monotonicTime()) {
       touch_timer_ = scheduler.createTimer(
           [this]() -> void {
             watchdog_->touch();
+            updateLoad();
             touch_timer_->enableTimer(timer_interval_);
           },
           dispatcher);
@@ -119,16 +137,52 @@ private:
     void touchWatchdog() { watchdog_->touch(); }
 
   private:
+    void updateLoad();
+
     Server::WatchDogSharedPtr watchdog_;
     const std::chrono::milliseconds timer_interval_;
+    TimeSource& time_source_;
+    DispatcherLoad& load_;
+    MonotonicTime last_sample_time_;
+    // The CPU time of the dispatcher thread at the last sample, unset until the timer first runs
+    // since the registration may be created on another thread.
+    absl::optional<std::chrono::nanoseconds> last_cpu_time_;
     TimerPtr touch_timer_;
   };
   using WatchdogRegistrationPtr = std::unique_ptr<WatchdogRegistration>;
 
+  // A schedulable callback that, when scheduled for the current iteration, is queued to run in the
+  // dispatcher's next batch instead of being activated in libevent on its own.
+  class BatchedSchedulableCallback : public SchedulableCallback {
+  public:
+    BatchedSchedulableCallback(DispatcherImpl& parent, std::function<void()> cb);
+    ~BatchedSchedulableCallback() override { cancel(); }
+
+    // SchedulableCallback
+    void scheduleCallbackCurrentIteration() override;
+    void scheduleCallbackNextIteration() override;
+    void cancel() override;
+    bool enabled() override { return queued_ || next_iteration_cb_->enabled(); }
+
+  private:
+    friend class DispatcherImpl;
+
+    DispatcherImpl& parent_;
+    const std::function<void()> cb_;
+    // Next iteration scheduling is left to libevent, as those callbacks do not run in the current
+    // wakeup anyway.
+    const SchedulableCallbackPtr next_iteration_cb_;
+    std::list<BatchedSchedulableCallback*>::iterator entry_;
+    bool queued_{};
+  };
+
   TimerPtr createTimerInternal(TimerCb cb);
   void updateApproximateMonotonicTimeInternal();
   void runPostCallbacks();
   void runThreadLocalDelete();
+  void runBatch();
+  void scheduleBatch();
+  void recordPhaseDuration(Stats::Histogram& histogram, MonotonicTime start);
 
   // Helper used to touch the watchdog after most schedulable, fd, and timer callbacks.
   void touchWatchdog();
@@ -150,6 +204,8 @@ private:
   Buffer::WatermarkFactorySharedPtr buffer_factory_;
   LibeventScheduler base_scheduler_;
   SchedulerPtr scheduler_;
+  // Set when dispatcher timers are run on a timer wheel rather than directly by scheduler_.
+  TimerWheelPtr timer_wheel_;
 
   SchedulableCallbackPtr thread_local_delete_cb_;
   Thread::MutexBasicLockable thread_local_deletable_lock_;
@@ -168,10 +224,17 @@ private:
   std::vector<DeferredDeletablePtr> to_delete_2_;
   std::vector<DeferredDeletablePtr>* current_to_delete_;
 
+  // Batching state, only used once enableBatching() has been called.
+  uint32_t max_batch_size_{};
+  std::chrono::microseconds batch_latency_budget_{};
+  SchedulableCallbackPtr batch_cb_;
+  std::list<BatchedSchedulableCallback*> batched_callbacks_;
+
   absl::InlinedVector<const ScopeTrackedObject*, ExpectedMaxTrackedObjectStackDepth>
       tracked_object_stack_;
   bool deferred_deleting_{};
   MonotonicTime approximate_monotonic_time_;
+  DispatcherLoad load_;
   WatchdogRegistrationPtr watchdog_registration_;
   const ScaledRangeTimerManagerPtr scaled_timer_manager_;
 };
@@ -116,6 +116,7 @@ void LibeventScheduler::onPrepareForStats(evwatch*, const evwatch_prepare_cb_inf
     timeval delta;
     evutil_timersub(&self->prepare_time_, &self->check_time_, &delta);
     recordTimeval(self->stats_->loop_duration_us_, delta);
+    self->stats_->events_per_wakeup_.recordValue(self->events_);
   }
 }
 
@@ -127,6 +128,7 @@ void LibeventScheduler::onCheckForStats(evwatch*, const evwatch_check_cb_info*,
   // from above to compute the actual polling duration, and store it for the next iteration of the
   // event loop to compute the loop duration.
   evutil_gettimeofday(&self->check_time_, nullptr);
+  self->events_ = 0;
   if (self->timeout_set_) {
     timeval delta, delay;
     evutil_timersub(&self->check_time_, &self->prepare_time_, &delta);
@@ -109,6 +109,12 @@ public:
    */
   void initializeStats(DispatcherStats* stats);
 
+  /**
+   * Count an event run in the current iteration of the event loop, for the events_per_wakeup
+   * stat.
+   */
+  void countEvent() { events_++; }
+
 private:
   static void onPrepareForCallback(evwatch*, const evwatch_prepare_cb_info* info, void* arg);
   static void onCheckForCallback(evwatch*, const evwatch_check_cb_info* info, void* arg);
@@ -131,6 +137,7 @@ private:
   timeval timeout_{};        // the poll timeout for the current event loop iteration, if available
   timeval prepare_time_{};   // timestamp immediately before polling
   timeval check_time_{};     // timestamp immediately after polling
+  uint64_t events_{};        // number of events run since the last poll
   OnPrepareCallback prepare_callback_; // callback to be called from onPrepareForCallback()
   OnCheckCallback check_callback_;     // callback to be called from onCheckForCallback()
 };
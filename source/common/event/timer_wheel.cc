@@ -0,0 +1,273 @@
+#include "source/common/event/timer_wheel.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/scope_tracker.h"
+
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+// Same bound as TimerUtils::durationToTimeval(), which keeps the deadline computations below from
+// overflowing.
+constexpr std::chrono::milliseconds MaxDelay{int64_t(INT32_MAX) * 1000};
+
+} // namespace
+
+class TimerWheel::WheelTimer : public Timer {
+public:
+  static constexpr uint8_t Unlinked = Levels;
+
+  WheelTimer(TimerWheel& wheel, TimerCb cb) : wheel_(wheel), cb_(std::move(cb)) { ASSERT(cb_); }
+  ~WheelTimer() override { disableTimer(); }
+
+  // Timer
+  void disableTimer() override {
+    ASSERT(wheel_.dispatcher_.isThreadSafe());
+    if (level_ != Unlinked) {
+      wheel_.unlink(*this);
+    }
+    if (fallback_ != nullptr) {
+      fallback_->disableTimer();
+    }
+  }
+
+  void enableTimer(std::chrono::milliseconds delay, const ScopeTrackedObject* object) override {
+    ASSERT(wheel_.dispatcher_.isThreadSafe());
+    if (delay.count() <= 0) {
+      enableFallback().enableTimer(delay, object);
+      return;
+    }
+    if (fallback_ != nullptr) {
+      fallback_->disableTimer();
+    }
+    object_ = object;
+    wheel_.schedule(*this, std::min(delay, MaxDelay));
+  }
+
+  void enableHRTimer(std::chrono::microseconds delay, const ScopeTrackedObject* object) override {
+    ASSERT(wheel_.dispatcher_.isThreadSafe());
+    enableFallback().enableHRTimer(delay, object);
+  }
+
+  bool enabled() override {
+    ASSERT(wheel_.dispatcher_.isThreadSafe());
+    return level_ != Unlinked || (fallback_ != nullptr && fallback_->enabled());
+  }
+
+  void run() {
+    if (object_ == nullptr) {
+      cb_();
+      return;
+    }
+    ScopeTrackerScopeState scope(object_, wheel_.dispatcher_);
+    object_ = nullptr;
+    cb_();
+  }
+
+  TimerWheel& wheel_;
+  const TimerCb cb_;
+  const ScopeTrackedObject* object_{};
+  // Links in the list of the slot the timer is in.
+  WheelTimer* prev_{};
+  WheelTimer* next_{};
+  // The tick at which the timer fires. This can be later than the ticks covered by its slot.
+  uint64_t expiry_{};
+  uint8_t level_{Unlinked};
+  uint8_t index_{};
+
+private:
+  Timer& enableFallback() {
+    if (level_ != Unlinked) {
+      wheel_.unlink(*this);
+    }
+    if (fallback_ == nullptr) {
+      fallback_ = wheel_.scheduler_.createTimer(cb_, wheel_.dispatcher_);
+    }
+    return *fallback_;
+  }
+
+  // Created the first time the timer is enabled with a zero delay or as a high resolution timer.
+  TimerPtr fallback_;
+};
+
+TimerWheel::TimerWheel(Scheduler& scheduler, Dispatcher& dispatcher, TimeSource& time_source)
+    : scheduler_(scheduler), dispatcher_(dispatcher), time_source_(time_source),
+      start_(time_source.monotonicTime()),
+      driver_(scheduler.createTimer([this]() { onDriverTimer(); }, dispatcher)) {}
+
+TimerPtr TimerWheel::createTimer(TimerCb cb) {
+  return std::make_unique<WheelTimer>(*this, std::move(cb));
+}
+
+void TimerWheel::schedule(WheelTimer& timer, std::chrono::milliseconds delay) {
+  // Round up, so that the timer never fires before its delay has elapsed.
+  const auto deadline = time_source_.monotonicTime() - start_ + delay;
+  const uint64_t expiry =
+      std::max<uint64_t>((deadline + TickDuration - std::chrono::nanoseconds(1)) / TickDuration,
+                         current_tick_ + 1);
+  if (timer.level_ != WheelTimer::Unlinked) {
+    if (expiry >= timer.expiry_) {
+      // The timer is moved to the right slot when the wheel reaches its current one.
+      timer.expiry_ = expiry;
+      return;
+    }
+    unlink(timer);
+  }
+  timer.expiry_ = expiry;
+  link(timer);
+}
+
+void TimerWheel::link(WheelTimer& timer) {
+  ASSERT(timer.expiry_ >= current_tick_);
+  const uint64_t delta = timer.expiry_ - current_tick_;
+  uint32_t level = 0;
+  while (level + 1 < Levels && (delta >> (SlotBits * (level + 1))) != 0) {
+    level++;
+  }
+  const uint32_t shift = SlotBits * level;
+  // Timers beyond the range of the wheel are parked in the furthest slot of the top level.
+  const uint64_t placement =
+      std::min(timer.expiry_, current_tick_ + (uint64_t(1) << (SlotBits * Levels)) - 1);
+  const uint32_t index = (placement >> shift) & SlotMask;
+
+  Slot& slot = slots_[level][index];
+  timer.level_ = static_cast<uint8_t>(level);
+  timer.index_ = static_cast<uint8_t>(index);
+  timer.prev_ = slot.tail_;
+  timer.next_ = nullptr;
+  if (slot.tail_ != nullptr) {
+    slot.tail_->next_ = &timer;
+  } else {
+    slot.head_ = &timer;
+    occupied_[level][index / 64] |= uint64_t(1) << (index % 64);
+  }
+  slot.tail_ = &timer;
+
+  if (!processing_) {
+    // The tick at which the wheel reaches the slot.
+    uint64_t distance = (index - (current_tick_ >> shift)) & SlotMask;
+    if (distance == 0) {
+      distance = SlotsPerLevel;
+    }
+    const uint64_t tick = ((current_tick_ >> shift) + distance) << shift;
+    if (tick < armed_tick_) {
+      armDriver(tick);
+    }
+  }
+}
+
+void TimerWheel::unlink(WheelTimer& timer) {
+  Slot& slot = slots_[timer.level_][timer.index_];
+  if (timer.prev_ != nullptr) {
+    timer.prev_->next_ = timer.next_;
+  } else {
+    slot.head_ = timer.next_;
+  }
+  if (timer.next_ != nullptr) {
+    timer.next_->prev_ = timer.prev_;
+  } else {
+    slot.tail_ = timer.prev_;
+  }
+  if (slot.head_ == nullptr) {
+    occupied_[timer.level_][timer.index_ / 64] &= ~(uint64_t(1) << (timer.index_ % 64));
+  }
+  timer.prev_ = nullptr;
+  timer.next_ = nullptr;
+  timer.level_ = WheelTimer::Unlinked;
+}
+
+uint32_t TimerWheel::nextOccupied(uint32_t level, uint32_t index) const {
+  // Scan the slots after `index`, wrapping around so that the slot at `index` comes last.
+  const uint32_t start = (index + 1) & SlotMask;
+  for (uint32_t i = 0; i <= WordsPerLevel; i++) {
+    const uint32_t word = ((start / 64) + i) % WordsPerLevel;
+    uint64_t bits = occupied_[level][word];
+    if (i == 0) {
+      bits &= ~uint64_t(0) << (start % 64);
+    }
+    if (bits != 0) {
+      const uint32_t slot = word * 64 + absl::countr_zero(bits);
+      return ((slot - index - 1) & SlotMask) + 1;
+    }
+  }
+  return 0;
+}
+
+uint64_t TimerWheel::nextEventTick() const {
+  uint64_t next = NotArmed;
+  for (uint32_t level = 0; level < Levels; level++) {
+    const uint32_t shift = SlotBits * level;
+    const uint32_t distance = nextOccupied(level, (current_tick_ >> shift) & SlotMask);
+    if (distance != 0) {
+      next = std::min(next, ((current_tick_ >> shift) + distance) << shift);
+    }
+  }
+  return next;
+}
+
+void TimerWheel::onDriverTimer() {
+  armed_tick_ = NotArmed;
+  const uint64_t now_tick = (time_source_.monotonicTime() - start_) / TickDuration;
+  processing_ = true;
+  // Only visit the ticks at which there is a slot to process, there can be long stretches of empty
+  // ones.
+  for (uint64_t tick = nextEventTick(); tick <= now_tick; tick = nextEventTick()) {
+    current_tick_ = tick;
+    // Cascade from the top, so that timers moved to a level that also starts a slot at this tick
+    // are cascaded again.
+    for (uint32_t level = Levels - 1; level > 0; level--) {
+      const uint32_t shift = SlotBits * level;
+      if ((tick & ((uint64_t(1) << shift) - 1)) == 0) {
+        cascade(level, (tick >> shift) & SlotMask);
+      }
+    }
+    expire(tick & SlotMask);
+  }
+  current_tick_ = std::max(current_tick_, now_tick);
+  processing_ = false;
+
+  const uint64_t next = nextEventTick();
+  if (next != NotArmed) {
+    armDriver(next);
+  }
+}
+
+void TimerWheel::cascade(uint32_t level, uint32_t index) {
+  // Relinking never puts a timer back in the slot being cascaded.
+  Slot& slot = slots_[level][index];
+  while (slot.head_ != nullptr) {
+    WheelTimer& timer = *slot.head_;
+    unlink(timer);
+    link(timer);
+  }
+}
+
+void TimerWheel::expire(uint32_t index) {
+  // Timers enabled by the callbacks are at least a tick away, so they never land in this slot.
+  Slot& slot = slots_[0][index];
+  while (slot.head_ != nullptr) {
+    WheelTimer& timer = *slot.head_;
+    unlink(timer);
+    if (timer.expiry_ > current_tick_) {
+      // Re-enabled for a later deadline since it was linked.
+      link(timer);
+    } else {
+      // The callback may destroy the timer.
+      timer.run();
+    }
+  }
+}
+
+void TimerWheel::armDriver(uint64_t tick) {
+  armed_tick_ = tick;
+  const auto delay = std::chrono::duration_cast<std::chrono::microseconds>(
+      start_ + static_cast<int64_t>(tick) * TickDuration - time_source_.monotonicTime());
+  driver_->enableHRTimer(std::max(delay, std::chrono::microseconds(0)));
+}
+
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * A hashed hierarchical timing wheel (Varghese and Lauck) with a resolution of one millisecond,
+ * which multiplexes any number of timers over a single timer of the underlying scheduler.
+ *
+ * The wheel has Levels levels of SlotsPerLevel slots each. A slot of level L covers
+ * SlotsPerLevel^L ticks, so that the wheel covers SlotsPerLevel^Levels ticks (about 49 days) past
+ * the current tick; timers further out are parked in the top level until they get close enough.
+ * Each slot is an intrusive list of timers, so enabling and disabling a timer is O(1). When the
+ * wheel reaches the start of a slot of a level above 0, the timers in it are cascaded to the lower
+ * levels; when it reaches a slot of level 0, the timers in it fire.
+ *
+ * Re-enabling a timer for a later deadline, which is what idle timers do on every read and write,
+ * only updates its deadline: the timer stays in its slot and is moved when the wheel reaches that
+ * slot. Disabling a timer leaves the underlying timer armed; a wakeup with nothing to do costs
+ * less than re-arming the underlying timer every time.
+ *
+ * Timers enabled with a zero delay, which libevent runs in the next iteration of the event loop,
+ * and high resolution timers are not a fit for a millisecond wheel and use their own timer of the
+ * underlying scheduler instead.
+ */
+class TimerWheel : NonCopyable {
+public:
+  static constexpr uint32_t SlotBits = 8;
+  static constexpr uint32_t SlotsPerLevel = 1 << SlotBits;
+  static constexpr uint32_t Levels = 4;
+  static constexpr std::chrono::milliseconds TickDuration{1};
+
+  /**
+   * @param scheduler the scheduler providing the underlying timers.
+   * @param dispatcher the dispatcher running the timers.
+   * @param time_source the time source the scheduler's timers are based on.
+   */
+  TimerWheel(Scheduler& scheduler, Dispatcher& dispatcher, TimeSource& time_source);
+
+  /**
+   * Create a timer on the wheel. The timers must not outlive the wheel.
+   */
+  TimerPtr createTimer(TimerCb cb);
+
+private:
+  class WheelTimer;
+
+  struct Slot {
+    WheelTimer* head_{};
+    WheelTimer* tail_{};
+  };
+
+  static constexpr uint64_t SlotMask = SlotsPerLevel - 1;
+  static constexpr uint32_t WordsPerLevel = SlotsPerLevel / 64;
+  static constexpr uint64_t NotArmed = std::numeric_limits<uint64_t>::max();
+
+  void schedule(WheelTimer& timer, std::chrono::milliseconds delay);
+  void link(WheelTimer& timer);
+  void unlink(WheelTimer& timer);
+  uint32_t nextOccupied(uint32_t level, uint32_t index) const;
+  uint64_t nextEventTick() const;
+  void onDriverTimer();
+  void cascade(uint32_t level, uint32_t index);
+  void expire(uint32_t index);
+  void armDriver(uint64_t tick);
+
+  Scheduler& scheduler_;
+  Dispatcher& dispatcher_;
+  TimeSource& time_source_;
+  // Tick 0 of the wheel.
+  const MonotonicTime start_;
+  // The last tick the wheel has processed.
+  uint64_t current_tick_{};
+  // The tick the driver timer is armed for, or NotArmed.
+  uint64_t armed_tick_{NotArmed};
+  // Whether the wheel is processing slots, in which case the driver is armed once done.
+  bool processing_{};
+  std::array<std::array<Slot, SlotsPerLevel>, Levels> slots_;
+  // One bit per non-empty slot, used to skip over empty slots.
+  std::array<std::array<uint64_t, WordsPerLevel>, Levels> occupied_{};
+  const TimerPtr driver_;
+};
+
+using TimerWheelPtr = std::unique_ptr<TimerWheel>;
+
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,213 @@
+#include "source/common/http/character_set_scanner.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ENVOY_CHARACTER_SET_SCANNER_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define ENVOY_CHARACTER_SET_SCANNER_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Envoy {
+namespace Http {
+
+namespace {
+
+// Returns the index of the first character of `str`, starting at `from`, whose presence in `set`
+// is `match`, or `str.size()`.
+size_t findScalar(const CharacterSet& set, absl::string_view str, size_t from, bool match) {
+  for (size_t i = from; i < str.size(); ++i) {
+    if (set.contains(str[i]) == match) {
+      return i;
+    }
+  }
+  return str.size();
+}
+
+// The bit of a nibble row for each high nibble, no bit being set for extended ASCII characters.
+alignas(16) constexpr uint8_t kHighNibbleBits[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                                     0, 0, 0, 0, 0, 0, 0, 0};
+
+#if defined(ENVOY_CHARACTER_SET_SCANNER_X86)
+
+// Returns a mask with bit `i` set if byte `i` of `block` is in the set described by `rows`.
+__attribute__((target("sse4.2"))) inline uint32_t inSetMaskSse42(__m128i block, __m128i rows,
+                                                                 __m128i high_bits) {
+  const __m128i low_nibble_mask = _mm_set1_epi8(0x0f);
+  const __m128i low = _mm_and_si128(block, low_nibble_mask);
+  const __m128i high = _mm_and_si128(_mm_srli_epi16(block, 4), low_nibble_mask);
+  const __m128i row = _mm_shuffle_epi8(rows, low);
+  const __m128i bit = _mm_shuffle_epi8(high_bits, high);
+  const __m128i not_in_set = _mm_cmpeq_epi8(_mm_and_si128(row, bit), _mm_setzero_si128());
+  return ~static_cast<uint32_t>(_mm_movemask_epi8(not_in_set)) & 0xffff;
+}
+
+__attribute__((target("sse4.2"))) size_t findSse42(const CharacterSet& set, absl::string_view str,
+                                                   bool match) {
+  const __m128i rows = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.nibbleRows().data()));
+  const __m128i high_bits = _mm_load_si128(reinterpret_cast<const __m128i*>(kHighNibbleBits));
+  const uint32_t flip = match ? 0 : 0xffff;
+  size_t i = 0;
+  for (; i + 16 <= str.size(); i += 16) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + i));
+    const uint32_t found = inSetMaskSse42(block, rows, high_bits) ^ flip;
+    if (found != 0) {
+      return i + __builtin_ctz(found);
+    }
+  }
+  return findScalar(set, str, i, match);
+}
+
+__attribute__((target("avx2"))) size_t findAvx2(const CharacterSet& set, absl::string_view str,
+                                                bool match) {
+  // The shuffles look up each 128 bit lane separately, so both lanes get the tables.
+  const __m256i rows = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.nibbleRows().data())));
+  const __m256i high_bits = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kHighNibbleBits)));
+  const __m256i low_nibble_mask = _mm256_set1_epi8(0x0f);
+  const uint32_t flip = match ? 0 : 0xffffffff;
+  size_t i = 0;
+  for (; i + 32 <= str.size(); i += 32) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str.data() + i));
+    const __m256i low = _mm256_and_si256(block, low_nibble_mask);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(block, 4), low_nibble_mask);
+    const __m256i row = _mm256_shuffle_epi8(rows, low);
+    const __m256i bit = _mm256_shuffle_epi8(high_bits, high);
+    const __m256i not_in_set =
+        _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), _mm256_setzero_si256());
+    const uint32_t found = ~static_cast<uint32_t>(_mm256_movemask_epi8(not_in_set)) ^ flip;
+    if (found != 0) {
+      return i + __builtin_ctz(found);
+    }
+  }
+  if (i + 16 <= str.size()) {
+    const size_t found = findSse42(set, absl::string_view(str.data() + i, 16), match);
+    if (found != 16) {
+      return i + found;
+    }
+    i += 16;
+  }
+  return findScalar(set, str, i, match);
+}
+
+#elif defined(ENVOY_CHARACTER_SET_SCANNER_NEON)
+
+size_t findNeon(const CharacterSet& set, absl::string_view str, bool match) {
+  const uint8x16_t rows = vld1q_u8(set.nibbleRows().data());
+  const uint8x16_t high_bits = vld1q_u8(kHighNibbleBits);
+  const uint8x16_t low_nibble_mask = vdupq_n_u8(0x0f);
+  const uint8x16_t flip = vdupq_n_u8(match ? 0 : 0xff);
+  size_t i = 0;
+  for (; i + 16 <= str.size(); i += 16) {
+    const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(str.data() + i));
+    const uint8x16_t row = vqtbl1q_u8(rows, vandq_u8(block, low_nibble_mask));
+    const uint8x16_t bit = vqtbl1q_u8(high_bits, vshrq_n_u8(block, 4));
+    const uint8x16_t found = veorq_u8(vtstq_u8(row, bit), flip);
+    // Narrow each byte of the comparison to a nibble to get a 64 bit mask.
+    const uint64_t mask =
+        vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(found), 4)), 0);
+    if (mask != 0) {
+      return i + (__builtin_ctzll(mask) >> 2);
+    }
+  }
+  return findScalar(set, str, i, match);
+}
+
+#endif
+
+using FindFunction = size_t (*)(const CharacterSet&, absl::string_view, bool);
+
+FindFunction findFunction(CharacterSetScanner::Implementation implementation) {
+  switch (implementation) {
+  case CharacterSetScanner::Implementation::Scalar:
+    return [](const CharacterSet& set, absl::string_view str, bool match) {
+      return findScalar(set, str, 0, match);
+    };
+#if defined(ENVOY_CHARACTER_SET_SCANNER_X86)
+  case CharacterSetScanner::Implementation::Sse42:
+    return findSse42;
+  case CharacterSetScanner::Implementation::Avx2:
+    return findAvx2;
+#elif defined(ENVOY_CHARACTER_SET_SCANNER_NEON)
+  case CharacterSetScanner::Implementation::Neon:
+    return findNeon;
+#endif
+  default:
+    PANIC("unsupported character set scanner implementation");
+  }
+}
+
+struct ActiveImplementation {
+  ActiveImplementation() { set(CharacterSetScanner::supportedImplementations().back()); }
+
+  void set(CharacterSetScanner::Implementation implementation) {
+    implementation_ = implementation;
+    find_ = findFunction(implementation);
+  }
+
+  CharacterSetScanner::Implementation implementation_;
+  FindFunction find_;
+};
+
+ActiveImplementation& activeImplementation() {
+  MUTABLE_CONSTRUCT_ON_FIRST_USE(ActiveImplementation);
+}
+
+size_t find(const CharacterSet& set, absl::string_view str, bool match) {
+  if (!set.asciiOnly()) {
+    return findScalar(set, str, 0, match);
+  }
+  return activeImplementation().find_(set, str, match);
+}
+
+} // namespace
+
+size_t CharacterSet::findFirstNotOf(absl::string_view str) const {
+  return find(*this, str, false);
+}
+
+size_t CharacterSet::findFirstOf(absl::string_view str) const { return find(*this, str, true); }
+
+CharacterSetScanner::Implementation CharacterSetScanner::implementation() {
+  return activeImplementation().implementation_;
+}
+
+std::vector<CharacterSetScanner::Implementation> CharacterSetScanner::supportedImplementations() {
+  std::vector<Implementation> implementations{Implementation::Scalar};
+#if defined(ENVOY_CHARACTER_SET_SCANNER_X86)
+  if (__builtin_cpu_supports("sse4.2")) {
+    implementations.push_back(Implementation::Sse42);
+    if (__builtin_cpu_supports("avx2")) {
+      implementations.push_back(Implementation::Avx2);
+    }
+  }
+#elif defined(ENVOY_CHARACTER_SET_SCANNER_NEON)
+  implementations.push_back(Implementation::Neon);
+#endif
+  return implementations;
+}
+
+void CharacterSetScanner::setImplementation(Implementation implementation) {
+  activeImplementation().set(implementation);
+}
+
+absl::string_view CharacterSetScanner::implementationName(Implementation implementation) {
+  switch (implementation) {
+  case Implementation::Scalar:
+    return "scalar";
+  case Implementation::Sse42:
+    return "sse4.2";
+  case Implementation::Avx2:
+    return "avx2";
+  case Implementation::Neon:
+    return "neon";
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "source/common/http/character_set_validation.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * A set of characters, built from one of the tables of character_set_validation.h, that strings
+ * can be scanned against with SIMD instructions.
+ *
+ * Sets of ASCII characters are looked up 16 or 32 bytes at a time by splitting each byte into its
+ * high and low nibbles: a byte is in the set if the bit for its high nibble is set in the row for
+ * its low nibble. Sets that contain extended ASCII characters are scanned one byte at a time.
+ */
+class CharacterSet {
+public:
+  explicit constexpr CharacterSet(const std::array<uint32_t, 8>& table) : table_(table) {
+    for (unsigned c = 0; c < 256; ++c) {
+      if (!testCharInTable(table_, static_cast<char>(c))) {
+        continue;
+      }
+      if (c >= 0x80) {
+        ascii_only_ = false;
+      } else {
+        nibble_rows_[c & 0xf] |= 1 << (c >> 4);
+      }
+    }
+  }
+
+  /**
+   * @return true if the character is in the set.
+   */
+  bool contains(char c) const { return testCharInTable(table_, c); }
+
+  /**
+   * @return the index of the first character of `str` that is not in the set, or `str.size()` if
+   * all the characters are.
+   */
+  size_t findFirstNotOf(absl::string_view str) const;
+
+  /**
+   * @return the index of the first character of `str` that is in the set, or `str.size()` if none
+   * is.
+   */
+  size_t findFirstOf(absl::string_view str) const;
+
+  /**
+   * @return true if all the characters of `str` are in the set.
+   */
+  bool containsAll(absl::string_view str) const { return findFirstNotOf(str) == str.size(); }
+
+  /**
+   * @return true if any of the characters of `str` is in the set.
+   */
+  bool containsAny(absl::string_view str) const { return findFirstOf(str) != str.size(); }
+
+  const std::array<uint32_t, 8>& table() const { return table_; }
+  // Bit `h` of row `l` is set if the character `h << 4 | l` is in the set, for `h` below 8.
+  const std::array<uint8_t, 16>& nibbleRows() const { return nibble_rows_; }
+  bool asciiOnly() const { return ascii_only_; }
+
+private:
+  std::array<uint32_t, 8> table_;
+  std::array<uint8_t, 16> nibble_rows_{};
+  bool ascii_only_{true};
+};
+
+/**
+ * Selects the instructions that CharacterSet scans strings with. The best implementation supported
+ * by the CPU is picked at startup.
+ */
+class CharacterSetScanner {
+public:
+  enum class Implementation { Scalar, Sse42, Avx2, Neon };
+
+  /**
+   * @return the implementation currently used to scan strings.
+   */
+  static Implementation implementation();
+
+  /**
+   * @return the implementations supported by this build and CPU, the last one being the best.
+   */
+  static std::vector<Implementation> supportedImplementations();
+
+  /**
+   * Overrides the implementation used to scan strings, for tests and benchmarks. This is not
+   * thread safe.
+   * @param implementation one of supportedImplementations().
+   */
+  static void setImplementation(Implementation implementation);
+
+  static absl::string_view implementationName(Implementation implementation);
+};
+
+// Characters allowed in field names according to Section 5.1 and in methods according to Section
+// 9.1 of RFC 9110, https://www.rfc-editor.org/rfc/rfc9110.html.
+inline constexpr CharacterSet kGenericHeaderNameCharacterSet{kGenericHeaderNameCharTable};
+
+// The CR and LF characters.
+inline constexpr CharacterSet kCrLfCharacterSet{std::array<uint32_t, 8>{
+    // control characters
+    0b00000000001001000000000000000000,
+    0b00000000000000000000000000000000,
+    0b00000000000000000000000000000000,
+    0b00000000000000000000000000000000,
+    // extended ascii
+    0b00000000000000000000000000000000,
+    0b00000000000000000000000000000000,
+    0b00000000000000000000000000000000,
+    0b00000000000000000000000000000000,
+}};
+
+} // namespace Http
+} // namespace Envoy
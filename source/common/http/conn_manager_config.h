@@ -46,6 +46,8 @@ namespace Http {
   COUNTER(downstream_cx_ssl_total)                                                                 \
   COUNTER(downstream_cx_total)                                                                     \
   COUNTER(downstream_cx_tx_bytes_total)                                                            \
+  COUNTER(downstream_cx_tx_zero_copy_completed)                                                    \
+  COUNTER(downstream_cx_tx_zero_copy_fallback)                                                     \
   COUNTER(downstream_cx_upgrades_total)                                                            \
   COUNTER(downstream_flow_control_paused_reading_total)                                            \
   COUNTER(downstream_flow_control_resumed_reading_total)                                           \
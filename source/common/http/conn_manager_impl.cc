@@ -195,7 +195,9 @@ void ConnectionManagerImpl::initializeReadFilterCallbacks(Network::ReadFilterCal
   read_callbacks_->connection().setConnectionStats(
       {stats_.named_.downstream_cx_rx_bytes_total_, stats_.named_.downstream_cx_rx_bytes_buffered_,
        stats_.named_.downstream_cx_tx_bytes_total_, stats_.named_.downstream_cx_tx_bytes_buffered_,
-       nullptr, &stats_.named_.downstream_cx_delayed_close_timeout_});
+       nullptr, &stats_.named_.downstream_cx_delayed_close_timeout_,
+       &stats_.named_.downstream_cx_tx_zero_copy_completed_,
+       &stats_.named_.downstream_cx_tx_zero_copy_fallback_});
 }
 
 ConnectionManagerImpl::~ConnectionManagerImpl() {
@@ -866,6 +868,7 @@ ConnectionManagerImpl::ActiveStream::ActiveStream(ConnectionManagerImpl& connect
 
   connection_manager_.stats_.named_.downstream_rq_total_.inc();
   connection_manager_.stats_.named_.downstream_rq_active_.inc();
+  connection_manager_.dispatcher_->load().active_streams_.fetch_add(1, std::memory_order_relaxed);
   if (connection_manager_.codec_->protocol() == Protocol::Http2) {
     connection_manager_.stats_.named_.downstream_rq_http2_total_.inc();
   } else if (connection_manager_.codec_->protocol() == Protocol::Http3) {
@@ -944,6 +947,7 @@ void ConnectionManagerImpl::ActiveStream::completeRequest() {
   filter_manager_.streamInfo().onRequestComplete();
 
   connection_manager_.stats_.named_.downstream_rq_active_.dec();
+  connection_manager_.dispatcher_->load().active_streams_.fetch_sub(1, std::memory_order_relaxed);
   if (filter_manager_.streamInfo().healthCheck()) {
     connection_manager_.config_->tracingStats().health_check_.inc();
   }
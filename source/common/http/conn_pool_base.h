@@ -132,7 +132,7 @@ public:
     codec_client_->setConnectionStats(
         {traffic_stats.upstream_cx_rx_bytes_total_, traffic_stats.upstream_cx_rx_bytes_buffered_,
          traffic_stats.upstream_cx_tx_bytes_total_, traffic_stats.upstream_cx_tx_bytes_buffered_,
-         &traffic_stats.bind_errors_, nullptr});
+         &traffic_stats.bind_errors_, nullptr, nullptr, nullptr});
   }
 
   void initializeReadFilters() override { codec_client_->initializeReadFilters(); }
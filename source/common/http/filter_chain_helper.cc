@@ -1,5 +1,6 @@
 #include "source/common/http/filter_chain_helper.h"
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -25,23 +26,59 @@ void FilterChainUtility::createFilterChainForFactories(
             .value_or(filter_config_provider.disabled)) {
       continue;
     }
+    createFilter(manager, filter_config_provider, added_missing_config_filter);
+  }
+}
 
-    auto config = filter_config_provider.provider->config();
-    if (config.has_value()) {
-      manager.applyFilterFactoryCb({filter_config_provider.provider->name()}, config.ref());
-      continue;
-    }
+void FilterChainUtility::createFilterChainForFactories(
+    Http::FilterChainManager& manager, const FilterChainOptions& options,
+    const FilterFactoriesList& filter_factories, uint64_t chain_id) {
+  const FilterChainTemplate* filters =
+      options.filterChainTemplate(chain_id, [&options, &filter_factories]() {
+        FilterChainTemplate filters;
+        for (uint32_t i = 0; i < filter_factories.size(); i++) {
+          if (!options.filterDisabled(filter_factories[i].provider->name())
+                   .value_or(filter_factories[i].disabled)) {
+            filters.push_back(i);
+          }
+        }
+        return filters;
+      });
+  if (filters == nullptr) {
+    createFilterChainForFactories(manager, options, filter_factories);
+    return;
+  }
 
-    // If a filter config is missing after warming, inject a local reply with status 500.
-    if (!added_missing_config_filter) {
-      ENVOY_LOG(trace, "Missing filter config for a provider {}",
-                filter_config_provider.provider->name());
-      manager.applyFilterFactoryCb({}, MissingConfigFilterFactory);
-      added_missing_config_filter = true;
-    } else {
-      ENVOY_LOG(trace, "Provider {} missing a filter config",
-                filter_config_provider.provider->name());
-    }
+  bool added_missing_config_filter = false;
+  for (const uint32_t i : *filters) {
+    createFilter(manager, filter_factories[i], added_missing_config_filter);
+  }
+}
+
+uint64_t FilterChainUtility::nextFilterChainId() {
+  // Starts at 1 so that a default constructed identifier never matches a filter chain.
+  static std::atomic<uint64_t> next_filter_chain_id{1};
+  return next_filter_chain_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FilterChainUtility::createFilter(Http::FilterChainManager& manager,
+                                      const FilterFactoryProvider& filter_config_provider,
+                                      bool& added_missing_config_filter) {
+  auto config = filter_config_provider.provider->config();
+  if (config.has_value()) {
+    manager.applyFilterFactoryCb({filter_config_provider.provider->name()}, config.ref());
+    return;
+  }
+
+  // If a filter config is missing after warming, inject a local reply with status 500.
+  if (!added_missing_config_filter) {
+    ENVOY_LOG(trace, "Missing filter config for a provider {}",
+              filter_config_provider.provider->name());
+    manager.applyFilterFactoryCb({}, MissingConfigFilterFactory);
+    added_missing_config_filter = true;
+  } else {
+    ENVOY_LOG(trace, "Provider {} missing a filter config",
+              filter_config_provider.provider->name());
   }
 }
 
@@ -59,6 +59,17 @@ public:
                                             const FilterChainOptions& options,
                                             const FilterFactoriesList& filter_factories);
 
+  // Same as above, but the filters to create are looked up once per filter chain template of
+  // the options, instead of once per stream, when the options keep templates.
+  static void createFilterChainForFactories(Http::FilterChainManager& manager,
+                                            const FilterChainOptions& options,
+                                            const FilterFactoriesList& filter_factories,
+                                            uint64_t chain_id);
+
+  // Returns a process wide unique identifier for a filter chain, used as the key of the filter
+  // chain templates of the routes.
+  static uint64_t nextFilterChainId();
+
   static absl::Status checkUpstreamHttpFiltersList(const FiltersList& filters);
 
   static std::shared_ptr<DownstreamFilterConfigProviderManager>
@@ -68,6 +79,10 @@ public:
   static std::shared_ptr<UpstreamFilterConfigProviderManager>
   createSingletonUpstreamFilterConfigProviderManager(
       Server::Configuration::ServerFactoryContext& context);
+
+private:
+  static void createFilter(Http::FilterChainManager& manager, const FilterFactoryProvider& filter,
+                           bool& added_missing_config_filter);
 };
 
 template <class FilterCtx, class NeutralNamedHttpFilterFactory>
@@ -1029,6 +1029,11 @@ private:
     absl::optional<bool> filterDisabled(absl::string_view config_name) const override {
       return route_ != nullptr ? route_->filterDisabled(config_name) : absl::nullopt;
     }
+    const FilterChainTemplate*
+    filterChainTemplate(uint64_t chain_id,
+                        const std::function<FilterChainTemplate()>& build) const override {
+      return route_ != nullptr ? route_->filterChainTemplate(chain_id, build) : nullptr;
+    }
 
   private:
     const Router::RouteConstSharedPtr route_;
@@ -0,0 +1,83 @@
+#include "source/common/http/header_map_arena.h"
+
+#include <algorithm>
+#include <new>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Http {
+
+namespace {
+
+constexpr size_t kMaxAlignment = alignof(std::max_align_t);
+
+constexpr size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Allocations are rounded up so that every allocation, and thus a free list node written in it,
+// is aligned on kMaxAlignment.
+constexpr size_t roundedSize(size_t size) {
+  return alignUp(std::max(size, sizeof(void*)), kMaxAlignment);
+}
+
+} // namespace
+
+HeaderMapArena::HeaderMapArena(size_t initial_block_size) : next_block_size_(initial_block_size) {}
+
+HeaderMapArena::~HeaderMapArena() {
+  while (blocks_ != nullptr) {
+    Block* next = blocks_->next_;
+    ::operator delete(blocks_);
+    blocks_ = next;
+  }
+}
+
+void* HeaderMapArena::allocate(size_t size, size_t alignment) {
+  ASSERT(alignment <= kMaxAlignment);
+  size = roundedSize(size);
+  for (auto& [free_size, head] : free_lists_) {
+    if (free_size == size && head != nullptr) {
+      FreeNode* node = head;
+      head = node->next_;
+      return node;
+    }
+  }
+  if (static_cast<size_t>(end_ - current_) < size) {
+    addBlock(size);
+  }
+  void* memory = current_;
+  current_ += size;
+  return memory;
+}
+
+void HeaderMapArena::deallocate(void* memory, size_t size) {
+  size = roundedSize(size);
+  FreeNode* node = static_cast<FreeNode*>(memory);
+  for (auto& [free_size, head] : free_lists_) {
+    if (free_size == size) {
+      node->next_ = head;
+      head = node;
+      return;
+    }
+  }
+  node->next_ = nullptr;
+  free_lists_.emplace_back(size, node);
+}
+
+void HeaderMapArena::addBlock(size_t min_size) {
+  // Blocks double in size so that large header maps need few of them.
+  const size_t header_size = roundedSize(sizeof(Block));
+  const size_t block_size = std::max(next_block_size_, header_size + min_size);
+  next_block_size_ = block_size * 2;
+  Block* block = static_cast<Block*>(::operator new(block_size));
+  block->next_ = blocks_;
+  blocks_ = block;
+  bytes_reserved_ += block_size;
+  current_ = reinterpret_cast<char*>(block) + header_size;
+  end_ = reinterpret_cast<char*>(block) + block_size;
+}
+
+} // namespace Http
+} // namespace Envoy
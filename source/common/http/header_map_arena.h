@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * A bump allocator for the entries of the header maps of a stream. The request headers and
+ * trailers of a stream, or its response headers and trailers, share an arena so that adding a
+ * header does not need its own heap allocation. The memory is only returned to the heap when the
+ * arena is destroyed, which happens when the last header map using it is destroyed.
+ *
+ * Freed allocations are kept on a free list per size and reused by later allocations of the same
+ * size, so that a header map whose headers are repeatedly removed and added does not grow its
+ * arena without bound.
+ *
+ * An arena is not thread safe; like the header maps using it, it must only be used by one thread at
+ * a time.
+ */
+class HeaderMapArena : NonCopyable {
+public:
+  // The size of the first block, enough for the entries of a typical request or response.
+  static constexpr size_t DefaultInitialBlockSize = 4096;
+
+  explicit HeaderMapArena(size_t initial_block_size = DefaultInitialBlockSize);
+  ~HeaderMapArena();
+
+  /**
+   * @return memory for `size` bytes aligned on `alignment`, which must not be larger than the
+   *         alignment of std::max_align_t.
+   */
+  void* allocate(size_t size, size_t alignment);
+
+  /**
+   * Makes memory returned by allocate() available to later allocations of the same size.
+   */
+  void deallocate(void* memory, size_t size);
+
+  /**
+   * @return the number of bytes allocated from the heap for the blocks of the arena.
+   */
+  uint64_t bytesReserved() const { return bytes_reserved_; }
+
+private:
+  struct Block {
+    Block* next_;
+  };
+  struct FreeNode {
+    FreeNode* next_;
+  };
+
+  void addBlock(size_t min_size);
+
+  Block* blocks_{};
+  char* current_{};
+  char* end_{};
+  size_t next_block_size_;
+  uint64_t bytes_reserved_{};
+  absl::InlinedVector<std::pair<size_t, FreeNode*>, 4> free_lists_;
+};
+
+using HeaderMapArenaSharedPtr = std::shared_ptr<HeaderMapArena>;
+
+/**
+ * A standard allocator that allocates from a HeaderMapArena, or from the heap when it has no arena.
+ */
+template <class T> class HeaderMapArenaAllocator {
+public:
+  using value_type = T;
+
+  HeaderMapArenaAllocator() = default;
+  explicit HeaderMapArenaAllocator(HeaderMapArena* arena) : arena_(arena) {}
+  template <class U>
+  HeaderMapArenaAllocator(const HeaderMapArenaAllocator<U>& other) : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    if (arena_ == nullptr) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* memory, size_t n) {
+    if (arena_ == nullptr) {
+      std::allocator<T>().deallocate(memory, n);
+      return;
+    }
+    arena_->deallocate(memory, n * sizeof(T));
+  }
+
+  HeaderMapArena* arena() const { return arena_; }
+
+  template <class U> bool operator==(const HeaderMapArenaAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+  template <class U> bool operator!=(const HeaderMapArenaAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+private:
+  HeaderMapArena* arena_{};
+};
+
+} // namespace Http
+} // namespace Envoy
@@ -43,6 +43,10 @@ HeaderString::HeaderString(const LowerCaseString& ref_value) noexcept
 
 HeaderString::HeaderString(UnionString&& move_value) noexcept {
   buffer_ = std::move(move_value.storage());
+  borrowed_storage_ = std::move(move_value.borrowedStorage());
+  if (borrowed_storage_ != nullptr) {
+    move_value.storage() = InlinedStringVector();
+  }
   move_value.clear();
   ASSERT(valid());
 }
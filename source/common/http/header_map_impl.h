@@ -14,6 +14,7 @@
 #include "source/common/common/compiled_string_map.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
+#include "source/common/http/header_map_arena.h"
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 
@@ -55,8 +56,10 @@ public:
 class HeaderMapImpl : NonCopyable {
 public:
   HeaderMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                const uint32_t max_headers_count = UINT32_MAX)
-      : max_headers_kb_(max_headers_kb), max_headers_count_(max_headers_count) {}
+                const uint32_t max_headers_count = UINT32_MAX,
+                HeaderMapArenaSharedPtr arena = nullptr)
+      : arena_(std::move(arena)), headers_(arena_.get()), max_headers_kb_(max_headers_kb),
+        max_headers_count_(max_headers_count) {}
   virtual ~HeaderMapImpl() = default;
 
   // The following "constructors" call virtual functions during construction and must use the
@@ -112,8 +115,13 @@ public:
     return StatefulHeaderKeyFormatterOptConstRef(makeOptRefFromPtr(formatter_.get()));
   }
   StatefulHeaderKeyFormatterOptRef formatter() { return makeOptRefFromPtr(formatter_.get()); }
+  // The arena the entries of the map are allocated from, if any.
+  HeaderMapArena* arena() const { return arena_.get(); }
 
 protected:
+  struct HeaderEntryImpl;
+  using HeaderEntryList = std::list<HeaderEntryImpl, HeaderMapArenaAllocator<HeaderEntryImpl>>;
+
   struct HeaderEntryImpl : public HeaderEntry, NonCopyable {
     HeaderEntryImpl(const LowerCaseString& key);
     HeaderEntryImpl(const LowerCaseString& key, HeaderString&& value);
@@ -129,9 +137,9 @@ protected:
 
     HeaderString key_;
     HeaderString value_;
-    std::list<HeaderEntryImpl>::iterator entry_;
+    HeaderEntryList::iterator entry_;
   };
-  using HeaderNode = std::list<HeaderEntryImpl>::iterator;
+  using HeaderNode = HeaderEntryList::iterator;
 
   /**
    * This is the static lookup table that is used to determine whether a header is one of the O(1)
@@ -208,9 +216,16 @@ protected:
   class HeaderList : NonCopyable {
   public:
     using HeaderNodeVector = absl::InlinedVector<HeaderNode, 1>;
-    using HeaderLazyMap = absl::flat_hash_map<absl::string_view, HeaderNodeVector>;
+    using HeaderLazyMap = absl::flat_hash_map<
+        absl::string_view, HeaderNodeVector, absl::Hash<absl::string_view>,
+        std::equal_to<absl::string_view>,
+        HeaderMapArenaAllocator<std::pair<const absl::string_view, HeaderNodeVector>>>;
 
-    HeaderList() : pseudo_headers_end_(headers_.end()) {}
+    // The entries are allocated from the arena if it is not null, and from the heap otherwise.
+    explicit HeaderList(HeaderMapArena* arena)
+        : headers_(HeaderMapArenaAllocator<HeaderEntryImpl>(arena)),
+          pseudo_headers_end_(headers_.end()),
+          lazy_map_(HeaderLazyMap::allocator_type(arena)) {}
 
     template <class Key> bool isPseudoHeader(const Key& key) {
       return !key.getStringView().empty() && key.getStringView()[0] == ':';
@@ -300,12 +315,12 @@ protected:
      */
     size_t remove(absl::string_view key);
 
-    std::list<HeaderEntryImpl>::iterator begin() { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::iterator end() { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_iterator begin() const { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::const_iterator end() const { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rend() const { return headers_.rend(); }
+    HeaderEntryList::iterator begin() { return headers_.begin(); }
+    HeaderEntryList::iterator end() { return headers_.end(); }
+    HeaderEntryList::const_iterator begin() const { return headers_.begin(); }
+    HeaderEntryList::const_iterator end() const { return headers_.end(); }
+    HeaderEntryList::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
+    HeaderEntryList::const_reverse_iterator rend() const { return headers_.rend(); }
     HeaderLazyMap::iterator mapFind(absl::string_view key) { return lazy_map_.find(key); }
     HeaderLazyMap::iterator mapEnd() { return lazy_map_.end(); }
     size_t size() const { return headers_.size(); }
@@ -317,7 +332,7 @@ protected:
     }
 
   private:
-    std::list<HeaderEntryImpl> headers_;
+    HeaderEntryList headers_;
     HeaderNode pseudo_headers_end_;
     HeaderLazyMap lazy_map_;
   };
@@ -340,6 +355,8 @@ protected:
   virtual void clearInline() PURE;
   virtual HeaderEntryImpl** inlineHeaders() PURE;
 
+  // Declared before headers_ so that the arena outlives the entries allocated from it.
+  const HeaderMapArenaSharedPtr arena_;
   HeaderList headers_;
   // TODO(mattklein123): The formatter does not currently get copied when a header map gets
   // copied. This may be problematic in certain cases like request shadowing. This is omitted
@@ -365,8 +382,9 @@ protected:
 template <class Interface> class TypedHeaderMapImpl : public HeaderMapImpl, public Interface {
 public:
   TypedHeaderMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                     const uint32_t max_headers_count = UINT32_MAX)
-      : HeaderMapImpl(max_headers_kb, max_headers_count) {}
+                     const uint32_t max_headers_count = UINT32_MAX,
+                     HeaderMapArenaSharedPtr arena = nullptr)
+      : HeaderMapImpl(max_headers_kb, max_headers_count, std::move(arena)) {}
   void setFormatter(StatefulHeaderKeyFormatterPtr&& formatter) {
     formatter_ = std::move(formatter);
   }
@@ -492,9 +510,9 @@ class RequestHeaderMapImpl final : public TypedHeaderMapImpl<RequestHeaderMap>,
 public:
   static std::unique_ptr<RequestHeaderMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
-         const uint32_t max_headers_count = UINT32_MAX) {
-    return std::unique_ptr<RequestHeaderMapImpl>(
-        new (inlineHeadersSize()) RequestHeaderMapImpl(max_headers_kb, max_headers_count));
+         const uint32_t max_headers_count = UINT32_MAX, HeaderMapArenaSharedPtr arena = nullptr) {
+    return std::unique_ptr<RequestHeaderMapImpl>(new (inlineHeadersSize()) RequestHeaderMapImpl(
+        max_headers_kb, max_headers_count, std::move(arena)));
   }
 
   INLINE_REQ_STRING_HEADERS(DEFINE_INLINE_HEADER_STRING_FUNCS)
@@ -521,9 +539,9 @@ private:
 
   using HeaderHandles = ConstSingleton<HeaderHandleValues>;
 
-  RequestHeaderMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                       const uint32_t max_headers_count = UINT32_MAX)
-      : TypedHeaderMapImpl<RequestHeaderMap>(max_headers_kb, max_headers_count) {
+  RequestHeaderMapImpl(const uint32_t max_headers_kb, const uint32_t max_headers_count,
+                       HeaderMapArenaSharedPtr arena)
+      : TypedHeaderMapImpl<RequestHeaderMap>(max_headers_kb, max_headers_count, std::move(arena)) {
     clearInline();
   }
 
@@ -539,9 +557,9 @@ class RequestTrailerMapImpl final : public TypedHeaderMapImpl<RequestTrailerMap>
 public:
   static std::unique_ptr<RequestTrailerMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
-         const uint32_t max_headers_count = UINT32_MAX) {
-    return std::unique_ptr<RequestTrailerMapImpl>(
-        new (inlineHeadersSize()) RequestTrailerMapImpl(max_headers_kb, max_headers_count));
+         const uint32_t max_headers_count = UINT32_MAX, HeaderMapArenaSharedPtr arena = nullptr) {
+    return std::unique_ptr<RequestTrailerMapImpl>(new (inlineHeadersSize()) RequestTrailerMapImpl(
+        max_headers_kb, max_headers_count, std::move(arena)));
   }
 
 protected:
@@ -551,9 +569,9 @@ protected:
   HeaderEntryImpl** inlineHeaders() override { return inline_headers_; }
 
 private:
-  RequestTrailerMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                        const uint32_t max_headers_count = UINT32_MAX)
-      : TypedHeaderMapImpl<RequestTrailerMap>(max_headers_kb, max_headers_count) {
+  RequestTrailerMapImpl(const uint32_t max_headers_kb, const uint32_t max_headers_count,
+                        HeaderMapArenaSharedPtr arena)
+      : TypedHeaderMapImpl<RequestTrailerMap>(max_headers_kb, max_headers_count, std::move(arena)) {
     clearInline();
   }
 
@@ -569,9 +587,9 @@ class ResponseHeaderMapImpl final : public TypedHeaderMapImpl<ResponseHeaderMap>
 public:
   static std::unique_ptr<ResponseHeaderMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
-         const uint32_t max_headers_count = UINT32_MAX) {
-    return std::unique_ptr<ResponseHeaderMapImpl>(
-        new (inlineHeadersSize()) ResponseHeaderMapImpl(max_headers_kb, max_headers_count));
+         const uint32_t max_headers_count = UINT32_MAX, HeaderMapArenaSharedPtr arena = nullptr) {
+    return std::unique_ptr<ResponseHeaderMapImpl>(new (inlineHeadersSize()) ResponseHeaderMapImpl(
+        max_headers_kb, max_headers_count, std::move(arena)));
   }
 
   INLINE_RESP_STRING_HEADERS(DEFINE_INLINE_HEADER_STRING_FUNCS)
@@ -599,9 +617,9 @@ private:
 
   using HeaderHandles = ConstSingleton<HeaderHandleValues>;
 
-  ResponseHeaderMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                        const uint32_t max_headers_count = UINT32_MAX)
-      : TypedHeaderMapImpl<ResponseHeaderMap>(max_headers_kb, max_headers_count) {
+  ResponseHeaderMapImpl(const uint32_t max_headers_kb, const uint32_t max_headers_count,
+                        HeaderMapArenaSharedPtr arena)
+      : TypedHeaderMapImpl<ResponseHeaderMap>(max_headers_kb, max_headers_count, std::move(arena)) {
     clearInline();
   }
   HeaderEntryImpl* inline_headers_[];
@@ -616,9 +634,9 @@ class ResponseTrailerMapImpl final : public TypedHeaderMapImpl<ResponseTrailerMa
 public:
   static std::unique_ptr<ResponseTrailerMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
-         const uint32_t max_headers_count = UINT32_MAX) {
-    return std::unique_ptr<ResponseTrailerMapImpl>(
-        new (inlineHeadersSize()) ResponseTrailerMapImpl(max_headers_kb, max_headers_count));
+         const uint32_t max_headers_count = UINT32_MAX, HeaderMapArenaSharedPtr arena = nullptr) {
+    return std::unique_ptr<ResponseTrailerMapImpl>(new (inlineHeadersSize()) ResponseTrailerMapImpl(
+        max_headers_kb, max_headers_count, std::move(arena)));
   }
 
   INLINE_RESP_STRING_HEADERS_TRAILERS(DEFINE_INLINE_HEADER_STRING_FUNCS)
@@ -638,9 +656,10 @@ private:
 
   using HeaderHandles = ConstSingleton<HeaderHandleValues>;
 
-  ResponseTrailerMapImpl(const uint32_t max_headers_kb = UINT32_MAX,
-                         const uint32_t max_headers_count = UINT32_MAX)
-      : TypedHeaderMapImpl<ResponseTrailerMap>(max_headers_kb, max_headers_count) {
+  ResponseTrailerMapImpl(const uint32_t max_headers_kb, const uint32_t max_headers_count,
+                         HeaderMapArenaSharedPtr arena)
+      : TypedHeaderMapImpl<ResponseTrailerMap>(max_headers_kb, max_headers_count,
+                                               std::move(arena)) {
     clearInline();
   }
 
@@ -5,6 +5,7 @@
 #include <cstdint>
 
 #include "source/common/common/assert.h"
+#include "source/common/http/character_set_scanner.h"
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 
@@ -25,13 +26,22 @@ constexpr absl::string_view kColonSlashSlash = "://";
 constexpr char kResponseFirstByte = 'H';
 constexpr absl::string_view kHttpVersionPrefix = "HTTP/";
 
-// Allowed characters for field names according to Section 5.1
-// and for methods according to Section 9.1 of RFC 9110:
-// https://www.rfc-editor.org/rfc/rfc9110.html
-constexpr absl::string_view kValidCharacters =
-    "!#$%&'*+-.0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ^_`abcdefghijklmnopqrstuvwxyz|~";
-constexpr absl::string_view::iterator kValidCharactersBegin = kValidCharacters.begin();
-constexpr absl::string_view::iterator kValidCharactersEnd = kValidCharacters.end();
+// Same set of characters are allowed for path and query: HT, FF and the visible ASCII characters.
+constexpr CharacterSet kPathQueryCharacterSet{std::array<uint32_t, 8>{
+    // control characters
+    0b00000000010010000000000000000000,
+    // !"#$%&'()*+,-./0123456789:;<=>?
+    0b01111111111111111111111111111111,
+    //@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\]^_
+    0b11111111111111111111111111111111,
+    //`abcdefghijklmnopqrstuvwxyz{|}~
+    0b11111111111111111111111111111110,
+    // extended ascii
+    0b00000000000000000000000000000000,
+    0b00000000000000000000000000000000,
+    0b00000000000000000000000000000000,
+    0b00000000000000000000000000000000,
+}};
 
 bool isFirstCharacterOfValidMethod(char c) {
   static constexpr char kValidFirstCharacters[] = {'A', 'B', 'C', 'D', 'G', 'H', 'L', 'M',
@@ -46,10 +56,7 @@ bool isFirstCharacterOfValidMethod(char c) {
 // enabled.
 bool isMethodValid(absl::string_view method, bool allow_custom_methods) {
   if (allow_custom_methods) {
-    return !method.empty() &&
-           std::all_of(method.begin(), method.end(), [](absl::string_view::value_type c) {
-             return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-           });
+    return !method.empty() && kGenericHeaderNameCharacterSet.containsAll(method);
   }
 
   static constexpr absl::string_view kValidMethods[] = {
@@ -70,15 +77,9 @@ bool isUrlValid(absl::string_view url, bool is_connect) {
     return false;
   }
 
-  // Same set of characters are allowed for path and query.
-  const auto is_valid_path_query_char = [](char c) {
-    return c == 9 || c == 12 || ('!' <= c && c <= 126);
-  };
-
   // The URL may start with a path.
-  if (auto it = url.begin(); *it == '/' || *it == '*') {
-    ++it;
-    return std::all_of(it, url.end(), is_valid_path_query_char);
+  if (url[0] == '/' || url[0] == '*') {
+    return kPathQueryCharacterSet.containsAll(url.substr(1));
   }
 
   // If method is not CONNECT, parse scheme.
@@ -119,7 +120,7 @@ bool isUrlValid(absl::string_view url, bool is_connect) {
   // Match http-parser's quirk of allowing any number of '@' characters in host
   // as long as they are not consecutive.
   return std::all_of(host.begin(), host.end(), valid_host_char) && !absl::StrContains(host, "@@") &&
-         std::all_of(path_query.begin(), path_query.end(), is_valid_path_query_char);
+         kPathQueryCharacterSet.containsAll(path_query);
 }
 
 // Returns true if `version_input` is a valid HTTP version string as defined at
@@ -140,9 +141,7 @@ bool isVersionValid(absl::string_view version_input) {
 }
 
 bool isHeaderNameValid(absl::string_view name) {
-  return std::all_of(name.begin(), name.end(), [](absl::string_view::value_type c) {
-    return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-  });
+  return kGenericHeaderNameCharacterSet.containsAll(name);
 }
 
 } // anonymous namespace
@@ -165,7 +164,7 @@ BalsaParser::BalsaParser(MessageType type, ParserCallbacks* connection, size_t m
       "envoy.reloadable_features.http1_balsa_disallow_lone_cr_in_chunk_extension");
   framer_.set_http_validation_policy(http_validation_policy);
 
-  framer_.set_balsa_headers(&headers_);
+  framer_.set_balsa_headers(headers_.get());
   framer_.set_balsa_visitor(this);
   framer_.set_max_header_length(max_header_length);
   framer_.set_invalid_chars_level(quiche::BalsaFrame::InvalidCharsLevel::kError);
@@ -189,7 +188,7 @@ size_t BalsaParser::execute(const char* slice, int len) {
       if (first_message_) {
         first_message_ = false;
       } else {
-        framer_.Reset();
+        resetFramer();
       }
     }
 
@@ -218,7 +217,7 @@ size_t BalsaParser::execute(const char* slice, int len) {
 
   if (len == 0 && headers_done_ && !isChunked() &&
       ((message_type_ == MessageType::Response && hasTransferEncoding()) ||
-       !headers_.content_length_valid())) {
+       !headers_->content_length_valid())) {
     MessageDone();
     return 0;
   }
@@ -246,33 +245,34 @@ CallbackResult BalsaParser::pause() {
 ParserStatus BalsaParser::getStatus() const { return status_; }
 
 Http::Code BalsaParser::statusCode() const {
-  return static_cast<Http::Code>(headers_.parsed_response_code());
+  return static_cast<Http::Code>(headers_->parsed_response_code());
 }
 
 bool BalsaParser::isHttp11() const {
   if (message_type_ == MessageType::Request) {
-    return absl::EndsWith(headers_.first_line(), Http::Headers::get().ProtocolStrings.Http11String);
+    return absl::EndsWith(headers_->first_line(),
+                          Http::Headers::get().ProtocolStrings.Http11String);
   } else {
-    return absl::StartsWith(headers_.first_line(),
+    return absl::StartsWith(headers_->first_line(),
                             Http::Headers::get().ProtocolStrings.Http11String);
   }
 }
 
 absl::optional<uint64_t> BalsaParser::contentLength() const {
-  if (!headers_.content_length_valid()) {
+  if (!headers_->content_length_valid()) {
     return absl::nullopt;
   }
-  return headers_.content_length();
+  return headers_->content_length();
 }
 
-bool BalsaParser::isChunked() const { return headers_.transfer_encoding_is_chunked(); }
+bool BalsaParser::isChunked() const { return headers_->transfer_encoding_is_chunked(); }
 
-absl::string_view BalsaParser::methodName() const { return headers_.request_method(); }
+absl::string_view BalsaParser::methodName() const { return headers_->request_method(); }
 
 absl::string_view BalsaParser::errorMessage() const { return error_message_; }
 
 int BalsaParser::hasTransferEncoding() const {
-  return headers_.HasHeader(Http::Headers::get().TransferEncoding);
+  return headers_->HasHeader(Http::Headers::get().TransferEncoding);
 }
 
 void BalsaParser::OnRawBodyInput(absl::string_view /*input*/) {}
@@ -289,10 +289,16 @@ void BalsaParser::OnHeaderInput(absl::string_view /*input*/) {}
 void BalsaParser::OnTrailerInput(absl::string_view /*input*/) {}
 
 void BalsaParser::ProcessHeaders(const BalsaHeaders& headers) {
+  ASSERT(&headers == headers_.get());
+  header_storage_ = headers_;
   validateAndProcessHeadersOrTrailersImpl(headers, /* trailers = */ false);
+  header_storage_.reset();
 }
 void BalsaParser::OnTrailers(std::unique_ptr<quiche::BalsaHeaders> trailers) {
-  validateAndProcessHeadersOrTrailersImpl(*trailers, /* trailers = */ true);
+  std::shared_ptr<const quiche::BalsaHeaders> shared_trailers = std::move(trailers);
+  header_storage_ = shared_trailers;
+  validateAndProcessHeadersOrTrailersImpl(*shared_trailers, /* trailers = */ true);
+  header_storage_.reset();
 }
 
 void BalsaParser::OnRequestFirstLineInput(absl::string_view /*line_input*/,
@@ -371,12 +377,22 @@ void BalsaParser::MessageDone() {
   }
   status_ = convertResult(connection_->onMessageComplete());
   if (!delay_reset_) {
-    framer_.Reset();
+    resetFramer();
   }
   first_byte_processed_ = false;
   headers_done_ = false;
 }
 
+void BalsaParser::resetFramer() {
+  if (headers_.use_count() > 1) {
+    // Header strings of the previous message still borrow from its headers, so parse the next
+    // message into new ones.
+    headers_ = std::make_shared<quiche::BalsaHeaders>();
+    framer_.set_balsa_headers(headers_.get());
+  }
+  framer_.Reset();
+}
+
 void BalsaParser::HandleError(BalsaFrameEnums::ErrorCode error_code) {
   status_ = ParserStatus::Error;
   switch (error_code) {
@@ -435,17 +451,21 @@ void BalsaParser::validateAndProcessHeadersOrTrailersImpl(const quiche::BalsaHea
     }
 
     // Remove CR and LF characters to match http-parser behavior.
-    auto is_cr_or_lf = [](char c) { return c == '\r' || c == '\n'; };
-    if (std::any_of(value.begin(), value.end(), is_cr_or_lf)) {
+    if (const size_t first_cr_or_lf = kCrLfCharacterSet.findFirstOf(value);
+        first_cr_or_lf != value.size()) {
       std::string value_without_cr_or_lf;
       value_without_cr_or_lf.reserve(value.size());
-      for (char c : value) {
-        if (!is_cr_or_lf(c)) {
+      value_without_cr_or_lf.append(value.data(), first_cr_or_lf);
+      for (char c : value.substr(first_cr_or_lf)) {
+        if (!kCrLfCharacterSet.contains(c)) {
           value_without_cr_or_lf.push_back(c);
         }
       }
+      // The copy only lives for the duration of the callback and must not be borrowed.
+      BorrowedStorageSharedPtr header_storage = std::move(header_storage_);
       status_ = convertResult(connection_->onHeaderValue(value_without_cr_or_lf.data(),
                                                          value_without_cr_or_lf.length()));
+      header_storage_ = std::move(header_storage);
     } else {
       // No need to copy if header value does not contain CR or LF.
       status_ = convertResult(connection_->onHeaderValue(value.data(), value.length()));
@@ -35,6 +35,7 @@ public:
   absl::string_view methodName() const override;
   absl::string_view errorMessage() const override;
   int hasTransferEncoding() const override;
+  BorrowedStorageSharedPtr headerStorage() const override { return header_storage_; }
 
 private:
   // quiche::BalsaVisitorInterface implementation
@@ -60,6 +61,10 @@ private:
   void HandleError(quiche::BalsaFrameEnums::ErrorCode error_code) override;
   void HandleWarning(quiche::BalsaFrameEnums::ErrorCode error_code) override;
 
+  // Resets the framer for the next message. The headers of the previous message are left alone if
+  // header strings still borrow from them.
+  void resetFramer();
+
   // Shared implementation for ProcessHeaders() and OnTrailers().
   void validateAndProcessHeadersOrTrailersImpl(const quiche::BalsaHeaders& headers, bool trailers);
 
@@ -69,7 +74,9 @@ private:
   ABSL_MUST_USE_RESULT ParserStatus convertResult(CallbackResult result) const;
 
   quiche::BalsaFrame framer_;
-  quiche::BalsaHeaders headers_;
+  std::shared_ptr<quiche::BalsaHeaders> headers_{std::make_shared<quiche::BalsaHeaders>()};
+  // The headers or trailers being passed to the connection, while they are.
+  BorrowedStorageSharedPtr header_storage_;
 
   const MessageType message_type_ = MessageType::Request;
   ParserCallbacks* connection_ = nullptr;
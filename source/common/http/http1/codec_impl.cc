@@ -1,5 +1,6 @@
 #include "source/common/http/http1/codec_impl.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -534,7 +535,11 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
       encode_only_header_key_formatter_(encodeOnlyFormatterFromSettings(settings)),
       processing_trailers_(false), handling_upgrade_(false), reset_stream_called_(false),
       deferred_end_stream_headers_(false), dispatching_(false), max_headers_kb_(max_headers_kb),
-      max_headers_count_(max_headers_count) {
+      max_headers_count_(max_headers_count),
+      use_header_map_arena_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http_header_map_arena")),
+      borrow_header_data_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http1_borrow_header_data")) {
   if (codec_settings_.use_balsa_parser_) {
     parser_ = std::make_unique<BalsaParser>(type, this, max_headers_kb_ * 1024, enableTrailers(),
                                             codec_settings_.allow_custom_methods_);
@@ -566,7 +571,16 @@ Status ConnectionImpl::completeCurrentHeader() {
     if (formatter.has_value()) {
       formatter->processKey(current_header_field_.getStringView());
     }
-    current_header_field_.inlineTransform([](char c) { return absl::ascii_tolower(c); });
+    if (current_header_field_.isBorrowed()) {
+      // A borrowed name is only kept as is if it is already lower case.
+      const absl::string_view name = current_header_field_.getStringView();
+      if (std::any_of(name.begin(), name.end(), absl::ascii_isupper)) {
+        current_header_field_.setCopy(name);
+      }
+    }
+    if (!current_header_field_.isBorrowed()) {
+      current_header_field_.inlineTransform([](char c) { return absl::ascii_tolower(c); });
+    }
 
     headers_or_trailers.addViaMove(std::move(current_header_field_),
                                    std::move(current_header_value_));
@@ -636,6 +650,15 @@ void ConnectionImpl::onDispatch(const Buffer::Instance& data) {
 
 Http::Status ClientConnectionImpl::dispatch(Buffer::Instance& data) {
   Http::Status status = ConnectionImpl::dispatch(data);
+  // The responses to pipelined requests may follow the completed response in the same read.
+  while (status.ok() && data.length() > 0 && !pending_responses_.empty() &&
+         !resetStreamCalled()) {
+    const uint64_t remaining = data.length();
+    status = ConnectionImpl::dispatch(data);
+    if (data.length() == remaining) {
+      break;
+    }
+  }
   if (status.ok() && data.length() > 0) {
     // The HTTP/1.1 codec pauses dispatch after a single response is complete. Extraneous data
     // after a response is complete indicates an error.
@@ -801,7 +824,7 @@ Status ConnectionImpl::onHeaderFieldImpl(const char* data, size_t length) {
     RETURN_IF_ERROR(completeCurrentHeader());
   }
 
-  current_header_field_.append(data, length);
+  appendHeaderData(current_header_field_, absl::string_view(data, length));
 
   return checkMaxHeadersSize();
 }
@@ -832,11 +855,23 @@ Status ConnectionImpl::onHeaderValueImpl(const char* data, size_t length) {
     // whitespace as the spec requires: https://tools.ietf.org/html/rfc7230#section-3.2.4 .
     header_value = StringUtil::ltrim(header_value);
   }
-  current_header_value_.append(header_value.data(), header_value.length());
+  appendHeaderData(current_header_value_, header_value);
 
   return checkMaxHeadersSize();
 }
 
+void ConnectionImpl::appendHeaderData(HeaderString& header_string, absl::string_view data) {
+  if (borrow_header_data_ && header_string.empty()) {
+    BorrowedStorageSharedPtr storage = parser_->headerStorage();
+    if (storage != nullptr) {
+      header_string.setBorrowed(data, std::move(storage));
+      return;
+    }
+  }
+  // Appending to a borrowed string copies it.
+  header_string.append(data.data(), data.length());
+}
+
 StatusOr<CallbackResult> ConnectionImpl::onHeadersCompleteImpl() {
   ASSERT(!processing_trailers_);
   ASSERT(dispatching_);
@@ -984,7 +1019,7 @@ void ConnectionImpl::dispatchBufferedBody() {
 }
 
 void ConnectionImpl::onResetStreamBase(StreamResetReason reason) {
-  ASSERT(!reset_stream_called_);
+  ASSERT(!reset_stream_called_ || resettingPipelinedStreams());
   reset_stream_called_ = true;
   onResetStream(reason);
 }
@@ -1057,9 +1092,9 @@ void ClientConnectionImpl::dumpAdditionalState(std::ostream& os, int indent_leve
 
   // Dump the associated request.
   os << spaces << "Dumping corresponding downstream request:";
-  if (pending_response_.has_value()) {
+  if (!pending_responses_.empty()) {
     os << '\n';
-    const ResponseDecoder* decoder = pending_response_.value().decoder_;
+    const ResponseDecoder* decoder = pending_responses_.front().decoder_;
     DUMP_DETAILS(decoder);
   } else {
     os << " null\n";
@@ -1464,7 +1499,7 @@ ClientConnectionImpl::ClientConnectionImpl(Network::Connection& connection, Code
 }
 
 bool ClientConnectionImpl::cannotHaveBody() {
-  if (pending_response_.has_value() && pending_response_.value().encoder_.headRequest()) {
+  if (!pending_responses_.empty() && pending_responses_.front().encoder_.headRequest()) {
     ASSERT(!pending_response_done_);
     return true;
   } else if (parser_->statusCode() == Http::Code::NoContent ||
@@ -1480,14 +1515,20 @@ bool ClientConnectionImpl::cannotHaveBody() {
 
 RequestEncoder& ClientConnectionImpl::newStream(ResponseDecoder& response_decoder) {
   // If reads were disabled due to flow control, we expect reads to always be enabled again before
-  // reusing this connection. This is done when the response is received.
-  ASSERT(connection_.readEnabled());
-
-  ASSERT(!pending_response_.has_value());
-  ASSERT(pending_response_done_);
-  pending_response_.emplace(*this, std::move(bytes_meter_before_stream_), &response_decoder);
-  pending_response_done_ = false;
-  return pending_response_.value().encoder_;
+  // reusing this connection. This is done when the response is received. A pipelined request may
+  // be sent while an earlier response is still flow controlled.
+  ASSERT(connection_.readEnabled() || !pending_responses_.empty());
+
+  // With pipelining the new request is queued behind the responses that are still outstanding.
+  if (pending_responses_.empty()) {
+    ASSERT(pending_response_done_);
+    pending_responses_.emplace_back(*this, std::move(bytes_meter_before_stream_),
+                                    &response_decoder);
+    pending_response_done_ = false;
+  } else {
+    pending_responses_.emplace_back(*this, nullptr, &response_decoder);
+  }
+  return pending_responses_.back().encoder_;
 }
 
 Status ClientConnectionImpl::onStatusBase(const char* data, size_t length) {
@@ -1506,9 +1547,9 @@ Envoy::StatusOr<CallbackResult> ClientConnectionImpl::onHeadersCompleteBase() {
   // Handle the case where the client is closing a kept alive connection (by sending a 408
   // with a 'Connection: close' header). In this case we just let response flush out followed
   // by the remote close.
-  if (!pending_response_.has_value() && !resetStreamCalled()) {
+  if (pending_responses_.empty() && !resetStreamCalled()) {
     return prematureResponseError("", parser_->statusCode());
-  } else if (pending_response_.has_value()) {
+  } else if (!pending_responses_.empty()) {
     ASSERT(!pending_response_done_);
     auto& headers = absl::get<ResponseHeaderMapPtr>(headers_or_trailers_);
     ENVOY_CONN_LOG(trace, "Client: onHeadersComplete size={}", connection_, headers->size());
@@ -1516,7 +1557,7 @@ Envoy::StatusOr<CallbackResult> ClientConnectionImpl::onHeadersCompleteBase() {
 
     if (parser_->statusCode() >= Http::Code::OK &&
         parser_->statusCode() < Http::Code::MultipleChoices &&
-        pending_response_.value().encoder_.connectRequest()) {
+        pending_responses_.front().encoder_.connectRequest()) {
       ENVOY_CONN_LOG(trace, "codec entering upgrade mode for CONNECT response.", connection_);
       handling_upgrade_ = true;
     }
@@ -1543,11 +1584,11 @@ Envoy::StatusOr<CallbackResult> ClientConnectionImpl::onHeadersCompleteBase() {
     }
 
     if (HeaderUtility::isSpecial1xx(*headers)) {
-      pending_response_.value().decoder_->decode1xxHeaders(std::move(headers));
+      pending_responses_.front().decoder_->decode1xxHeaders(std::move(headers));
     } else if (cannotHaveBody() && !handling_upgrade_) {
       deferred_end_stream_headers_ = true;
     } else {
-      pending_response_.value().decoder_->decodeHeaders(std::move(headers), false);
+      pending_responses_.front().decoder_->decodeHeaders(std::move(headers), false);
     }
 
     // http-parser treats 1xx headers as their own complete response. Swallow the spurious
@@ -1568,17 +1609,17 @@ Envoy::StatusOr<CallbackResult> ClientConnectionImpl::onHeadersCompleteBase() {
 }
 
 bool ClientConnectionImpl::upgradeAllowed() const {
-  if (pending_response_.has_value()) {
-    return pending_response_->encoder_.upgradeRequest();
+  if (!pending_responses_.empty()) {
+    return pending_responses_.front().encoder_.upgradeRequest();
   }
   return false;
 }
 
 void ClientConnectionImpl::onBody(Buffer::Instance& data) {
   ASSERT(!deferred_end_stream_headers_);
-  if (pending_response_.has_value()) {
+  if (!pending_responses_.empty()) {
     ASSERT(!pending_response_done_);
-    pending_response_.value().decoder_->decodeData(data, false);
+    pending_responses_.front().decoder_->decodeData(data, false);
   }
 }
 
@@ -1588,12 +1629,12 @@ CallbackResult ClientConnectionImpl::onMessageCompleteBase() {
     ignore_message_complete_for_1xx_ = false;
     return CallbackResult::Success;
   }
-  if (pending_response_.has_value()) {
+  if (!pending_responses_.empty()) {
     ASSERT(!pending_response_done_);
     // After calling decodeData() with end stream set to true, we should no longer be able to reset.
-    PendingResponse& response = pending_response_.value();
-    // Encoder is used as part of decode* calls later in this function so pending_response_ can not
-    // be reset just yet. Preserve the state in pending_response_done_ instead.
+    PendingResponse& response = pending_responses_.front();
+    // Encoder is used as part of decode* calls later in this function so the response can not be
+    // released just yet. Preserve the state in pending_response_done_ instead.
     pending_response_done_ = true;
 
     if (deferred_end_stream_headers_) {
@@ -1619,7 +1660,8 @@ CallbackResult ClientConnectionImpl::onMessageCompleteBase() {
     }
 
     // Reset to ensure no information from one requests persists to the next.
-    pending_response_.reset();
+    pending_responses_.pop_front();
+    pending_response_done_ = pending_responses_.empty();
     headers_or_trailers_.emplace<ResponseHeaderMapPtr>(nullptr);
   }
 
@@ -1628,32 +1670,47 @@ CallbackResult ClientConnectionImpl::onMessageCompleteBase() {
 }
 
 void ClientConnectionImpl::onResetStream(StreamResetReason reason) {
-  // Only raise reset if we did not already dispatch a complete response.
-  if (pending_response_.has_value() && !pending_response_done_) {
-    pending_response_.value().encoder_.runResetCallbacks(reason, absl::string_view());
-    pending_response_done_ = true;
-    pending_response_.reset();
+  // Only raise reset if we did not already dispatch a complete response. A completed response
+  // stays at the front until onMessageCompleteBase() releases it.
+  // The reset tears down the connection, so the requests pipelined behind the front one are reset
+  // as well. Their teardown may re-enter here, hence each response is unlinked before its callbacks
+  // run and the loop picks up whatever is left.
+  const bool resetting_pipelined_streams = resetting_pipelined_streams_;
+  resetting_pipelined_streams_ = true;
+  while (pending_responses_.size() > (pending_response_done_ ? 1 : 0)) {
+    auto it = pending_responses_.begin();
+    if (pending_response_done_) {
+      ++it;
+    }
+    std::list<PendingResponse> reset_response;
+    reset_response.splice(reset_response.end(), pending_responses_, it);
+    if (pending_responses_.empty()) {
+      pending_response_done_ = true;
+    }
+    reset_response.front().encoder_.runResetCallbacks(reason, absl::string_view());
   }
+  resetting_pipelined_streams_ = resetting_pipelined_streams;
 }
 
 Status ClientConnectionImpl::sendProtocolError(absl::string_view details) {
-  if (pending_response_.has_value()) {
+  if (!pending_responses_.empty()) {
     ASSERT(!pending_response_done_);
-    pending_response_.value().encoder_.setDetails(details);
+    pending_responses_.front().encoder_.setDetails(details);
   }
   return okStatus();
 }
 
 void ClientConnectionImpl::onAboveHighWatermark() {
-  // This should never happen without an active stream/request.
-  pending_response_.value().encoder_.runHighWatermarkCallbacks();
+  // This should never happen without an active stream/request. Write side flow control applies to
+  // the request being encoded, which is the most recent one.
+  pending_responses_.back().encoder_.runHighWatermarkCallbacks();
 }
 
 void ClientConnectionImpl::onBelowLowWatermark() {
   // This can get called without an active stream/request when the response completion causes us to
   // close the connection, but in doing so go below low watermark.
-  if (pending_response_.has_value() && !pending_response_done_) {
-    pending_response_.value().encoder_.runLowWatermarkCallbacks();
+  if (pending_responses_.size() > (pending_response_done_ ? 1 : 0)) {
+    pending_responses_.back().encoder_.runLowWatermarkCallbacks();
   }
 }
 
@@ -280,6 +280,9 @@ protected:
                  MessageType type, uint32_t max_headers_kb, const uint32_t max_headers_count);
 
   bool resetStreamCalled() { return reset_stream_called_; }
+  // True while the resets of pipelined requests are being raised, during which a request that is
+  // torn down may reset its stream again.
+  virtual bool resettingPipelinedStreams() const { return false; }
 
   // This must be protected because it is called through ServerConnectionImpl::sendProtocolError.
   Status onMessageBeginImpl();
@@ -320,6 +323,10 @@ protected:
   StreamInfo::BytesMeterSharedPtr bytes_meter_before_stream_;
   const uint32_t max_headers_kb_;
   const uint32_t max_headers_count_;
+  const bool use_header_map_arena_;
+  const bool borrow_header_data_;
+  // The arena shared by the headers and trailers of the message being parsed, if arenas are used.
+  HeaderMapArenaSharedPtr header_map_arena_;
 
 private:
   enum class HeaderParsingState { Field, Value, Done };
@@ -346,6 +353,13 @@ private:
    */
   Status completeCurrentHeader();
 
+  /**
+   * Appends header field or value data received from the parser to a header string. The data is
+   * borrowed from the parser instead of copied if the string is empty and the parser keeps the
+   * data alive.
+   */
+  void appendHeaderData(HeaderString& header_string, absl::string_view data);
+
   /**
    * Check if header name contains underscore character.
    * Underscore character is allowed in header names by the RFC-7230 and this check is implemented
@@ -543,7 +557,9 @@ private:
   }
   void allocHeaders(StatefulHeaderKeyFormatterPtr&& formatter) override {
     ASSERT(!processing_trailers_);
-    auto headers = RequestHeaderMapImpl::create(max_headers_kb_, max_headers_count_);
+    header_map_arena_ = use_header_map_arena_ ? std::make_shared<HeaderMapArena>() : nullptr;
+    auto headers =
+        RequestHeaderMapImpl::create(max_headers_kb_, max_headers_count_, header_map_arena_);
     headers->setFormatter(std::move(formatter));
     headers_or_trailers_.emplace<RequestHeaderMapPtr>(std::move(headers));
   }
@@ -551,7 +567,7 @@ private:
     ASSERT(processing_trailers_);
     if (!absl::holds_alternative<RequestTrailerMapPtr>(headers_or_trailers_)) {
       headers_or_trailers_.emplace<RequestTrailerMapPtr>(
-          RequestTrailerMapImpl::create(max_headers_kb_, max_headers_count_));
+          RequestTrailerMapImpl::create(max_headers_kb_, max_headers_count_, header_map_arena_));
     }
   }
   void dumpAdditionalState(std::ostream& os, int indent_level) const override;
@@ -620,8 +636,8 @@ private:
   Http::Status dispatch(Buffer::Instance& data) override;
   void onEncodeComplete() override { encode_complete_ = true; }
   StreamInfo::BytesMeter& getBytesMeter() override {
-    if (pending_response_.has_value()) {
-      return *(pending_response_->encoder_.getStream().bytesMeter());
+    if (!pending_responses_.empty()) {
+      return *(pending_responses_.front().encoder_.getStream().bytesMeter());
     }
     if (bytes_meter_before_stream_ == nullptr) {
       bytes_meter_before_stream_ = std::make_shared<StreamInfo::BytesMeter>();
@@ -634,6 +650,7 @@ private:
   void onBody(Buffer::Instance& data) override;
   CallbackResult onMessageCompleteBase() override;
   void onResetStream(StreamResetReason reason) override;
+  bool resettingPipelinedStreams() const override { return resetting_pipelined_streams_; }
   Status sendProtocolError(absl::string_view details) override;
   void onAboveHighWatermark() override;
   void onBelowLowWatermark() override;
@@ -650,7 +667,9 @@ private:
   void allocHeaders(StatefulHeaderKeyFormatterPtr&& formatter) override {
     ASSERT(nullptr == absl::get<ResponseHeaderMapPtr>(headers_or_trailers_));
     ASSERT(!processing_trailers_);
-    auto headers = ResponseHeaderMapImpl::create(max_headers_kb_, max_headers_count_);
+    header_map_arena_ = use_header_map_arena_ ? std::make_shared<HeaderMapArena>() : nullptr;
+    auto headers =
+        ResponseHeaderMapImpl::create(max_headers_kb_, max_headers_count_, header_map_arena_);
     headers->setFormatter(std::move(formatter));
     headers_or_trailers_.emplace<ResponseHeaderMapPtr>(std::move(headers));
   }
@@ -658,7 +677,7 @@ private:
     ASSERT(processing_trailers_);
     if (!absl::holds_alternative<ResponseTrailerMapPtr>(headers_or_trailers_)) {
       headers_or_trailers_.emplace<ResponseTrailerMapPtr>(
-          ResponseTrailerMapImpl::create(max_headers_kb_, max_headers_count_));
+          ResponseTrailerMapImpl::create(max_headers_kb_, max_headers_count_, header_map_arena_));
     }
   }
   void dumpAdditionalState(std::ostream& os, int indent_level) const override;
@@ -667,13 +686,17 @@ private:
   // buffer. This buffer is always allocated, never nullptr.
   Buffer::InstancePtr owned_output_buffer_;
 
-  absl::optional<PendingResponse> pending_response_;
-  // TODO(mattklein123): The following bool tracks whether a pending response is complete before
-  // dispatching callbacks. This is needed so that pending_response_ stays valid during callbacks
+  // Responses in the order their requests were sent. The front is the response being decoded, the
+  // back belongs to the request being encoded. There is more than one only when the connection
+  // pool pipelines requests. A list keeps the encoders at stable addresses.
+  std::list<PendingResponse> pending_responses_;
+  // TODO(mattklein123): The following bool tracks whether the front pending response is complete
+  // before dispatching callbacks. This is needed so that the response stays valid during callbacks
   // in order to access the stream, but to avoid invoking callbacks that shouldn't be called once
   // the response is complete. The existence of this variable is hard to reason about and it should
-  // be combined with pending_response_ somehow in a follow up cleanup.
+  // be combined with pending_responses_ somehow in a follow up cleanup.
   bool pending_response_done_{true};
+  bool resetting_pipelined_streams_{};
   // Set true between receiving non-101 1xx headers and receiving the spurious onMessageComplete.
   bool ignore_message_complete_for_1xx_{};
   // TODO(mattklein123): This should be a member of PendingResponse but this change needs dedicated
@@ -1,5 +1,6 @@
 #include "source/common/http/http1/conn_pool.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -35,9 +36,13 @@ ActiveClient::StreamWrapper::~StreamWrapper() {
   // here to attach pending requests in next dispatcher loop to handle that case.
   // https://github.com/envoyproxy/envoy/issues/2715
   parent_.parent_.onStreamClosed(parent_, true);
+  parent_.updatePipelineLimit();
 }
 
-void ActiveClient::StreamWrapper::onEncodeComplete() { encode_complete_ = true; }
+void ActiveClient::StreamWrapper::onEncodeComplete() {
+  encode_complete_ = true;
+  parent_.updatePipelineLimit();
+}
 
 void ActiveClient::StreamWrapper::decodeHeaders(ResponseHeaderMapPtr&& headers, bool end_stream) {
   close_connection_ =
@@ -58,38 +63,106 @@ void ActiveClient::StreamWrapper::onDecodeComplete() {
     parent_.codec_client_->close();
   } else if (close_connection_ || parent_.codec_client_->remoteClosed()) {
     ENVOY_CONN_LOG(debug, "saw upstream close connection", *parent_.codec_client_);
+    // The upstream does not process requests pipelined behind a response that closes the
+    // connection, so they are refused rather than failed and may be retried. A connection closed
+    // without such a response may have been closed at any point, so its pipelined requests are
+    // reset as on any other connection termination.
+    parent_.resetPipelinedStreams(close_connection_ ? StreamResetReason::RemoteRefusedStreamReset
+                                                    : StreamResetReason::ConnectionTermination);
     parent_.codec_client_->close();
   } else {
+    ASSERT(parent_.stream_wrappers_.front().get() == this);
     auto* pool = &parent_.parent();
     pool->scheduleOnUpstreamReady();
-    parent_.stream_wrapper_.reset();
+    parent_.releaseFrontStream();
 
     pool->checkForIdleAndCloseIdleConnsIfDraining();
   }
 }
 
 void ActiveClient::StreamWrapper::onResetStream(StreamResetReason, absl::string_view) {
-  parent_.codec_client_->close();
+  if (!parent_.resetting_pipelined_streams_) {
+    parent_.codec_client_->close();
+  }
 }
 
 ActiveClient::ActiveClient(HttpConnPoolImplBase& parent,
-                           OptRef<Upstream::Host::CreateConnectionData> data)
+                           OptRef<Upstream::Host::CreateConnectionData> data,
+                           uint32_t max_pipelined_requests)
     : Envoy::Http::ActiveClient(parent, parent.host()->cluster().maxRequestsPerConnection(),
-                                /* effective_concurrent_stream_limit */ 1,
-                                /* configured_concurrent_stream_limit */ 1, data) {
+                                /* effective_concurrent_stream_limit */ max_pipelined_requests,
+                                /* configured_concurrent_stream_limit */ max_pipelined_requests,
+                                data),
+      max_pipelined_requests_(max_pipelined_requests) {
   parent.host()->cluster().trafficStats()->upstream_cx_http1_total_.inc();
 }
 
-ActiveClient::~ActiveClient() { ASSERT(!stream_wrapper_.get()); }
+ActiveClient::~ActiveClient() { ASSERT(stream_wrappers_.empty()); }
 
 bool ActiveClient::closingWithIncompleteStream() const {
-  return (stream_wrapper_ != nullptr) && (!stream_wrapper_->decode_complete_);
+  return std::any_of(stream_wrappers_.begin(), stream_wrappers_.end(),
+                     [](const StreamWrapperPtr& wrapper) { return !wrapper->decode_complete_; });
 }
 
 RequestEncoder& ActiveClient::newStreamEncoder(ResponseDecoder& response_decoder) {
-  ASSERT(!stream_wrapper_);
-  stream_wrapper_ = std::make_unique<StreamWrapper>(response_decoder, *this);
-  return *stream_wrapper_;
+  ASSERT(stream_wrappers_.size() < max_pipelined_requests_);
+  ASSERT(stream_wrappers_.empty() || stream_wrappers_.back()->encode_complete_);
+  if (max_pipelined_requests_ > 1) {
+    Upstream::ClusterTrafficStats& traffic_stats = *parent_.host()->cluster().trafficStats();
+    if (!stream_wrappers_.empty()) {
+      traffic_stats.upstream_rq_pipelined_.inc();
+    }
+    traffic_stats.upstream_rq_pipeline_depth_.recordValue(stream_wrappers_.size() + 1);
+  }
+  stream_wrappers_.push_back(std::make_unique<StreamWrapper>(response_decoder, *this));
+  updatePipelineLimit();
+  return *stream_wrappers_.back();
+}
+
+void ActiveClient::releaseFrontStream() {
+  // Unlink the stream before destroying it so that the pool observes the freed capacity.
+  StreamWrapperPtr stream = std::move(stream_wrappers_.front());
+  stream_wrappers_.pop_front();
+  stream.reset();
+}
+
+void ActiveClient::resetPipelinedStreams(StreamResetReason reason) {
+  if (stream_wrappers_.size() < 2) {
+    return;
+  }
+  // The codec resets every request behind the completed response at once. The caller closes the
+  // connection afterwards.
+  resetting_pipelined_streams_ = true;
+  (*std::next(stream_wrappers_.begin()))->getStream().resetStream(reason);
+  resetting_pipelined_streams_ = false;
+}
+
+void ActiveClient::updatePipelineLimit() {
+  if (max_pipelined_requests_ <= 1 || state() == State::Closed) {
+    return;
+  }
+  const uint32_t limit = stream_wrappers_.empty() || stream_wrappers_.back()->encode_complete_
+                             ? max_pipelined_requests_
+                             : stream_wrappers_.size();
+  if (limit == concurrent_stream_limit_) {
+    return;
+  }
+  // Adjust the pool's view of the capacity of this connection in the same way as a change of the
+  // HTTP/2 SETTINGS_MAX_CONCURRENT_STREAMS does.
+  const int64_t old_unused_capacity = currentUnusedCapacity();
+  concurrent_stream_limit_ = limit;
+  const int64_t delta = old_unused_capacity - currentUnusedCapacity();
+  if (state() == State::Ready && currentUnusedCapacity() <= 0) {
+    parent_.transitionActiveClientState(*this, State::Busy);
+  } else if (state() == State::Busy && currentUnusedCapacity() > 0) {
+    parent_.transitionActiveClientState(*this, State::Ready);
+    parent_.scheduleOnUpstreamReady();
+  }
+  if (delta > 0) {
+    parent_.decrClusterStreamCapacity(delta);
+  } else if (delta < 0) {
+    parent_.incrClusterStreamCapacity(-delta);
+  }
 }
 
 ConnectionPool::InstancePtr
@@ -103,7 +176,9 @@ allocateConnPool(Event::Dispatcher& dispatcher, Random::RandomGenerator& random_
       std::move(host), std::move(priority), dispatcher, options, transport_socket_options,
       random_generator, state,
       [](HttpConnPoolImplBase* pool) {
-        return std::make_unique<ActiveClient>(*pool, absl::nullopt);
+        return std::make_unique<ActiveClient>(
+            *pool, absl::nullopt,
+            pool->host()->cluster().http1Settings().max_pipelined_requests_);
       },
       [](Upstream::Host::CreateConnectionData& data, HttpConnPoolImplBase* pool) {
         CodecClientPtr codec{new CodecClientProd(
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <list>
+
 #include "envoy/event/timer.h"
 #include "envoy/http/codec.h"
 #include "envoy/server/overload/overload_manager.h"
@@ -13,11 +15,14 @@ namespace Http {
 namespace Http1 {
 
 /**
- * An active client for HTTP/1.1 connections.
+ * An active client for HTTP/1.1 connections. With max_pipelined_requests greater than one,
+ * requests are pipelined on the connection: a new request is sent once the previous one has been
+ * fully encoded, while up to max_pipelined_requests responses are outstanding.
  */
 class ActiveClient : public Envoy::Http::ActiveClient {
 public:
-  ActiveClient(HttpConnPoolImplBase& parent, OptRef<Upstream::Host::CreateConnectionData> data);
+  ActiveClient(HttpConnPoolImplBase& parent, OptRef<Upstream::Host::CreateConnectionData> data,
+               uint32_t max_pipelined_requests = 1);
   ~ActiveClient() override;
 
   // ConnPoolImplBase::ActiveClient
@@ -29,10 +34,13 @@ public:
     // Unfortunately for the HTTP/1 codec, the stream is destroyed before decode
     // is complete, and we must make sure the connection pool does not observe available
     // capacity and assign a new stream before decode is complete.
-    return stream_wrapper_.get() ? 1 : 0;
+    return stream_wrappers_.size();
   }
   void releaseResources() override {
-    parent_.dispatcher().deferredDelete(std::move(stream_wrapper_));
+    while (!stream_wrappers_.empty()) {
+      parent_.dispatcher().deferredDelete(std::move(stream_wrappers_.front()));
+      stream_wrappers_.pop_front();
+    }
     Envoy::Http::ActiveClient::releaseResources();
   }
 
@@ -66,7 +74,18 @@ public:
   };
   using StreamWrapperPtr = std::unique_ptr<StreamWrapper>;
 
-  StreamWrapperPtr stream_wrapper_;
+  // Removes the completed front stream, destroying it.
+  void releaseFrontStream();
+  // Resets the streams pipelined behind the front one without closing the connection for each.
+  void resetPipelinedStreams(StreamResetReason reason);
+  // Admits further requests only once the most recent one has been fully encoded, so that the
+  // bytes of pipelined requests do not interleave on the connection.
+  void updatePipelineLimit();
+
+  // Streams in the order their requests were sent, which is also the order of the responses.
+  std::list<StreamWrapperPtr> stream_wrappers_;
+  const uint32_t max_pipelined_requests_;
+  bool resetting_pipelined_streams_{};
 };
 
 ConnectionPool::InstancePtr
@@ -166,6 +166,9 @@ absl::string_view LegacyHttpParserImpl::errorMessage() const {
 
 int LegacyHttpParserImpl::hasTransferEncoding() const { return impl_->hasTransferEncoding(); }
 
+// http_parser points into the input slice, which the codec drains once it is parsed.
+BorrowedStorageSharedPtr LegacyHttpParserImpl::headerStorage() const { return nullptr; }
+
 } // namespace Http1
 } // namespace Http
 } // namespace Envoy
@@ -25,6 +25,7 @@ public:
   absl::string_view methodName() const override;
   absl::string_view errorMessage() const override;
   int hasTransferEncoding() const override;
+  BorrowedStorageSharedPtr headerStorage() const override;
 
 private:
   class Impl;
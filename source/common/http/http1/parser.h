@@ -3,6 +3,7 @@
 #include <memory>
 
 #include "envoy/common/pure.h"
+#include "envoy/common/union_string.h"
 
 #include "source/common/common/statusor.h"
 #include "source/common/http/status.h"
@@ -150,6 +151,11 @@ public:
 
   // Returns whether the Transfer-Encoding header is present.
   virtual int hasTransferEncoding() const PURE;
+
+  // Returns storage that keeps alive the data passed to the onHeaderField() or onHeaderValue()
+  // callback being invoked, so that the callback can borrow the data instead of copying it. Returns
+  // nullptr if the data is only valid for the duration of the callback.
+  virtual BorrowedStorageSharedPtr headerStorage() const PURE;
 };
 
 using ParserPtr = std::unique_ptr<Parser>;
@@ -48,6 +48,13 @@ const int ERR_PROTO = -505;
 const int ERR_STREAM_CLOSED = -510;
 const int ERR_FLOW_CONTROL = -524;
 
+// Outbound frame coalescing and DATA frame sizing, see ConnectionImpl::writeOutboundFrame() and
+// ConnectionImpl::updateMaxDataFramePayload().
+constexpr uint64_t MaxCoalescedOutboundBytes = 64 * 1024;
+constexpr uint64_t FrameHeaderSize = 9;
+constexpr uint64_t MinAdaptiveDataFramePayload = 4 * 1024;
+constexpr std::chrono::milliseconds CongestionWindowSampleInterval{100};
+
 // Changes or additions to details should be reflected in
 // docs/root/configuration/http/http_conn_man/response_code_details.rst
 class Http2ResponseCodeDetailValues {
@@ -191,6 +198,8 @@ template <typename T> static T* removeConst(const void* object) {
 
 ConnectionImpl::StreamImpl::StreamImpl(ConnectionImpl& parent, uint32_t buffer_limit)
     : MultiplexedStreamImplBase(parent.connection_.dispatcher()), parent_(parent),
+      header_map_arena_(parent.use_header_map_arena_ ? std::make_shared<HeaderMapArena>()
+                                                     : nullptr),
       pending_recv_data_(parent_.connection_.dispatcher().getWatermarkFactory().createBuffer(
           [this]() -> void { this->pendingRecvBufferLowWatermark(); },
           [this]() -> void { this->pendingRecvBufferHighWatermark(); },
@@ -237,7 +246,8 @@ void ConnectionImpl::ServerStreamImpl::destroy() {
 }
 
 http2::adapter::HeaderRep getRep(const HeaderString& str) {
-  if (str.isReference()) {
+  // Borrowed strings only live as long as their header map, which the adapter may outlive.
+  if (str.isReference() && !str.isBorrowed()) {
     return str.getStringView();
   } else {
     return std::string(str.getStringView());
@@ -859,10 +869,15 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
                                const uint32_t max_headers_kb, const uint32_t max_headers_count)
     : stats_(stats), connection_(connection), max_headers_kb_(max_headers_kb),
       max_headers_count_(max_headers_count),
+      use_header_map_arena_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http_header_map_arena")),
       per_stream_buffer_limit_(http2_options.initial_stream_window_size().value()),
       stream_error_on_invalid_http_messaging_(
           http2_options.override_stream_error_on_invalid_http_message().value()),
-      protocol_constraints_(stats, http2_options), dispatching_(false), raised_goaway_(false),
+      protocol_constraints_(stats, http2_options),
+      coalesce_outbound_frames_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.http2_coalesce_outbound_frames")),
+      dispatching_(false), raised_goaway_(false),
       random_(random_generator),
       last_received_data_time_(connection_.dispatcher().timeSource().monotonicTime()) {
   if (http2_options.has_use_oghttp2_codec()) {
@@ -1375,6 +1390,11 @@ Status ConnectionImpl::trackInboundFrames(int32_t stream_id, size_t length, uint
 
 ssize_t ConnectionImpl::onSend(const uint8_t* data, size_t length) {
   ENVOY_CONN_LOG(trace, "send data: bytes={}", connection_, length);
+  if (coalesce_outbound_frames_) {
+    addOutboundFrameFragment(coalesced_output_, data, length);
+    writeOutboundFrame(coalesced_output_);
+    return length;
+  }
   Buffer::OwnedImpl buffer;
   addOutboundFrameFragment(buffer, data, length);
 
@@ -1389,6 +1409,42 @@ ssize_t ConnectionImpl::onSend(const uint8_t* data, size_t length) {
   return length;
 }
 
+void ConnectionImpl::writeOutboundFrame(Buffer::OwnedImpl& output) {
+  if (&output != &coalesced_output_) {
+    connection_.write(output, false);
+  } else if (output.length() >= MaxCoalescedOutboundBytes) {
+    flushCoalescedFrames();
+  }
+}
+
+void ConnectionImpl::flushCoalescedFrames() {
+  if (coalesced_output_.length() > 0) {
+    connection_.write(coalesced_output_, false);
+    // Match the non coalescing path, where anything a write filter left behind is dropped along
+    // with the transient buffer.
+    coalesced_output_.drain(coalesced_output_.length());
+  }
+}
+
+void ConnectionImpl::updateMaxDataFramePayload() {
+  const MonotonicTime now = connection_.dispatcher().approximateMonotonicTime();
+  if (last_congestion_window_sample_.has_value() &&
+      now - *last_congestion_window_sample_ < CongestionWindowSampleInterval) {
+    return;
+  }
+  last_congestion_window_sample_ = now;
+  // Keep DATA frames within the congestion window so that a frame does not straddle two flights
+  // while the window is small, e.g. during slow start or after a loss.
+  const absl::optional<uint64_t> cwnd = connection_.congestionWindowInBytes();
+  if (!cwnd.has_value()) {
+    max_data_frame_payload_ = std::numeric_limits<uint64_t>::max();
+    return;
+  }
+  max_data_frame_payload_ = cwnd.value() > MinAdaptiveDataFramePayload + FrameHeaderSize
+                                ? cwnd.value() - FrameHeaderSize
+                                : MinAdaptiveDataFramePayload;
+}
+
 Status ConnectionImpl::onStreamClose(StreamImpl* stream, uint32_t error_code) {
   if (stream) {
     const int32_t stream_id = stream->stream_id_;
@@ -1548,7 +1604,12 @@ Status ConnectionImpl::sendPendingFrames() {
     return okStatus();
   }
 
+  if (coalesce_outbound_frames_) {
+    updateMaxDataFramePayload();
+  }
   const int rc = adapter_->Send();
+  // Frames serialized before an error still go out so that e.g. GOAWAY reaches the peer.
+  flushCoalescedFrames();
   if (rc != 0) {
     ASSERT(rc == ERR_CALLBACK_FAILURE);
     return codecProtocolError(codecStrError(rc));
@@ -1711,7 +1772,8 @@ ConnectionImpl::Http2Visitor::OnReadyToSendDataForStream(Http2StreamId stream_id
     stream->data_deferred_ = true;
     return {/*payload_length=*/0, /*end_data=*/false, /*end_stream=*/false};
   }
-  const size_t length = std::min<size_t>(max_length, stream->pending_send_data_->length());
+  const size_t length = std::min<uint64_t>(
+      {max_length, stream->pending_send_data_->length(), connection_->max_data_frame_payload_});
   bool end_data = false;
   bool end_stream = false;
   if (stream->local_end_stream_ && length == stream->pending_send_data_->length()) {
@@ -1737,7 +1799,9 @@ bool ConnectionImpl::Http2Visitor::SendDataFrame(Http2StreamId stream_id,
                    stream_id);
     return false;
   }
-  Buffer::OwnedImpl output;
+  Buffer::OwnedImpl local_output;
+  Buffer::OwnedImpl& output =
+      connection_->coalesce_outbound_frames_ ? connection_->coalesced_output_ : local_output;
   connection_->addOutboundFrameFragment(
       output, reinterpret_cast<const uint8_t*>(frame_header.data()), frame_header.size());
   if (!connection_->protocol_constraints_.checkOutboundFrameLimits().ok()) {
@@ -1748,7 +1812,7 @@ bool ConnectionImpl::Http2Visitor::SendDataFrame(Http2StreamId stream_id,
 
   connection_->stats_.pending_send_bytes_.sub(payload_length);
   output.move(*stream->pending_send_data_, payload_length);
-  connection_->connection_.write(output, false);
+  connection_->writeOutboundFrame(output);
   return true;
 }
 
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <list>
 #include <memory>
 #include <ostream>
@@ -412,6 +413,9 @@ protected:
 
     const StreamInfo::BytesMeterSharedPtr& bytesMeter() override { return bytes_meter_; }
     ConnectionImpl& parent_;
+    // The arena shared by the header maps received on the stream, if arenas are used. This is
+    // initialized before the header maps of the derived streams.
+    const HeaderMapArenaSharedPtr header_map_arena_;
     int32_t stream_id_{-1};
     uint32_t unconsumed_bytes_{0};
     uint32_t read_disable_count_{0};
@@ -506,7 +510,8 @@ protected:
                      ResponseDecoder& response_decoder)
         : StreamImpl(parent, buffer_limit), response_decoder_(response_decoder),
           headers_or_trailers_(
-              ResponseHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_)) {}
+              ResponseHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_,
+                                            header_map_arena_)) {}
 
     // Http::MultiplexedStreamImplBase
     // Client streams do not need a flush timer because we currently assume that any failure
@@ -538,10 +543,12 @@ protected:
       // we are about to receive trailers. The codec makes sure this is the only valid sequence.
       if (received_noninformational_headers_) {
         headers_or_trailers_.emplace<ResponseTrailerMapPtr>(
-            ResponseTrailerMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_));
+            ResponseTrailerMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_,
+                                           header_map_arena_));
       } else {
         headers_or_trailers_.emplace<ResponseHeaderMapPtr>(
-            ResponseHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_));
+            ResponseHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_,
+                                          header_map_arena_));
       }
     }
     HeaderMapPtr cloneTrailers(const HeaderMap& trailers) override {
@@ -573,7 +580,8 @@ protected:
     ServerStreamImpl(ConnectionImpl& parent, uint32_t buffer_limit)
         : StreamImpl(parent, buffer_limit),
           headers_or_trailers_(
-              RequestHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_)) {}
+              RequestHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_,
+                                           header_map_arena_)) {}
 
     // StreamImpl
     void destroy() override;
@@ -597,7 +605,8 @@ protected:
     }
     void allocTrailers() override {
       headers_or_trailers_.emplace<RequestTrailerMapPtr>(
-          RequestTrailerMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_));
+          RequestTrailerMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_,
+                                        header_map_arena_));
     }
     HeaderMapPtr cloneTrailers(const HeaderMap& trailers) override {
       return createHeaderMap<ResponseTrailerMapImpl>(trailers);
@@ -720,6 +729,7 @@ protected:
   Network::Connection& connection_;
   const uint32_t max_headers_kb_;
   const uint32_t max_headers_count_;
+  const bool use_header_map_arena_;
   uint32_t per_stream_buffer_limit_;
   bool allow_metadata_;
   uint64_t max_metadata_size_;
@@ -735,6 +745,14 @@ protected:
   // RST_STREAM.
   bool is_outbound_flood_monitored_control_frame_ = 0;
   ProtocolConstraints protocol_constraints_;
+  // When outbound frame coalescing is enabled, the frames serialized by one sendPendingFrames()
+  // call are collected here and handed to the connection with a single write. This is declared
+  // after protocol_constraints_ as the buffered fragments hold its drain trackers.
+  Buffer::OwnedImpl coalesced_output_;
+  const bool coalesce_outbound_frames_;
+  // Upper bound of the DATA frame payload derived from the congestion window of the connection.
+  uint64_t max_data_frame_payload_{std::numeric_limits<uint64_t>::max()};
+  absl::optional<MonotonicTime> last_congestion_window_sample_;
 
   // For the flood mitigation to work the onSend callback must be called once for each outbound
   // frame. This is what the nghttp2 library is doing, however this is not documented. The
@@ -743,6 +761,14 @@ protected:
   // nghttp2 library will keep calling this callback to write the rest of the frame.
   ssize_t onSend(const uint8_t* data, size_t length);
 
+  // Hands a serialized outbound frame to the connection, or keeps it in coalesced_output_ until
+  // the end of the current sendPendingFrames() call or until the write budget is exceeded.
+  void writeOutboundFrame(Buffer::OwnedImpl& output);
+  void flushCoalescedFrames();
+
+  // Samples the congestion window of the connection to size outbound DATA frames.
+  void updateMaxDataFramePayload();
+
   // Called when a stream encodes to the http2 connection which enables us to
   // keep the active_streams list in LRU if deferred processing.
   void updateActiveStreamsOnEncode(StreamImpl& stream) {
@@ -30,7 +30,12 @@ IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polli
   RELEASE_ASSERT(ret == 0, fmt::format("unable to initialize io_uring: {}", errorDetails(-ret)));
 }
 
-IoUringImpl::~IoUringImpl() { io_uring_queue_exit(&ring_); }
+IoUringImpl::~IoUringImpl() {
+  if (buf_ring_ != nullptr) {
+    io_uring_free_buf_ring(&ring_, buf_ring_, provided_buffer_count_, ProvidedBufferGroup);
+  }
+  io_uring_queue_exit(&ring_);
+}
 
 os_fd_t IoUringImpl::registerEventfd() {
   ASSERT(!isEventfdRegistered());
@@ -69,7 +74,11 @@ void IoUringImpl::forEveryCompletion(const CompletionCb& completion_cb) {
 
   for (unsigned i = 0; i < count; ++i) {
     struct io_uring_cqe* cqe = cqes_[i];
-    completion_cb(reinterpret_cast<Request*>(cqe->user_data), cqe->res, false);
+    Request* req = reinterpret_cast<Request*>(cqe->user_data);
+    if (req != nullptr) {
+      req->setCompletionFlags(cqe->flags);
+    }
+    completion_cb(req, cqe->res, false);
   }
 
   io_uring_cq_advance(&ring_, count);
@@ -136,6 +145,23 @@ IoUringResult IoUringImpl::prepareReadv(os_fd_t fd, const struct iovec* iovecs,
   return IoUringResult::Ok;
 }
 
+IoUringResult IoUringImpl::prepareRecvMultishot(os_fd_t fd, Request* user_data) {
+  ENVOY_LOG(trace, "prepare multishot recv for fd = {}", fd);
+  ASSERT(buf_ring_ != nullptr);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = ProvidedBufferGroup;
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                          off_t offset, Request* user_data) {
   ENVOY_LOG(trace, "prepare writev for fd = {}", fd);
@@ -195,6 +221,37 @@ IoUringResult IoUringImpl::prepareShutdown(os_fd_t fd, int how, Request* user_da
   return IoUringResult::Ok;
 }
 
+bool IoUringImpl::registerProvidedBuffers(uint32_t count, uint32_t size) {
+  ASSERT(buf_ring_ == nullptr);
+  ASSERT(count > 0 && count <= 32768 && (count & (count - 1)) == 0);
+  int ret = 0;
+  buf_ring_ = io_uring_setup_buf_ring(&ring_, count, ProvidedBufferGroup, 0, &ret);
+  if (buf_ring_ == nullptr) {
+    ENVOY_LOG(debug, "unable to register provided buffers: {}", errorDetails(-ret));
+    return false;
+  }
+  provided_buffer_count_ = count;
+  provided_buffer_size_ = size;
+  provided_buffers_ = std::make_unique<uint8_t[]>(static_cast<size_t>(count) * size);
+  const int mask = io_uring_buf_ring_mask(count);
+  for (uint32_t i = 0; i < count; i++) {
+    io_uring_buf_ring_add(buf_ring_, providedBuffer(i), size, i, mask, i);
+  }
+  io_uring_buf_ring_advance(buf_ring_, count);
+  return true;
+}
+
+uint8_t* IoUringImpl::providedBuffer(uint16_t buffer_id) {
+  ASSERT(buffer_id < provided_buffer_count_);
+  return provided_buffers_.get() + static_cast<size_t>(buffer_id) * provided_buffer_size_;
+}
+
+void IoUringImpl::recycleProvidedBuffer(uint16_t buffer_id) {
+  io_uring_buf_ring_add(buf_ring_, providedBuffer(buffer_id), provided_buffer_size_, buffer_id,
+                        io_uring_buf_ring_mask(provided_buffer_count_), 0);
+  io_uring_buf_ring_advance(buf_ring_, 1);
+}
+
 IoUringResult IoUringImpl::submit() {
   int res = io_uring_submit(&ring_);
   RELEASE_ASSERT(res >= 0 || res == -EBUSY, "unable to submit io_uring queue entries");
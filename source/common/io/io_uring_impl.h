@@ -38,17 +38,29 @@ public:
                                Request* user_data) override;
   IoUringResult prepareReadv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                              Request* user_data) override;
+  IoUringResult prepareRecvMultishot(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                               off_t offset, Request* user_data) override;
   IoUringResult prepareClose(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareCancel(Request* cancelling_user_data, Request* user_data) override;
   IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) override;
+  bool registerProvidedBuffers(uint32_t count, uint32_t size) override;
+  uint8_t* providedBuffer(uint16_t buffer_id) override;
+  void recycleProvidedBuffer(uint16_t buffer_id) override;
   IoUringResult submit() override;
   void injectCompletion(os_fd_t fd, Request* user_data, int32_t result) override;
   void removeInjectedCompletion(os_fd_t fd) override;
 
 private:
+  // The id of the only buffer group registered with the ring.
+  static constexpr uint16_t ProvidedBufferGroup = 0;
+
   struct io_uring ring_ {};
+  // The ring of provided buffers and the memory backing them, if registered.
+  struct io_uring_buf_ring* buf_ring_{};
+  std::unique_ptr<uint8_t[]> provided_buffers_;
+  uint32_t provided_buffer_count_{};
+  uint32_t provided_buffer_size_{};
   std::vector<struct io_uring_cqe*> cqes_;
   os_fd_t event_fd_{INVALID_SOCKET};
   std::list<InjectedCompletion> injected_completions_;
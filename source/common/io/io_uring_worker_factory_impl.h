@@ -9,8 +9,8 @@ namespace Io {
 class IoUringWorkerFactoryImpl : public IoUringWorkerFactory {
 public:
   IoUringWorkerFactoryImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
-                           uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                           ThreadLocal::SlotAllocator& tls);
+                           uint32_t read_buffer_size, uint32_t provided_buffer_count,
+                           uint32_t write_timeout_ms, ThreadLocal::SlotAllocator& tls);
 
   OptRef<IoUringWorker> getIoUringWorker() override;
 
@@ -21,6 +21,7 @@ private:
   const uint32_t io_uring_size_;
   const bool use_submission_queue_polling_;
   const uint32_t read_buffer_size_;
+  const uint32_t provided_buffer_count_;
   const uint32_t write_timeout_ms_;
   ThreadLocal::TypedSlot<IoUringWorker> tls_;
 };
@@ -59,10 +59,15 @@ void IoUringSocketEntry::onRemoteClose() {
 }
 
 IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
-                                     uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                                     Event::Dispatcher& dispatcher)
+                                     uint32_t read_buffer_size, uint32_t provided_buffer_count,
+                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher)
     : IoUringWorkerImpl(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling),
-                        read_buffer_size, write_timeout_ms, dispatcher) {}
+                        read_buffer_size, write_timeout_ms, dispatcher) {
+  enableSubmissionBatching();
+  if (provided_buffer_count > 0 && !enableProvidedBuffers(provided_buffer_count)) {
+    ENVOY_LOG(info, "io_uring provided buffers are not supported, using per request buffers");
+  }
+}
 
 IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
                                      uint32_t write_timeout_ms, Event::Dispatcher& dispatcher)
@@ -83,6 +88,9 @@ IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer
 IoUringWorkerImpl::~IoUringWorkerImpl() {
   ENVOY_LOG(trace, "destruct io uring worker, existing sockets = {}", sockets_.size());
 
+  // The event loop is not running anymore, the requests closing the sockets are submitted directly.
+  submit_cb_.reset();
+
   for (auto& socket : sockets_) {
     if (socket->getStatus() != Closed) {
       socket->close(false);
@@ -129,6 +137,36 @@ IoUringSocket& IoUringWorkerImpl::addClientSocket(os_fd_t fd, Event::FileReadyCb
 
 Event::Dispatcher& IoUringWorkerImpl::dispatcher() { return dispatcher_; }
 
+void IoUringWorkerImpl::enableSubmissionBatching() {
+  submit_cb_ = dispatcher_.createSchedulableCallback([this]() { io_uring_->submit(); });
+}
+
+bool IoUringWorkerImpl::enableProvidedBuffers(uint32_t count) {
+  ASSERT(!provided_buffers_enabled_);
+  // The kernel requires the number of entries of a buffer ring to be a power of two.
+  uint32_t ring_size = 1;
+  while (ring_size < count && ring_size < MaxProvidedBuffers) {
+    ring_size <<= 1;
+  }
+  provided_buffers_enabled_ = io_uring_->registerProvidedBuffers(ring_size, read_buffer_size_);
+  return provided_buffers_enabled_;
+}
+
+void IoUringWorkerImpl::releaseProvidedBuffer(const Request& req, Buffer::Instance* data,
+                                              uint64_t length) {
+  const uint32_t flags = req.completionFlags();
+  if (!(flags & IORING_CQE_F_BUFFER)) {
+    return;
+  }
+  const uint16_t buffer_id = flags >> IORING_CQE_BUFFER_SHIFT;
+  // The data is copied out so that the buffer returns to the kernel right away. This keeps the
+  // ring from running dry no matter how long the upper layers hold on to the data.
+  if (data != nullptr) {
+    data->add(io_uring_->providedBuffer(buffer_id), length);
+  }
+  io_uring_->recycleProvidedBuffer(buffer_id);
+}
+
 IoUringSocketEntry& IoUringWorkerImpl::addSocket(IoUringSocketEntryPtr&& socket) {
   LinkedList::moveIntoListBack(std::move(socket), sockets_);
   return *sockets_.back();
@@ -144,7 +182,7 @@ IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
   auto res = io_uring_->prepareConnect(socket.fd(), address, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    io_uring_->submit();
     res = io_uring_->prepareConnect(socket.fd(), address, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare connect");
   }
@@ -160,7 +198,7 @@ Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
   auto res = io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    io_uring_->submit();
     res = io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare readv");
   }
@@ -168,6 +206,24 @@ Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
   return req;
 }
 
+Request* IoUringWorkerImpl::submitRecvMultishotRequest(IoUringSocket& socket) {
+  ASSERT(provided_buffers_enabled_);
+  Request* req = new Request(Request::RequestType::Read, socket);
+
+  ENVOY_LOG(trace, "submit multishot recv request, fd = {}, read req = {}", socket.fd(),
+            fmt::ptr(req));
+
+  auto res = io_uring_->prepareRecvMultishot(socket.fd(), req);
+  if (res == IoUringResult::Failed) {
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    io_uring_->submit();
+    res = io_uring_->prepareRecvMultishot(socket.fd(), req);
+    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare multishot recv");
+  }
+  submit();
+  return req;
+}
+
 Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
                                                const Buffer::RawSliceVector& slices) {
   WriteRequest* req = new WriteRequest(socket, slices);
@@ -177,7 +233,7 @@ Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
   auto res = io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    io_uring_->submit();
     res = io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare writev");
   }
@@ -193,7 +249,7 @@ Request* IoUringWorkerImpl::submitCloseRequest(IoUringSocket& socket) {
   auto res = io_uring_->prepareClose(socket.fd(), req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    io_uring_->submit();
     res = io_uring_->prepareClose(socket.fd(), req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare close");
   }
@@ -210,7 +266,7 @@ Request* IoUringWorkerImpl::submitCancelRequest(IoUringSocket& socket, Request*
   auto res = io_uring_->prepareCancel(request_to_cancel, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    io_uring_->submit();
     res = io_uring_->prepareCancel(request_to_cancel, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare cancel");
   }
@@ -227,7 +283,7 @@ Request* IoUringWorkerImpl::submitShutdownRequest(IoUringSocket& socket, int how
   auto res = io_uring_->prepareShutdown(socket.fd(), how, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    io_uring_->submit();
     res = io_uring_->prepareShutdown(socket.fd(), how, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare cancel");
   }
@@ -294,16 +350,24 @@ void IoUringWorkerImpl::onFileEvent() {
       break;
     }
 
-    delete req;
+    // A multishot request stays armed until a completion without IORING_CQE_F_MORE.
+    if (!(req->completionFlags() & IORING_CQE_F_MORE)) {
+      delete req;
+    }
   });
   delay_submit_ = false;
   submit();
 }
 
 void IoUringWorkerImpl::submit() {
-  if (!delay_submit_) {
-    io_uring_->submit();
+  if (delay_submit_) {
+    return;
+  }
+  if (submit_cb_ != nullptr) {
+    submit_cb_->scheduleCallbackCurrentIteration();
+    return;
   }
+  io_uring_->submit();
 }
 
 IoUringServerSocket::IoUringServerSocket(os_fd_t fd, IoUringWorkerImpl& parent,
@@ -338,7 +402,7 @@ void IoUringServerSocket::close(bool keep_fd_open, IoUringSocketOnClosedCb cb) {
     return;
   }
 
-  if (read_req_ != nullptr) {
+  if (read_req_ != nullptr && read_cancel_req_ == nullptr) {
     ENVOY_LOG(trace, "cancel the read request, fd = {}", fd_);
     read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
   }
@@ -372,7 +436,15 @@ void IoUringServerSocket::enableRead() {
   submitReadRequest();
 }
 
-void IoUringServerSocket::disableRead() { IoUringSocketEntry::disableRead(); }
+void IoUringServerSocket::disableRead() {
+  IoUringSocketEntry::disableRead();
+  // Stop a multishot recv from reading more data while the handler does not want it. A single
+  // read is submitted instead once it completes, to notice the remote close.
+  if (read_req_ != nullptr && read_multishot_ && read_cancel_req_ == nullptr) {
+    ENVOY_LOG(trace, "cancel the multishot recv request, fd = {}", fd_);
+    read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
+  }
+}
 
 void IoUringServerSocket::write(Buffer::Instance& data) {
   ENVOY_LOG(trace, "write, buffer size = {}, fd = {}", data.length(), fd_);
@@ -429,6 +501,10 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
 }
 
 void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length) {
+  if (req->completionFlags() & IORING_CQE_F_BUFFER) {
+    parent_.releaseProvidedBuffer(*req, &read_buf_, data_length);
+    return;
+  }
   ReadRequest* read_req = static_cast<ReadRequest*>(req);
   Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
       read_req->buf_.release(), data_length,
@@ -457,12 +533,17 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
             "onRead with result {}, fd = {}, injected = {}, status_ = {}, enable_close_event = {}",
             result, fd_, injected, static_cast<int>(status_), enable_close_event_);
   if (!injected) {
-    read_req_ = nullptr;
+    if (!(req->completionFlags() & IORING_CQE_F_MORE)) {
+      read_req_ = nullptr;
+      read_multishot_ = false;
+    }
     // If the socket is going to close, discard all results.
-    if (status_ == Closed && write_or_shutdown_req_ == nullptr && read_cancel_req_ == nullptr &&
-        write_or_shutdown_cancel_req_ == nullptr) {
+    if (status_ == Closed && read_req_ == nullptr && write_or_shutdown_req_ == nullptr &&
+        read_cancel_req_ == nullptr && write_or_shutdown_cancel_req_ == nullptr) {
       if (result > 0 && keep_fd_open_) {
         moveReadDataToBuffer(req, result);
+      } else {
+        parent_.releaseProvidedBuffer(*req, nullptr, 0);
       }
       closeInternal();
       return;
@@ -473,7 +554,9 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   if (result > 0) {
     moveReadDataToBuffer(req, result);
   } else {
-    if (result != -ECANCELED) {
+    parent_.releaseProvidedBuffer(*req, nullptr, 0);
+    // ENOBUFS means the provided buffers ran out, the multishot recv is submitted again below.
+    if (result != -ECANCELED && result != -ENOBUFS) {
       read_error_ = result;
     }
   }
@@ -622,7 +705,11 @@ void IoUringServerSocket::closeInternal() {
 
 void IoUringServerSocket::submitReadRequest() {
   if (!read_req_) {
-    read_req_ = parent_.submitReadRequest(*this);
+    // Keep a multishot recv armed while the handler wants data. A socket with reads disabled only
+    // needs a single read to notice the remote close.
+    read_multishot_ = status_ == ReadEnabled && parent_.providedBuffersEnabled();
+    read_req_ = read_multishot_ ? parent_.submitRecvMultishotRequest(*this)
+                                : parent_.submitReadRequest(*this);
   }
 }
 
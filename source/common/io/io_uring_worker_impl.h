@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/common/io/io_uring.h"
+#include "envoy/event/schedulable_cb.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/linked_object.h"
@@ -30,9 +31,12 @@ using IoUringSocketEntryPtr = std::unique_ptr<IoUringSocketEntry>;
 
 class IoUringWorkerImpl : public IoUringWorker, private Logger::Loggable<Logger::Id::io> {
 public:
+  // The largest buffer ring the kernel supports.
+  static constexpr uint32_t MaxProvidedBuffers = 32768;
+
   IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
-                    uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    uint32_t read_buffer_size, uint32_t provided_buffer_count,
+                    uint32_t write_timeout_ms, Event::Dispatcher& dispatcher);
   IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size, uint32_t write_timeout_ms,
                     Event::Dispatcher& dispatcher);
   ~IoUringWorkerImpl() override;
@@ -55,6 +59,23 @@ public:
 
   Event::Dispatcher& dispatcher() override;
 
+  // Submit a multishot recv request for a socket, which reads into provided buffers until it is
+  // canceled. Only valid when providedBuffersEnabled().
+  Request* submitRecvMultishotRequest(IoUringSocket& socket);
+
+  // Defer the submission of requests prepared outside of completion handling to the end of the
+  // current event loop iteration, so that they reach the kernel in a single system call.
+  void enableSubmissionBatching();
+
+  // Register a ring of the given number of read buffers with the io_uring instance, rounded up to
+  // a power of two. Returns whether the kernel supports it.
+  bool enableProvidedBuffers(uint32_t count);
+  bool providedBuffersEnabled() const { return provided_buffers_enabled_; }
+
+  // If the completion of the given request carries a provided buffer, copy the first length bytes
+  // of it to data, when not null, and hand the buffer back to the kernel.
+  void releaseProvidedBuffer(const Request& req, Buffer::Instance* data, uint64_t length);
+
   // Remove a socket from this worker.
   IoUringSocketEntryPtr removeSocket(IoUringSocketEntry& socket);
 
@@ -84,6 +105,9 @@ protected:
   // The IoUringWorker will delay the submit the requests which are submitted in request completion
   // callback.
   bool delay_submit_{false};
+  // Submits the pending requests at the end of the event loop iteration, if batching is enabled.
+  Event::SchedulableCallbackPtr submit_cb_;
+  bool provided_buffers_enabled_{false};
 };
 
 class IoUringSocketEntry : public IoUringSocket,
@@ -236,6 +260,8 @@ protected:
   Event::TimerPtr write_timeout_timer_{nullptr};
   // Whether keep the fd open when close the IoUringSocket.
   bool keep_fd_open_{false};
+  // Whether read_req_ is a multishot recv, which stays armed across completions.
+  bool read_multishot_{false};
   // This is used for tracking the read's cancel request.
   Request* read_cancel_req_{nullptr};
   // This is used for tracking the write or shutdown's cancel request.
@@ -2,6 +2,7 @@
 
 #include "envoy/network/filter.h"
 
+#include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/stats/timespan_impl.h"
 
 namespace Envoy {
@@ -55,6 +56,15 @@ void ActiveStreamListenerBase::newConnection(Network::ConnectionSocketPtr&& sock
   socket->connectionInfoProvider().setFilterChainInfo(
       std::make_shared<FilterChainInfoImpl>(filter_chain->name()));
 
+  if (const uint32_t zero_copy_send_min_bytes = config_->zeroCopySendMinBytes();
+      zero_copy_send_min_bytes > 0) {
+    // Only sockets of the default socket interface support zero copy sends.
+    if (auto* io_handle = dynamic_cast<Network::IoSocketHandleImpl*>(&socket->ioHandle());
+        io_handle != nullptr) {
+      io_handle->enableZeroCopySend(zero_copy_send_min_bytes);
+    }
+  }
+
   auto transport_socket = filter_chain->transportSocketFactory().createDownstreamTransportSocket();
   auto server_conn_ptr = dispatcher().createServerConnection(
       std::move(socket), std::move(transport_socket), *stream_info);
@@ -72,6 +72,9 @@ public:
     ++num_listener_connections_;
     config_->openConnections().inc();
   }
+  const Event::DispatcherLoad& load() const override {
+    return tcp_conn_handler_.dispatcher().load();
+  }
   void post(Network::ConnectionSocketPtr&& socket) override;
   void onAcceptWorker(Network::ConnectionSocketPtr&& socket,
                       bool hand_off_restored_destination_connections, bool rebalanced) override;
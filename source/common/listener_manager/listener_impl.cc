@@ -294,6 +294,8 @@ ListenerImpl::ListenerImpl(const envoy::config::listener::v3::Listener& config,
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, use_original_dst, false)),
       per_connection_buffer_limit_bytes_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, per_connection_buffer_limit_bytes, 1024 * 1024)),
+      zero_copy_send_min_bytes_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, zero_copy_send_min_bytes, 0)),
       listener_tag_(parent_.factory_->nextListenerTag()), name_(name),
       added_via_api_(added_via_api), workers_started_(workers_started), maybe_stale_hash_(hash),
       tcp_backlog_size_(
@@ -432,6 +434,8 @@ ListenerImpl::ListenerImpl(ListenerImpl& origin,
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, use_original_dst, false)),
       per_connection_buffer_limit_bytes_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, per_connection_buffer_limit_bytes, 1024 * 1024)),
+      zero_copy_send_min_bytes_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, zero_copy_send_min_bytes, 0)),
       listener_tag_(origin.listener_tag_), name_(name), added_via_api_(added_via_api),
       workers_started_(workers_started), maybe_stale_hash_(hash),
       tcp_backlog_size_(
@@ -520,6 +524,18 @@ absl::Status ListenerImpl::validateConfig() {
           name_));
     }
   }
+  if (configInternal().connection_balance_config().has_reuse_port_cpu_balance()) {
+    if (socket_type_ != Network::Socket::Type::Stream || !reuse_port_) {
+      return absl::InvalidArgumentError(
+          fmt::format("listener {}: reuse_port_cpu_balance can only be used with TCP listeners "
+                      "that have enable_reuse_port set",
+                      name_));
+    }
+    if (!ENVOY_SOCKET_SO_ATTACH_REUSEPORT_CBPF.hasValue()) {
+      return absl::InvalidArgumentError(fmt::format(
+          "listener {}: reuse_port_cpu_balance is not supported by the operating system", name_));
+    }
+  }
   return absl::OkStatus();
 }
 
@@ -541,7 +557,8 @@ ListenerImpl::buildInternalListener(const envoy::config::listener::v3::Listener&
                       name_));
     }
     if ((config.has_connection_balance_config() &&
-         config.connection_balance_config().has_exact_balance()) ||
+         (config.connection_balance_config().has_exact_balance() ||
+          config.connection_balance_config().has_load_aware_balance())) ||
         config.enable_mptcp() ||
         config.has_enable_reuse_port() // internal listener doesn't use physical l4 port.
         || (config.has_freebind() && config.freebind().value()) || config.has_tcp_backlog_size() ||
@@ -688,6 +705,11 @@ void ListenerImpl::buildListenSocketOptions(
     if (reuse_port_) {
       addListenSocketOptions(listen_socket_options_list_[i],
                              Network::SocketOptionFactory::buildReusePortOptions());
+      if (config.connection_balance_config().has_reuse_port_cpu_balance()) {
+        addListenSocketOptions(listen_socket_options_list_[i],
+                               Network::SocketOptionFactory::buildReusePortCpuSteeringOptions(
+                                   parent_.server_.options().concurrency()));
+      }
     }
     if (!address_opts_list[i].get().empty()) {
       addListenSocketOptions(
@@ -827,6 +849,18 @@ ListenerImpl::buildConnectionBalancer(const envoy::config::listener::v3::Listene
         connection_balancers_.emplace(address.asString(),
                                       std::make_shared<Network::ExactConnectionBalancerImpl>());
         break;
+      case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kReusePortCpuBalance:
+        // The kernel picks the worker through the program attached to the listen sockets, each
+        // worker keeps the connections it accepts.
+        connection_balancers_.emplace(address.asString(),
+                                      std::make_shared<Network::NopConnectionBalancerImpl>());
+        break;
+      case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kLoadAwareBalance:
+        connection_balancers_.emplace(
+            address.asString(),
+            std::make_shared<Network::LoadAwareConnectionBalancerImpl>(
+                config.connection_balance_config().load_aware_balance()));
+        break;
       case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kExtendBalance: {
         const std::string connection_balance_library_type{TypeUtil::typeUrlToDescriptorFullName(
             config.connection_balance_config().extend_balance().typed_config().type_url())};
@@ -295,6 +295,7 @@ public:
   uint32_t perConnectionBufferLimitBytes() const override {
     return per_connection_buffer_limit_bytes_;
   }
+  uint32_t zeroCopySendMinBytes() const override { return zero_copy_send_min_bytes_; }
   std::chrono::milliseconds listenerFiltersTimeout() const override {
     return listener_filters_timeout_;
   }
@@ -442,6 +443,7 @@ private:
   const bool mptcp_enabled_;
   const bool hand_off_restored_destination_connections_;
   const uint32_t per_connection_buffer_limit_bytes_;
+  const uint32_t zero_copy_send_min_bytes_;
   const uint64_t listener_tag_;
   const std::string name_;
   const bool added_via_api_;
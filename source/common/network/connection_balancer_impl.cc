@@ -1,5 +1,9 @@
 #include "source/common/network/connection_balancer_impl.h"
 
+#include "envoy/event/dispatcher.h"
+
+#include "source/common/protobuf/utility.h"
+
 namespace Envoy {
 namespace Network {
 
@@ -34,5 +38,55 @@ ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&) {
   return *min_connection_handler;
 }
 
+LoadAwareConnectionBalancerImpl::LoadAwareConnectionBalancerImpl(
+    const envoy::config::listener::v3::Listener::ConnectionBalanceConfig::LoadAwareBalance& config)
+    : connection_weight_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, connection_weight, 1)),
+      active_stream_weight_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, active_stream_weight, 1)),
+      event_loop_lag_weight_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, event_loop_lag_weight, 10)),
+      cpu_utilization_weight_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, cpu_utilization_weight, 1)),
+      handoff_threshold_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, handoff_threshold, 0)) {}
+
+void LoadAwareConnectionBalancerImpl::registerHandler(BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(&lock_);
+  handlers_.push_back(&handler);
+}
+
+void LoadAwareConnectionBalancerImpl::unregisterHandler(BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(&lock_);
+  handlers_.erase(std::find(handlers_.begin(), handlers_.end(), &handler));
+}
+
+uint64_t
+LoadAwareConnectionBalancerImpl::handlerLoad(const BalancedConnectionHandler& handler) const {
+  const Event::DispatcherLoad& load = handler.load();
+  return connection_weight_ * handler.numConnections() +
+         active_stream_weight_ * load.active_streams_.load(std::memory_order_relaxed) +
+         event_loop_lag_weight_ * (load.event_loop_lag_us_.load(std::memory_order_relaxed) / 1000) +
+         cpu_utilization_weight_ *
+             (load.cpu_utilization_permille_.load(std::memory_order_relaxed) / 10);
+}
+
+BalancedConnectionHandler&
+LoadAwareConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler& current_handler) {
+  // The handlers are only read here, and unregisterHandler() waits for the picks in progress, so
+  // that the picked handler can't be gone before its connection count is incremented.
+  absl::ReaderMutexLock lock(&lock_);
+  BalancedConnectionHandler* target = &current_handler;
+  const uint64_t current_load = handlerLoad(current_handler);
+  uint64_t min_load = current_load;
+  for (BalancedConnectionHandler* handler : handlers_) {
+    const uint64_t load = handlerLoad(*handler);
+    if (load < min_load) {
+      min_load = load;
+      target = handler;
+    }
+  }
+  if (current_load <= min_load + handoff_threshold_) {
+    target = &current_handler;
+  }
+  target->incNumConnections();
+  return *target;
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -44,6 +44,40 @@ private:
   std::vector<BalancedConnectionHandler*> handlers_ ABSL_GUARDED_BY(lock_);
 };
 
+/**
+ * Implementation of connection balancer that hands each connection off to the handler with the
+ * least load, where the load of a handler is a weighted sum of its connections and of the active
+ * streams, event loop lag and CPU utilization of its worker. The handlers' loads are read from
+ * atomic counters; the lock on the list of handlers is only taken exclusively when a handler is
+ * registered or unregistered. The accepting handler keeps the connection unless another one is
+ * less loaded by more than the handoff threshold.
+ */
+class LoadAwareConnectionBalancerImpl : public ConnectionBalancer {
+public:
+  explicit LoadAwareConnectionBalancerImpl(
+      const envoy::config::listener::v3::Listener::ConnectionBalanceConfig::LoadAwareBalance&
+          config);
+
+  // ConnectionBalancer
+  void registerHandler(BalancedConnectionHandler& handler) override;
+  void unregisterHandler(BalancedConnectionHandler& handler) override;
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler) override;
+
+  /**
+   * @return the load of a handler as used for balancing.
+   */
+  uint64_t handlerLoad(const BalancedConnectionHandler& handler) const;
+
+private:
+  const uint64_t connection_weight_;
+  const uint64_t active_stream_weight_;
+  const uint64_t event_loop_lag_weight_;
+  const uint64_t cpu_utilization_weight_;
+  const uint64_t handoff_threshold_;
+  absl::Mutex lock_;
+  std::vector<BalancedConnectionHandler*> handlers_ ABSL_GUARDED_BY(lock_);
+};
+
 /**
  * A NOP connection balancer implementation that always continues execution after incrementing
  * the handler's connection count.
@@ -19,6 +19,7 @@
 #include "source/common/common/scope_tracker.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/connection_socket_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/raw_buffer_socket.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/socket_option_impl.h"
@@ -113,6 +114,13 @@ ConnectionImpl::ConnectionImpl(Event::Dispatcher& dispatcher, ConnectionSocketPt
 
   transport_socket_->setTransportSocketCallbacks(*this);
 
+  // The owner of the socket may have enabled MSG_ZEROCOPY sends, whose completions are tracked in
+  // the connection stats.
+  if (auto* io_handle = dynamic_cast<IoSocketHandleImpl*>(&socket_->ioHandle());
+      io_handle != nullptr && io_handle->zeroCopySendEnabled()) {
+    zero_copy_io_handle_ = io_handle;
+  }
+
   // TODO(soulxu): generate the connection id inside the addressProvider directly,
   // then we don't need a setter or any of the optional stuff.
   socket_->connectionInfoProvider().setConnectionID(id());
@@ -178,7 +186,7 @@ void ConnectionImpl::closeInternal(ConnectionCloseType type) {
     return;
   }
 
-  uint64_t data_to_write = write_buffer_->length();
+  uint64_t data_to_write = pendingWriteBytes();
   ENVOY_CONN_LOG_EVENT(debug, "connection_closing", "closing data_to_write={} type={}", *this,
                        data_to_write, enumToInt(type));
 
@@ -324,6 +332,7 @@ void ConnectionImpl::closeSocket(ConnectionEvent close_type) {
   // connection outlasting the subscriber.
   write_buffer_->drain(write_buffer_->length());
 
+  updateZeroCopySendStats();
   connection_stats_.reset();
 
   if (detected_close_type_ == DetectedCloseType::RemoteReset ||
@@ -828,6 +837,7 @@ void ConnectionImpl::onWriteReady() {
   ASSERT(!result.end_stream_read_); // The interface guarantees that only read operations set this.
   uint64_t new_buffer_size = write_buffer_->length();
   updateWriteBufferStats(result.bytes_processed_, new_buffer_size);
+  updateZeroCopySendStats();
 
   // The socket is closed immediately when receiving RST.
   if (result.err_code_.has_value() &&
@@ -848,7 +858,7 @@ void ConnectionImpl::onWriteReady() {
     // write callback. This can happen if we manage to complete the SSL handshake in the write
     // callback, raise a connected event, and close the connection.
     closeSocket(ConnectionEvent::RemoteClose);
-  } else if ((inDelayedClose() && new_buffer_size == 0) || bothSidesHalfClosed()) {
+  } else if ((inDelayedClose() && pendingWriteBytes() == 0) || bothSidesHalfClosed()) {
     ENVOY_CONN_LOG(debug, "write flush complete", *this);
     if (delayed_close_state_ == DelayedCloseState::CloseAfterFlushAndWait) {
       ASSERT(delayed_close_timer_ != nullptr && delayed_close_timer_->enabled());
@@ -915,10 +925,28 @@ void ConnectionImpl::updateWriteBufferStats(uint64_t num_written, uint64_t new_s
                                            connection_stats_->write_current_);
 }
 
+void ConnectionImpl::updateZeroCopySendStats() {
+  if (zero_copy_io_handle_ == nullptr) {
+    return;
+  }
+
+  // Completions must be processed even without stats, to release the memory of the sent slices.
+  const IoSocketHandleImpl::ZeroCopySendStats stats =
+      zero_copy_io_handle_->processZeroCopySendCompletions();
+  if (!connection_stats_) {
+    return;
+  }
+  if (connection_stats_->zero_copy_send_completions_ != nullptr) {
+    connection_stats_->zero_copy_send_completions_->add(stats.completed_);
+  }
+  if (connection_stats_->zero_copy_send_fallbacks_ != nullptr) {
+    connection_stats_->zero_copy_send_fallbacks_->add(stats.fallbacks_);
+  }
+}
+
 bool ConnectionImpl::bothSidesHalfClosed() {
-  // If the write_buffer_ is not empty, then the end_stream has not been sent to the transport
-  // yet.
-  return read_end_stream_ && write_end_stream_ && write_buffer_->length() == 0;
+  // If there are bytes left to write, then the end_stream has not been sent to the transport yet.
+  return read_end_stream_ && write_end_stream_ && pendingWriteBytes() == 0;
 }
 
 bool ConnectionImpl::setSocketOption(Network::SocketOptionName name, absl::Span<uint8_t> value) {
@@ -22,6 +22,7 @@ class TestPauseFilter;
 
 namespace Network {
 
+class IoSocketHandleImpl;
 class MultiConnectionBaseImpl;
 
 /**
@@ -155,6 +156,7 @@ public:
   void setTransportSocketIsReadable() override;
   void flushWriteBuffer() override;
   TransportSocketPtr& transportSocket() { return transport_socket_; }
+  bool hasSingleDataFilter() const { return filter_manager_.hasSingleDataFilter(); }
 
   // Obtain global next connection ID. This should only be used in tests.
   static uint64_t nextGlobalIdForTest() { return next_global_id_; }
@@ -222,6 +224,7 @@ private:
   void onWriteReady();
   void updateReadBufferStats(uint64_t num_read, uint64_t new_size);
   void updateWriteBufferStats(uint64_t num_written, uint64_t new_size);
+  void updateZeroCopySendStats();
 
   // Write data to the connection bypassing filter chain (optionally).
   void write(Buffer::Instance& data, bool end_stream, bool through_filter_chain);
@@ -229,6 +232,12 @@ private:
   // Returns true iff end of stream has been both written and read.
   bool bothSidesHalfClosed();
 
+  // Returns the number of bytes left to write, including those the transport socket writes from
+  // outside the write buffer.
+  uint64_t pendingWriteBytes() const {
+    return write_buffer_->length() + transport_socket_->pendingWriteBytes();
+  }
+
   // Set the detected close type for this connection.
   void setDetectedCloseType(DetectedCloseType close_type);
 
@@ -245,6 +254,8 @@ private:
   uint64_t last_read_buffer_size_{};
   uint64_t last_write_buffer_size_{};
   Buffer::Instance* current_write_buffer_{};
+  // Only set if MSG_ZEROCOPY sends are enabled on the socket.
+  IoSocketHandleImpl* zero_copy_io_handle_{};
   uint32_t read_disable_count_{0};
   DetectedCloseType detected_close_type_{DetectedCloseType::Normal};
   bool write_buffer_above_high_watermark_ : 1;
@@ -38,6 +38,19 @@ void FilterManagerImpl::removeReadFilter(ReadFilterSharedPtr filter_to_remove) {
   }
 }
 
+bool FilterManagerImpl::hasSingleDataFilter() const {
+  if (!downstream_filters_.empty()) {
+    return false;
+  }
+  uint32_t read_filters = 0;
+  for (const auto& filter : upstream_filters_) {
+    if (filter->filter_ != nullptr) {
+      ++read_filters;
+    }
+  }
+  return read_filters == 1;
+}
+
 bool FilterManagerImpl::initializeReadFilters() {
   if (upstream_filters_.empty()) {
     return false;
@@ -121,6 +121,9 @@ public:
   void maybeClose();
   void onConnectionClose(ConnectionCloseAction close_action);
   bool pendingClose() { return state_.local_close_pending_ || state_.remote_close_pending_; }
+  // Returns true if there is a single read filter that has not been removed and no write filter,
+  // i.e. no other filter sees the data read from or written to the connection.
+  bool hasSingleDataFilter() const;
 
 protected:
   struct State {
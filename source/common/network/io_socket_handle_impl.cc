@@ -1,6 +1,12 @@
 #include "source/common/network/io_socket_handle_impl.h"
 
+#include <algorithm>
 #include <memory>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#endif
 
 #include "envoy/buffer/buffer.h"
 
@@ -15,6 +21,10 @@
 #include "absl/container/fixed_array.h"
 #include "absl/types/optional.h"
 
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#define ENVOY_ZERO_COPY_SEND 1
+#endif
+
 using Envoy::Api::SysCallIntResult;
 using Envoy::Api::SysCallSizeResult;
 
@@ -59,12 +69,64 @@ IoSocketHandleImpl::~IoSocketHandleImpl() {
   }
 }
 
+thread_local std::vector<IoSocketHandleImpl::ClosedZeroCopySocket>
+    IoSocketHandleImpl::closed_zero_copy_sockets_;
+
+IoSocketHandleImpl::ClosedZeroCopySocket&
+IoSocketHandleImpl::ClosedZeroCopySocket::operator=(ClosedZeroCopySocket&& other) noexcept {
+  if (this != &other) {
+    // The event must be unregistered before its socket is closed.
+    file_event_ = std::move(other.file_event_);
+    if (SOCKET_VALID(fd_)) {
+      Api::OsSysCallsSingleton::get().close(fd_);
+    }
+    fd_ = std::exchange(other.fd_, INVALID_SOCKET);
+    state_ = std::move(other.state_);
+  }
+  return *this;
+}
+
+IoSocketHandleImpl::ClosedZeroCopySocket::~ClosedZeroCopySocket() {
+  file_event_.reset();
+  if (SOCKET_VALID(fd_)) {
+    Api::OsSysCallsSingleton::get().close(fd_);
+  }
+}
+
 Api::IoCallUint64Result IoSocketHandleImpl::close() {
   if (file_event_) {
     file_event_.reset();
   }
-
   ASSERT(SOCKET_VALID(fd_));
+  if (zero_copy_send_ != nullptr) {
+    readZeroCopySendCompletions(fd_, *zero_copy_send_);
+    reapClosedZeroCopySockets();
+    if (!zero_copy_send_->pending_.empty()) {
+      // The kernel may still be transmitting from the pending slices, and it only reports their
+      // completions on the error queue of the open socket. Shut the connection down now, and
+      // close the socket once all the completions have been read.
+      Api::OsSysCallsSingleton::get().shutdown(fd_, ENVOY_SHUT_RDWR);
+      Event::Dispatcher* dispatcher = zero_copy_send_->dispatcher_;
+      ClosedZeroCopySocket& closed =
+          closed_zero_copy_sockets_.emplace_back(fd_, std::move(zero_copy_send_));
+      if (dispatcher != nullptr) {
+        // Completions are reported as errors on the socket, which wake up its readers, so they
+        // are read as they arrive even if no other handle of the thread is used anymore.
+        closed.file_event_ = dispatcher->createFileEvent(
+            fd_,
+            [](uint32_t) {
+              // This may destroy the event whose callback is running, which must not be used
+              // afterwards.
+              reapClosedZeroCopySockets();
+              return absl::OkStatus();
+            },
+            Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+      }
+      SET_SOCKET_INVALID(fd_);
+      return Api::ioCallUint64ResultNoError();
+    }
+  }
+
   const int rc = Api::OsSysCallsSingleton::get().close(fd_).return_value_;
   SET_SOCKET_INVALID(fd_);
   return {static_cast<unsigned long>(rc), Api::IoError::none()};
@@ -139,6 +201,29 @@ Api::IoCallUint64Result IoSocketHandleImpl::writev(const Buffer::RawSlice* slice
 Api::IoCallUint64Result IoSocketHandleImpl::write(Buffer::Instance& buffer) {
   constexpr uint64_t MaxSlices = 16;
   Buffer::RawSliceVector slices = buffer.getRawSlices(MaxSlices);
+  if (zero_copy_send_ != nullptr) {
+    readZeroCopySendCompletions(fd_, *zero_copy_send_);
+    reapClosedZeroCopySockets();
+    // Zero copy sends keep the written slices, which requires the buffer implementation.
+    auto* owned_buffer = dynamic_cast<Buffer::OwnedImpl*>(&buffer);
+    if (zero_copy_send_->enabled_ && owned_buffer != nullptr &&
+        buffer.length() >= zero_copy_send_->min_bytes_) {
+      const SysCallSizeResult result = writeZeroCopy(*owned_buffer, slices);
+      if (result.return_value_ >= 0 ||
+          (result.errno_ != ENOBUFS && result.errno_ != EOPNOTSUPP && result.errno_ != EINVAL)) {
+        return sysCallResultToIoCallResult(result);
+      }
+      if (result.errno_ != ENOBUFS) {
+        // The socket does not support MSG_ZEROCOPY (anymore), e.g. once a kernel TLS ULP is
+        // installed. Copy this and all further writes.
+        ENVOY_LOG(debug, "disabling zero copy sends: {}", errorDetails(result.errno_));
+        zero_copy_send_->enabled_ = false;
+      }
+      // Otherwise the socket is out of option memory to track another zero copy send, copy this
+      // write.
+      zero_copy_send_->stats_.fallbacks_++;
+    }
+  }
   Api::IoCallUint64Result result = writev(slices.begin(), slices.size());
   if (result.ok() && result.return_value_ > 0) {
     buffer.drain(static_cast<uint64_t>(result.return_value_));
@@ -146,6 +231,131 @@ Api::IoCallUint64Result IoSocketHandleImpl::write(Buffer::Instance& buffer) {
   return result;
 }
 
+bool IoSocketHandleImpl::enableZeroCopySend(uint64_t min_bytes) {
+#ifdef ENVOY_ZERO_COPY_SEND
+  if (zero_copy_send_ == nullptr) {
+    const int enable = 1;
+    const SysCallIntResult result = Api::OsSysCallsSingleton::get().setsockopt(
+        fd_, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable));
+    if (result.return_value_ != 0) {
+      ENVOY_LOG(debug, "failed to enable SO_ZEROCOPY: {}", errorDetails(result.errno_));
+      return false;
+    }
+  }
+  zero_copy_send_ = std::make_unique<ZeroCopySendState>(min_bytes);
+  return true;
+#else
+  UNREFERENCED_PARAMETER(min_bytes);
+  return false;
+#endif
+}
+
+void IoSocketHandleImpl::disableZeroCopySend() {
+  if (zero_copy_send_ != nullptr) {
+    zero_copy_send_->enabled_ = false;
+  }
+}
+
+IoSocketHandleImpl::ZeroCopySendStats IoSocketHandleImpl::processZeroCopySendCompletions() {
+  if (zero_copy_send_ == nullptr) {
+    return {};
+  }
+  if (SOCKET_VALID(fd_)) {
+    readZeroCopySendCompletions(fd_, *zero_copy_send_);
+  }
+  return std::exchange(zero_copy_send_->stats_, ZeroCopySendStats{});
+}
+
+SysCallSizeResult IoSocketHandleImpl::writeZeroCopy(Buffer::OwnedImpl& buffer,
+                                                    const Buffer::RawSliceVector& slices) {
+#ifdef ENVOY_ZERO_COPY_SEND
+  absl::FixedArray<iovec> iov(slices.size());
+  uint64_t num_slices_to_write = 0;
+  for (const Buffer::RawSlice& slice : slices) {
+    if (slice.mem_ != nullptr && slice.len_ != 0) {
+      iov[num_slices_to_write].iov_base = slice.mem_;
+      iov[num_slices_to_write].iov_len = slice.len_;
+      num_slices_to_write++;
+    }
+  }
+  msghdr message{};
+  message.msg_iov = iov.begin();
+  message.msg_iovlen = num_slices_to_write;
+  const SysCallSizeResult result =
+      Api::OsSysCallsSingleton::get().sendmsg(fd_, &message, MSG_ZEROCOPY);
+  if (result.return_value_ > 0) {
+    // The kernel numbers every zero copy send that transmitted data, starting from 0.
+    ZeroCopySend& send = zero_copy_send_->pending_.emplace_back();
+    send.sequence_ = zero_copy_send_->next_sequence_++;
+    buffer.drainToSlices(result.return_value_, send.slices_);
+  }
+  return result;
+#else
+  UNREFERENCED_PARAMETER(buffer);
+  UNREFERENCED_PARAMETER(slices);
+  PANIC("not implemented");
+#endif
+}
+
+void IoSocketHandleImpl::readZeroCopySendCompletions(os_fd_t fd, ZeroCopySendState& state) {
+#ifdef ENVOY_ZERO_COPY_SEND
+  auto& pending = state.pending_;
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  while (!pending.empty()) {
+    // Large enough for a sock_extended_err followed by an IPv6 offender address.
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    msghdr message{};
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    if (os_sys_calls.recvmsg(fd, &message, MSG_ERRQUEUE).return_value_ < 0) {
+      // Usually EAGAIN, there are no more notifications to read.
+      return;
+    }
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&message, cmsg)) {
+      if (!(cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) &&
+          !(cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+      sock_extended_err err;
+      safeMemcpyUnsafeSrc(&err, CMSG_DATA(cmsg));
+      if (err.ee_errno != 0 || err.ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      // The notification covers the sends numbered from ee_info to ee_data, inclusive.
+      const uint32_t first = err.ee_info;
+      const uint32_t count = err.ee_data - err.ee_info + 1;
+      if (err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+        state.stats_.fallbacks_ += count;
+      } else {
+        state.stats_.completed_ += count;
+      }
+      pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                   [first, count](const ZeroCopySend& send) {
+                                     return send.sequence_ - first < count;
+                                   }),
+                    pending.end());
+    }
+  }
+#else
+  UNREFERENCED_PARAMETER(fd);
+  UNREFERENCED_PARAMETER(state);
+#endif
+}
+
+void IoSocketHandleImpl::reapClosedZeroCopySockets() {
+  auto& sockets = closed_zero_copy_sockets_;
+  for (ClosedZeroCopySocket& socket : sockets) {
+    readZeroCopySendCompletions(socket.fd_, *socket.state_);
+  }
+  // Destroying a socket closes it.
+  sockets.erase(std::remove_if(sockets.begin(), sockets.end(),
+                               [](const ClosedZeroCopySocket& socket) {
+                                 return socket.state_->pending_.empty();
+                               }),
+                sockets.end());
+}
+
 Api::IoCallUint64Result IoSocketHandleImpl::sendmsg(const Buffer::RawSlice* slices,
                                                     uint64_t num_slice, int flags,
                                                     const Address::Ip* self_ip,
@@ -601,6 +811,9 @@ void IoSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher, Even
   ASSERT(file_event_ == nullptr, "Attempting to initialize two `file_event_` for the same "
                                  "file descriptor. This is not allowed.");
   file_event_ = dispatcher.createFileEvent(fd_, cb, trigger, events);
+  if (zero_copy_send_ != nullptr) {
+    zero_copy_send_->dispatcher_ = &dispatcher;
+  }
 }
 
 void IoSocketHandleImpl::activateFileEvents(uint32_t events) {
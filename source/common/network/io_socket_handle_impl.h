@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -9,6 +10,7 @@
 #include "envoy/event/dispatcher.h"
 #include "envoy/network/io_handle.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
 #include "source/common/network/io_socket_error_impl.h"
 #include "source/common/network/io_socket_handle_base_impl.h"
@@ -79,6 +81,46 @@ public:
 
   Api::SysCallIntResult shutdown(int how) override;
 
+  /**
+   * Counters of the writes made eligible for MSG_ZEROCOPY by enableZeroCopySend().
+   */
+  struct ZeroCopySendStats {
+    // Zero copy sends that the kernel completed without copying the data.
+    uint64_t completed_{};
+    // Eligible writes whose data was copied after all, either by the kernel or because the socket
+    // could not track more zero copy sends.
+    uint64_t fallbacks_{};
+  };
+
+  /**
+   * Send writes of at least min_bytes with MSG_ZEROCOPY. The written buffer slices are kept alive
+   * until the kernel reports on the socket error queue that it no longer references them. If sends
+   * are still pending when the handle is closed, the socket is shut down but only closed once the
+   * kernel has completed them. The completions are then read when the socket's error queue becomes
+   * readable, on the dispatcher of the file event, so zero copy sends must be enabled before
+   * initializeFileEvent() is called.
+   * @param min_bytes the minimum size of a write to be sent without copying.
+   * @return whether zero copy sends are supported and were enabled on the socket.
+   */
+  bool enableZeroCopySend(uint64_t min_bytes);
+
+  /**
+   * Copy all further writes, e.g. because the socket no longer supports MSG_ZEROCOPY. The sends
+   * already made are still tracked until the kernel completes them.
+   */
+  void disableZeroCopySend();
+
+  /**
+   * @return whether enableZeroCopySend() was successfully called on this socket.
+   */
+  bool zeroCopySendEnabled() const { return zero_copy_send_ != nullptr; }
+
+  /**
+   * Release the slices of the zero copy sends that the kernel has completed.
+   * @return the counters accumulated since the previous call.
+   */
+  ZeroCopySendStats processZeroCopySendCompletions();
+
 protected:
   // Converts a SysCallSizeResult to IoCallUint64Result.
   template <typename T>
@@ -116,6 +158,59 @@ private:
   Address::InstanceConstSharedPtr getOrCreateEnvoyAddressInstance(sockaddr_storage ss,
                                                                   socklen_t ss_len);
 
+  Api::SysCallSizeResult writeZeroCopy(Buffer::OwnedImpl& buffer,
+                                       const Buffer::RawSliceVector& slices);
+
+  struct ZeroCopySend {
+    // The sequence number the kernel assigned to the send.
+    uint32_t sequence_;
+    // The slices the kernel may still reference.
+    std::vector<Buffer::Slice> slices_;
+  };
+
+  struct ZeroCopySendState {
+    explicit ZeroCopySendState(uint64_t min_bytes) : min_bytes_(min_bytes) {}
+
+    const uint64_t min_bytes_;
+    uint32_t next_sequence_{};
+    // Cleared by disableZeroCopySend() or when the socket rejects MSG_ZEROCOPY.
+    bool enabled_{true};
+    // Sends not completed yet, in sequence order.
+    std::deque<ZeroCopySend> pending_;
+    ZeroCopySendStats stats_;
+    // The dispatcher of the handle's file event, which watches the socket once it is closed.
+    Event::Dispatcher* dispatcher_{};
+  };
+
+  // A socket closed while some of its zero copy sends were pending. It is kept open, shut down,
+  // until the kernel reports their completions on its error queue.
+  struct ClosedZeroCopySocket {
+    ClosedZeroCopySocket(os_fd_t fd, std::unique_ptr<ZeroCopySendState> state)
+        : fd_(fd), state_(std::move(state)) {}
+    ClosedZeroCopySocket(ClosedZeroCopySocket&& other) noexcept
+        : fd_(std::exchange(other.fd_, INVALID_SOCKET)), state_(std::move(other.state_)),
+          file_event_(std::move(other.file_event_)) {}
+    ClosedZeroCopySocket& operator=(ClosedZeroCopySocket&& other) noexcept;
+    ~ClosedZeroCopySocket();
+
+    os_fd_t fd_;
+    std::unique_ptr<ZeroCopySendState> state_;
+    // Reaps the closed sockets when the error queue of this one becomes readable. Null if the
+    // handle had no file event.
+    Event::FileEventPtr file_event_;
+  };
+
+  // Reads the available completions of the socket's zero copy sends and releases their slices.
+  static void readZeroCopySendCompletions(os_fd_t fd, ZeroCopySendState& state);
+  // Closes the sockets of closed_zero_copy_sockets_ whose sends have all completed.
+  static void reapClosedZeroCopySockets();
+
+  // The closed sockets of this thread that still have pending zero copy sends. They are polled
+  // when the error queue of one of them becomes readable, and whenever a handle of the thread
+  // writes with zero copy sends enabled or is closed. Worker threads destroy them on exit, before
+  // their dispatcher.
+  static thread_local std::vector<ClosedZeroCopySocket> closed_zero_copy_sockets_;
+
   // Caches the address instances of the most recently received packets on this socket.
   // Should only be used by QUIC client sockets to avoid creating multiple address instances for
   // the same address in each read operation. Since the QUIC client sockets are connected via a
@@ -124,6 +219,8 @@ private:
   size_t address_cache_max_capacity_;
   // Only non-null if address_cache_max_capacity_ is greater than 0.
   absl::optional<std::vector<QuicEnvoyAddressPair>> recent_received_addresses_ = absl::nullopt;
+  // Only non-null once enableZeroCopySend() succeeded.
+  std::unique_ptr<ZeroCopySendState> zero_copy_send_;
 
   // For testing and benchmarking non-public methods.
   friend class IoSocketHandleImplTestWrapper;
@@ -8,12 +8,76 @@
 namespace Envoy {
 namespace Network {
 
+RawBufferSocket::~RawBufferSocket() { resetSplicePipes(); }
+
 void RawBufferSocket::setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) {
   ASSERT(!callbacks_);
   callbacks_ = &callbacks;
 }
 
+void RawBufferSocket::setSplicePipes(SplicePipeSharedPtr read_pipe,
+                                     SplicePipeSharedPtr write_pipe) {
+  ASSERT(callbacks_ != nullptr);
+  resetSplicePipes();
+  read_pipe_ = std::move(read_pipe);
+  write_pipe_ = std::move(write_pipe);
+  if (read_pipe_ != nullptr) {
+    read_pipe_->setSource(callbacks_);
+  }
+  if (write_pipe_ != nullptr) {
+    write_pipe_->setSink(callbacks_);
+  }
+}
+
+void RawBufferSocket::resetSplicePipes() {
+  if (read_pipe_ != nullptr) {
+    read_pipe_->setSource(nullptr);
+    read_pipe_.reset();
+  }
+  if (write_pipe_ != nullptr) {
+    write_pipe_->setSink(nullptr);
+    write_pipe_.reset();
+  }
+}
+
+void RawBufferSocket::closeSocket(Network::ConnectionEvent) {
+  // The peer must not wake this connection up once its socket is closed.
+  resetSplicePipes();
+}
+
+IoResult RawBufferSocket::doSpliceRead() {
+  if (read_pipe_->pendingBytes() > 0) {
+    // The sink has not written out the previous read yet. It resumes reading once it drained the
+    // pipe, which bounds the bytes in flight to the pipe capacity.
+    read_pipe_->onSourceFilled();
+    return {PostIoAction::KeepOpen, 0, false, absl::nullopt};
+  }
+
+  Api::IoCallUint64Result result = read_pipe_->fillFrom(callbacks_->ioHandle());
+  if (result.ok()) {
+    ENVOY_CONN_LOG(trace, "splice read returns: {}", callbacks_->connection(),
+                   result.return_value_);
+    if (result.return_value_ == 0) {
+      // Remote close. The pipe is empty so the sink has written out everything read before.
+      return {PostIoAction::KeepOpen, 0, true, absl::nullopt};
+    }
+    read_pipe_->onSourceFilled();
+    return {PostIoAction::KeepOpen, result.return_value_, false, absl::nullopt};
+  }
+
+  ENVOY_CONN_LOG(trace, "splice read error: {}, code: {}", callbacks_->connection(),
+                 result.err_->getErrorDetails(), static_cast<int>(result.err_->getErrorCode()));
+  if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+    return {PostIoAction::KeepOpen, 0, false, absl::nullopt};
+  }
+  return {PostIoAction::Close, 0, false, result.err_->getErrorCode()};
+}
+
 IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
+  if (read_pipe_ != nullptr) {
+    return doSpliceRead();
+  }
+
   PostIoAction action = PostIoAction::KeepOpen;
   uint64_t bytes_read = 0;
   bool end_stream = false;
@@ -53,6 +117,27 @@ IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
   uint64_t bytes_written = 0;
   absl::optional<Api::IoError::IoErrorCode> err = absl::nullopt;
   ASSERT(!shutdown_ || buffer.length() == 0);
+
+  // Bytes spliced from the peer were read before anything in the write buffer, so they go first.
+  while (write_pipe_ != nullptr && write_pipe_->pendingBytes() > 0) {
+    Api::IoCallUint64Result result = write_pipe_->drainTo(callbacks_->ioHandle());
+    if (result.ok()) {
+      ENVOY_CONN_LOG(trace, "splice write returns: {}", callbacks_->connection(),
+                     result.return_value_);
+      bytes_written += result.return_value_;
+      if (write_pipe_->pendingBytes() == 0) {
+        write_pipe_->onSinkDrained();
+      }
+      continue;
+    }
+    ENVOY_CONN_LOG(trace, "splice write error: {}, code: {}", callbacks_->connection(),
+                   result.err_->getErrorDetails(), static_cast<int>(result.err_->getErrorCode()));
+    if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+      return {PostIoAction::KeepOpen, bytes_written, false, absl::nullopt};
+    }
+    return {PostIoAction::Close, bytes_written, false, result.err_->getErrorCode()};
+  }
+
   do {
     if (buffer.length() == 0) {
       if (end_stream && !shutdown_) {
@@ -5,6 +5,7 @@
 #include "envoy/network/transport_socket.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/network/splice_pipe.h"
 #include "source/common/network/transport_socket_options_impl.h"
 
 namespace Envoy {
@@ -12,15 +13,30 @@ namespace Network {
 
 class RawBufferSocket : public TransportSocket, protected Logger::Loggable<Logger::Id::connection> {
 public:
+  ~RawBufferSocket() override;
+
+  /**
+   * Move bytes between this socket and other connections through kernel pipes, bypassing the
+   * connection buffers. Must be called before any data has been read from or written to the socket.
+   * @param read_pipe if not nullptr, bytes read from the socket are moved into this pipe instead of
+   *        the read buffer. The connection still sees the end of stream and the byte counts.
+   * @param write_pipe if not nullptr, bytes in this pipe are written to the socket ahead of the
+   *        contents of the write buffer.
+   */
+  void setSplicePipes(SplicePipeSharedPtr read_pipe, SplicePipeSharedPtr write_pipe);
+
   // Network::TransportSocket
   void setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) override;
   std::string protocol() const override;
   absl::string_view failureReason() const override;
   bool canFlushClose() override { return true; }
-  void closeSocket(Network::ConnectionEvent) override {}
+  void closeSocket(Network::ConnectionEvent) override;
   void onConnected() override;
   IoResult doRead(Buffer::Instance& buffer) override;
   IoResult doWrite(Buffer::Instance& buffer, bool end_stream) override;
+  uint64_t pendingWriteBytes() const override {
+    return write_pipe_ != nullptr ? write_pipe_->pendingBytes() : 0;
+  }
   Ssl::ConnectionInfoConstSharedPtr ssl() const override { return nullptr; }
   bool startSecureTransport() override { return false; }
   void configureInitialCongestionWindow(uint64_t, std::chrono::microseconds) override {}
@@ -29,8 +45,13 @@ protected:
   TransportSocketCallbacks* transportSocketCallbacks() const { return callbacks_; };
 
 private:
+  IoResult doSpliceRead();
+  void resetSplicePipes();
+
   bool shutdown_{};
   TransportSocketCallbacks* callbacks_{};
+  SplicePipeSharedPtr read_pipe_;
+  SplicePipeSharedPtr write_pipe_;
 };
 
 class RawBufferSocketFactory : public DownstreamTransportSocketFactory,
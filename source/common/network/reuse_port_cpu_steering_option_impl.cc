@@ -0,0 +1,82 @@
+#include "source/common/network/reuse_port_cpu_steering_option_impl.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/scalar_to_byte_vector.h"
+#include "source/common/common/utility.h"
+#include "source/common/network/socket_option_impl.h"
+
+#include "absl/strings/str_cat.h"
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+namespace Envoy {
+namespace Network {
+
+ReusePortCpuSteeringOptionImpl::ReusePortCpuSteeringOptionImpl(uint32_t num_workers)
+    : num_workers_(num_workers) {
+  ASSERT(num_workers_ > 0);
+}
+
+bool ReusePortCpuSteeringOptionImpl::setOption(
+    Socket& socket, envoy::config::core::v3::SocketOption::SocketState state) const {
+  if (state != in_state_) {
+    return true;
+  }
+  if (!isSupported()) {
+    ENVOY_LOG(warn, "Failed to set unsupported option on socket");
+    return false;
+  }
+#if defined(__linux__)
+  // A = the CPU handling the packet; A %= num_workers; return A.
+  sock_filter code[] = {
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, num_workers_},
+      {BPF_RET | BPF_A, 0, 0, 0},
+  };
+  sock_fprog program{static_cast<unsigned short>(sizeof(code) / sizeof(code[0])), code};
+  const Api::SysCallIntResult result = SocketOptionImpl::setSocketOption(
+      socket, ENVOY_SOCKET_SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program));
+  if (result.return_value_ != 0) {
+    ENVOY_LOG(warn, "Attaching the reuse port CPU steering program to socket failed: {}",
+              errorDetails(result.errno_));
+    return false;
+  }
+  return true;
+#else
+  UNREFERENCED_PARAMETER(socket);
+  return false;
+#endif
+}
+
+void ReusePortCpuSteeringOptionImpl::hashKey(std::vector<uint8_t>& hash) const {
+  const Network::SocketOptionName& optname = ENVOY_SOCKET_SO_ATTACH_REUSEPORT_CBPF;
+  if (optname.hasValue()) {
+    pushScalarToByteVector(optname.level(), hash);
+    pushScalarToByteVector(optname.option(), hash);
+    pushScalarToByteVector(num_workers_, hash);
+  }
+}
+
+absl::optional<Socket::Option::Details> ReusePortCpuSteeringOptionImpl::getOptionDetails(
+    const Socket&, envoy::config::core::v3::SocketOption::SocketState state) const {
+  if (state != in_state_ || !isSupported()) {
+    return absl::nullopt;
+  }
+  Socket::Option::Details info;
+  info.name_ = ENVOY_SOCKET_SO_ATTACH_REUSEPORT_CBPF;
+  info.value_ = absl::StrCat(num_workers_);
+  return absl::make_optional(std::move(info));
+}
+
+bool ReusePortCpuSteeringOptionImpl::isSupported() const {
+#if defined(__linux__)
+  return ENVOY_SOCKET_SO_ATTACH_REUSEPORT_CBPF.hasValue();
+#else
+  return false;
+#endif
+}
+
+} // namespace Network
+} // namespace Envoy
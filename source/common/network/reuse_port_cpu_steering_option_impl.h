@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/network/listen_socket.h"
+
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * Socket option that attaches a classic BPF program to the SO_REUSEPORT group of a listen socket.
+ * The program makes the kernel pick the socket of the group whose index is the number of the CPU
+ * handling the incoming connection modulo the number of sockets in the group. Listen sockets
+ * join the group in worker order, so that a connection is accepted by worker
+ * `cpu % num_workers`.
+ *
+ * The program is attached to the whole group, so it only needs to be set on one of its sockets;
+ * setting it on every socket is harmless. It is attached once the socket is listening, which is
+ * when a TCP socket joins the group.
+ */
+class ReusePortCpuSteeringOptionImpl : public Socket::Option,
+                                       Logger::Loggable<Logger::Id::connection> {
+public:
+  explicit ReusePortCpuSteeringOptionImpl(uint32_t num_workers);
+
+  // Socket::Option
+  bool setOption(Socket& socket,
+                 envoy::config::core::v3::SocketOption::SocketState state) const override;
+  void hashKey(std::vector<uint8_t>& hash) const override;
+  absl::optional<Details>
+  getOptionDetails(const Socket& socket,
+                   envoy::config::core::v3::SocketOption::SocketState state) const override;
+  bool isSupported() const override;
+
+private:
+  static constexpr envoy::config::core::v3::SocketOption::SocketState in_state_ =
+      envoy::config::core::v3::SocketOption::STATE_LISTENING;
+  const uint32_t num_workers_;
+};
+
+} // namespace Network
+} // namespace Envoy
@@ -178,6 +178,7 @@ Server::BootstrapExtensionPtr SocketInterfaceImpl::createBootstrapExtension(
             PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, io_uring_size, 1000),
             options.enable_submission_queue_polling(),
             PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, read_buffer_size, 8192),
+            options.provided_buffer_count().value(),
             PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, write_timeout_ms, 1000),
             context.threadLocal());
     io_uring_worker_factory_ = io_uring_worker_factory;
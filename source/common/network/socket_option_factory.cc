@@ -4,6 +4,7 @@
 
 #include "source/common/common/fmt.h"
 #include "source/common/network/addr_family_aware_socket_option_impl.h"
+#include "source/common/network/reuse_port_cpu_steering_option_impl.h"
 #include "source/common/network/socket_option_impl.h"
 #include "source/common/network/win32_redirect_records_option_impl.h"
 
@@ -154,6 +155,13 @@ std::unique_ptr<Socket::Options> SocketOptionFactory::buildReusePortOptions() {
   return options;
 }
 
+std::unique_ptr<Socket::Options>
+SocketOptionFactory::buildReusePortCpuSteeringOptions(uint32_t num_workers) {
+  std::unique_ptr<Socket::Options> options = std::make_unique<Socket::Options>();
+  options->push_back(std::make_shared<ReusePortCpuSteeringOptionImpl>(num_workers));
+  return options;
+}
+
 std::unique_ptr<Socket::Options> SocketOptionFactory::buildUdpGroOptions() {
   std::unique_ptr<Socket::Options> options = std::make_unique<Socket::Options>();
   options->push_back(std::make_shared<SocketOptionImpl>(
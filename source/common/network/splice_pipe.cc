@@ -0,0 +1,105 @@
+#include "source/common/network/splice_pipe.h"
+
+#include "envoy/common/platform.h"
+#include "envoy/event/file_event.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+#include "source/common/network/io_socket_error_impl.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+// The default capacity of a Linux pipe. Asking splice(2) for more is harmless, it moves at most as
+// much as the pipe can hold.
+constexpr size_t MaxSpliceBytes = 64 * 1024;
+
+template <typename T>
+Api::IoCallUint64Result sysCallResultToIoCallResult(const Api::SysCallResult<T>& result) {
+  if (result.return_value_ >= 0) {
+    return {static_cast<uint64_t>(result.return_value_), Api::IoError::none()};
+  }
+  return {0, result.errno_ == SOCKET_ERROR_AGAIN ? IoSocketError::getIoSocketEagainError()
+                                                 : IoSocketError::create(result.errno_)};
+}
+
+} // namespace
+
+SplicePipeSharedPtr SplicePipe::create() {
+#if defined(__linux__)
+  int fds[2];
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().pipe2(fds, O_NONBLOCK | O_CLOEXEC);
+  if (result.return_value_ != 0) {
+    ENVOY_LOG(debug, "failed to create splice pipe: {}", errorDetails(result.errno_));
+    return nullptr;
+  }
+  return SplicePipeSharedPtr(new SplicePipe(fds[0], fds[1]));
+#else
+  return nullptr;
+#endif
+}
+
+SplicePipe::~SplicePipe() {
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  os_sys_calls.close(read_fd_);
+  os_sys_calls.close(write_fd_);
+}
+
+Api::IoCallUint64Result SplicePipe::fillFrom(IoHandle& io_handle) {
+#if defined(__linux__)
+  const Api::SysCallSizeResult result = Api::LinuxOsSysCallsSingleton::get().splice(
+      io_handle.fdDoNotUse(), nullptr, write_fd_, nullptr, MaxSpliceBytes,
+      SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+  if (result.return_value_ > 0) {
+    pending_bytes_ += result.return_value_;
+  }
+  return sysCallResultToIoCallResult(result);
+#else
+  UNREFERENCED_PARAMETER(io_handle);
+  PANIC("not implemented");
+#endif
+}
+
+Api::IoCallUint64Result SplicePipe::drainTo(IoHandle& io_handle) {
+#if defined(__linux__)
+  ASSERT(pending_bytes_ > 0);
+  const Api::SysCallSizeResult result = Api::LinuxOsSysCallsSingleton::get().splice(
+      read_fd_, nullptr, io_handle.fdDoNotUse(), nullptr, pending_bytes_,
+      SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+  if (result.return_value_ > 0) {
+    ASSERT(static_cast<uint64_t>(result.return_value_) <= pending_bytes_);
+    pending_bytes_ -= result.return_value_;
+  }
+  return sysCallResultToIoCallResult(result);
+#else
+  UNREFERENCED_PARAMETER(io_handle);
+  PANIC("not implemented");
+#endif
+}
+
+void SplicePipe::onSourceFilled() {
+  source_wants_read_ = true;
+  if (sink_ != nullptr) {
+    sink_->ioHandle().activateFileEvents(Event::FileReadyType::Write);
+  }
+}
+
+void SplicePipe::onSinkDrained() {
+  ASSERT(pending_bytes_ == 0);
+  if (source_wants_read_ && source_ != nullptr) {
+    source_wants_read_ = false;
+    source_->setTransportSocketIsReadable();
+  }
+}
+
+} // namespace Network
+} // namespace Envoy
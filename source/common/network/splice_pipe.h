@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/api/io_error.h"
+#include "envoy/network/io_handle.h"
+#include "envoy/network/transport_socket.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Network {
+
+class SplicePipe;
+using SplicePipeSharedPtr = std::shared_ptr<SplicePipe>;
+
+/**
+ * A kernel pipe used to move bytes from one socket to another with splice(2), without copying them
+ * through user space. The pipe is shared between the transport socket of the connection that reads
+ * the bytes (the source) and the transport socket of the connection that writes them (the sink).
+ * Each side only ever touches its own socket; the pipe wakes up the other side through its
+ * transport socket callbacks when it has data to write or room to read into.
+ *
+ * The pipe capacity bounds the number of bytes in flight between the two connections, the same way
+ * the connection buffer limits bound them on the buffered path: the source stops reading while the
+ * sink has not drained the pipe.
+ */
+class SplicePipe : NonCopyable, protected Logger::Loggable<Logger::Id::connection> {
+public:
+  ~SplicePipe();
+
+  /**
+   * @return a new pipe, or nullptr if splice(2) is not supported on this platform or the pipe
+   * could not be created.
+   */
+  static SplicePipeSharedPtr create();
+
+  /**
+   * Move as many bytes as the pipe can hold from the given socket into the pipe.
+   * @param io_handle the source socket.
+   * @return the number of bytes moved, 0 on end of stream, or the error.
+   */
+  Api::IoCallUint64Result fillFrom(IoHandle& io_handle);
+
+  /**
+   * Move as many bytes as the socket accepts from the pipe to the given socket.
+   * @param io_handle the sink socket.
+   * @return the number of bytes moved or the error.
+   */
+  Api::IoCallUint64Result drainTo(IoHandle& io_handle);
+
+  /**
+   * @return the number of bytes in the pipe that have not been written to the sink yet.
+   */
+  uint64_t pendingBytes() const { return pending_bytes_; }
+
+  /**
+   * Register or clear (with nullptr) the transport socket callbacks of the source and sink
+   * connections. Connections must clear their registration before their socket is closed.
+   */
+  void setSource(TransportSocketCallbacks* callbacks) { source_ = callbacks; }
+  void setSink(TransportSocketCallbacks* callbacks) { sink_ = callbacks; }
+
+  /**
+   * Called by the source after it moved bytes into the pipe. Schedules a write on the sink and
+   * remembers to resume reading on the source once the sink has drained the pipe.
+   */
+  void onSourceFilled();
+
+  /**
+   * Called by the sink after it drained the pipe completely. Resumes reading on the source if it
+   * stopped because the pipe was not empty.
+   */
+  void onSinkDrained();
+
+private:
+  SplicePipe(int read_fd, int write_fd) : read_fd_(read_fd), write_fd_(write_fd) {}
+
+  const int read_fd_;
+  const int write_fd_;
+  uint64_t pending_bytes_{};
+  bool source_wants_read_{};
+  TransportSocketCallbacks* source_{};
+  TransportSocketCallbacks* sink_{};
+};
+
+} // namespace Network
+} // namespace Envoy
@@ -24,16 +24,18 @@ namespace Rds {
 /**
  * All RDS stats. @see stats_macros.h
  */
-#define ALL_RDS_STATS(COUNTER, GAUGE)                                                              \
+#define ALL_RDS_STATS(COUNTER, GAUGE, HISTOGRAM)                                                   \
   COUNTER(config_reload)                                                                           \
+  COUNTER(config_reused_bytes)                                                                     \
   COUNTER(update_empty)                                                                            \
-  GAUGE(config_reload_time_ms, NeverImport)
+  GAUGE(config_reload_time_ms, NeverImport)                                                        \
+  HISTOGRAM(config_rebuild_ms, Milliseconds)
 
 /**
  * Struct definition for all RDS stats. @see stats_macros.h
  */
 struct RdsStats {
-  ALL_RDS_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+  ALL_RDS_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
 /**
@@ -15,11 +15,14 @@ RouteConfigUpdateReceiverImpl::RouteConfigUpdateReceiverImpl(
 
 void RouteConfigUpdateReceiverImpl::updateConfig(
     std::unique_ptr<Protobuf::Message>&& route_config_proto) {
-  config_ = config_traits_.createConfig(*route_config_proto, factory_context_,
-                                        false /* not validate unknown cluster */);
+  uint64_t reused_bytes = 0;
+  config_ = config_traits_.createConfigFromPrevious(*route_config_proto, factory_context_,
+                                                    false /* not validate unknown cluster */,
+                                                    config_, reused_bytes);
   // If the above create config doesn't raise exception, update the
   // other cached config entries.
   route_config_proto_ = std::move(route_config_proto);
+  last_update_reused_bytes_ = reused_bytes;
 }
 
 void RouteConfigUpdateReceiverImpl::onUpdateCommon(const std::string& version_info) {
@@ -28,6 +28,7 @@ public:
   const Protobuf::Message& protobufConfiguration() const override { return *route_config_proto_; }
   ConfigConstSharedPtr parsedConfiguration() const override { return config_; }
   SystemTime lastUpdated() const override { return last_updated_; }
+  uint64_t lastUpdateReusedBytes() const override { return last_update_reused_bytes_; }
 
 private:
   ConfigTraits& config_traits_;
@@ -36,6 +37,7 @@ private:
   TimeSource& time_source_;
   ProtobufTypes::MessagePtr route_config_proto_;
   uint64_t last_config_hash_{0ull};
+  uint64_t last_update_reused_bytes_{0ull};
   SystemTime last_updated_;
   absl::optional<RouteConfigProvider::ConfigInfo> config_info_;
   ConfigConstSharedPtr config_;
@@ -55,7 +55,9 @@
 #include "source/extensions/path/match/uri_template/uri_template_match.h"
 #include "source/extensions/path/rewrite/uri_template/uri_template_rewrite.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/memory/memory.h"
 #include "absl/strings/match.h"
 
 namespace Envoy {
@@ -224,6 +226,23 @@ createRedirectConfig(const envoy::config::route::v3::Route& route, Regex::Engine
   return redirect_config;
 }
 
+// Returns the hash of a message without one of its fields. The other fields are copied through
+// reflection so that the possibly large skipped field is never copied.
+uint64_t hashWithoutField(const Protobuf::Message& message, int field_number) {
+  Protobuf::ReflectableMessage reflectable_message = createReflectableMessage(message);
+  std::vector<const Protobuf::FieldDescriptor*> fields;
+  reflectable_message->GetReflection()->ListFields(*reflectable_message, &fields);
+  Protobuf::FieldMask mask;
+  for (const Protobuf::FieldDescriptor* field : fields) {
+    if (field->number() != field_number) {
+      mask.add_paths(field->name());
+    }
+  }
+  auto copy = absl::WrapUnique(reflectable_message->New());
+  ProtobufUtil::FieldMaskUtil::MergeMessageTo(*reflectable_message, mask, {}, copy.get());
+  return MessageUtil::hash(*copy);
+}
+
 } // namespace
 
 const std::string& OriginalConnectPort::key() {
@@ -610,6 +629,9 @@ RouteEntryImplBase::RouteEntryImplBase(const CommonVirtualHostSharedPtr& vhost,
       PerFilterConfigs::create(route.typed_per_filter_config(), factory_context, validator);
   SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
   per_filter_configs_ = std::move(config_or_error.value());
+  // Resolve the filter overrides of the route and its virtual host once here, so that the
+  // filters to create from a filter chain are only looked up the first time it is used.
+  filter_overrides_ = per_filter_configs_->resolveOverrides(vhost_->filterOverrides());
 
   auto policy_or_error =
       buildRetryPolicy(vhost->retryPolicy(), route.route(), validator, factory_context);
@@ -1538,11 +1560,7 @@ RouteEntryImplBase::validateClusters(const Upstream::ClusterManager& cluster_man
 }
 
 absl::optional<bool> RouteEntryImplBase::filterDisabled(absl::string_view config_name) const {
-  absl::optional<bool> result = per_filter_configs_->disabled(config_name);
-  if (result.has_value()) {
-    return result.value();
-  }
-  return vhost_->filterDisabled(config_name);
+  return filter_overrides_->filterDisabled(config_name);
 }
 
 RouteSpecificFilterConfigs
@@ -1588,6 +1606,7 @@ RouteEntryImplBase::WeightedClusterEntry::WeightedClusterEntry(
           std::unique_ptr<PerFilterConfigs>)),
       host_rewrite_(cluster.host_rewrite_literal()),
       cluster_header_name_(cluster.cluster_header()) {
+  filter_overrides_ = per_filter_configs_->resolveOverrides(parent->filter_overrides_);
   if (!cluster.request_headers_to_add().empty() || !cluster.request_headers_to_remove().empty()) {
     request_headers_parser_ =
         THROW_OR_RETURN_VALUE(HeaderParser::configure(cluster.request_headers_to_add(),
@@ -1859,6 +1878,9 @@ CommonVirtualHostImpl::CommonVirtualHostImpl(
       include_attempt_count_in_request_(virtual_host.include_request_attempt_count()),
       include_attempt_count_in_response_(virtual_host.include_attempt_count_in_response()),
       include_is_timeout_retry_header_(virtual_host.include_is_timeout_retry_header()) {
+  filter_overrides_ =
+      per_filter_configs_->resolveOverrides(global_route_config_->filterOverrides());
+
   if (!virtual_host.request_headers_to_add().empty() ||
       !virtual_host.request_headers_to_remove().empty()) {
     request_headers_parser_ =
@@ -1948,11 +1970,7 @@ CommonVirtualHostImpl::VirtualClusterEntry::VirtualClusterEntry(
 const CommonConfig& CommonVirtualHostImpl::routeConfig() const { return *global_route_config_; }
 
 absl::optional<bool> CommonVirtualHostImpl::filterDisabled(absl::string_view config_name) const {
-  absl::optional<bool> result = per_filter_configs_->disabled(config_name);
-  if (result.has_value()) {
-    return result.value();
-  }
-  return global_route_config_->filterDisabled(config_name);
+  return filter_overrides_->filterDisabled(config_name);
 }
 
 const RouteSpecificFilterConfig*
@@ -2002,12 +2020,31 @@ VirtualHostImpl::VirtualHostImpl(const envoy::config::route::v3::VirtualHost& vi
                                  const CommonConfigSharedPtr& global_route_config,
                                  Server::Configuration::ServerFactoryContext& factory_context,
                                  Stats::Scope& scope, ProtobufMessage::ValidationVisitor& validator,
-                                 bool validate_clusters, absl::Status& creation_status) {
+                                 bool validate_clusters,
+                                 std::unique_ptr<ConfigHashes> config_hashes,
+                                 const VirtualHostImpl* previous, uint64_t& reused_bytes,
+                                 absl::Status& creation_status)
+    : config_hashes_(std::move(config_hashes)) {
+  if (config_hashes_ != nullptr) {
+    config_hashes_->common_ = hashWithoutField(
+        virtual_host, envoy::config::route::v3::VirtualHost::kRoutesFieldNumber);
+    if (previous != nullptr && (previous->config_hashes_ == nullptr ||
+                                previous->config_hashes_->common_ != config_hashes_->common_)) {
+      previous = nullptr;
+    }
+  } else {
+    previous = nullptr;
+  }
 
-  auto host_or_error = CommonVirtualHostImpl::create(virtual_host, global_route_config,
-                                                     factory_context, scope, validator);
-  SET_AND_RETURN_IF_NOT_OK(host_or_error.status(), creation_status);
-  shared_virtual_host_ = std::move(host_or_error.value());
+  if (previous != nullptr) {
+    // Only the routes changed, so the shared part of the previous virtual host is still valid.
+    shared_virtual_host_ = previous->shared_virtual_host_;
+  } else {
+    auto host_or_error = CommonVirtualHostImpl::create(virtual_host, global_route_config,
+                                                       factory_context, scope, validator);
+    SET_AND_RETURN_IF_NOT_OK(host_or_error.status(), creation_status);
+    shared_virtual_host_ = std::move(host_or_error.value());
+  }
 
   switch (virtual_host.require_tls()) {
     PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
@@ -2021,7 +2058,9 @@ VirtualHostImpl::VirtualHostImpl(const envoy::config::route::v3::VirtualHost& vi
     ssl_requirements_ = SslRequirements::All;
     break;
   }
-  ssl_redirect_route_ = std::make_shared<SslRedirectRoute>(shared_virtual_host_);
+  ssl_redirect_route_ = previous != nullptr
+                            ? previous->ssl_redirect_route_
+                            : std::make_shared<SslRedirectRoute>(shared_virtual_host_);
 
   if (virtual_host.has_matcher()) {
     RouteActionContext context{shared_virtual_host_, factory_context};
@@ -2039,15 +2078,70 @@ VirtualHostImpl::VirtualHostImpl(const envoy::config::route::v3::VirtualHost& vi
       return;
     }
   } else {
+    // Routes of the previous virtual host by configuration hash.
+    absl::flat_hash_map<uint64_t, RouteEntryImplBaseConstSharedPtr> previous_routes;
+    if (previous != nullptr) {
+      for (size_t i = 0; i < previous->routes_.size(); ++i) {
+        previous_routes.emplace(previous->config_hashes_->routes_[i], previous->routes_[i]);
+      }
+    }
     for (const auto& route : virtual_host.routes()) {
+      if (config_hashes_ != nullptr) {
+        const uint64_t route_hash = MessageUtil::hash(route);
+        config_hashes_->routes_.push_back(route_hash);
+        auto it = previous_routes.find(route_hash);
+        if (it != previous_routes.end()) {
+          routes_.emplace_back(it->second);
+          reused_bytes += route.ByteSizeLong();
+          continue;
+        }
+      }
       auto route_or_error = RouteCreator::createAndValidateRoute(
           route, shared_virtual_host_, factory_context, validator, validate_clusters);
       SET_AND_RETURN_IF_NOT_OK(route_or_error.status(), creation_status);
       routes_.emplace_back(route_or_error.value());
     }
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.router_compiled_route_matcher")) {
+      buildRoutePathIndex();
+    }
   }
 }
 
+void VirtualHostImpl::buildRoutePathIndex() {
+  auto index = std::make_unique<RoutePathIndex>();
+  for (const auto& route : routes_) {
+    const PathMatchCriterion& criterion = route->pathMatchCriterion();
+    switch (criterion.matchType()) {
+    case PathMatchType::Prefix:
+    case PathMatchType::PathSeparatedPrefix:
+      // A path separated prefix also has to be followed by a separator or the end of the path,
+      // which the route checks itself.
+      if (route->case_sensitive()) {
+        index->addPrefix(criterion.matcher());
+      } else {
+        index->addUnindexed();
+      }
+      break;
+    case PathMatchType::Exact:
+      if (route->case_sensitive()) {
+        index->addExact(criterion.matcher());
+      } else {
+        index->addUnindexed();
+      }
+      break;
+    case PathMatchType::Regex:
+      index->addRegex(criterion.matcher());
+      break;
+    case PathMatchType::None:
+    case PathMatchType::Template:
+      index->addUnindexed();
+      break;
+    }
+  }
+  ASSERT(index->size() == routes_.size());
+  route_path_index_ = std::move(index);
+}
+
 const VirtualHost& SslRedirectRoute::virtualHost() const { return *virtual_host_; }
 
 RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
@@ -2138,12 +2232,121 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
   }
 
   // Check for a route that matches the request.
+  if (route_path_index_ != nullptr && headers.Path()) {
+    return getRouteFromPathIndex(cb, headers, stream_info, random_value);
+  }
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
 
+RouteConstSharedPtr VirtualHostImpl::getRouteFromPathIndex(
+    const RouteCallback& cb, const Http::RequestHeaderMap& headers,
+    const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const {
+  // Look up the path the way the route path matchers see it.
+  absl::string_view path = Http::PathUtil::removeQueryAndFragment(headers.getPathValue());
+  if (shared_virtual_host_->globalRouteConfig().ignorePathParametersInPathMatching()) {
+    path = path.substr(0, path.find(';'));
+  }
+
+  // The index only skips routes whose path matcher can't match, so evaluating the candidates in
+  // order gives the same result as walking all routes. The evaluation status passed to the
+  // callback is still based on the position of the route among all routes.
+  RouteConstSharedPtr result;
+  bool exhausted = true;
+  route_path_index_->forEachCandidate(path, [&](uint32_t index) {
+    RouteConstSharedPtr route_entry = routes_[index]->matches(headers, stream_info, random_value);
+    if (route_entry == nullptr) {
+      return true;
+    }
+
+    if (cb == nullptr) {
+      result = std::move(route_entry);
+      exhausted = false;
+      return false;
+    }
+
+    RouteEvalStatus eval_status = (index + 1 == routes_.size()) ? RouteEvalStatus::NoMoreRoutes
+                                                                : RouteEvalStatus::HasMoreRoutes;
+    RouteMatchStatus match_status = cb(route_entry, eval_status);
+    if (match_status == RouteMatchStatus::Accept) {
+      result = std::move(route_entry);
+      exhausted = false;
+      return false;
+    }
+    if (match_status == RouteMatchStatus::Continue &&
+        eval_status == RouteEvalStatus::NoMoreRoutes) {
+      ENVOY_LOG(debug,
+                "return null when route match status is Continue but there is no more routes");
+      exhausted = false;
+      return false;
+    }
+    return true;
+  });
+
+  if (exhausted) {
+    ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  }
+  return result;
+}
+
+const VirtualHostImpl* RouteMatcher::findSuffixWildcardVirtualHost(absl::string_view host) const {
+  // The longest suffix of the host starting at a '.' other than its first character is the
+  // longest match among the label wildcards, as *.foo.com shouldn't match .foo.com.
+  const VirtualHostImpl* vhost = nullptr;
+  size_t match_length = 0;
+  if (!label_wildcard_virtual_host_suffixes_.empty()) {
+    for (size_t pos = host.find('.', 1); pos != absl::string_view::npos;
+         pos = host.find('.', pos + 1)) {
+      const auto iter = label_wildcard_virtual_host_suffixes_.find(host.substr(pos));
+      if (iter != label_wildcard_virtual_host_suffixes_.end()) {
+        vhost = iter->second.get();
+        match_length = host.size() - pos;
+        break;
+      }
+    }
+  }
+  if (!wildcard_virtual_host_suffixes_.empty()) {
+    const VirtualHostImpl* longer_vhost = findWildcardVirtualHost(
+        host, wildcard_virtual_host_suffixes_,
+        [](absl::string_view h, int l) -> absl::string_view { return h.substr(h.size() - l); },
+        match_length);
+    if (longer_vhost != nullptr) {
+      return longer_vhost;
+    }
+  }
+  return vhost;
+}
+
+const VirtualHostImpl* RouteMatcher::findPrefixWildcardVirtualHost(absl::string_view host) const {
+  // The longest prefix of the host ending at a '.' other than its last character is the longest
+  // match among the label wildcards.
+  const VirtualHostImpl* vhost = nullptr;
+  size_t match_length = 0;
+  if (!label_wildcard_virtual_host_prefixes_.empty() && host.size() >= 2) {
+    for (size_t pos = host.rfind('.', host.size() - 2); pos != absl::string_view::npos;
+         pos = pos == 0 ? absl::string_view::npos : host.rfind('.', pos - 1)) {
+      const auto iter = label_wildcard_virtual_host_prefixes_.find(host.substr(0, pos + 1));
+      if (iter != label_wildcard_virtual_host_prefixes_.end()) {
+        vhost = iter->second.get();
+        match_length = pos + 1;
+        break;
+      }
+    }
+  }
+  if (!wildcard_virtual_host_prefixes_.empty()) {
+    const VirtualHostImpl* longer_vhost = findWildcardVirtualHost(
+        host, wildcard_virtual_host_prefixes_,
+        [](absl::string_view h, int l) -> absl::string_view { return h.substr(0, l); },
+        match_length);
+    if (longer_vhost != nullptr) {
+      return longer_vhost;
+    }
+  }
+  return vhost;
+}
+
 const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
     absl::string_view host, const RouteMatcher::WildcardVirtualHosts& wildcard_virtual_hosts,
-    RouteMatcher::SubstringFunction substring_function) const {
+    RouteMatcher::SubstringFunction substring_function, size_t min_length) const {
   // We do a longest wildcard match against the host that's passed in
   // (e.g. "foo-bar.baz.com" should match "*-bar.baz.com" before matching "*.baz.com" for suffix
   // wildcards). This is done by scanning the length => wildcards map looking for every wildcard
@@ -2151,6 +2354,9 @@ const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
   for (const auto& iter : wildcard_virtual_hosts) {
     const uint32_t wildcard_length = iter.first;
     const auto& wildcard_map = iter.second;
+    if (wildcard_length <= min_length) {
+      break;
+    }
     // >= because *.foo.com shouldn't match .foo.com.
     if (wildcard_length >= host.size()) {
       continue;
@@ -2166,11 +2372,12 @@ absl::StatusOr<std::unique_ptr<RouteMatcher>>
 RouteMatcher::create(const envoy::config::route::v3::RouteConfiguration& route_config,
                      const CommonConfigSharedPtr& global_route_config,
                      Server::Configuration::ServerFactoryContext& factory_context,
-                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters) {
+                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                     bool incremental, const RouteMatcher* previous, uint64_t& reused_bytes) {
   absl::Status creation_status = absl::OkStatus();
-  auto ret = std::unique_ptr<RouteMatcher>{new RouteMatcher(route_config, global_route_config,
-                                                            factory_context, validator,
-                                                            validate_clusters, creation_status)};
+  auto ret = std::unique_ptr<RouteMatcher>{
+      new RouteMatcher(route_config, global_route_config, factory_context, validator,
+                       validate_clusters, incremental, previous, reused_bytes, creation_status)};
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -2178,15 +2385,48 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
                            const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
                            ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                           bool incremental, const RouteMatcher* previous, uint64_t& reused_bytes,
                            absl::Status& creation_status)
     : vhost_scope_(factory_context.scope().scopeFromStatName(
           factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()) {
+  // Virtual hosts of the previous route configuration by configuration hash and by name.
+  absl::flat_hash_map<uint64_t, VirtualHostSharedPtr> previous_by_hash;
+  absl::flat_hash_map<absl::string_view, const VirtualHostImpl*> previous_by_name;
+  if (incremental && previous != nullptr) {
+    for (const VirtualHostSharedPtr& virtual_host : previous->virtual_host_list_) {
+      previous_by_hash.emplace(virtual_host->configHashes()->virtual_host_, virtual_host);
+      previous_by_name.emplace(virtual_host->name(), virtual_host.get());
+    }
+  }
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostSharedPtr virtual_host = std::make_shared<VirtualHostImpl>(
-        virtual_host_config, global_route_config, factory_context, *vhost_scope_, validator,
-        validate_clusters, creation_status);
-    SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    VirtualHostSharedPtr virtual_host;
+    std::unique_ptr<VirtualHostImpl::ConfigHashes> config_hashes;
+    const VirtualHostImpl* previous_virtual_host = nullptr;
+    if (incremental) {
+      config_hashes = std::make_unique<VirtualHostImpl::ConfigHashes>();
+      config_hashes->virtual_host_ = MessageUtil::hash(virtual_host_config);
+      auto hash_it = previous_by_hash.find(config_hashes->virtual_host_);
+      if (hash_it != previous_by_hash.end()) {
+        virtual_host = hash_it->second;
+        reused_bytes += virtual_host_config.ByteSizeLong();
+      } else {
+        auto name_it = previous_by_name.find(virtual_host_config.name());
+        if (name_it != previous_by_name.end()) {
+          previous_virtual_host = name_it->second;
+        }
+      }
+    }
+    if (virtual_host == nullptr) {
+      virtual_host = std::make_shared<VirtualHostImpl>(
+          virtual_host_config, global_route_config, factory_context, *vhost_scope_, validator,
+          validate_clusters, std::move(config_hashes), previous_virtual_host, reused_bytes,
+          creation_status);
+      SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    }
+    if (incremental) {
+      virtual_host_list_.push_back(virtual_host);
+    }
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const Http::LowerCaseString lower_case_domain_name(domain_name);
       absl::string_view domain = lower_case_domain_name;
@@ -2199,13 +2439,25 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
         }
         default_virtual_host_ = virtual_host;
       } else if (!domain.empty() && '*' == domain[0]) {
-        duplicate_found = !wildcard_virtual_host_suffixes_[domain.size() - 1]
-                               .emplace(domain.substr(1), virtual_host)
-                               .second;
+        if (domain[1] == '.') {
+          duplicate_found =
+              !label_wildcard_virtual_host_suffixes_.emplace(domain.substr(1), virtual_host)
+                   .second;
+        } else {
+          duplicate_found = !wildcard_virtual_host_suffixes_[domain.size() - 1]
+                                 .emplace(domain.substr(1), virtual_host)
+                                 .second;
+        }
       } else if (!domain.empty() && '*' == domain[domain.size() - 1]) {
-        duplicate_found = !wildcard_virtual_host_prefixes_[domain.size() - 1]
-                               .emplace(domain.substr(0, domain.size() - 1), virtual_host)
-                               .second;
+        if (domain.size() >= 2 && domain[domain.size() - 2] == '.') {
+          duplicate_found = !label_wildcard_virtual_host_prefixes_
+                                 .emplace(domain.substr(0, domain.size() - 1), virtual_host)
+                                 .second;
+        } else {
+          duplicate_found = !wildcard_virtual_host_prefixes_[domain.size() - 1]
+                                 .emplace(domain.substr(0, domain.size() - 1), virtual_host)
+                                 .second;
+        }
       } else {
         duplicate_found = !virtual_hosts_.emplace(domain, virtual_host).second;
       }
@@ -2223,7 +2475,8 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
 const VirtualHostImpl* RouteMatcher::findVirtualHost(const Http::RequestHeaderMap& headers) const {
   // Fast path the case where we only have a default virtual host.
   if (virtual_hosts_.empty() && wildcard_virtual_host_suffixes_.empty() &&
-      wildcard_virtual_host_prefixes_.empty()) {
+      wildcard_virtual_host_prefixes_.empty() && label_wildcard_virtual_host_suffixes_.empty() &&
+      label_wildcard_virtual_host_prefixes_.empty()) {
     return default_virtual_host_.get();
   }
 
@@ -2249,21 +2502,13 @@ const VirtualHostImpl* RouteMatcher::findVirtualHost(const Http::RequestHeaderMa
   if (iter != virtual_hosts_.end()) {
     return iter->second.get();
   }
-  if (!wildcard_virtual_host_suffixes_.empty()) {
-    const VirtualHostImpl* vhost = findWildcardVirtualHost(
-        host, wildcard_virtual_host_suffixes_,
-        [](absl::string_view h, int l) -> absl::string_view { return h.substr(h.size() - l); });
-    if (vhost != nullptr) {
-      return vhost;
-    }
+  const VirtualHostImpl* vhost = findSuffixWildcardVirtualHost(host);
+  if (vhost != nullptr) {
+    return vhost;
   }
-  if (!wildcard_virtual_host_prefixes_.empty()) {
-    const VirtualHostImpl* vhost = findWildcardVirtualHost(
-        host, wildcard_virtual_host_prefixes_,
-        [](absl::string_view h, int l) -> absl::string_view { return h.substr(0, l); });
-    if (vhost != nullptr) {
-      return vhost;
-    }
+  vhost = findPrefixWildcardVirtualHost(host);
+  if (vhost != nullptr) {
+    return vhost;
   }
   return default_virtual_host_.get();
 }
@@ -2325,6 +2570,8 @@ CommonConfigImpl::CommonConfigImpl(const envoy::config::route::v3::RouteConfigur
       uses_vhds_(config.has_vhds()),
       most_specific_header_mutations_wins_(config.most_specific_header_mutations_wins()),
       ignore_path_parameters_in_path_matching_(config.ignore_path_parameters_in_path_matching()) {
+  filter_overrides_ = per_filter_configs_->resolveOverrides(nullptr);
+
   if (!config.request_mirror_policies().empty()) {
     shadow_policies_.reserve(config.request_mirror_policies().size());
     for (const auto& mirror_policy_config : config.request_mirror_policies()) {
@@ -2398,8 +2645,22 @@ ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
                    Server::Configuration::ServerFactoryContext& factory_context,
                    ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default) {
   absl::Status creation_status = absl::OkStatus();
+  auto ret = std::shared_ptr<ConfigImpl>(new ConfigImpl(config, factory_context, validator,
+                                                        validate_clusters_default, false, nullptr,
+                                                        creation_status));
+  RETURN_IF_NOT_OK(creation_status);
+  return ret;
+}
+
+absl::StatusOr<std::shared_ptr<ConfigImpl>>
+ConfigImpl::createIncremental(const envoy::config::route::v3::RouteConfiguration& config,
+                              Server::Configuration::ServerFactoryContext& factory_context,
+                              ProtobufMessage::ValidationVisitor& validator,
+                              bool validate_clusters_default, const ConfigImpl* previous) {
+  absl::Status creation_status = absl::OkStatus();
   auto ret = std::shared_ptr<ConfigImpl>(new ConfigImpl(
-      config, factory_context, validator, validate_clusters_default, creation_status));
+      config, factory_context, validator, validate_clusters_default, true, previous,
+      creation_status));
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -2407,14 +2668,34 @@ ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
 ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
                        Server::Configuration::ServerFactoryContext& factory_context,
                        ProtobufMessage::ValidationVisitor& validator,
-                       bool validate_clusters_default, absl::Status& creation_status) {
-  auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
-  SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
-  shared_config_ = std::move(config_or_error.value());
+                       bool validate_clusters_default, bool incremental,
+                       const ConfigImpl* previous, absl::Status& creation_status) {
+  const bool validate_clusters =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default);
+  // Reused virtual hosts and routes would skip the cluster validation.
+  incremental = incremental && !validate_clusters;
+
+  const RouteMatcher* previous_route_matcher = nullptr;
+  if (incremental) {
+    common_config_hash_ = hashWithoutField(
+        config, envoy::config::route::v3::RouteConfiguration::kVirtualHostsFieldNumber);
+    // The virtual hosts hold the shared route configuration, so they can only be reused along
+    // with it.
+    if (previous != nullptr && previous->common_config_hash_ == common_config_hash_) {
+      shared_config_ = previous->shared_config_;
+      previous_route_matcher = previous->route_matcher_.get();
+    }
+  }
+
+  if (shared_config_ == nullptr) {
+    auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
+    SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
+    shared_config_ = std::move(config_or_error.value());
+  }
 
-  auto matcher_or_error = RouteMatcher::create(
-      config, shared_config_, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
+  auto matcher_or_error =
+      RouteMatcher::create(config, shared_config_, factory_context, validator, validate_clusters,
+                           incremental, previous_route_matcher, reused_bytes_);
   SET_AND_RETURN_IF_NOT_OK(matcher_or_error.status(), creation_status);
   route_matcher_ = std::move(matcher_or_error.value());
 }
@@ -2557,6 +2838,51 @@ absl::optional<bool> PerFilterConfigs::disabled(absl::string_view name) const {
   return it != configs_.end() ? absl::optional<bool>{it->second.disabled_} : absl::nullopt;
 }
 
+FilterOverridesConstSharedPtr
+PerFilterConfigs::resolveOverrides(const FilterOverridesConstSharedPtr& less_specific) const {
+  if (less_specific != nullptr && configs_.empty()) {
+    return less_specific;
+  }
+
+  absl::flat_hash_map<std::string, bool> disabled;
+  if (less_specific != nullptr) {
+    disabled = less_specific->disabled();
+  }
+  for (const auto& [name, config] : configs_) {
+    disabled[name] = config.disabled_;
+  }
+  return std::make_shared<const FilterOverrides>(std::move(disabled));
+}
+
+const Http::FilterChainTemplate* FilterOverrides::filterChainTemplate(
+    uint64_t chain_id, const std::function<Http::FilterChainTemplate()>& build) const {
+  const ChainTemplate* chain_template =
+      findTemplate(templates_.load(std::memory_order_acquire), chain_id);
+  if (chain_template != nullptr) {
+    return &chain_template->filters_;
+  }
+
+  absl::MutexLock lock(&templates_mutex_);
+  // Another worker may have built the template since the lookup above.
+  const ChainTemplate* head = templates_.load(std::memory_order_relaxed);
+  chain_template = findTemplate(head, chain_id);
+  if (chain_template == nullptr) {
+    owned_templates_.push_back(
+        std::make_unique<const ChainTemplate>(ChainTemplate{chain_id, build(), head}));
+    chain_template = owned_templates_.back().get();
+    templates_.store(chain_template, std::memory_order_release);
+  }
+  return &chain_template->filters_;
+}
+
+const FilterOverrides::ChainTemplate*
+FilterOverrides::findTemplate(const ChainTemplate* chain_template, uint64_t chain_id) {
+  while (chain_template != nullptr && chain_template->chain_id_ != chain_id) {
+    chain_template = chain_template->next_;
+  }
+  return chain_template;
+}
+
 Matcher::ActionFactoryCb RouteMatchActionFactory::createActionFactoryCb(
     const Protobuf::Message& config, RouteActionContext& context,
     ProtobufMessage::ValidationVisitor& validation_visitor) {
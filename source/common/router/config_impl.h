@@ -1,7 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <iterator>
 #include <map>
 #include <memory>
@@ -31,11 +33,13 @@
 #include "source/common/router/config_utility.h"
 #include "source/common/router/header_parser.h"
 #include "source/common/router/metadatamatchcriteria_impl.h"
+#include "source/common/router/route_path_index.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
 
 #include "absl/container/node_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -80,6 +84,62 @@ public:
   virtual bool supportsPathlessHeaders() const { return false; }
 };
 
+/**
+ * The explicit enabled (false) or disabled (true) state of HTTP filters, keyed by filter config
+ * name, resolved at config load time from a route, its virtual host and the route configuration.
+ * Also keeps the filters to create from each filter chain under this state, so that once a
+ * filter chain has been used, building it for a request needs no lookup per filter.
+ */
+class FilterOverrides {
+public:
+  explicit FilterOverrides(absl::flat_hash_map<std::string, bool> disabled)
+      : disabled_(std::move(disabled)) {}
+
+  /**
+   * @return true if the named filter is explicitly disabled, false if it is explicitly enabled,
+   * or absl::nullopt if it is neither.
+   */
+  absl::optional<bool> filterDisabled(absl::string_view name) const {
+    // Quick exit if no filter is overridden anywhere up the route configuration.
+    if (disabled_.empty()) {
+      return absl::nullopt;
+    }
+    const auto it = disabled_.find(name);
+    return it != disabled_.end() ? absl::optional<bool>{it->second} : absl::nullopt;
+  }
+
+  const absl::flat_hash_map<std::string, bool>& disabled() const { return disabled_; }
+
+  /**
+   * @return the template of the filter chain identified by chain_id, built by build the first
+   * time the filter chain is used with these overrides. Templates are kept for the lifetime of
+   * the route configuration.
+   */
+  const Http::FilterChainTemplate*
+  filterChainTemplate(uint64_t chain_id,
+                      const std::function<Http::FilterChainTemplate()>& build) const;
+
+private:
+  struct ChainTemplate {
+    uint64_t chain_id_;
+    Http::FilterChainTemplate filters_;
+    const ChainTemplate* next_;
+  };
+
+  static const ChainTemplate* findTemplate(const ChainTemplate* chain_template,
+                                           uint64_t chain_id);
+
+  const absl::flat_hash_map<std::string, bool> disabled_;
+  // Head of a list of the templates that is only ever prepended to, so that the workers can
+  // read it without locking. The templates are owned by owned_templates_.
+  mutable std::atomic<const ChainTemplate*> templates_{nullptr};
+  mutable absl::Mutex templates_mutex_;
+  mutable std::vector<std::unique_ptr<const ChainTemplate>>
+      owned_templates_ ABSL_GUARDED_BY(templates_mutex_);
+};
+
+using FilterOverridesConstSharedPtr = std::shared_ptr<const FilterOverrides>;
+
 class PerFilterConfigs : public Logger::Loggable<Logger::Id::http> {
 public:
   static absl::StatusOr<std::unique_ptr<PerFilterConfigs>>
@@ -101,6 +161,14 @@ public:
    */
   absl::optional<bool> disabled(absl::string_view name) const;
 
+  /**
+   * @return the enabled or disabled state of the filters of this config layered over the less
+   * specific state, or over nothing if less_specific is nullptr. The less specific overrides,
+   * and so their filter chain templates, are shared if this config has no entries of its own.
+   */
+  FilterOverridesConstSharedPtr
+  resolveOverrides(const FilterOverridesConstSharedPtr& less_specific) const;
+
 private:
   PerFilterConfigs(const Protobuf::Map<std::string, ProtobufWkt::Any>& typed_configs,
                    Server::Configuration::ServerFactoryContext& factory_context,
@@ -278,6 +346,7 @@ public:
     return HeaderParser::defaultParser();
   }
   absl::optional<bool> filterDisabled(absl::string_view config_name) const;
+  const FilterOverridesConstSharedPtr& filterOverrides() const { return filter_overrides_; }
 
   // Router::VirtualHost
   const CorsPolicy* corsPolicy() const override { return cors_policy_.get(); }
@@ -375,6 +444,7 @@ private:
   HeaderParserPtr request_headers_parser_;
   HeaderParserPtr response_headers_parser_;
   std::unique_ptr<PerFilterConfigs> per_filter_configs_;
+  FilterOverridesConstSharedPtr filter_overrides_;
   std::unique_ptr<envoy::config::route::v3::RetryPolicy> retry_policy_;
   std::unique_ptr<envoy::config::route::v3::HedgePolicy> hedge_policy_;
   std::unique_ptr<const CatchAllVirtualCluster> virtual_cluster_catch_all_;
@@ -391,11 +461,36 @@ private:
  */
 class VirtualHostImpl : Logger::Loggable<Logger::Id::router> {
 public:
+  /**
+   * Hashes of the virtual host configuration. Only recorded by incremental route configuration
+   * builds, @see ConfigImpl::createIncremental().
+   */
+  struct ConfigHashes {
+    // Hash of the whole virtual host configuration.
+    uint64_t virtual_host_{};
+    // Hash of the virtual host configuration without its routes.
+    uint64_t common_{};
+    // Hashes of the route configurations, in the order of routes_.
+    std::vector<uint64_t> routes_;
+  };
+
+  /**
+   * @param config_hashes supplies the hash of the whole virtual host configuration if the route
+   *    configuration is built incrementally, nullptr otherwise.
+   * @param previous supplies the virtual host with the same name in the previous route
+   *    configuration, if any. Only used by incremental builds: if nothing but the routes changed,
+   *    its shared part and its unchanged routes are reused.
+   * @param reused_bytes is incremented by the serialized size of the reused routes.
+   */
   VirtualHostImpl(const envoy::config::route::v3::VirtualHost& virtual_host,
                   const CommonConfigSharedPtr& global_route_config,
                   Server::Configuration::ServerFactoryContext& factory_context, Stats::Scope& scope,
                   ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
-                  absl::Status& creation_status);
+                  std::unique_ptr<ConfigHashes> config_hashes, const VirtualHostImpl* previous,
+                  uint64_t& reused_bytes, absl::Status& creation_status);
+
+  const std::string& name() const { return shared_virtual_host_->name(); }
+  const ConfigHashes* configHashes() const { return config_hashes_.get(); }
 
   RouteConstSharedPtr getRouteFromEntries(const RouteCallback& cb,
                                           const Http::RequestHeaderMap& headers,
@@ -410,13 +505,22 @@ public:
 private:
   enum class SslRequirements : uint8_t { None, ExternalOnly, All };
 
+  void buildRoutePathIndex();
+  RouteConstSharedPtr getRouteFromPathIndex(const RouteCallback& cb,
+                                            const Http::RequestHeaderMap& headers,
+                                            const StreamInfo::StreamInfo& stream_info,
+                                            uint64_t random_value) const;
+
   CommonVirtualHostSharedPtr shared_virtual_host_;
 
   std::shared_ptr<const SslRedirectRoute> ssl_redirect_route_;
   SslRequirements ssl_requirements_;
 
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  // Index over the path matchers of routes_. Only built if compiled route matching is enabled.
+  std::unique_ptr<const RoutePathIndex> route_path_index_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
+  std::unique_ptr<ConfigHashes> config_hashes_;
 };
 
 using VirtualHostSharedPtr = std::shared_ptr<VirtualHostImpl>;
@@ -664,6 +768,7 @@ public:
   bool isDirectResponse() const { return direct_response_code_.has_value(); }
 
   bool isRedirect() const;
+  bool case_sensitive() const { return case_sensitive_; }
 
   bool matchRoute(const Http::RequestHeaderMap& headers, const StreamInfo::StreamInfo& stream_info,
                   uint64_t random_value) const;
@@ -820,6 +925,11 @@ public:
   const Decorator* decorator() const override { return decorator_.get(); }
   const RouteTracing* tracingConfig() const override { return route_tracing_.get(); }
   absl::optional<bool> filterDisabled(absl::string_view config_name) const override;
+  const Http::FilterChainTemplate*
+  filterChainTemplate(uint64_t chain_id,
+                      const std::function<Http::FilterChainTemplate()>& build) const override {
+    return filter_overrides_->filterChainTemplate(chain_id, build);
+  }
   const RouteSpecificFilterConfig*
   mostSpecificPerFilterConfig(absl::string_view name) const override {
     auto* config = per_filter_configs_->get(name);
@@ -955,6 +1065,11 @@ public:
     absl::optional<bool> filterDisabled(absl::string_view config_name) const override {
       return parent_->filterDisabled(config_name);
     }
+    const Http::FilterChainTemplate*
+    filterChainTemplate(uint64_t chain_id,
+                        const std::function<Http::FilterChainTemplate()>& build) const override {
+      return parent_->filterChainTemplate(chain_id, build);
+    }
     const RouteSpecificFilterConfig*
     mostSpecificPerFilterConfig(absl::string_view name) const override {
       return parent_->mostSpecificPerFilterConfig(name);
@@ -1040,11 +1155,12 @@ public:
                                                     bool do_formatting = true) const override;
 
     absl::optional<bool> filterDisabled(absl::string_view config_name) const override {
-      absl::optional<bool> result = per_filter_configs_->disabled(config_name);
-      if (result.has_value()) {
-        return result.value();
-      }
-      return DynamicRouteEntry::filterDisabled(config_name);
+      return filter_overrides_->filterDisabled(config_name);
+    }
+    const Http::FilterChainTemplate*
+    filterChainTemplate(uint64_t chain_id,
+                        const std::function<Http::FilterChainTemplate()>& build) const override {
+      return filter_overrides_->filterChainTemplate(chain_id, build);
     }
     const RouteSpecificFilterConfig*
     mostSpecificPerFilterConfig(absl::string_view name) const override {
@@ -1067,6 +1183,7 @@ public:
     HeaderParserPtr request_headers_parser_;
     HeaderParserPtr response_headers_parser_;
     std::unique_ptr<PerFilterConfigs> per_filter_configs_;
+    FilterOverridesConstSharedPtr filter_overrides_;
     const std::string host_rewrite_;
     const Http::LowerCaseString cluster_header_name_;
   };
@@ -1099,7 +1216,6 @@ protected:
   const std::string host_rewrite_;
   std::unique_ptr<ConnectConfig> connect_config_;
 
-  bool case_sensitive() const { return case_sensitive_; }
   RouteConstSharedPtr clusterEntry(const Http::RequestHeaderMap& headers,
                                    const StreamInfo::StreamInfo& stream_info,
                                    uint64_t random_value) const;
@@ -1249,6 +1365,7 @@ private:
   const RouteTracingConstPtr route_tracing_;
   Envoy::Config::DataSource::DataSourceProviderPtr direct_response_body_provider_;
   std::unique_ptr<PerFilterConfigs> per_filter_configs_;
+  FilterOverridesConstSharedPtr filter_overrides_;
   const std::string route_name_;
   TimeSource& time_source_;
   EarlyDataPolicyPtr early_data_policy_;
@@ -1525,11 +1642,20 @@ DECLARE_FACTORY(RouteListMatchActionFactory);
  */
 class RouteMatcher {
 public:
+  /**
+   * @param incremental supplies whether to record the hashes needed to reuse the virtual hosts in
+   *    a later incremental build.
+   * @param previous supplies the route matcher of the previous route configuration if its virtual
+   *    hosts can be reused, nullptr otherwise. Only used by incremental builds.
+   * @param reused_bytes is incremented by the serialized size of the reused virtual hosts and
+   *    routes.
+   */
   static absl::StatusOr<std::unique_ptr<RouteMatcher>>
   create(const envoy::config::route::v3::RouteConfiguration& config,
          const CommonConfigSharedPtr& global_route_config,
          Server::Configuration::ServerFactoryContext& factory_context,
-         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters, bool incremental,
+         const RouteMatcher* previous, uint64_t& reused_bytes);
 
   RouteConstSharedPtr route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                             const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
@@ -1541,18 +1667,30 @@ private:
                const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
                ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+               bool incremental, const RouteMatcher* previous, uint64_t& reused_bytes,
                absl::Status& creation_status);
 
   using WildcardVirtualHosts =
       std::map<int64_t, absl::node_hash_map<std::string, VirtualHostSharedPtr>, std::greater<>>;
+  using LabelWildcardVirtualHosts = absl::flat_hash_map<std::string, VirtualHostSharedPtr>;
   using SubstringFunction = std::function<absl::string_view(absl::string_view, int)>;
+  const VirtualHostImpl* findSuffixWildcardVirtualHost(absl::string_view host) const;
+  const VirtualHostImpl* findPrefixWildcardVirtualHost(absl::string_view host) const;
+  // Only considers the wildcards whose fixed part is longer than min_length.
   const VirtualHostImpl* findWildcardVirtualHost(absl::string_view host,
                                                  const WildcardVirtualHosts& wildcard_virtual_hosts,
-                                                 SubstringFunction substring_function) const;
+                                                 SubstringFunction substring_function,
+                                                 size_t min_length) const;
   bool ignorePortInHostMatching() const { return ignore_port_in_host_matching_; }
 
   Stats::ScopeSharedPtr vhost_scope_;
-  absl::node_hash_map<std::string, VirtualHostSharedPtr> virtual_hosts_;
+  absl::flat_hash_map<std::string, VirtualHostSharedPtr> virtual_hosts_;
+  // Wildcards whose fixed part starts (for suffix wildcards, e.g. "*.foo.com") or ends (for prefix
+  // wildcards, e.g. "foo.*") at a label boundary, keyed by their fixed part. These make up nearly
+  // all wildcard domains in practice and are found with one lookup per '.' in the host, however
+  // many domains there are. The other wildcards are kept in the maps by length below.
+  LabelWildcardVirtualHosts label_wildcard_virtual_host_suffixes_;
+  LabelWildcardVirtualHosts label_wildcard_virtual_host_prefixes_;
   // std::greater as a minor optimization to iterate from more to less specific
   //
   // A note on using an unordered_map versus a vector of (string, VirtualHostSharedPtr) pairs:
@@ -1566,6 +1704,8 @@ private:
   WildcardVirtualHosts wildcard_virtual_host_prefixes_;
 
   VirtualHostSharedPtr default_virtual_host_;
+  // All virtual hosts in configuration order. Only kept by incremental builds.
+  std::vector<VirtualHostSharedPtr> virtual_host_list_;
   const bool ignore_port_in_host_matching_{false};
 };
 
@@ -1598,6 +1738,7 @@ public:
   absl::optional<bool> filterDisabled(absl::string_view config_name) const {
     return per_filter_configs_->disabled(config_name);
   }
+  const FilterOverridesConstSharedPtr& filterOverrides() const { return filter_overrides_; }
 
   // Router::CommonConfig
   const std::vector<Http::LowerCaseString>& internalOnlyHeaders() const override {
@@ -1633,6 +1774,7 @@ private:
   // Cluster specifier plugins/providers.
   absl::flat_hash_map<std::string, ClusterSpecifierPluginSharedPtr> cluster_specifier_plugins_;
   std::unique_ptr<PerFilterConfigs> per_filter_configs_;
+  FilterOverridesConstSharedPtr filter_overrides_;
   RouteMetadataPackPtr metadata_;
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   const uint32_t max_direct_response_body_size_bytes_;
@@ -1651,6 +1793,25 @@ public:
          Server::Configuration::ServerFactoryContext& factory_context,
          ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
 
+  /**
+   * Same as create(), but reuses the shared route configuration, virtual hosts and routes of the
+   * previous config whose configuration did not change, and records the configuration hashes
+   * needed to reuse parts of the new config in the next incremental build. Reused objects skip
+   * the cluster validation, so configs which validate clusters are always built from scratch.
+   * @param previous supplies the config of the previous update, nullptr if there is none.
+   */
+  static absl::StatusOr<std::shared_ptr<ConfigImpl>>
+  createIncremental(const envoy::config::route::v3::RouteConfiguration& config,
+                    Server::Configuration::ServerFactoryContext& factory_context,
+                    ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+                    const ConfigImpl* previous);
+
+  /**
+   * @return uint64_t the serialized size of the virtual host and route configurations whose
+   * config objects were reused from the previous config by an incremental build.
+   */
+  uint64_t reusedBytes() const { return reused_bytes_; }
+
   bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
     return route_matcher_->findVirtualHost(headers) != nullptr;
   }
@@ -1692,11 +1853,14 @@ protected:
   ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
              Server::Configuration::ServerFactoryContext& factory_context,
              ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
-             absl::Status& creation_status);
+             bool incremental, const ConfigImpl* previous, absl::Status& creation_status);
 
 private:
   CommonConfigSharedPtr shared_config_;
   std::unique_ptr<RouteMatcher> route_matcher_;
+  // Hash of the route configuration without its virtual hosts. Only set by incremental builds.
+  absl::optional<uint64_t> common_config_hash_;
+  uint64_t reused_bytes_{};
 };
 
 /**
@@ -12,6 +12,7 @@
 #include "source/common/config/resource_name.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/config_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Router {
@@ -50,6 +51,26 @@ ConfigTraitsImpl::createConfig(const Protobuf::Message& rc,
       std::shared_ptr<ConfigImpl>);
 }
 
+Rds::ConfigConstSharedPtr ConfigTraitsImpl::createConfigFromPrevious(
+    const Protobuf::Message& rc, Server::Configuration::ServerFactoryContext& factory_context,
+    bool validate_clusters_default, const Rds::ConfigConstSharedPtr& previous,
+    uint64_t& reused_bytes) const {
+  if (!Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.rds_incremental_route_config_rebuild")) {
+    reused_bytes = 0;
+    return createConfig(rc, factory_context, validate_clusters_default);
+  }
+  ASSERT(dynamic_cast<const envoy::config::route::v3::RouteConfiguration*>(&rc));
+  // The previous config is the null config before the first update.
+  auto config = THROW_OR_RETURN_VALUE(
+      ConfigImpl::createIncremental(
+          static_cast<const envoy::config::route::v3::RouteConfiguration&>(rc), factory_context,
+          validator_, validate_clusters_default, dynamic_cast<const ConfigImpl*>(previous.get())),
+      std::shared_ptr<ConfigImpl>);
+  reused_bytes = config->reusedBytes();
+  return config;
+}
+
 bool RouteConfigUpdateReceiverImpl::onRdsUpdate(const Protobuf::Message& rc,
                                                 const std::string& version_info) {
   uint64_t new_hash = base_.getHash(rc);
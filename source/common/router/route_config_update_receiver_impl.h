@@ -26,6 +26,12 @@ public:
   Rds::ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
                                          Server::Configuration::ServerFactoryContext& context,
                                          bool validate_clusters_default) const override;
+  Rds::ConfigConstSharedPtr
+  createConfigFromPrevious(const Protobuf::Message& rc,
+                           Server::Configuration::ServerFactoryContext& context,
+                           bool validate_clusters_default,
+                           const Rds::ConfigConstSharedPtr& previous,
+                           uint64_t& reused_bytes) const override;
 
 private:
   ProtobufMessage::ValidationVisitor& validator_;
@@ -62,6 +68,7 @@ public:
     return base_.parsedConfiguration();
   }
   SystemTime lastUpdated() const override { return base_.lastUpdated(); }
+  uint64_t lastUpdateReusedBytes() const override { return base_.lastUpdateReusedBytes(); }
   const std::set<std::string>& resourceIdsInLastVhdsUpdate() override {
     return resource_ids_in_last_update_;
   }
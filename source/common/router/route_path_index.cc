@@ -0,0 +1,116 @@
+#include "source/common/router/route_path_index.h"
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/ascii.h"
+
+namespace Envoy {
+namespace Router {
+
+namespace {
+
+// Characters that always match themselves in a regex outside of a character class.
+bool isRegexLiteral(char c) {
+  if (absl::ascii_isalnum(c)) {
+    return true;
+  }
+  switch (c) {
+  case '/':
+  case '-':
+  case '_':
+  case '~':
+  case '%':
+  case ':':
+  case '@':
+  case ',':
+  case ';':
+  case '=':
+  case '&':
+  case '!':
+  case '\'':
+    return true;
+  default:
+    return false;
+  }
+}
+
+} // namespace
+
+RoutePathIndex::Bucket& RoutePathIndex::prefixBucket(absl::string_view prefix) {
+  Bucket* bucket = prefixes_.find(prefix);
+  if (bucket == nullptr) {
+    bucket = prefix_buckets_.emplace_back(std::make_unique<Bucket>()).get();
+    prefixes_.add(prefix, bucket);
+  }
+  return *bucket;
+}
+
+void RoutePathIndex::addPrefix(absl::string_view prefix) {
+  // The empty prefix matches every path and is cheaper to keep with the unindexed routes.
+  if (prefix.empty()) {
+    addUnindexed();
+    return;
+  }
+  prefixBucket(prefix).push_back(size_++);
+}
+
+void RoutePathIndex::addExact(absl::string_view path) { exact_[path].push_back(size_++); }
+
+void RoutePathIndex::addRegex(absl::string_view regex) { addPrefix(regexLiteralPrefix(regex)); }
+
+void RoutePathIndex::addUnindexed() { unindexed_.push_back(size_++); }
+
+void RoutePathIndex::forEachCandidate(absl::string_view path,
+                                      absl::FunctionRef<bool(uint32_t)> cb) const {
+  // Every route is in exactly one bucket and every bucket is sorted, so a merge of the buckets
+  // that apply to the path yields each candidate once and in route order. Only a handful of
+  // buckets apply to any one path, so a linear scan for the smallest head is enough.
+  using Cursor = std::pair<Bucket::const_iterator, Bucket::const_iterator>;
+  absl::InlinedVector<Cursor, 8> cursors;
+  for (const Bucket* bucket : prefixes_.findMatchingPrefixes(path)) {
+    cursors.emplace_back(bucket->begin(), bucket->end());
+  }
+  if (const auto it = exact_.find(path); it != exact_.end()) {
+    cursors.emplace_back(it->second.begin(), it->second.end());
+  }
+  if (!unindexed_.empty()) {
+    cursors.emplace_back(unindexed_.begin(), unindexed_.end());
+  }
+
+  while (true) {
+    Cursor* next = nullptr;
+    for (Cursor& cursor : cursors) {
+      if (cursor.first != cursor.second && (next == nullptr || *cursor.first < *next->first)) {
+        next = &cursor;
+      }
+    }
+    if (next == nullptr || !cb(*next->first++)) {
+      return;
+    }
+  }
+}
+
+absl::string_view RoutePathIndex::regexLiteralPrefix(absl::string_view regex) {
+  // Without an explicit anchor a partial matching engine could match anywhere in the path, and
+  // with an alternation the anchor may only apply to one of the branches.
+  if (regex.empty() || regex[0] != '^' || regex.find('|') != absl::string_view::npos) {
+    return {};
+  }
+  regex.remove_prefix(1);
+
+  size_t length = 0;
+  while (length < regex.size() && isRegexLiteral(regex[length])) {
+    const char next = length + 1 < regex.size() ? regex[length + 1] : '\0';
+    if (next == '?' || next == '*' || next == '{') {
+      // The character may be repeated zero times and so isn't part of every match.
+      break;
+    }
+    ++length;
+    if (next == '+') {
+      break;
+    }
+  }
+  return regex.substr(0, length);
+}
+
+} // namespace Router
+} // namespace Envoy
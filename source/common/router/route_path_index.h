@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/common/trie_lookup_table.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * An index over the path matchers of the routes of a virtual host. It is built once when the
+ * route configuration is loaded and, given the path of a request, yields the routes whose path
+ * matcher may match that path in route order. Only those routes need to be evaluated in full,
+ * which keeps the first-match semantics of a linear walk over the routes without visiting every
+ * route of a large virtual host.
+ *
+ * Routes are identified by their position in the virtual host and must be added in order. Routes
+ * whose path matcher can't be indexed are yielded for every path.
+ */
+class RoutePathIndex {
+public:
+  /**
+   * Adds a route that can only match paths starting with the given case sensitive prefix.
+   */
+  void addPrefix(absl::string_view prefix);
+
+  /**
+   * Adds a route that can only match the given case sensitive path.
+   */
+  void addExact(absl::string_view path);
+
+  /**
+   * Adds a route with a regex path matcher. The route is indexed by the literal prefix of the
+   * regex, if any.
+   */
+  void addRegex(absl::string_view regex);
+
+  /**
+   * Adds a route that must be evaluated for every path.
+   */
+  void addUnindexed();
+
+  /**
+   * @return the number of routes added to the index.
+   */
+  uint32_t size() const { return size_; }
+
+  /**
+   * Calls cb with the position of every route that may match the path, in ascending order, until
+   * cb returns false.
+   * @param path the path of the request without the query string and fragment.
+   * @param cb the callback to call for every candidate route.
+   */
+  void forEachCandidate(absl::string_view path, absl::FunctionRef<bool(uint32_t)> cb) const;
+
+  /**
+   * @return the literal text every string matched by the regex must start with. Only regexes that
+   * are explicitly anchored with '^' and contain no alternation are considered, so that the
+   * prefix holds for both full and partial matching regex engines. Returns an empty string if no
+   * such prefix could be determined.
+   */
+  static absl::string_view regexLiteralPrefix(absl::string_view regex);
+
+private:
+  using Bucket = std::vector<uint32_t>;
+
+  Bucket& prefixBucket(absl::string_view prefix);
+
+  // Routes indexed by prefix. The trie stores pointers into prefix_buckets_.
+  TrieLookupTable<Bucket*> prefixes_;
+  std::vector<std::unique_ptr<Bucket>> prefix_buckets_;
+  absl::flat_hash_map<std::string, Bucket> exact_;
+  Bucket unindexed_;
+  uint32_t size_{};
+};
+
+} // namespace Router
+} // namespace Envoy
@@ -16,6 +16,7 @@
 #include "source/common/grpc/common.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/config_impl.h"
+#include "source/common/stats/timespan_impl.h"
 
 namespace Envoy {
 namespace Router {
@@ -48,10 +49,10 @@ VhdsSubscription::VhdsSubscription(RouteConfigUpdatePtr& config_update_info,
                                    absl::Status& status)
     : Envoy::Config::SubscriptionBase<envoy::config::route::v3::VirtualHost>(
           factory_context.messageValidationContext().dynamicValidationVisitor(), "name"),
-      config_update_info_(config_update_info),
+      config_update_info_(config_update_info), time_source_(factory_context.timeSource()),
       scope_(factory_context.scope().createScope(
           stat_prefix + "vhds." + config_update_info_->protobufConfigurationCast().name() + ".")),
-      stats_({ALL_VHDS_STATS(POOL_COUNTER(*scope_))}),
+      stats_({ALL_VHDS_STATS(POOL_COUNTER(*scope_), POOL_HISTOGRAM(*scope_))}),
       init_target_(fmt::format("VhdsConfigSubscription {}",
                                config_update_info_->protobufConfigurationCast().name()),
                    [this]() {
@@ -100,9 +101,12 @@ absl::Status VhdsSubscription::onConfigUpdate(
     added_vhosts.emplace_back(
         dynamic_cast<const envoy::config::route::v3::VirtualHost&>(resource.get().resource()));
   }
+  Stats::HistogramCompletableTimespanImpl rebuild_time(stats_.config_rebuild_ms_, time_source_);
   if (config_update_info_->onVhdsUpdate(added_vhosts, added_resource_ids, removed_resources,
                                         version_info)) {
+    rebuild_time.complete();
     stats_.config_reload_.inc();
+    stats_.config_reused_bytes_.add(config_update_info_->lastUpdateReusedBytes());
     ENVOY_LOG(debug, "vhds: loading new configuration: config_name={} hash={}",
               config_update_info_->protobufConfigurationCast().name(),
               config_update_info_->configHash());
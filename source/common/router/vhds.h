@@ -28,12 +28,14 @@
 namespace Envoy {
 namespace Router {
 
-#define ALL_VHDS_STATS(COUNTER)                                                                    \
+#define ALL_VHDS_STATS(COUNTER, HISTOGRAM)                                                         \
   COUNTER(config_reload)                                                                           \
-  COUNTER(update_empty)
+  COUNTER(config_reused_bytes)                                                                     \
+  COUNTER(update_empty)                                                                            \
+  HISTOGRAM(config_rebuild_ms, Milliseconds)
 
 struct VhdsStats {
-  ALL_VHDS_STATS(GENERATE_COUNTER_STRUCT)
+  ALL_VHDS_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
 class VhdsSubscription : Envoy::Config::SubscriptionBase<envoy::config::route::v3::VirtualHost>,
@@ -76,6 +78,7 @@ private:
                             const EnvoyException* e) override;
 
   RouteConfigUpdatePtr& config_update_info_;
+  TimeSource& time_source_;
   Stats::ScopeSharedPtr scope_;
   VhdsStats stats_;
   Envoy::Config::SubscriptionPtr subscription_;
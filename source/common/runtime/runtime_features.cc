@@ -155,6 +155,24 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_use_canonical_suffix_for_quic_brok
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_log_ip_families_on_network_error);
 // TODO(botengyao): flip to true after canarying the feature internally without problems.
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_connection_close_through_filter_manager);
+// Runs dispatcher timers on a hierarchical timer wheel instead of one libevent timer each.
+FALSE_RUNTIME_GUARD(envoy_restart_features_dispatcher_timer_wheel);
+// Allocates HTTP/1 and HTTP/2 header map entries from a per stream arena.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http_header_map_arena);
+// Makes the HTTP/1 codec borrow header names and values from the parser instead of copying them.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http1_borrow_header_data);
+// Writes the frames of an HTTP/2 send pass at once and sizes DATA frames to the congestion window.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http2_coalesce_outbound_frames);
+// Matches routes through a per virtual host index of path matchers instead of a linear scan.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_router_compiled_route_matcher);
+// Reuses unchanged virtual hosts and routes of the previous route configuration on RDS/VHDS.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_rds_incremental_route_config_rebuild);
+// Updates round robin and least request schedulers in place on host additions and removals.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_edf_lb_host_set_delta_updates);
+// Skips rebuilding ring hash and Maglev tables of priorities a host set update leaves unchanged.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_thread_aware_lb_skip_unchanged_table_builds);
+// Makes the random lb and zone aware locality sampling weighted, using alias tables.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_lb_alias_table_weighted_random);
 
 // A flag to set the maximum TLS version for google_grpc client to TLS1.2, when needed for
 // compliance restrictions.
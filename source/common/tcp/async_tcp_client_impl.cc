@@ -59,7 +59,8 @@ bool AsyncTcpClientImpl::connect() {
                                    cluster_info_->trafficStats()->upstream_cx_rx_bytes_buffered_,
                                    cluster_info_->trafficStats()->upstream_cx_tx_bytes_total_,
                                    cluster_info_->trafficStats()->upstream_cx_tx_bytes_buffered_,
-                                   &cluster_info_->trafficStats()->bind_errors_, nullptr});
+                                   &cluster_info_->trafficStats()->bind_errors_, nullptr, nullptr,
+                                   nullptr});
   connection_->noDelay(true);
   connection_->connect();
   return true;
@@ -30,7 +30,8 @@ ActiveTcpClient::ActiveTcpClient(Envoy::ConnectionPool::ConnPoolImplBase& parent
                                    cluster_traffic_stats.upstream_cx_rx_bytes_buffered_,
                                    cluster_traffic_stats.upstream_cx_tx_bytes_total_,
                                    cluster_traffic_stats.upstream_cx_tx_bytes_buffered_,
-                                   &cluster_traffic_stats.bind_errors_, nullptr});
+                                   &cluster_traffic_stats.bind_errors_, nullptr, nullptr,
+                                   nullptr});
   connection_->noDelay(true);
   connection_->connect();
 
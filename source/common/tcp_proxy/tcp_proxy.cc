@@ -27,8 +27,12 @@
 #include "source/common/config/utility.h"
 #include "source/common/config/well_known_names.h"
 #include "source/common/network/application_protocol.h"
+#include "source/common/network/connection_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/proxy_protocol_filter_state.h"
+#include "source/common/network/raw_buffer_socket.h"
 #include "source/common/network/socket_option_factory.h"
+#include "source/common/network/splice_pipe.h"
 #include "source/common/network/transport_socket_options_impl.h"
 #include "source/common/network/upstream_server_name.h"
 #include "source/common/network/upstream_socket_options_filter_state.h"
@@ -40,6 +44,29 @@
 
 namespace Envoy {
 namespace TcpProxy {
+namespace {
+
+// Returns the raw buffer transport socket of the connection if its payload can be moved with
+// splice(2), i.e. it is a plain socket served by the default socket interface, and the proxy is the
+// only filter that sees its data. Spliced bytes bypass the filter chain, so any other read or write
+// filter, such as RBAC on the downstream connection or upstream network filters of the cluster,
+// requires the buffered path.
+Network::RawBufferSocket* spliceableSocket(Network::Connection& connection) {
+  auto* connection_impl = dynamic_cast<Network::ConnectionImpl*>(&connection);
+  if (connection_impl == nullptr || connection_impl->state() != Network::Connection::State::Open ||
+      dynamic_cast<Network::IoSocketHandleImpl*>(&connection_impl->ioHandle()) == nullptr ||
+      !connection_impl->hasSingleDataFilter()) {
+    return nullptr;
+  }
+  Network::TransportSocketPtr& transport_socket = connection_impl->transportSocket();
+  if (transport_socket == nullptr ||
+      typeid(*transport_socket) != typeid(Network::RawBufferSocket)) {
+    return nullptr;
+  }
+  return static_cast<Network::RawBufferSocket*>(transport_socket.get());
+}
+
+} // namespace
 
 const std::string& PerConnectionCluster::key() {
   CONSTRUCT_ON_FIRST_USE(std::string, "envoy.tcp_proxy.cluster");
@@ -114,7 +141,7 @@ Config::SharedConfig::SharedConfig(
     const envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy& config,
     Server::Configuration::FactoryContext& context)
     : stats_scope_(context.scope().createScope(fmt::format("tcp.{}", config.stat_prefix()))),
-      stats_(generateStats(*stats_scope_)) {
+      stats_(generateStats(*stats_scope_)), splice_passthrough_(config.splice_passthrough()) {
   if (config.has_idle_timeout()) {
     const uint64_t timeout = DurationUtil::durationToMilliseconds(config.idle_timeout());
     if (timeout > 0) {
@@ -343,7 +370,7 @@ void Filter::initialize(Network::ReadFilterCallbacks& callbacks, bool set_connec
         {config_->stats().downstream_cx_rx_bytes_total_,
          config_->stats().downstream_cx_rx_bytes_buffered_,
          config_->stats().downstream_cx_tx_bytes_total_,
-         config_->stats().downstream_cx_tx_bytes_buffered_, nullptr, nullptr});
+         config_->stats().downstream_cx_tx_bytes_buffered_, nullptr, nullptr, nullptr, nullptr});
   }
 }
 
@@ -1018,6 +1045,9 @@ void Filter::onUpstreamConnection() {
     // Re-enable downstream reads now that the early data buffer is flushed.
     read_callbacks_->connection().readDisable(false);
   } else if (!receive_before_connect_) {
+    if (config_->splicePassthrough()) {
+      maybeEnableSplice();
+    }
     // Re-enable downstream reads now that the upstream connection is established
     read_callbacks_->connection().readDisable(false);
   }
@@ -1061,6 +1091,49 @@ void Filter::onUpstreamConnection() {
   }
 }
 
+void Filter::maybeEnableSplice() {
+  Network::RawBufferSocket* downstream_socket = spliceableSocket(read_callbacks_->connection());
+  OptRef<Network::Connection> upstream_connection =
+      upstream_ != nullptr ? upstream_->tcpConnection() : OptRef<Network::Connection>();
+  Network::RawBufferSocket* upstream_socket =
+      upstream_connection.has_value() ? spliceableSocket(*upstream_connection) : nullptr;
+  if (downstream_socket == nullptr || upstream_socket == nullptr) {
+    config_->stats().downstream_cx_splice_fallback_total_.inc();
+    return;
+  }
+
+  Network::SplicePipeSharedPtr downstream_to_upstream = Network::SplicePipe::create();
+  Network::SplicePipeSharedPtr upstream_to_downstream = Network::SplicePipe::create();
+  if (downstream_to_upstream == nullptr || upstream_to_downstream == nullptr) {
+    config_->stats().downstream_cx_splice_fallback_total_.inc();
+    return;
+  }
+
+  ENVOY_CONN_LOG(debug, "TCP: splicing payload between downstream and upstream",
+                 read_callbacks_->connection());
+  downstream_socket->setSplicePipes(downstream_to_upstream, upstream_to_downstream);
+  upstream_socket->setSplicePipes(upstream_to_downstream, downstream_to_upstream);
+  config_->stats().downstream_cx_splice_total_.inc();
+
+  // Spliced bytes never reach onData() or onUpstreamData(), so account for them in the bytes meters
+  // once they have been written out.
+  read_callbacks_->connection().addBytesSentCallback([this](uint64_t bytes) {
+    getStreamInfo().getUpstreamBytesMeter()->addWireBytesReceived(bytes);
+    getStreamInfo().getDownstreamBytesMeter()->addWireBytesSent(bytes);
+    return true;
+  });
+  upstream_->addBytesSentCallback([upstream_callbacks = upstream_callbacks_](uint64_t bytes) {
+    // The upstream connection may outlive the filter when it is handed over to a drainer.
+    if (upstream_callbacks->parent_ == nullptr) {
+      return false;
+    }
+    StreamInfo::StreamInfo& stream_info = upstream_callbacks->parent_->getStreamInfo();
+    stream_info.getDownstreamBytesMeter()->addWireBytesReceived(bytes);
+    stream_info.getUpstreamBytesMeter()->addWireBytesSent(bytes);
+    return true;
+  });
+}
+
 void Filter::onIdleTimeout() {
   ENVOY_CONN_LOG(debug, "Session timed out", read_callbacks_->connection());
   config_->stats().idle_timeout_.inc();
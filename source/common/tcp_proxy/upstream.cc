@@ -60,6 +60,13 @@ Ssl::ConnectionInfoConstSharedPtr TcpUpstream::getUpstreamConnectionSslInfo() {
   return nullptr;
 }
 
+OptRef<Network::Connection> TcpUpstream::tcpConnection() {
+  if (upstream_conn_data_ != nullptr) {
+    return upstream_conn_data_->connection();
+  }
+  return {};
+}
+
 Tcp::ConnectionPool::ConnectionData*
 TcpUpstream::onDownstreamEvent(Network::ConnectionEvent event) {
   // TODO(botengyao): propagate RST back to upstream connection if RST is received from downstream.
@@ -94,6 +94,11 @@ public:
 
   SslStats& stats() { return stats_; }
 
+  /**
+   * @return true if connections should try to offload their transmit direction to kernel TLS.
+   */
+  bool kernelTlsOffload() const { return kernel_tls_offload_; }
+
   /**
    * The global SSL-library index used for storing a pointer to the SslExtendedSocketInfo
    * class in the SSL instance, for retrieval in callbacks.
@@ -174,6 +179,7 @@ protected:
   const Network::Address::IpList tls_keylog_local_;
   const Network::Address::IpList tls_keylog_remote_;
   AccessLog::AccessLogFileSharedPtr tls_keylog_file_;
+  const bool kernel_tls_offload_;
 };
 
 using ContextImplSharedPtr = std::shared_ptr<ContextImpl>;
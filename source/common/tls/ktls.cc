@@ -0,0 +1,190 @@
+#include "source/common/tls/ktls.h"
+
+#include <cstring>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "openssl/crypto.h"
+#include "openssl/nid.h"
+
+#if defined(__linux__)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+
+// Older libc headers do not define the constants of the kernel TLS upper layer protocol.
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+#if defined(__linux__)
+namespace {
+
+// The content type of TLS alert records, RFC 5246 section 6.2.1.
+constexpr uint8_t AlertRecordType = 21;
+// The level and description of a close_notify alert, RFC 5246 section 7.2.
+constexpr uint8_t CloseNotifyAlert[] = {1, 0};
+
+// Copies the sequence number of the next record in network byte order.
+void writeSequence(uint64_t sequence, unsigned char* out) {
+  for (int i = 7; i >= 0; --i) {
+    out[i] = sequence & 0xff;
+    sequence >>= 8;
+  }
+}
+
+// Fills the kernel crypto info of the given type from the write key and fixed IV of the
+// connection. `CryptoInfo` is one of the tls12_crypto_info_* structs of linux/tls.h.
+template <class CryptoInfo>
+absl::Status setTxCryptoInfo(SSL* ssl, Network::IoHandle& io_handle, uint16_t cipher_type) {
+  CryptoInfo info{};
+  info.info.version = TLS_1_2_VERSION;
+  info.info.cipher_type = cipher_type;
+  constexpr size_t key_len = sizeof(info.key);
+  // The kernel splits the implicit part of the nonce in a salt and an IV for AES-GCM, where the
+  // IV is the explicit nonce sent in each record; ChaCha20-Poly1305 has no explicit nonce.
+  constexpr size_t fixed_iv_len = sizeof(info.salt) > 0 ? sizeof(info.salt) : sizeof(info.iv);
+
+  // The TLS 1.2 key block is laid out as: client MAC key, server MAC key, client write key,
+  // server write key, client IV, server IV. AEAD ciphers have no MAC keys.
+  const size_t key_block_len = SSL_get_key_block_len(ssl);
+  if (key_block_len != 2 * (key_len + fixed_iv_len)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("unexpected TLS key block length ", key_block_len));
+  }
+  uint8_t key_block[2 * (key_len + fixed_iv_len)];
+  if (!SSL_generate_key_block(ssl, key_block, key_block_len)) {
+    return absl::InternalError("failed to generate the TLS key block");
+  }
+  const bool is_server = SSL_is_server(ssl);
+  const uint8_t* key = key_block + (is_server ? key_len : 0);
+  const uint8_t* fixed_iv = key_block + 2 * key_len + (is_server ? fixed_iv_len : 0);
+  memcpy(info.key, key, key_len);
+
+  writeSequence(SSL_get_write_sequence(ssl), info.rec_seq);
+  if constexpr (sizeof(info.salt) > 0) {
+    memcpy(info.salt, fixed_iv, fixed_iv_len);
+    // BoringSSL uses the record sequence number as the explicit nonce, so the kernel does too.
+    static_assert(sizeof(info.iv) == sizeof(info.rec_seq));
+    memcpy(info.iv, info.rec_seq, sizeof(info.iv));
+  } else {
+    memcpy(info.iv, fixed_iv, fixed_iv_len);
+  }
+  OPENSSL_cleanse(key_block, sizeof(key_block));
+
+  const Api::SysCallIntResult result = io_handle.setOption(SOL_TLS, TLS_TX, &info, sizeof(info));
+  OPENSSL_cleanse(&info, sizeof(info));
+  if (result.return_value_ != 0) {
+    return absl::UnavailableError(
+        absl::StrCat("failed to set the kernel TLS transmit keys: ", errorDetails(result.errno_)));
+  }
+  return absl::OkStatus();
+}
+
+} // namespace
+#endif
+
+bool Ktls::isSupported(uint16_t version, const SSL_CIPHER* cipher) {
+#if defined(__linux__)
+  if (version != TLS1_2_VERSION || cipher == nullptr) {
+    return false;
+  }
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+  case NID_aes_128_gcm:
+  case NID_aes_256_gcm:
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+  case NID_chacha20_poly1305:
+#endif
+    return true;
+  default:
+    return false;
+  }
+#else
+  UNREFERENCED_PARAMETER(version);
+  UNREFERENCED_PARAMETER(cipher);
+  return false;
+#endif
+}
+
+absl::Status Ktls::enableTx(SSL* ssl, Network::IoHandle& io_handle) {
+#if defined(__linux__)
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (!isSupported(SSL_version(ssl), cipher)) {
+    return absl::UnimplementedError(
+        absl::StrCat("kernel TLS is not supported for ", SSL_get_version(ssl), " with ",
+                     cipher != nullptr ? SSL_CIPHER_get_name(cipher) : "no cipher"));
+  }
+
+  static constexpr char Ulp[] = "tls";
+  const Api::SysCallIntResult result = io_handle.setOption(IPPROTO_TCP, TCP_ULP, Ulp, sizeof(Ulp));
+  if (result.return_value_ != 0) {
+    return absl::UnavailableError(
+        absl::StrCat("failed to enable the kernel TLS protocol: ", errorDetails(result.errno_)));
+  }
+
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+  case NID_aes_128_gcm:
+    return setTxCryptoInfo<tls12_crypto_info_aes_gcm_128>(ssl, io_handle,
+                                                          TLS_CIPHER_AES_GCM_128);
+  case NID_aes_256_gcm:
+    return setTxCryptoInfo<tls12_crypto_info_aes_gcm_256>(ssl, io_handle,
+                                                          TLS_CIPHER_AES_GCM_256);
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+  case NID_chacha20_poly1305:
+    return setTxCryptoInfo<tls12_crypto_info_chacha20_poly1305>(ssl, io_handle,
+                                                                TLS_CIPHER_CHACHA20_POLY1305);
+#endif
+  default:
+    PANIC_DUE_TO_CORRUPT_ENUM;
+  }
+#else
+  UNREFERENCED_PARAMETER(ssl);
+  UNREFERENCED_PARAMETER(io_handle);
+  return absl::UnimplementedError("kernel TLS is only supported on Linux");
+#endif
+}
+
+absl::Status Ktls::sendCloseNotify(Network::IoHandle& io_handle) {
+#if defined(__linux__)
+  // The record type of data sent on a kernel TLS socket is set by a control message.
+  char control[CMSG_SPACE(sizeof(AlertRecordType))] = {};
+  iovec iov{const_cast<uint8_t*>(CloseNotifyAlert), sizeof(CloseNotifyAlert)};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(AlertRecordType));
+  *CMSG_DATA(cmsg) = AlertRecordType;
+
+  const Api::SysCallSizeResult result =
+      Api::OsSysCallsSingleton::get().sendmsg(io_handle.fdDoNotUse(), &message, 0);
+  if (result.return_value_ < 0) {
+    return absl::UnavailableError(
+        absl::StrCat("failed to send close_notify: ", errorDetails(result.errno_)));
+  }
+  return absl::OkStatus();
+#else
+  UNREFERENCED_PARAMETER(io_handle);
+  return absl::UnimplementedError("kernel TLS is only supported on Linux");
+#endif
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "envoy/network/io_handle.h"
+
+#include "absl/status/status.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * Utilities for offloading the record encryption of an established TLS connection to the kernel
+ * (kTLS). Only the transmit direction is offloaded: the receive direction keeps being decrypted
+ * by BoringSSL, so that alerts and other control records are still handled in user space.
+ */
+class Ktls {
+public:
+  /**
+   * Hands the transmit keys of an established connection to the kernel. On success, plaintext
+   * written to the socket is sent as TLS application data records, and SSL_write() must not be
+   * called on the connection anymore.
+   * @param ssl the connection whose handshake has completed. All the data it wrote, if any, must
+   *        have been flushed to the socket.
+   * @param io_handle the socket of the connection.
+   * @return an error if the negotiated protocol version or cipher cannot be offloaded or if the
+   *         kernel does not support kTLS. The tls upper layer protocol cannot be removed from the
+   *         socket once set, so it stays set if only the transmit keys were rejected; the socket
+   *         then still sends data as written, and the connection can keep using SSL_write().
+   */
+  static absl::Status enableTx(SSL* ssl, Network::IoHandle& io_handle);
+
+  /**
+   * Sends a close_notify alert on a connection whose transmit direction has been offloaded.
+   * @param io_handle the socket of the connection.
+   * @return an error if the alert could not be sent.
+   */
+  static absl::Status sendCloseNotify(Network::IoHandle& io_handle);
+
+  /**
+   * @return true if the kernel supports offloading the transmit direction of a connection that
+   *         negotiated the given protocol version and cipher.
+   */
+  static bool isSupported(uint16_t version, const SSL_CIPHER* cipher);
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -6,7 +6,9 @@
 #include "source/common/common/empty_string.h"
 #include "source/common/common/hex.h"
 #include "source/common/http/headers.h"
+#include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/tls/io_handle_bio.h"
+#include "source/common/tls/ktls.h"
 #include "source/common/tls/ssl_handshaker.h"
 #include "source/common/tls/utility.h"
 
@@ -191,6 +193,9 @@ Network::Connection& SslSocket::connection() const { return callbacks_->connecti
 
 void SslSocket::onSuccess(SSL* ssl) {
   ctx_->logHandshake(ssl);
+  if (ctx_->kernelTlsOffload()) {
+    maybeEnableKtlsTx(ssl);
+  }
   if (callbacks_->connection().streamInfo().upstreamInfo()) {
     callbacks_->connection()
         .streamInfo()
@@ -206,6 +211,26 @@ void SslSocket::onSuccess(SSL* ssl) {
 
 void SslSocket::onFailure() { drainErrorQueue(); }
 
+void SslSocket::maybeEnableKtlsTx(SSL* ssl) {
+  // Everything BoringSSL wrote has been flushed when the handshake completes, so the kernel
+  // continues the record sequence where BoringSSL left it.
+  const absl::Status status = Ktls::enableTx(ssl, callbacks_->ioHandle());
+  if (!status.ok()) {
+    ENVOY_CONN_LOG(debug, "kernel TLS offload not enabled: {}", callbacks_->connection(),
+                   status.message());
+    ctx_->stats().ktls_tx_fallback_.inc();
+    return;
+  }
+  ENVOY_CONN_LOG(debug, "kernel TLS transmit offload enabled", callbacks_->connection());
+  ctx_->stats().ktls_tx_offloaded_.inc();
+  ktls_tx_ = true;
+  // The kernel rejects MSG_ZEROCOPY sends on a socket with TLS_TX installed.
+  auto* io_handle = dynamic_cast<Network::IoSocketHandleImpl*>(&callbacks_->ioHandle());
+  if (io_handle != nullptr) {
+    io_handle->disableZeroCopySend();
+  }
+}
+
 PostIoAction SslSocket::doHandshake() { return info_->doHandshake(); }
 
 void SslSocket::drainErrorQueue() {
@@ -263,6 +288,10 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     }
   }
 
+  if (ktls_tx_) {
+    return doKtlsWrite(write_buffer, end_stream);
+  }
+
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
     bytes_to_write = bytes_to_retry_;
@@ -313,6 +342,32 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
   return {PostIoAction::KeepOpen, total_bytes_written, false};
 }
 
+Network::IoResult SslSocket::doKtlsWrite(Buffer::Instance& write_buffer, bool end_stream) {
+  // The kernel encrypts and frames the data, so the buffer is written as is, without the copy
+  // into a linear buffer nor the 16KiB chunking needed by SSL_write().
+  uint64_t total_bytes_written = 0;
+  while (write_buffer.length() > 0) {
+    Api::IoCallUint64Result result = callbacks_->ioHandle().write(write_buffer);
+    if (!result.ok()) {
+      ENVOY_CONN_LOG(trace, "ktls write error: {}, code: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails(), static_cast<int>(result.err_->getErrorCode()));
+      if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+        return {PostIoAction::KeepOpen, total_bytes_written, false};
+      }
+      return {PostIoAction::Close, total_bytes_written, false, result.err_->getErrorCode()};
+    }
+    ENVOY_CONN_LOG(trace, "ktls write returns: {}", callbacks_->connection(),
+                   result.return_value_);
+    total_bytes_written += result.return_value_;
+  }
+
+  if (end_stream) {
+    shutdownSsl();
+  }
+
+  return {PostIoAction::KeepOpen, total_bytes_written, false};
+}
+
 void SslSocket::onConnected() { ASSERT(info_->state() == Ssl::SocketState::PreHandshake); }
 
 Ssl::ConnectionInfoConstSharedPtr SslSocket::ssl() const { return info_; }
@@ -321,6 +376,13 @@ void SslSocket::shutdownSsl() {
   ASSERT(info_->state() != Ssl::SocketState::PreHandshake);
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
+    if (ktls_tx_) {
+      // BoringSSL no longer owns the transmit keys, so the alert has to go through the kernel.
+      const absl::Status status = Ktls::sendCloseNotify(callbacks_->ioHandle());
+      ENVOY_CONN_LOG(debug, "SSL shutdown: {}", callbacks_->connection(), status.ToString());
+      info_->setState(Ssl::SocketState::ShutdownSent);
+      return;
+    }
     int rc = SSL_shutdown(rawSsl());
     if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
       // Windows operate under `EmulatedEdge`. These are level events that are artificially
@@ -92,6 +92,8 @@ private:
     absl::optional<int> error_;
   };
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
+  Network::IoResult doKtlsWrite(Buffer::Instance& write_buffer, bool end_stream);
+  void maybeEnableKtlsTx(SSL* ssl);
 
   Network::PostIoAction doHandshake();
   void drainErrorQueue();
@@ -104,6 +106,9 @@ private:
   ContextImplSharedPtr ctx_;
   uint64_t bytes_to_retry_{};
   std::string failure_reason_;
+  // Whether the transmit direction has been offloaded to kernel TLS, in which case plaintext is
+  // written directly to the socket.
+  bool ktls_tx_{};
 
   SslHandshakerImplSharedPtr info_;
 };
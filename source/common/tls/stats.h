@@ -21,6 +21,8 @@ namespace Tls {
   COUNTER(ocsp_staple_omitted)                                                                     \
   COUNTER(ocsp_staple_responses)                                                                   \
   COUNTER(ocsp_staple_requests)                                                                    \
+  COUNTER(ktls_tx_offloaded)                                                                       \
+  COUNTER(ktls_tx_fallback)                                                                        \
   COUNTER(was_key_usage_invalid)
 
 /**
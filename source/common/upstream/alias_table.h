@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Upstream {
+
+// Alias table (https://en.wikipedia.org/wiki/Alias_method) for weighted random selection.
+// Building the table from N weights is O(N) (Vose's method); each pick afterwards is O(1) and
+// consumes a single 64-bit random value: the low 32 bits choose a column of the table and the high
+// 32 bits choose between the column's own index and its alias.
+//
+// The table only stores indices, so it is meant to be rebuilt alongside the vector of objects it
+// was built for whenever that vector or the weights of its objects change.
+class AliasTable {
+public:
+  AliasTable() = default;
+
+  /**
+   * Builds the table for the given weights.
+   * @param size the number of objects to select from.
+   * @param weight returns the non-negative weight of the object at an index. If every weight is
+   *        zero the table is left empty.
+   */
+  template <class WeightFunction> AliasTable(size_t size, WeightFunction weight) {
+    ASSERT(size <= UINT32_MAX);
+    std::vector<double> scaled_weights;
+    scaled_weights.reserve(size);
+    double total_weight = 0;
+    for (size_t i = 0; i < size; ++i) {
+      const double w = weight(i);
+      ASSERT(w >= 0);
+      scaled_weights.push_back(w);
+      total_weight += w;
+    }
+    if (total_weight <= 0) {
+      return;
+    }
+
+    // Scale the weights so that they average to 1, and split the columns into the ones below and
+    // above the average. Each step fills up a column below the average with the excess of a column
+    // above it, so every column ends up holding at most two indices.
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (uint32_t i = 0; i < size; ++i) {
+      scaled_weights[i] *= size / total_weight;
+      (scaled_weights[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    entries_.resize(size);
+    while (!small.empty() && !large.empty()) {
+      const uint32_t less = small.back();
+      small.pop_back();
+      const uint32_t more = large.back();
+      entries_[less] = {toThreshold(scaled_weights[less]), more};
+      scaled_weights[more] -= 1.0 - scaled_weights[less];
+      if (scaled_weights[more] < 1.0) {
+        large.pop_back();
+        small.push_back(more);
+      }
+    }
+    // Whatever remains is equal to the average up to rounding errors, and always picks itself.
+    for (const uint32_t index : large) {
+      entries_[index] = {FullThreshold, index};
+    }
+    for (const uint32_t index : small) {
+      entries_[index] = {FullThreshold, index};
+    }
+  }
+
+  /**
+   * @param random a uniformly distributed random value.
+   * @return the index of the picked object. Must not be called on an empty table.
+   */
+  uint32_t pick(uint64_t random) const {
+    ASSERT(!entries_.empty());
+    // Scale the low 32 bits to a column without a division (see
+    // https://lemire.me/blog/2016/06/27/a-fast-alternative-to-the-modulo-reduction/).
+    const uint32_t column = ((random & UINT32_MAX) * entries_.size()) >> 32;
+    const Entry& entry = entries_[column];
+    return (random >> 32) < entry.threshold_ ? column : entry.alias_;
+  }
+
+  size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+private:
+  static constexpr uint64_t FullThreshold = uint64_t(1) << 32;
+
+  static uint64_t toThreshold(double probability) {
+    return static_cast<uint64_t>(probability * FullThreshold);
+  }
+
+  struct Entry {
+    // The column picks its own index if the high 32 bits of the random value are below this.
+    uint64_t threshold_{FullThreshold};
+    uint32_t alias_{};
+  };
+
+  std::vector<Entry> entries_;
+};
+
+} // namespace Upstream
+} // namespace Envoy
@@ -587,6 +587,7 @@ absl::Status ClusterManagerImpl::onClusterInit(ClusterManagerCluster& cm_cluster
         //
         // See https://github.com/envoyproxy/envoy/pull/3941 for more context.
         bool scheduled = false;
+        bool cancelled_merged_updates = false;
         const auto merge_timeout = PROTOBUF_GET_MS_OR_DEFAULT(
             cm_cluster.cluster().info()->lbConfig(), update_merge_window, 1000);
         // Remember: we only merge updates with no adds/removes — just hc/weight/metadata changes.
@@ -595,14 +596,17 @@ absl::Status ClusterManagerImpl::onClusterInit(ClusterManagerCluster& cm_cluster
         if (merge_timeout > 0) {
           // If this is not mergeable, we should cancel any scheduled updates since
           // we'll deliver it immediately.
-          scheduled = scheduleUpdate(cm_cluster, priority, is_mergeable, merge_timeout);
+          scheduled = scheduleUpdate(cm_cluster, priority, is_mergeable, merge_timeout,
+                                     cancelled_merged_updates);
         }
 
         // If an update was not scheduled for later, deliver it immediately.
         if (!scheduled) {
           cm_stats_.cluster_updated_.inc();
-          postThreadLocalClusterUpdate(
-              cm_cluster, ThreadLocalClusterUpdateParams(priority, hosts_added, hosts_removed));
+          ThreadLocalClusterUpdateParams params(priority, hosts_added, hosts_removed);
+          params.per_priority_update_params_[0].includes_merged_updates_ =
+              cancelled_merged_updates;
+          postThreadLocalClusterUpdate(cm_cluster, std::move(params));
         }
         return absl::OkStatus();
       });
@@ -626,7 +630,8 @@ absl::Status ClusterManagerImpl::onClusterInit(ClusterManagerCluster& cm_cluster
 }
 
 bool ClusterManagerImpl::scheduleUpdate(ClusterManagerCluster& cluster, uint32_t priority,
-                                        bool mergeable, const uint64_t timeout) {
+                                        bool mergeable, const uint64_t timeout,
+                                        bool& cancelled_merged_updates) {
   // Find pending updates for this cluster.
   auto& updates_by_prio = updates_map_[cluster.cluster().info()->name()];
   if (!updates_by_prio) {
@@ -662,6 +667,7 @@ bool ClusterManagerImpl::scheduleUpdate(ClusterManagerCluster& cluster, uint32_t
     // 2) Were there previous updates that we are cancelling (and delivering immediately)?
     if (updates->disableTimer()) {
       cm_stats_.update_merge_cancelled_.inc();
+      cancelled_merged_updates = true;
     }
 
     updates->last_updated_ = time_source_.monotonicTime();
@@ -693,8 +699,9 @@ void ClusterManagerImpl::applyUpdates(ClusterManagerCluster& cluster, uint32_t p
   static const HostVector hosts_added;
   static const HostVector hosts_removed;
 
-  postThreadLocalClusterUpdate(
-      cluster, ThreadLocalClusterUpdateParams(priority, hosts_added, hosts_removed));
+  ThreadLocalClusterUpdateParams params(priority, hosts_added, hosts_removed);
+  params.per_priority_update_params_[0].includes_merged_updates_ = true;
+  postThreadLocalClusterUpdate(cluster, std::move(params));
 
   cm_stats_.cluster_updated_via_merge_.inc();
   updates.last_updated_ = time_source_.monotonicTime();
@@ -1155,6 +1162,11 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
     const auto& host_set =
         cm_cluster.cluster().prioritySet().hostSetsPerPriority()[per_priority.priority_];
     per_priority.update_hosts_params_ = HostSetImpl::updateHostsParams(*host_set);
+    // The host set only records whether its last update was a membership only update, which does
+    // not describe the merged updates delivered along with it.
+    if (per_priority.includes_merged_updates_) {
+      per_priority.update_hosts_params_.membership_update_only = false;
+    }
     per_priority.locality_weights_ = host_set->localityWeights();
     per_priority.weighted_priority_health_ = host_set->weightedPriorityHealth();
     per_priority.overprovisioning_factor_ = host_set->overprovisioningFactor();
@@ -425,6 +425,9 @@ protected:
       const uint32_t priority_;
       bool weighted_priority_health_;
       uint32_t overprovisioning_factor_;
+      // Whether the update also delivers merged health check, weight or metadata updates, in which
+      // case it is never a membership only update.
+      bool includes_merged_updates_{false};
     };
 
     ThreadLocalClusterUpdateParams() = default;
@@ -875,8 +878,10 @@ private:
   using ClusterCreationsMap = absl::flat_hash_map<std::string, ClusterCreation>;
 
   void applyUpdates(ClusterManagerCluster& cluster, uint32_t priority, PendingUpdates& updates);
+  // Sets cancelled_merged_updates if the update is not scheduled and cancels pending merged
+  // updates, which must then be delivered with it.
   bool scheduleUpdate(ClusterManagerCluster& cluster, uint32_t priority, bool mergeable,
-                      const uint64_t timeout);
+                      const uint64_t timeout, bool& cancelled_merged_updates);
   ProtobufTypes::MessagePtr dumpClusterConfigs(const Matchers::StringMatcher& name_matcher);
   static ClusterManagerStats generateStats(Stats::Scope& scope);
 
@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <iosfwd>
 #include <queue>
+#include <set>
 
 #include "envoy/upstream/scheduler.h"
 
@@ -44,7 +45,7 @@ public:
       // In this case the entry was added back during peekAgain so don't re-add.
       std::shared_ptr<C> ret = prepick_list_.front().lock();
       prepick_list_.pop_front();
-      if (ret) {
+      if (ret && !isRemoved(ret)) {
         return ret;
       }
     }
@@ -57,6 +58,10 @@ public:
 
   void add(double weight, std::shared_ptr<C> entry) override {
     ASSERT(weight > 0);
+    if (isRemoved(entry)) {
+      // The entry is added back while its old queue entry is still pending removal.
+      compact();
+    }
     const double deadline = current_time_ + 1.0 / weight;
     EDF_TRACE("Insertion {} in queue with deadline {} and weight {}.",
               static_cast<const void*>(entry.get()), deadline, weight);
@@ -64,7 +69,19 @@ public:
     ASSERT(queue_.top().deadline_ >= current_time_);
   }
 
-  bool empty() const override { return queue_.empty(); }
+  bool empty() const override { return queue_.size() == removed_.size(); }
+
+  /**
+   * Removes an entry that was previously added to the scheduler. The queue entry is left in place
+   * and skipped when it reaches the top of the queue. The queue is compacted once removed entries
+   * make up more than half of it.
+   */
+  void remove(const std::shared_ptr<C>& entry) {
+    removed_.insert(entry);
+    if (removed_.size() * 2 > queue_.size()) {
+      compact();
+    }
+  }
 
   // Creates an EdfScheduler with the given weights and their corresponding
   // entries, and emulating a number of initial picks to be performed. Note that
@@ -185,8 +202,9 @@ private:
       const EdfEntry& edf_entry = queue_.top();
       // Entry has been removed, let's see if there's another one.
       std::shared_ptr<C> ret = edf_entry.entry_.lock();
-      if (!ret) {
-        EDF_TRACE("Entry has expired, repick.");
+      const bool removed = !removed_.empty() && removed_.erase(edf_entry.entry_) > 0;
+      if (!ret || removed) {
+        EDF_TRACE("Entry has expired or was removed, repick.");
         queue_.pop();
         continue;
       }
@@ -198,12 +216,37 @@ private:
     }
   }
 
+  bool isRemoved(const std::shared_ptr<C>& entry) const {
+    return !removed_.empty() && removed_.count(entry) > 0;
+  }
+
+  /**
+   * Drops expired and removed entries from the queue and the prepick list.
+   */
+  void compact() {
+    EDF_TRACE("Compacting queue: queue_.size()={}, removed_.size()={}.", queue_.size(),
+              removed_.size());
+    std::vector<EdfEntry> entries;
+    entries.reserve(queue_.size());
+    for (; !queue_.empty(); queue_.pop()) {
+      const EdfEntry& edf_entry = queue_.top();
+      if (!edf_entry.entry_.expired() && removed_.count(edf_entry.entry_) == 0) {
+        entries.push_back(edf_entry);
+      }
+    }
+    prepick_list_.remove_if([this](const std::weak_ptr<C>& entry) {
+      return entry.expired() || removed_.count(entry) > 0;
+    });
+    removed_.clear();
+    queue_ = std::priority_queue<EdfEntry>(entries.cbegin(), entries.cend());
+  }
+
   struct EdfEntry {
     double deadline_;
     // Tie breaker for entries with the same deadline. This is used to provide FIFO behavior.
     uint64_t order_offset_;
-    // We only hold a weak pointer, since we don't support a remove operator. This allows entries to
-    // be lazily unloaded from the queue.
+    // We only hold a weak pointer, so that entries that are destroyed or removed are lazily
+    // unloaded from the queue.
     std::weak_ptr<C> entry_;
 
     // Flip < direction to make this a min queue.
@@ -228,6 +271,9 @@ private:
   // Min priority queue for EDF.
   std::priority_queue<EdfEntry> queue_;
   std::list<std::weak_ptr<C>> prepick_list_;
+  // Entries removed via remove() whose queue entry has not been popped yet. Ownership based
+  // ordering keeps a tombstone valid after its entry has been destroyed.
+  std::set<std::weak_ptr<C>, std::owner_less<std::weak_ptr<C>>> removed_;
 };
 
 #undef EDF_DEBUG
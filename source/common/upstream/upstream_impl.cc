@@ -725,6 +725,7 @@ void HostSetImpl::updateHosts(PrioritySet::UpdateHostsParams&& update_hosts_para
   healthy_hosts_per_locality_ = std::move(update_hosts_params.healthy_hosts_per_locality);
   degraded_hosts_per_locality_ = std::move(update_hosts_params.degraded_hosts_per_locality);
   excluded_hosts_per_locality_ = std::move(update_hosts_params.excluded_hosts_per_locality);
+  membership_update_only_ = update_hosts_params.membership_update_only;
   locality_weights_ = std::move(locality_weights);
 
   // TODO(ggreenway): implement `weighted_priority_health` support in `rebuildLocalityScheduler`.
@@ -827,10 +828,13 @@ HostSetImpl::updateHostsParams(HostVectorConstSharedPtr hosts,
 }
 
 PrioritySet::UpdateHostsParams HostSetImpl::updateHostsParams(const HostSet& host_set) {
-  return updateHostsParams(host_set.hostsPtr(), host_set.hostsPerLocalityPtr(),
-                           host_set.healthyHostsPtr(), host_set.healthyHostsPerLocalityPtr(),
-                           host_set.degradedHostsPtr(), host_set.degradedHostsPerLocalityPtr(),
-                           host_set.excludedHostsPtr(), host_set.excludedHostsPerLocalityPtr());
+  PrioritySet::UpdateHostsParams params = updateHostsParams(
+      host_set.hostsPtr(), host_set.hostsPerLocalityPtr(), host_set.healthyHostsPtr(),
+      host_set.healthyHostsPerLocalityPtr(), host_set.degradedHostsPtr(),
+      host_set.degradedHostsPerLocalityPtr(), host_set.excludedHostsPtr(),
+      host_set.excludedHostsPerLocalityPtr());
+  params.membership_update_only = host_set.membershipUpdateOnly();
+  return params;
 }
 PrioritySet::UpdateHostsParams
 HostSetImpl::partitionHosts(HostVectorConstSharedPtr hosts,
@@ -2209,8 +2213,8 @@ void PriorityStateManager::updateClusterPrioritySet(
     const uint32_t priority, HostVectorSharedPtr&& current_hosts,
     const absl::optional<HostVector>& hosts_added, const absl::optional<HostVector>& hosts_removed,
     const absl::optional<Upstream::Host::HealthFlag> health_checker_flag,
-    absl::optional<bool> weighted_priority_health,
-    absl::optional<uint32_t> overprovisioning_factor) {
+    absl::optional<bool> weighted_priority_health, absl::optional<uint32_t> overprovisioning_factor,
+    bool membership_update_only) {
   // If local locality is not defined then skip populating per locality hosts.
   const auto& local_locality = local_info_node_.locality();
   ENVOY_LOG(trace, "Local locality: {}", local_locality.DebugString());
@@ -2265,17 +2269,18 @@ void PriorityStateManager::updateClusterPrioritySet(
 
   auto per_locality_shared =
       std::make_shared<HostsPerLocalityImpl>(std::move(per_locality), non_empty_local_locality);
+  PrioritySet::UpdateHostsParams update_hosts_params =
+      HostSetImpl::partitionHosts(hosts, per_locality_shared);
+  update_hosts_params.membership_update_only = membership_update_only;
 
   // If a batch update callback was provided, use that. Otherwise directly update
   // the PrioritySet.
   if (update_cb_ != nullptr) {
-    update_cb_->updateHosts(priority, HostSetImpl::partitionHosts(hosts, per_locality_shared),
-                            std::move(locality_weights), hosts_added.value_or(*hosts),
-                            hosts_removed.value_or<HostVector>({}), random_.random(),
-                            weighted_priority_health, overprovisioning_factor);
+    update_cb_->updateHosts(priority, std::move(update_hosts_params), std::move(locality_weights),
+                            hosts_added.value_or(*hosts), hosts_removed.value_or<HostVector>({}),
+                            random_.random(), weighted_priority_health, overprovisioning_factor);
   } else {
-    parent_.prioritySet().updateHosts(priority,
-                                      HostSetImpl::partitionHosts(hosts, per_locality_shared),
+    parent_.prioritySet().updateHosts(priority, std::move(update_hosts_params),
                                       std::move(locality_weights), hosts_added.value_or(*hosts),
                                       hosts_removed.value_or<HostVector>({}), random_.random(),
                                       weighted_priority_health, overprovisioning_factor);
@@ -2285,7 +2290,8 @@ void PriorityStateManager::updateClusterPrioritySet(
 bool BaseDynamicClusterImpl::updateDynamicHostList(
     const HostVector& new_hosts, HostVector& current_priority_hosts,
     HostVector& hosts_added_to_current_priority, HostVector& hosts_removed_from_current_priority,
-    const HostMap& all_hosts, const absl::flat_hash_set<std::string>& all_new_hosts) {
+    const HostMap& all_hosts, const absl::flat_hash_set<std::string>& all_new_hosts,
+    bool* hosts_updated_in_place) {
   uint64_t max_host_weight = 1;
 
   // Did hosts change?
@@ -2301,6 +2307,9 @@ bool BaseDynamicClusterImpl::updateDynamicHostList(
   // updates to the Cluster object. This will probably make sense to do in
   // conjunction with https://github.com/envoyproxy/envoy/issues/2874.
   bool hosts_changed = false;
+  // Whether any host kept in the priority had its weight, health or metadata changed in place, as
+  // opposed to only hosts being added or removed.
+  bool updated_in_place = false;
 
   // Go through and see if the list we have is different from what we just got. If it is, we make
   // a new host list and raise a change notification. We also check for duplicates here. It's
@@ -2369,10 +2378,10 @@ bool BaseDynamicClusterImpl::updateDynamicHostList(
         // structures based on host weight. This may become a performance problem in certain
         // deployments so it is runtime feature guarded and may also need to be configurable
         // and/or dynamic in the future.
-        hosts_changed = true;
+        updated_in_place = true;
       }
 
-      hosts_changed |= updateEdsHealthFlag(*host, *existing_host->second);
+      updated_in_place |= updateEdsHealthFlag(*host, *existing_host->second);
 
       // Did metadata change?
       bool metadata_changed = true;
@@ -2394,7 +2403,7 @@ bool BaseDynamicClusterImpl::updateDynamicHostList(
         existing_host->second->canary(host->canary());
 
         // If metadata changed, we need to rebuild. See github issue #3810.
-        hosts_changed = true;
+        updated_in_place = true;
       }
 
       // Did the priority change?
@@ -2539,6 +2548,11 @@ bool BaseDynamicClusterImpl::updateDynamicHostList(
     hosts_changed = true;
   }
 
+  hosts_changed |= updated_in_place;
+  if (hosts_updated_in_place != nullptr) {
+    *hosts_updated_in_place = updated_in_place;
+  }
+
   // During the update we populated final_hosts with all the hosts that should remain
   // in the current priority, so move them back into current_priority_hosts.
   current_priority_hosts = std::move(final_hosts);
@@ -603,6 +603,7 @@ public:
   uint32_t priority() const override { return priority_; }
   uint32_t overprovisioningFactor() const override { return overprovisioning_factor_; }
   bool weightedPriorityHealth() const override { return weighted_priority_health_; }
+  bool membershipUpdateOnly() const override { return membership_update_only_; }
 
   static PrioritySet::UpdateHostsParams
   updateHostsParams(HostVectorConstSharedPtr hosts,
@@ -642,6 +643,7 @@ private:
   const uint32_t priority_;
   uint32_t overprovisioning_factor_;
   bool weighted_priority_health_;
+  bool membership_update_only_{};
   HostVectorConstSharedPtr hosts_;
   HealthyHostVectorConstSharedPtr healthy_hosts_;
   DegradedHostVectorConstSharedPtr degraded_hosts_;
@@ -1345,7 +1347,8 @@ public:
                            const absl::optional<HostVector>& hosts_removed,
                            const absl::optional<Upstream::Host::HealthFlag> health_checker_flag,
                            absl::optional<bool> weighted_priority_health = absl::nullopt,
-                           absl::optional<uint32_t> overprovisioning_factor = absl::nullopt);
+                           absl::optional<uint32_t> overprovisioning_factor = absl::nullopt,
+                           bool membership_update_only = false);
 
   // Returns the saved priority state.
   PriorityState& priorityState() { return priority_state_; }
@@ -1379,13 +1382,16 @@ protected:
    * priority.
    * @param all_hosts all known hosts prior to this host update across all priorities.
    * @param all_new_hosts addresses of all hosts in the new configuration across all priorities.
+   * @param hosts_updated_in_place if not null, will be set to whether the weight, health or
+   * metadata of a host kept in the priority was changed in place.
    * @return whether the hosts for the priority changed.
    */
   bool updateDynamicHostList(const HostVector& new_hosts, HostVector& current_priority_hosts,
                              HostVector& hosts_added_to_current_priority,
                              HostVector& hosts_removed_from_current_priority,
                              const HostMap& all_hosts,
-                             const absl::flat_hash_set<std::string>& all_new_hosts);
+                             const absl::flat_hash_set<std::string>& all_new_hosts,
+                             bool* hosts_updated_in_place = nullptr);
 };
 
 /**
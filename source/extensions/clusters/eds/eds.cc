@@ -423,8 +423,10 @@ bool EdsClusterImpl::updateHostsPerLocality(
   // performance implications, since this has the knock on effect that we rebuild the load balancers
   // and locality scheduler. See the comment in BaseDynamicClusterImpl::updateDynamicHostList
   // about this. In the future we may need to do better here.
-  const bool hosts_updated = updateDynamicHostList(new_hosts, *current_hosts_copy, hosts_added,
-                                                   hosts_removed, all_hosts, all_new_hosts);
+  bool hosts_updated_in_place = false;
+  const bool hosts_updated =
+      updateDynamicHostList(new_hosts, *current_hosts_copy, hosts_added, hosts_removed, all_hosts,
+                            all_new_hosts, &hosts_updated_in_place);
   if (hosts_updated || host_set.weightedPriorityHealth() != weighted_priority_health ||
       host_set.overprovisioningFactor() != overprovisioning_factor ||
       locality_weights_map != new_locality_weights_map) {
@@ -435,9 +437,11 @@ bool EdsClusterImpl::updateHostsPerLocality(
               "EDS hosts or locality weights changed for cluster: {} current hosts {} priority {}",
               info_->name(), host_set.hosts().size(), host_set.priority());
 
+    // Unless a host kept in the priority was updated in place, workers may apply the hosts added
+    // and removed to their load balancers without rebuilding them.
     priority_state_manager.updateClusterPrioritySet(
         priority, std::move(current_hosts_copy), hosts_added, hosts_removed, absl::nullopt,
-        weighted_priority_health, overprovisioning_factor);
+        weighted_priority_health, overprovisioning_factor, !hosts_updated_in_place);
     return true;
   }
   return false;
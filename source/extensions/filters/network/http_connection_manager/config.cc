@@ -800,7 +800,8 @@ Http::ServerConnectionPtr HttpConnectionManagerConfig::createCodec(
 
 bool HttpConnectionManagerConfig::createFilterChain(Http::FilterChainManager& manager,
                                                     const Http::FilterChainOptions& options) const {
-  Http::FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories_);
+  Http::FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories_,
+                                                          filter_chain_id_);
   return true;
 }
 
@@ -291,6 +291,8 @@ private:
   Http::RequestIDExtensionSharedPtr request_id_extension_;
   Server::Configuration::FactoryContext& context_;
   FilterFactoriesList filter_factories_;
+  // Identifies filter_factories_ in the filter chain templates of the routes.
+  const uint64_t filter_chain_id_{Http::FilterChainUtility::nextFilterChainId()};
   std::map<std::string, FilterConfig> upgrade_filter_factories_;
   AccessLog::InstanceSharedPtrVector access_logs_;
   bool flush_access_log_on_new_request_;
@@ -113,7 +113,8 @@ UdpProxyFilterConfigImpl::UdpProxyFilterConfigImpl(
       upstream_socket_config_(config.upstream_socket_config(), true),
       udp_session_filter_config_provider_manager_(
           createSingletonUdpSessionFilterConfigProviderManager(context.serverFactoryContext())),
-      random_generator_(context.serverFactoryContext().api().randomGenerator()) {
+      random_generator_(context.serverFactoryContext().api().randomGenerator()),
+      scope_(context.scope()) {
   if (use_per_packet_load_balancing_ && config.has_tunneling_config()) {
     throw EnvoyException(
         "Only one of use_per_packet_load_balancing or tunneling_config can be used.");
@@ -150,6 +151,14 @@ UdpProxyFilterConfigImpl::UdpProxyFilterConfigImpl(
     tunneling_config_ = std::make_unique<TunnelingConfigImpl>(config.tunneling_config(), context);
   }
 
+  if (config.has_upstream_packet_writer_config()) {
+    auto& factory_factory =
+        Config::Utility::getAndCheckFactory<Network::UdpPacketWriterFactoryFactory>(
+            config.upstream_packet_writer_config());
+    upstream_packet_writer_factory_ =
+        factory_factory.createUdpPacketWriterFactory(config.upstream_packet_writer_config());
+  }
+
   if (config.has_access_log_options()) {
     flush_access_log_on_tunnel_connected_ =
         config.access_log_options().flush_access_log_on_tunnel_connected();
@@ -157,6 +157,13 @@ public:
     return access_log_flush_interval_;
   }
   Random::RandomGenerator& randomGenerator() const override { return random_generator_; }
+  Network::UdpPacketWriterPtr
+  createUpstreamPacketWriter(Network::IoHandle& io_handle) const override {
+    if (upstream_packet_writer_factory_ == nullptr) {
+      return nullptr;
+    }
+    return upstream_packet_writer_factory_->createUdpPacketWriter(io_handle, scope_);
+  }
 
   // UdpSessionFilterChainFactory
   bool createFilterChain(Network::UdpSessionFilterChainFactoryCallbacks& callbacks) const override {
@@ -203,6 +210,8 @@ private:
       udp_session_filter_config_provider_manager_;
   UdpSessionFilterFactoriesList filter_factories_;
   Random::RandomGenerator& random_generator_;
+  Stats::Scope& scope_;
+  Network::UdpPacketWriterFactoryPtr upstream_packet_writer_factory_;
 };
 
 /**
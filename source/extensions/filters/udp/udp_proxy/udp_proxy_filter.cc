@@ -83,15 +83,22 @@ void UdpProxyFilter::onClusterRemoval(const std::string& cluster) {
 
 Network::FilterStatus StickySessionUdpProxyFilter::onDataInternal(Network::UdpRecvData& data) {
   bool defer_socket = config_->hasSessionFilters() || config_->tunnelingConfig();
-  const auto active_session_it = sessions_.find(data.addresses_);
-  ActiveSession* active_session;
-  if (active_session_it == sessions_.end()) {
+  ActiveSession* active_session = nullptr;
+  if (last_session_ != nullptr && last_session_->addresses() == data.addresses_) {
+    active_session = last_session_;
+  } else {
+    const auto active_session_it = sessions_.find(data.addresses_);
+    if (active_session_it != sessions_.end()) {
+      active_session = active_session_it->get();
+    }
+  }
+
+  if (active_session == nullptr) {
     active_session = createSession(std::move(data.addresses_), nullptr, defer_socket);
     if (active_session == nullptr) {
       return Network::FilterStatus::StopIteration;
     }
   } else {
-    active_session = active_session_it->get();
     // We defer the socket creation when the session includes filters, so the filters can be
     // iterated before choosing the host, to allow dynamically choosing upstream host. Due to this,
     // we can't perform health checks during a session.
@@ -119,6 +126,7 @@ Network::FilterStatus StickySessionUdpProxyFilter::onDataInternal(Network::UdpRe
     }
   }
 
+  last_session_ = active_session;
   active_session->onData(data);
 
   return Network::FilterStatus::StopIteration;
@@ -166,6 +174,15 @@ Network::FilterStatus UdpProxyFilter::onReceiveError(Api::IoError::IoErrorCode)
   return Network::FilterStatus::StopIteration;
 }
 
+void UdpProxyFilter::onReadComplete() {
+  in_read_event_ = false;
+  // Flushing does not add or remove sessions, so the set can be iterated directly.
+  for (UdpActiveSession* session : sessions_pending_flush_) {
+    session->flushUpstream();
+  }
+  sessions_pending_flush_.clear();
+}
+
 UdpProxyFilter::ClusterInfo*
 UdpProxyFilter::getClusterInfo(const Network::UdpRecvData::LocalPeerAddresses& addresses) {
   const std::string& route = config_->route(*addresses.local_, *addresses.peer_);
@@ -338,6 +355,13 @@ UdpProxyFilter::UdpActiveSession::UdpActiveSession(
     : ActiveSession(filter, std::move(addresses), std::move(host)),
       use_original_src_ip_(filter_.config_->usingOriginalSrcIp()) {}
 
+UdpProxyFilter::UdpActiveSession::~UdpActiveSession() {
+  // Send the datagrams buffered before the session was removed.
+  if (filter_.sessions_pending_flush_.erase(this) > 0) {
+    flushUpstream();
+  }
+}
+
 UdpProxyFilter::ActiveSession::~ActiveSession() {
   ENVOY_BUG(on_session_complete_called_, "onSessionComplete() not called");
 }
@@ -348,6 +372,9 @@ void UdpProxyFilter::ActiveSession::onSessionComplete() {
             host_ != nullptr ? host_->address()->asStringView() : "unknown");
 
   filter_.config_->stats().downstream_sess_active_.dec();
+  if (filter_.last_session_ == this) {
+    filter_.last_session_ = nullptr;
+  }
   if (cluster_connections_inc_) {
     cluster_->cluster_info_->resourceManager(Upstream::ResourcePriority::Default)
         .connections()
@@ -554,15 +581,44 @@ void UdpProxyFilter::UdpActiveSession::writeUpstream(Network::UdpRecvData& data)
             host_->address()->asStringView());
 
   const Network::Address::Ip* local_ip = use_original_src_ip_ ? addresses_.peer_->ip() : nullptr;
-  Api::IoCallUint64Result rc = Network::Utility::writeToSocket(
-      udp_socket_->ioHandle(), *data.buffer_, local_ip, *host_->address());
+  Api::IoCallUint64Result rc = Api::ioCallUint64ResultNoError();
+  if (upstream_writer_ != nullptr) {
+    // Packet writers take the datagram from a single slice.
+    data.buffer_->linearize(tx_buffer_length);
+    rc = upstream_writer_->writePacket(*data.buffer_, local_ip, *host_->address());
+  } else {
+    rc = Network::Utility::writeToSocket(udp_socket_->ioHandle(), *data.buffer_, local_ip,
+                                         *host_->address());
+  }
 
   if (!rc.ok()) {
     cluster_->cluster_stats_.sess_tx_errors_.inc();
+    if (upstream_writer_ != nullptr) {
+      // As with direct writes, the datagram is dropped and the next one is tried regardless.
+      upstream_writer_->setWritable();
+    }
   } else {
     cluster_->cluster_stats_.sess_tx_datagrams_.inc();
     cluster_->cluster_info_->trafficStats()->upstream_cx_tx_bytes_total_.add(tx_buffer_length);
   }
+
+  if (upstream_writer_ != nullptr && upstream_writer_->isBatchMode()) {
+    if (filter_.in_read_event_) {
+      filter_.sessions_pending_flush_.insert(this);
+    } else {
+      flushUpstream();
+    }
+  }
+}
+
+void UdpProxyFilter::UdpActiveSession::flushUpstream() {
+  ASSERT(upstream_writer_ != nullptr);
+  const Api::IoCallUint64Result rc = upstream_writer_->flush();
+  if (!rc.ok()) {
+    ENVOY_LOG(debug, "cannot flush upstream datagrams: {}", rc.err_->getErrorDetails());
+    cluster_->cluster_stats_.sess_tx_errors_.inc();
+    upstream_writer_->setWritable();
+  }
 }
 
 bool UdpProxyFilter::ActiveSession::onContinueFilterChain(ActiveReadFilter* filter) {
@@ -631,6 +687,7 @@ void UdpProxyFilter::UdpActiveSession::createUdpSocket(const Upstream::HostConst
   // NOTE: The socket call can only fail due to memory/fd exhaustion. No local ephemeral port
   //       is bound until the first packet is sent to the upstream host.
   udp_socket_ = filter_.createUdpSocket(host);
+  upstream_writer_ = filter_.config_->createUpstreamPacketWriter(udp_socket_->ioHandle());
   udp_socket_->ioHandle().initializeFileEvent(
       filter_.read_callbacks_->udpListener().dispatcher(),
       [this](uint32_t) {
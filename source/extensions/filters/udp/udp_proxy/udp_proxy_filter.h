@@ -9,6 +9,7 @@
 #include "envoy/extensions/filters/udp/udp_proxy/v3/udp_proxy.pb.h"
 #include "envoy/http/header_evaluator.h"
 #include "envoy/network/filter.h"
+#include "envoy/network/udp_packet_writer_handler.h"
 #include "envoy/stream_info/stream_info.h"
 #include "envoy/stream_info/uint32_accessor.h"
 #include "envoy/upstream/cluster_manager.h"
@@ -139,6 +140,12 @@ public:
   virtual bool flushAccessLogOnTunnelConnected() const PURE;
   virtual const absl::optional<std::chrono::milliseconds>& accessLogFlushInterval() const PURE;
   virtual Random::RandomGenerator& randomGenerator() const PURE;
+  /**
+   * @return the writer for datagrams sent to upstream hosts over the given socket, or nullptr if
+   *         datagrams should be written directly to the socket.
+   */
+  virtual Network::UdpPacketWriterPtr
+  createUpstreamPacketWriter(Network::IoHandle& io_handle) const PURE;
 };
 
 using UdpProxyFilterConfigSharedPtr = std::shared_ptr<const UdpProxyFilterConfig>;
@@ -498,6 +505,7 @@ class UdpProxyFilter : public Network::UdpListenerReadFilter,
 public:
   // Network::UdpListenerReadFilter
   Network::FilterStatus onData(Network::UdpRecvData& data) override {
+    in_read_event_ = true;
     if (udp_proxy_stats_) {
       udp_proxy_stats_.value().addBytesReceived(data.buffer_->length());
     }
@@ -506,10 +514,12 @@ public:
   }
 
   Network::FilterStatus onReceiveError(Api::IoError::IoErrorCode error_code) override;
+  void onReadComplete() override;
 
 protected:
   class ActiveSession;
   class ClusterInfo;
+  class UdpActiveSession;
 
   UdpProxyFilter(Network::UdpReadFilterCallbacks& callbacks,
                  const UdpProxyFilterConfigSharedPtr& config);
@@ -681,7 +691,7 @@ protected:
   public:
     UdpActiveSession(UdpProxyFilter& filter, Network::UdpRecvData::LocalPeerAddresses&& addresses,
                      const Upstream::HostConstSharedPtr& host);
-    ~UdpActiveSession() override = default;
+    ~UdpActiveSession() override;
 
     // ActiveSession
     bool shouldCreateUpstream() override;
@@ -689,6 +699,11 @@ protected:
     void writeUpstream(Network::UdpRecvData& data) override;
     void onIdleTimer() override;
 
+    /**
+     * Sends the datagrams buffered by a batching upstream packet writer.
+     */
+    void flushUpstream();
+
     // Network::UdpPacketProcessor
     void processPacket(Network::Address::InstanceConstSharedPtr local_address,
                        Network::Address::InstanceConstSharedPtr peer_address,
@@ -726,6 +741,9 @@ protected:
     // The socket has been connected to avoid port exhaustion.
     bool connected_{};
     const bool use_original_src_ip_;
+    // Writer for upstream datagrams, if one is configured. A batch mode writer buffers the
+    // datagrams of a downstream read event until flushUpstream() is called.
+    Network::UdpPacketWriterPtr upstream_writer_;
   };
 
   /**
@@ -894,7 +912,16 @@ protected:
                           HeterogeneousActiveSessionEqual>;
 
   const UdpProxyFilterConfigSharedPtr config_;
+  // Sessions with upstream datagrams buffered during the current downstream read event, which are
+  // flushed in onReadComplete().
+  absl::flat_hash_set<UdpActiveSession*> sessions_pending_flush_;
   SessionStorageType sessions_;
+  // The session of the last datagram received from downstream, to skip the session lookup for
+  // consecutive datagrams of a flow.
+  ActiveSession* last_session_{};
+  // Set while datagrams received from downstream are being processed, until the end of the read
+  // event. Upstream datagrams written outside of a read event are flushed immediately.
+  bool in_read_event_{};
 
 private:
   ActiveSession* createSessionWithOptionalHost(Network::UdpRecvData::LocalPeerAddresses&& addresses,
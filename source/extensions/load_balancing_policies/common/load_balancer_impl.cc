@@ -1,5 +1,6 @@
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
 
+#include <algorithm>
 #include <atomic>
 #include <bitset>
 #include <cstdint>
@@ -550,6 +551,15 @@ void ZoneAwareLoadBalancerBase::regenerateLocalityRoutingStructures() {
       state.residual_capacity_[i] = last_residual_capacity;
     }
   }
+
+  // An alias table samples a locality in constant time regardless of the number of localities.
+  state.residual_capacity_table_ = AliasTable();
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.lb_alias_table_weighted_random")) {
+    state.residual_capacity_table_ =
+        AliasTable(num_upstream_localities, [&state](size_t i) -> double {
+          return state.residual_capacity_[i] - (i > 0 ? state.residual_capacity_[i - 1] : 0);
+        });
+  }
 }
 
 void ZoneAwareLoadBalancerBase::resizePerPriorityState() {
@@ -714,6 +724,10 @@ uint32_t ZoneAwareLoadBalancerBase::tryChooseLocalLocalityHosts(const HostSet& h
     return random_.random() % number_of_localities;
   }
 
+  if (!state.residual_capacity_table_.empty()) {
+    return state.residual_capacity_table_.pick(random_.random());
+  }
+
   // Random sampling to select specific locality for cross locality traffic based on the
   // additional capacity in localities.
   uint64_t threshold = random_.random() % state.residual_capacity_[number_of_localities - 1];
@@ -845,6 +859,35 @@ const HostVector& ZoneAwareLoadBalancerBase::hostSourceToHosts(HostsSource hosts
   PANIC_DUE_TO_CORRUPT_ENUM;
 }
 
+void ZoneAwareLoadBalancerBase::forEachHostsSource(
+    uint32_t priority, const std::function<void(const HostsSource&, const HostVector&)>& cb) {
+  const auto& host_set = priority_set_.hostSetsPerPriority()[priority];
+  cb(HostsSource(priority, HostsSource::SourceType::AllHosts), host_set->hosts());
+  cb(HostsSource(priority, HostsSource::SourceType::HealthyHosts), host_set->healthyHosts());
+  cb(HostsSource(priority, HostsSource::SourceType::DegradedHosts), host_set->degradedHosts());
+  for (uint32_t locality_index = 0;
+       locality_index < host_set->healthyHostsPerLocality().get().size(); ++locality_index) {
+    cb(HostsSource(priority, HostsSource::SourceType::LocalityHealthyHosts, locality_index),
+       host_set->healthyHostsPerLocality().get()[locality_index]);
+  }
+  for (uint32_t locality_index = 0;
+       locality_index < host_set->degradedHostsPerLocality().get().size(); ++locality_index) {
+    cb(HostsSource(priority, HostsSource::SourceType::LocalityDegradedHosts, locality_index),
+       host_set->degradedHostsPerLocality().get()[locality_index]);
+  }
+}
+
+void ZoneAwareLoadBalancerBase::refreshAliasTable(HostsSourceAliasTables& alias_tables,
+                                                  const HostsSource& source,
+                                                  const HostVector& hosts) {
+  if (hostWeightsAreEqual(hosts)) {
+    alias_tables.erase(source);
+    return;
+  }
+  const auto host_weight = [&hosts](size_t i) -> double { return hosts[i]->weight(); };
+  alias_tables.insert_or_assign(source, AliasTable(hosts.size(), host_weight));
+}
+
 EdfLoadBalancerBase::EdfLoadBalancerBase(
     const PrioritySet& priority_set, const PrioritySet* local_priority_set, ClusterLbStats& stats,
     Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
@@ -869,12 +912,14 @@ EdfLoadBalancerBase::EdfLoadBalancerBase(
                                          : 0.1) {
   // We fully recompute the schedulers for a given host set here on membership change, which is
   // consistent with what other LB implementations do (e.g. thread aware).
-  // The downside of a full recompute is that time complexity is O(n * log n),
-  // so we will need to do better at delta tracking to scale (see
+  // The downside of a full recompute is that time complexity is O(n * log n), so updates that only
+  // add and remove hosts are applied to the existing schedulers when possible instead (see
   // https://github.com/envoyproxy/envoy/issues/2874).
   priority_update_cb_ = priority_set.addPriorityUpdateCb(
-      [this](uint32_t priority, const HostVector&, const HostVector&) {
-        refresh(priority);
+      [this](uint32_t priority, const HostVector& hosts_added, const HostVector& hosts_removed) {
+        if (!refreshDelta(priority, hosts_added, hosts_removed)) {
+          refresh(priority);
+        }
         return absl::OkStatus();
       });
   member_update_cb_ = priority_set.addMemberUpdateCb(
@@ -916,63 +961,191 @@ void EdfLoadBalancerBase::recalculateHostsInSlowStart(const HostVector& hosts) {
   }
 }
 
+void EdfLoadBalancerBase::rebuildHostsSource(const HostsSource& source, const HostVector& hosts) {
+  // Nuke existing scheduler if it exists.
+  auto& scheduler = scheduler_[source] = Scheduler{};
+  scheduler.hosts_ = hosts.size();
+  refreshHostSource(source);
+  if (isSlowStartEnabled()) {
+    recalculateHostsInSlowStart(hosts);
+  }
+
+  // Check if the original host weights are equal and no hosts are in slow start mode, in that
+  // case EDF creation is skipped. When all original weights are equal and no hosts are in slow
+  // start mode we can rely on unweighted host pick to do optimal round robin and least-loaded
+  // host selection with lower memory and CPU overhead. Load balancers that do their own weighted
+  // selection never use EDF.
+  if (!useEdfScheduler() || (hostWeightsAreEqual(hosts) && noHostsAreInSlowStart())) {
+    // Skip edf creation.
+    scheduler.weight_ = hosts.empty() ? 0 : hosts[0]->weight();
+    return;
+  }
+
+  // If there are no hosts or a single one, there is no need for an EDF scheduler
+  // (thus lowering memory and CPU overhead), as the (possibly) single host
+  // will be the one always selected by the scheduler.
+  if (hosts.size() <= 1) {
+    scheduler.weight_ = hosts.empty() ? 0 : hosts[0]->weight();
+    return;
+  }
+
+  // Populate the scheduler with the host list with a randomized starting point.
+  // TODO(mattklein123): We must build the EDF schedule even if all of the hosts are currently
+  // weighted 1. This is because currently we don't refresh host sets if only weights change.
+  // We should probably change this to refresh at all times. See the comment in
+  // BaseDynamicClusterImpl::updateDynamicHostList about this.
+  scheduler.edf_ = std::make_unique<EdfScheduler<Host>>(EdfScheduler<Host>::createWithPicks(
+      hosts,
+      // We use a fixed weight here. While the weight may change without
+      // notification, this will only be stale until this host is next picked,
+      // at which point it is reinserted into the EdfScheduler with its new
+      // weight in chooseHost().
+      [this](const Host& host) { return hostWeight(host); }, seed_));
+}
+
 void EdfLoadBalancerBase::refresh(uint32_t priority) {
-  const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts) {
-    // Nuke existing scheduler if it exists.
-    auto& scheduler = scheduler_[source] = Scheduler{};
-    refreshHostSource(source);
-    if (isSlowStartEnabled()) {
-      recalculateHostsInSlowStart(hosts);
-    }
+  // Populate EdfSchedulers for each valid HostsSource value for the host set at this priority.
+  forEachHostsSource(priority, [this](const HostsSource& source, const HostVector& hosts) {
+    rebuildHostsSource(source, hosts);
+  });
+  if (localities_per_priority_.size() <= priority) {
+    localities_per_priority_.resize(priority + 1);
+  }
+  localities_per_priority_[priority] =
+      priority_set_.hostSetsPerPriority()[priority]->hostsPerLocality().get().size();
+}
 
-    // Check if the original host weights are equal and no hosts are in slow start mode, in that
-    // case EDF creation is skipped. When all original weights are equal and no hosts are in slow
-    // start mode we can rely on unweighted host pick to do optimal round robin and least-loaded
-    // host selection with lower memory and CPU overhead.
-    if (hostWeightsAreEqual(hosts) && noHostsAreInSlowStart()) {
-      // Skip edf creation.
-      return;
-    }
+bool EdfLoadBalancerBase::refreshDelta(uint32_t priority, const HostVector& hosts_added,
+                                       const HostVector& hosts_removed) {
+  const HostSet& host_set = *priority_set_.hostSetsPerPriority()[priority];
+  // Slow start weights depend on the time hosts were added, so those schedulers are always
+  // rebuilt.
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.edf_lb_host_set_delta_updates") ||
+      !host_set.membershipUpdateOnly() || isSlowStartEnabled() ||
+      localities_per_priority_.size() <= priority) {
+    return false;
+  }
 
-    // If there are no hosts or a single one, there is no need for an EDF scheduler
-    // (thus lowering memory and CPU overhead), as the (possibly) single host
-    // will be the one always selected by the scheduler.
-    if (hosts.size() <= 1) {
-      return;
+  // The delta must account for the change in the number of hosts since the last refresh. Initial
+  // builds use the full refresh, which randomizes the starting point of the schedulers.
+  const auto all_hosts = scheduler_.find(HostsSource(priority, HostsSource::SourceType::AllHosts));
+  if (all_hosts == scheduler_.end() || all_hosts->second.hosts_ == 0 ||
+      all_hosts->second.hosts_ + hosts_added.size() !=
+          host_set.hosts().size() + hosts_removed.size()) {
+    return false;
+  }
+
+  // Locality host sources are indexed by position, so the localities must not have changed and
+  // every host added or removed must belong to one of them.
+  const auto& hosts_per_locality = host_set.hostsPerLocality().get();
+  if (hosts_per_locality.size() != localities_per_priority_[priority] ||
+      host_set.healthyHostsPerLocality().get().size() != hosts_per_locality.size() ||
+      host_set.degradedHostsPerLocality().get().size() != hosts_per_locality.size()) {
+    return false;
+  }
+  const auto locality_indices = [&hosts_per_locality](const HostVector& hosts,
+                                                      std::vector<uint32_t>& indices) {
+    indices.reserve(hosts.size());
+    for (const auto& host : hosts) {
+      const auto it = std::find_if(hosts_per_locality.begin(), hosts_per_locality.end(),
+                                   [&host](const HostVector& locality_hosts) {
+                                     return !locality_hosts.empty() &&
+                                            LocalityEqualTo()(locality_hosts.front()->locality(),
+                                                              host->locality());
+                                   });
+      if (it == hosts_per_locality.end()) {
+        return false;
+      }
+      indices.push_back(it - hosts_per_locality.begin());
     }
+    return true;
+  };
+  std::vector<uint32_t> added_localities;
+  std::vector<uint32_t> removed_localities;
+  if (!hosts_per_locality.empty() && (!locality_indices(hosts_added, added_localities) ||
+                                      !locality_indices(hosts_removed, removed_localities))) {
+    return false;
+  }
 
-    // Populate the scheduler with the host list with a randomized starting point.
-    // TODO(mattklein123): We must build the EDF schedule even if all of the hosts are currently
-    // weighted 1. This is because currently we don't refresh host sets if only weights change.
-    // We should probably change this to refresh at all times. See the comment in
-    // BaseDynamicClusterImpl::updateDynamicHostList about this.
-    scheduler.edf_ = std::make_unique<EdfScheduler<Host>>(EdfScheduler<Host>::createWithPicks(
-        hosts,
-        // We use a fixed weight here. While the weight may change without
-        // notification, this will only be stale until this host is next picked,
-        // at which point it is reinserted into the EdfScheduler with its new
-        // weight in chooseHost().
-        [this](const Host& host) { return hostWeight(host); }, seed_));
+  const auto filter_hosts = [&hosts_per_locality](const HostsSource& source,
+                                                  const HostVector& hosts,
+                                                  const std::vector<uint32_t>& localities) {
+    HostVector filtered;
+    for (size_t i = 0; i < hosts.size(); ++i) {
+      const Host::Health health = hosts[i]->coarseHealth();
+      bool in_source = false;
+      switch (source.source_type_) {
+      case HostsSource::SourceType::AllHosts:
+        in_source = true;
+        break;
+      case HostsSource::SourceType::HealthyHosts:
+        in_source = health == Host::Health::Healthy;
+        break;
+      case HostsSource::SourceType::DegradedHosts:
+        in_source = health == Host::Health::Degraded;
+        break;
+      case HostsSource::SourceType::LocalityHealthyHosts:
+        in_source = health == Host::Health::Healthy && !hosts_per_locality.empty() &&
+                    localities[i] == source.locality_index_;
+        break;
+      case HostsSource::SourceType::LocalityDegradedHosts:
+        in_source = health == Host::Health::Degraded && !hosts_per_locality.empty() &&
+                    localities[i] == source.locality_index_;
+        break;
+      }
+      if (in_source) {
+        filtered.push_back(hosts[i]);
+      }
+    }
+    return filtered;
   };
-  // Populate EdfSchedulers for each valid HostsSource value for the host set at this priority.
-  const auto& host_set = priority_set_.hostSetsPerPriority()[priority];
-  add_hosts_source(HostsSource(priority, HostsSource::SourceType::AllHosts), host_set->hosts());
-  add_hosts_source(HostsSource(priority, HostsSource::SourceType::HealthyHosts),
-                   host_set->healthyHosts());
-  add_hosts_source(HostsSource(priority, HostsSource::SourceType::DegradedHosts),
-                   host_set->degradedHosts());
-  for (uint32_t locality_index = 0;
-       locality_index < host_set->healthyHostsPerLocality().get().size(); ++locality_index) {
-    add_hosts_source(
-        HostsSource(priority, HostsSource::SourceType::LocalityHealthyHosts, locality_index),
-        host_set->healthyHostsPerLocality().get()[locality_index]);
+  forEachHostsSource(priority, [&](const HostsSource& source, const HostVector& hosts) {
+    applyHostsSourceDelta(source, hosts, filter_hosts(source, hosts_added, added_localities),
+                          filter_hosts(source, hosts_removed, removed_localities));
+  });
+  return true;
+}
+
+void EdfLoadBalancerBase::applyHostsSourceDelta(const HostsSource& source, const HostVector& hosts,
+                                                const HostVector& hosts_added,
+                                                const HostVector& hosts_removed) {
+  auto& scheduler = scheduler_[source];
+  // A source whose size does not match the delta, e.g. because the health of a host changed while
+  // the update was in flight, is rebuilt.
+  if (scheduler.hosts_ + hosts_added.size() != hosts.size() + hosts_removed.size()) {
+    rebuildHostsSource(source, hosts);
+    return;
   }
-  for (uint32_t locality_index = 0;
-       locality_index < host_set->degradedHostsPerLocality().get().size(); ++locality_index) {
-    add_hosts_source(
-        HostsSource(priority, HostsSource::SourceType::LocalityDegradedHosts, locality_index),
-        host_set->degradedHostsPerLocality().get()[locality_index]);
+  if (hosts_added.empty() && hosts_removed.empty()) {
+    return;
+  }
+
+  if (scheduler.edf_ != nullptr) {
+    refreshHostSource(source);
+    scheduler.hosts_ = hosts.size();
+    for (const auto& host : hosts_removed) {
+      scheduler.edf_->remove(host);
+    }
+    for (const auto& host : hosts_added) {
+      scheduler.edf_->add(hostWeight(*host), host);
+    }
+    return;
+  }
+
+  // Unweighted picks use the hosts of the source directly, so all that is needed is to check that
+  // the weights of the hosts are still equal.
+  uint32_t weight = scheduler.hosts_ == hosts_removed.size() ? 0 : scheduler.weight_;
+  for (const auto& host : hosts_added) {
+    if (weight == 0) {
+      weight = host->weight();
+    } else if (host->weight() != weight) {
+      rebuildHostsSource(source, hosts);
+      return;
+    }
   }
+  refreshHostSource(source);
+  scheduler.hosts_ = hosts.size();
+  scheduler.weight_ = weight;
 }
 
 bool EdfLoadBalancerBase::isSlowStartEnabled() const {
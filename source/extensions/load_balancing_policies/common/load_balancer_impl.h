@@ -3,6 +3,7 @@
 #include <bitset>
 #include <cmath>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <queue>
 #include <set>
@@ -21,6 +22,7 @@
 
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_protos.h"
+#include "source/common/upstream/alias_table.h"
 #include "source/common/upstream/edf_scheduler.h"
 #include "source/common/upstream/load_balancer_context_base.h"
 
@@ -354,6 +356,17 @@ protected:
    */
   const HostVector& hostSourceToHosts(HostsSource hosts_source) const;
 
+  // Invokes the callback with each HostsSource of the priority and the hosts that make it up.
+  void forEachHostsSource(uint32_t priority,
+                          const std::function<void(const HostsSource&, const HostVector&)>& cb);
+
+  using HostsSourceAliasTables = absl::flat_hash_map<HostsSource, AliasTable, HostsSourceHash>;
+
+  // Builds the alias table of the source from the weights of its hosts. Sources whose hosts all
+  // have the same weight are sampled uniformly and have their table removed instead.
+  static void refreshAliasTable(HostsSourceAliasTables& alias_tables, const HostsSource& source,
+                                const HostVector& hosts);
+
 private:
   enum class LocalityRoutingState {
     // Locality based routing is off.
@@ -447,6 +460,9 @@ private:
     // for each of the non-local localities to determine what traffic should be
     // routed where.
     std::vector<uint64_t> residual_capacity_;
+    // Alias table over the residual capacity of each locality, used instead of scanning
+    // residual_capacity_ when envoy.reloadable_features.lb_alias_table_weighted_random is enabled.
+    AliasTable residual_capacity_table_;
   };
   using PerPriorityStatePtr = std::unique_ptr<PerPriorityState>;
   // Routing state broken out for each priority level in priority_set_.
@@ -505,12 +521,26 @@ protected:
     // host weights of 2 or more hosts differ. When not present, the
     // implementation of chooseHostOnce falls back to unweightedHostPick.
     std::unique_ptr<EdfScheduler<Host>> edf_;
+    // Number of hosts in the source the last time the scheduler was refreshed.
+    size_t hosts_{};
+    // The weight shared by all the hosts of the source when edf_ is not present, or 0 if the source
+    // has no hosts. For load balancers that do not use EDF, the weight of the first host.
+    uint32_t weight_{};
   };
 
   void initialize();
 
   virtual void refresh(uint32_t priority);
 
+  /**
+   * Applies the hosts added to and removed from a priority to the existing schedulers of that
+   * priority, rebuilding only the schedulers of the host sources the delta cannot be applied to.
+   * @return false if the update is not a membership-only update that maps onto the host sources
+   *         of the priority, in which case refresh() must be used instead.
+   */
+  virtual bool refreshDelta(uint32_t priority, const HostVector& hosts_added,
+                            const HostVector& hosts_removed);
+
   bool isSlowStartEnabled() const;
   bool noHostsAreInSlowStart() const;
 
@@ -533,9 +563,19 @@ private:
                                                 const HostsSource& source) PURE;
   virtual HostConstSharedPtr unweightedHostPick(const HostVector& hosts_to_use,
                                                 const HostsSource& source) PURE;
+  // Whether host sources whose hosts have different weights are served from an EDF scheduler.
+  // Load balancers that return false handle such sources in unweightedHostPeek() and
+  // unweightedHostPick() themselves.
+  virtual bool useEdfScheduler() const { return true; }
+
+  void rebuildHostsSource(const HostsSource& source, const HostVector& hosts);
+  void applyHostsSourceDelta(const HostsSource& source, const HostVector& hosts,
+                             const HostVector& hosts_added, const HostVector& hosts_removed);
 
   // Scheduler for each valid HostsSource.
   absl::flat_hash_map<HostsSource, Scheduler, HostsSourceHash> scheduler_;
+  // Number of localities of each priority the schedulers were last refreshed for.
+  std::vector<size_t> localities_per_priority_;
   Common::CallbackHandlePtr priority_update_cb_;
   Common::CallbackHandlePtr member_update_cb_;
 
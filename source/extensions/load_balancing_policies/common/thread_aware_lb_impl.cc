@@ -1,8 +1,11 @@
 #include "source/extensions/load_balancing_policies/common/thread_aware_lb_impl.h"
 
+#include <chrono>
 #include <memory>
 #include <random>
 
+#include "source/common/runtime/runtime_features.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -93,8 +96,22 @@ absl::Status normalizeWeights(const HostSet& host_set, bool in_panic,
   return absl::OkStatus();
 }
 
+std::vector<MetadataConstSharedPtr>
+hostMetadata(const NormalizedHostWeightVector& normalized_host_weights) {
+  std::vector<MetadataConstSharedPtr> host_metadata;
+  host_metadata.reserve(normalized_host_weights.size());
+  for (const auto& host_weight : normalized_host_weights) {
+    host_metadata.push_back(host_weight.first->metadata());
+  }
+  return host_metadata;
+}
+
 } // namespace
 
+ThreadAwareLoadBalancerStats ThreadAwareLoadBalancerBase::generateTableStats(Stats::Scope& scope) {
+  return {ALL_THREAD_AWARE_LOAD_BALANCER_STATS(POOL_COUNTER(scope), POOL_HISTOGRAM(scope))};
+}
+
 absl::Status ThreadAwareLoadBalancerBase::initialize() {
   // TODO(mattklein123): In the future, once initialized and the initial LB is built, it would be
   // better to use a background thread for computing LB updates. This has the substantial benefit
@@ -115,6 +132,9 @@ absl::Status ThreadAwareLoadBalancerBase::refresh() {
       std::make_shared<HealthyLoad>(per_priority_load_.healthy_priority_load_);
   auto degraded_per_priority_load =
       std::make_shared<DegradedLoad>(per_priority_load_.degraded_priority_load_);
+  const bool skip_unchanged_tables = Runtime::runtimeFeatureEnabled(
+      "envoy.reloadable_features.thread_aware_lb_skip_unchanged_table_builds");
+  per_priority_tables_.resize(priority_set_.hostSetsPerPriority().size());
 
   for (const auto& host_set : priority_set_.hostSetsPerPriority()) {
     const uint32_t priority = host_set->priority();
@@ -132,8 +152,37 @@ absl::Status ThreadAwareLoadBalancerBase::refresh() {
                                            normalized_host_weights, min_normalized_weight,
                                            max_normalized_weight, locality_weighted_balancing_);
     RETURN_IF_NOT_OK(status);
+
+    // Host set updates are delivered for one priority at a time but every priority is refreshed,
+    // and health or metadata changes frequently leave the hashed hosts of a priority unchanged.
+    // Rebuilding a table from the same inputs yields the same table, so keep the old one.
+    PerPriorityTable& table = per_priority_tables_[priority];
+    std::vector<MetadataConstSharedPtr> host_metadata;
+    if (skip_unchanged_tables) {
+      host_metadata = hostMetadata(normalized_host_weights);
+      if (table.lb_ != nullptr && table.normalized_host_weights_ == normalized_host_weights &&
+          table.host_metadata_ == host_metadata) {
+        per_priority_state->current_lb_ = table.lb_;
+        table_stats_.table_builds_skipped_.inc();
+        continue;
+      }
+    }
+
+    const MonotonicTime build_start = time_source_.monotonicTime();
     per_priority_state->current_lb_ = createLoadBalancer(
-        std::move(normalized_host_weights), min_normalized_weight, max_normalized_weight);
+        normalized_host_weights, min_normalized_weight, max_normalized_weight);
+    const auto build_time = std::chrono::duration_cast<std::chrono::microseconds>(
+        time_source_.monotonicTime() - build_start);
+    table_stats_.table_builds_.inc();
+    table_stats_.table_build_time_us_.recordValue(build_time.count());
+
+    if (skip_unchanged_tables) {
+      table.normalized_host_weights_ = std::move(normalized_host_weights);
+      table.host_metadata_ = std::move(host_metadata);
+      table.lb_ = per_priority_state->current_lb_;
+    } else {
+      table = {};
+    }
   }
 
   {
@@ -259,11 +308,15 @@ ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost(uint64_t
   // When a host is overloaded, we choose the next host in a random manner rather than picking the
   // next one in the ring. The random sequence is seeded by the hash, so the same input gets the
   // same sequence of hosts all the time.
+  // The sequence is a Fisher-Yates shuffle of the host indices which only records the positions
+  // it has swapped, so that a hot key which finds an eligible host after a few probes does not pay
+  // for a permutation of the whole host set.
   const uint32_t num_hosts = normalized_host_weights_.size();
-  auto host_index = std::vector<uint32_t>(num_hosts);
-  for (uint32_t i = 0; i < num_hosts; i++) {
-    host_index[i] = i;
-  }
+  absl::flat_hash_map<uint32_t, uint32_t> swapped_host_index;
+  const auto host_index = [&swapped_host_index](uint32_t i) -> uint32_t {
+    const auto it = swapped_host_index.find(i);
+    return it == swapped_host_index.end() ? i : it->second;
+  };
 
   // Not using Random::RandomGenerator as it does not take a seed. Seeded RNG is a requirement
   // here as we need the same shuffle sequence for the same hash every time.
@@ -286,9 +339,10 @@ ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost(uint64_t
   for (uint32_t i = 0; i < num_hosts; i++) {
     // The random shuffle algorithm
     const uint32_t j = uniform_int(random, num_hosts - i);
-    std::swap(host_index[i], host_index[i + j]);
+    const uint32_t k = host_index(i + j);
+    // Position i is never read again, so only position i + j needs to record the swap.
+    swapped_host_index[i + j] = host_index(i);
 
-    const uint32_t k = host_index[i];
     alt_host = normalized_host_weights_[k].first;
     if (alt_host == host) {
       continue;
@@ -3,13 +3,17 @@
 #include <bitset>
 
 #include "envoy/common/callback.h"
+#include "envoy/common/time.h"
 #include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "source/common/common/logger.h"
 #include "source/common/config/metadata.h"
 #include "source/common/config/well_known_names.h"
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 
@@ -17,7 +21,23 @@ namespace Envoy {
 namespace Upstream {
 
 using NormalizedHostWeightVector = std::vector<std::pair<HostConstSharedPtr, double>>;
-using NormalizedHostWeightMap = std::map<HostConstSharedPtr, double>;
+using NormalizedHostWeightMap = absl::flat_hash_map<HostConstSharedPtr, double>;
+
+/**
+ * All stats for building the per-priority tables of thread aware load balancers. They are rooted
+ * at the scope of the concrete load balancer. @see stats_macros.h
+ */
+#define ALL_THREAD_AWARE_LOAD_BALANCER_STATS(COUNTER, HISTOGRAM)                                   \
+  COUNTER(table_builds)                                                                            \
+  COUNTER(table_builds_skipped)                                                                    \
+  HISTOGRAM(table_build_time_us, Microseconds)
+
+/**
+ * Struct definition for all thread aware load balancer stats. @see stats_macros.h
+ */
+struct ThreadAwareLoadBalancerStats {
+  ALL_THREAD_AWARE_LOAD_BALANCER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
+};
 
 class ThreadAwareLoadBalancerBase : public LoadBalancerBase, public ThreadAwareLoadBalancer {
 public:
@@ -77,6 +97,7 @@ public:
     const NormalizedHostWeightMap
     initNormalizedHostWeightMap(const NormalizedHostWeightVector& normalized_host_weights) {
       NormalizedHostWeightMap normalized_host_weights_map;
+      normalized_host_weights_map.reserve(normalized_host_weights.size());
       for (auto const& item : normalized_host_weights) {
         normalized_host_weights_map[item.first] = item.second;
       }
@@ -109,10 +130,17 @@ public:
 protected:
   ThreadAwareLoadBalancerBase(const PrioritySet& priority_set, ClusterLbStats& stats,
                               Runtime::Loader& runtime, Random::RandomGenerator& random,
-                              uint32_t healthy_panic_threshold, bool locality_weighted_balancing)
+                              uint32_t healthy_panic_threshold, bool locality_weighted_balancing,
+                              Stats::ScopeSharedPtr scope, TimeSource& time_source)
       : LoadBalancerBase(priority_set, stats, runtime, random, healthy_panic_threshold),
-        factory_(new LoadBalancerFactoryImpl(stats, random)),
-        locality_weighted_balancing_(locality_weighted_balancing) {}
+        scope_(std::move(scope)), factory_(new LoadBalancerFactoryImpl(stats, random)),
+        locality_weighted_balancing_(locality_weighted_balancing),
+        table_stats_(generateTableStats(*scope_)), time_source_(time_source) {}
+
+  static ThreadAwareLoadBalancerStats generateTableStats(Stats::Scope& scope);
+
+  // Scope of the concrete load balancer's stats.
+  const Stats::ScopeSharedPtr scope_;
 
 private:
   struct PerPriorityState {
@@ -121,6 +149,15 @@ private:
   };
   using PerPriorityStatePtr = std::unique_ptr<PerPriorityState>;
 
+  // Inputs of the last table built for a priority. The table is a pure function of the normalized
+  // host weights and of each host's hash key, which may come from its metadata, so a priority whose
+  // inputs are unchanged keeps its previous table instead of building an identical one.
+  struct PerPriorityTable {
+    NormalizedHostWeightVector normalized_host_weights_;
+    std::vector<MetadataConstSharedPtr> host_metadata_;
+    HashingLoadBalancerSharedPtr lb_;
+  };
+
   struct LoadBalancerImpl : public LoadBalancer {
     LoadBalancerImpl(ClusterLbStats& stats, Random::RandomGenerator& random)
         : stats_(stats), random_(random) {}
@@ -170,6 +207,9 @@ private:
 
   std::shared_ptr<LoadBalancerFactoryImpl> factory_;
   const bool locality_weighted_balancing_{};
+  ThreadAwareLoadBalancerStats table_stats_;
+  TimeSource& time_source_;
+  std::vector<PerPriorityTable> per_priority_tables_;
   Common::CallbackHandlePtr priority_update_cb_;
 };
 
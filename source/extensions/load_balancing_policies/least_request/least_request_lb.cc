@@ -3,6 +3,15 @@
 namespace Envoy {
 namespace Upstream {
 
+void LeastRequestLoadBalancer::refreshHostSource(const HostsSource& source) {
+  if (selection_method_ !=
+      envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::
+          WEIGHTED_N_CHOICES) {
+    return;
+  }
+  refreshAliasTable(alias_tables_, source, hostSourceToHosts(source));
+}
+
 double LeastRequestLoadBalancer::hostWeight(const Host& host) const {
   // This method is called to calculate the dynamic weight as following when all load balancing
   // weights are not equal:
@@ -55,7 +64,7 @@ HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPeek(const HostVector
 }
 
 HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPick(const HostVector& hosts_to_use,
-                                                                const HostsSource&) {
+                                                                const HostsSource& source) {
   HostSharedPtr candidate_host = nullptr;
 
   switch (selection_method_) {
@@ -65,6 +74,10 @@ HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPick(const HostVector
   case envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::N_CHOICES:
     candidate_host = unweightedHostPickNChoices(hosts_to_use);
     break;
+  case envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::
+      WEIGHTED_N_CHOICES:
+    candidate_host = weightedHostPickNChoices(hosts_to_use, source);
+    break;
   default:
     IS_ENVOY_BUG("unknown selection method specified for least request load balancer");
   }
@@ -140,5 +153,37 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickNChoices(const HostVec
   return candidate_host;
 }
 
+HostSharedPtr LeastRequestLoadBalancer::weightedHostPickNChoices(const HostVector& hosts_to_use,
+                                                                 const HostsSource& source) {
+  const auto alias_table_it = alias_tables_.find(source);
+  if (alias_table_it == alias_tables_.end()) {
+    return unweightedHostPickNChoices(hosts_to_use);
+  }
+  const AliasTable& alias_table = alias_table_it->second;
+  ASSERT(alias_table.size() == hosts_to_use.size());
+
+  // The samples are compared by their active requests per unit of weight, i.e. the candidate is
+  // replaced when sampled_active_rq / sampled_weight < candidate_active_rq / candidate_weight. The
+  // comparison is cross multiplied to stay exact. On a tie the first sample is kept, so that idle
+  // hosts are picked in proportion to their weights.
+  uint32_t candidate_index = 0;
+  uint64_t candidate_active_rq = 0;
+  uint64_t candidate_weight = 0;
+  for (uint32_t choice_idx = 0; choice_idx < choice_count_; ++choice_idx) {
+    const uint32_t index = alias_table.pick(random_.random());
+    const Host& sampled_host = *hosts_to_use[index];
+    const uint64_t sampled_active_rq = sampled_host.stats().rq_active_.value();
+    const uint64_t sampled_weight = sampled_host.weight();
+    if (choice_idx == 0 ||
+        sampled_active_rq * candidate_weight < candidate_active_rq * sampled_weight) {
+      candidate_index = index;
+      candidate_active_rq = sampled_active_rq;
+      candidate_weight = sampled_weight;
+    }
+  }
+
+  return hosts_to_use[candidate_index];
+}
+
 } // namespace Upstream
 } // namespace Envoy
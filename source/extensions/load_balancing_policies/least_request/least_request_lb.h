@@ -1,7 +1,10 @@
 #pragma once
 
+#include "source/common/upstream/alias_table.h"
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -21,6 +24,10 @@ namespace Upstream {
  * 2) Use a weighted Maglev table, and perform P2C on two random hosts selected from the table.
  *    The benefit of the Maglev table is at the expense of resolution, memory usage is capped.
  *    Additionally, the Maglev table can be shared amongst all threads.
+ *
+ * The WEIGHTED_N_CHOICES selection method replaces the EDF schedule with P2C over hosts sampled in
+ * proportion to their weights from an alias table, comparing the sampled hosts by their active
+ * requests only.
  */
 class LeastRequestLoadBalancer : public EdfLoadBalancerBase {
 public:
@@ -46,6 +53,18 @@ public:
 
 protected:
   void refresh(uint32_t priority) override {
+    refreshActiveRequestBias();
+    EdfLoadBalancerBase::refresh(priority);
+  }
+
+  bool refreshDelta(uint32_t priority, const HostVector& hosts_added,
+                    const HostVector& hosts_removed) override {
+    refreshActiveRequestBias();
+    return EdfLoadBalancerBase::refreshDelta(priority, hosts_added, hosts_removed);
+  }
+
+private:
+  void refreshActiveRequestBias() {
     active_request_bias_ = active_request_bias_runtime_ != absl::nullopt
                                ? active_request_bias_runtime_.value().value()
                                : 1.0;
@@ -56,19 +75,23 @@ protected:
                      active_request_bias_runtime_->runtimeKey());
       active_request_bias_ = 1.0;
     }
-
-    EdfLoadBalancerBase::refresh(priority);
   }
 
-private:
-  void refreshHostSource(const HostsSource&) override {}
+  void refreshHostSource(const HostsSource& source) override;
   double hostWeight(const Host& host) const override;
   HostConstSharedPtr unweightedHostPeek(const HostVector& hosts_to_use,
                                         const HostsSource& source) override;
   HostConstSharedPtr unweightedHostPick(const HostVector& hosts_to_use,
                                         const HostsSource& source) override;
+  bool useEdfScheduler() const override {
+    return selection_method_ !=
+           envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::
+               WEIGHTED_N_CHOICES;
+  }
   HostSharedPtr unweightedHostPickFullScan(const HostVector& hosts_to_use);
   HostSharedPtr unweightedHostPickNChoices(const HostVector& hosts_to_use);
+  HostSharedPtr weightedHostPickNChoices(const HostVector& hosts_to_use,
+                                         const HostsSource& source);
 
   const uint32_t choice_count_;
 
@@ -80,6 +103,10 @@ private:
   const absl::optional<Runtime::Double> active_request_bias_runtime_;
   const envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::SelectionMethod
       selection_method_{};
+
+  // Alias tables of the host sources whose hosts have different weights, for the
+  // WEIGHTED_N_CHOICES selection method. They are rebuilt in refreshHostSource().
+  HostsSourceAliasTables alias_tables_;
 };
 
 } // namespace Upstream
@@ -295,10 +295,12 @@ uint64_t MaglevTable::permutation(const TableBuildEntry& entry) {
 MaglevLoadBalancer::MaglevLoadBalancer(
     const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
     Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
-    const envoy::extensions::load_balancing_policies::maglev::v3::Maglev& config)
+    const envoy::extensions::load_balancing_policies::maglev::v3::Maglev& config,
+    TimeSource& time_source)
     : ThreadAwareLoadBalancerBase(priority_set, stats, runtime, random, healthy_panic_threshold,
-                                  config.has_locality_weighted_lb_config()),
-      scope_(scope.createScope("maglev_lb.")), stats_(generateStats(*scope_)),
+                                  config.has_locality_weighted_lb_config(),
+                                  scope.createScope("maglev_lb."), time_source),
+      stats_(generateStats(*scope_)),
       table_size_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, table_size, MaglevTable::DefaultTableSize)),
       use_hostname_for_hashing_(
@@ -1,8 +1,22 @@
 #include "source/extensions/load_balancing_policies/random/random_lb.h"
 
+#include "source/common/runtime/runtime_features.h"
+
 namespace Envoy {
 namespace Upstream {
 
+void RandomLoadBalancer::refresh(uint32_t priority) {
+  absl::erase_if(alias_tables_,
+                 [priority](const auto& entry) { return entry.first.priority_ == priority; });
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.lb_alias_table_weighted_random")) {
+    return;
+  }
+
+  forEachHostsSource(priority, [this](const HostsSource& source, const HostVector& hosts) {
+    refreshAliasTable(alias_tables_, source, hosts);
+  });
+}
+
 HostConstSharedPtr RandomLoadBalancer::peekAnotherHost(LoadBalancerContext* context) {
   if (tooManyPreconnects(stashed_random_.size(), total_healthy_hosts_)) {
     return nullptr;
@@ -26,6 +40,12 @@ HostConstSharedPtr RandomLoadBalancer::peekOrChoose(LoadBalancerContext* context
     return nullptr;
   }
 
+  const auto alias_table_it = alias_tables_.find(*hosts_source);
+  if (alias_table_it != alias_tables_.end()) {
+    ASSERT(alias_table_it->second.size() == hosts_to_use.size());
+    return hosts_to_use[alias_table_it->second.pick(random_hash)];
+  }
+
   return hosts_to_use[random_hash % hosts_to_use.size()];
 }
 
@@ -1,12 +1,18 @@
 #pragma once
 
+#include "source/common/upstream/alias_table.h"
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
 /**
- * Random load balancer that picks a random host out of all hosts.
+ * Random load balancer that picks a random host out of all hosts. When
+ * envoy.reloadable_features.lb_alias_table_weighted_random is enabled and the hosts have different
+ * weights, hosts are picked in proportion to their weights from an alias table that is rebuilt on
+ * each host set update, so a pick still takes constant time.
  */
 class RandomLoadBalancer : public ZoneAwareLoadBalancerBase {
 public:
@@ -16,7 +22,16 @@ public:
       const envoy::extensions::load_balancing_policies::random::v3::Random& random_config)
       : ZoneAwareLoadBalancerBase(
             priority_set, local_priority_set, stats, runtime, random, healthy_panic_threshold,
-            LoadBalancerConfigHelper::localityLbConfigFromProto(random_config)) {}
+            LoadBalancerConfigHelper::localityLbConfigFromProto(random_config)) {
+    priority_update_cb_ = priority_set.addPriorityUpdateCb(
+        [this](uint32_t priority, const HostVector&, const HostVector&) {
+          refresh(priority);
+          return absl::OkStatus();
+        });
+    for (uint32_t priority = 0; priority < priority_set.hostSetsPerPriority().size(); ++priority) {
+      refresh(priority);
+    }
+  }
 
   // Upstream::ZoneAwareLoadBalancerBase
   HostConstSharedPtr chooseHostOnce(LoadBalancerContext* context) override;
@@ -24,6 +39,13 @@ public:
 
 protected:
   HostConstSharedPtr peekOrChoose(LoadBalancerContext* context, bool peek);
+
+private:
+  void refresh(uint32_t priority);
+
+  Common::CallbackHandlePtr priority_update_cb_;
+  // Alias tables of the host sources whose hosts have different weights.
+  HostsSourceAliasTables alias_tables_;
 };
 
 } // namespace Upstream
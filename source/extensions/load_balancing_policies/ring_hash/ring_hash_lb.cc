@@ -40,10 +40,12 @@ TypedRingHashLbConfig::TypedRingHashLbConfig(const RingHashLbProto& lb_config)
 RingHashLoadBalancer::RingHashLoadBalancer(
     const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
     Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
-    const envoy::extensions::load_balancing_policies::ring_hash::v3::RingHash& config)
+    const envoy::extensions::load_balancing_policies::ring_hash::v3::RingHash& config,
+    TimeSource& time_source)
     : ThreadAwareLoadBalancerBase(priority_set, stats, runtime, random, healthy_panic_threshold,
-                                  config.has_locality_weighted_lb_config()),
-      scope_(scope.createScope("ring_hash_lb.")), stats_(generateStats(*scope_)),
+                                  config.has_locality_weighted_lb_config(),
+                                  scope.createScope("ring_hash_lb."), time_source),
+      stats_(generateStats(*scope_)),
       min_ring_size_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, minimum_ring_size, DefaultMinRingSize)),
       max_ring_size_(
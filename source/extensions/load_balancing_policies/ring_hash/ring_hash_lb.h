@@ -63,7 +63,8 @@ public:
   RingHashLoadBalancer(
       const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
       Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
-      const envoy::extensions::load_balancing_policies::ring_hash::v3::RingHash& config);
+      const envoy::extensions::load_balancing_policies::ring_hash::v3::RingHash& config,
+      TimeSource& time_source);
 
   const RingHashLoadBalancerStats& stats() const { return stats_; }
 
@@ -106,7 +107,6 @@ private:
 
   static RingHashLoadBalancerStats generateStats(Stats::Scope& scope);
 
-  Stats::ScopeSharedPtr scope_;
   RingHashLoadBalancerStats stats_;
 
   static const uint64_t DefaultMinRingSize = 1024;
@@ -390,7 +390,8 @@ void TcpStatsdSink::TlsSink::write(Buffer::Instance& buffer) {
                                      cluster_traffic_stats.upstream_cx_rx_bytes_buffered_,
                                      cluster_traffic_stats.upstream_cx_tx_bytes_total_,
                                      cluster_traffic_stats.upstream_cx_tx_bytes_buffered_,
-                                     &cluster_traffic_stats.bind_errors_, nullptr});
+                                     &cluster_traffic_stats.bind_errors_, nullptr, nullptr,
+                                     nullptr});
     connection_->connect();
   }
 
@@ -40,6 +40,10 @@ Network::IoResult PassthroughSocket::doWrite(Buffer::Instance& buffer, bool end_
   return transport_socket_->doWrite(buffer, end_stream);
 }
 
+uint64_t PassthroughSocket::pendingWriteBytes() const {
+  return transport_socket_->pendingWriteBytes();
+}
+
 void PassthroughSocket::onConnected() { transport_socket_->onConnected(); }
 
 Ssl::ConnectionInfoConstSharedPtr PassthroughSocket::ssl() const {
@@ -48,7 +48,9 @@ WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
                        WorkerStatNames& stat_names)
     : tls_(tls), hooks_(hooks), dispatcher_(std::move(dispatcher)), handler_(std::move(handler)),
       api_(api), reset_streams_counter_(
-                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)) {
+                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)),
+      slice_storage_pool_max_bytes_(
+          api_.bootstrap().memory_allocator_manager().per_worker_buffer_slice_cache_bytes()) {
   tls_.registerThread(*dispatcher_, false);
   overload_manager.registerForAction(
       OverloadActionNames::get().StopAcceptingConnections, *dispatcher_,
@@ -59,6 +61,17 @@ WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
   overload_manager.registerForAction(
       OverloadActionNames::get().ResetStreams, *dispatcher_,
       [this](OverloadActionState state) { resetStreamsUsingExcessiveMemory(state); });
+  if (slice_storage_pool_max_bytes_ > 0) {
+    const std::string prefix = absl::StrCat("server.", dispatcher_->name(), ".buffer_slice_pool.");
+    slice_storage_pool_ = std::make_unique<Buffer::SliceStoragePool>(
+        slice_storage_pool_max_bytes_,
+        Buffer::SliceStoragePoolStats{ALL_SLICE_STORAGE_POOL_STATS(
+            POOL_COUNTER_PREFIX(api_.rootScope(), prefix),
+            POOL_GAUGE_PREFIX(api_.rootScope(), prefix))});
+    overload_manager.registerForAction(
+        OverloadActionNames::get().ShrinkHeap, *dispatcher_,
+        [this](OverloadActionState state) { shrinkSliceStoragePoolCb(state); });
+  }
 }
 
 void WorkerImpl::addListener(absl::optional<uint64_t> overridden_listener,
@@ -144,6 +157,9 @@ void WorkerImpl::stopListener(Network::ListenerConfig& listener,
 
 void WorkerImpl::threadRoutine(OptRef<GuardDog> guard_dog, const std::function<void()>& cb) {
   ENVOY_LOG(debug, "worker entering dispatch loop");
+  if (slice_storage_pool_ != nullptr) {
+    slice_storage_pool_->install();
+  }
   // The watch dog must be created after the dispatcher starts running and has post events flushed,
   // as this is when TLS stat scopes start working.
   dispatcher_->post([this, &guard_dog, cb]() {
@@ -166,6 +182,9 @@ void WorkerImpl::threadRoutine(OptRef<GuardDog> guard_dog, const std::function<v
   handler_.reset();
   tls_.shutdownThread();
   watch_dog_.reset();
+  if (slice_storage_pool_ != nullptr) {
+    slice_storage_pool_->uninstall();
+  }
 }
 
 void WorkerImpl::stopAcceptingConnectionsCb(OverloadActionState state) {
@@ -186,5 +205,11 @@ void WorkerImpl::resetStreamsUsingExcessiveMemory(OverloadActionState state) {
   reset_streams_counter_.add(streams_reset_count);
 }
 
+void WorkerImpl::shrinkSliceStoragePoolCb(OverloadActionState state) {
+  // Cached slice storage is memory the allocator cannot reclaim, so give all of it back while the
+  // heap is being shrunk and stop caching until the pressure subsides.
+  slice_storage_pool_->setMaxCachedBytes(state.isSaturated() ? 0 : slice_storage_pool_max_bytes_);
+}
+
 } // namespace Server
 } // namespace Envoy
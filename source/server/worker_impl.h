@@ -10,6 +10,7 @@
 #include "envoy/server/worker.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/buffer/slice_storage_pool.h"
 #include "source/common/common/logger.h"
 #include "source/server/listener_hooks.h"
 
@@ -74,6 +75,7 @@ private:
   void stopAcceptingConnectionsCb(OverloadActionState state);
   void rejectIncomingConnectionsCb(OverloadActionState state);
   void resetStreamsUsingExcessiveMemory(OverloadActionState state);
+  void shrinkSliceStoragePoolCb(OverloadActionState state);
 
   ThreadLocal::Instance& tls_;
   ListenerHooks& hooks_;
@@ -83,6 +85,8 @@ private:
   Stats::Counter& reset_streams_counter_;
   Thread::ThreadPtr thread_;
   WatchDogSharedPtr watch_dog_;
+  const uint64_t slice_storage_pool_max_bytes_;
+  Buffer::SliceStoragePoolPtr slice_storage_pool_;
 };
 
 } // namespace Server
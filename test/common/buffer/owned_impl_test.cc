@@ -456,6 +456,39 @@ TEST_F(OwnedImplTest, ExtractWithDrainTracker) {
   slice.reset();
 }
 
+TEST_F(OwnedImplTest, DrainToSlices) {
+  // An unowned slice followed by an owned one.
+  std::string input{"unowned slice"};
+  auto frag = OwnedBufferFragmentImpl::create(
+      {input.c_str(), input.size()},
+      [this](const OwnedBufferFragmentImpl*) { release_callback_called_ = true; });
+  Buffer::OwnedImpl buffer;
+  buffer.addBufferFragment(*frag);
+  bool drain_tracker_called{false};
+  buffer.addDrainTracker([&] { drain_tracker_called = true; });
+  buffer.appendSliceForTest("owned slice");
+  const Buffer::RawSliceVector raw_slices = buffer.getRawSlices();
+  ASSERT_EQ(2, raw_slices.size());
+
+  // Drain the first slice and part of the second one.
+  std::vector<Slice> slices;
+  buffer.drainToSlices(input.size() + 6, slices);
+  EXPECT_EQ("slice", buffer.toString());
+  EXPECT_TRUE(drain_tracker_called);
+  EXPECT_FALSE(release_callback_called_);
+
+  // The slices still hold the memory the bytes were read from.
+  ASSERT_EQ(2, slices.size());
+  EXPECT_EQ(raw_slices[0].mem_, slices[0].data());
+  EXPECT_EQ(raw_slices[1].mem_, slices[1].data());
+  EXPECT_EQ("owned slice",
+            absl::string_view(reinterpret_cast<const char*>(slices[1].data()), raw_slices[1].len_));
+
+  slices.clear();
+  EXPECT_TRUE(release_callback_called_);
+  EXPECT_EQ("slice", buffer.toString());
+}
+
 TEST_F(OwnedImplTest, DrainTracking) {
   testing::InSequence s;
 
@@ -0,0 +1,140 @@
+#include <memory>
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_storage_pool.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+class SliceStoragePoolTest : public testing::Test {
+protected:
+  SliceStoragePoolTest()
+      : stats_{ALL_SLICE_STORAGE_POOL_STATS(POOL_COUNTER_PREFIX(*store_.rootScope(), "pool."),
+                                            POOL_GAUGE_PREFIX(*store_.rootScope(), "pool."))} {}
+
+  Stats::IsolatedStoreImpl store_;
+  SliceStoragePoolStats stats_;
+};
+
+TEST_F(SliceStoragePoolTest, Poolable) {
+  EXPECT_FALSE(SliceStoragePool::poolable(0));
+  EXPECT_FALSE(SliceStoragePool::poolable(100));
+  EXPECT_TRUE(SliceStoragePool::poolable(4096));
+  EXPECT_TRUE(SliceStoragePool::poolable(12288));
+  EXPECT_TRUE(SliceStoragePool::poolable(Slice::default_slice_size_));
+  EXPECT_FALSE(SliceStoragePool::poolable(Slice::default_slice_size_ + 4096));
+}
+
+TEST_F(SliceStoragePoolTest, ReuseBySizeClass) {
+  SliceStoragePool pool(64 * 1024, stats_);
+
+  auto storage = pool.allocate(16384);
+  uint8_t* addr = storage.get();
+  EXPECT_EQ(1, stats_.miss_.value());
+  pool.release(std::move(storage), 16384);
+  EXPECT_EQ(16384, pool.cachedBytes());
+  EXPECT_EQ(16384, stats_.cached_bytes_.value());
+
+  // A different size class does not reuse the cached block.
+  auto small = pool.allocate(4096);
+  EXPECT_EQ(2, stats_.miss_.value());
+  EXPECT_EQ(0, stats_.hit_.value());
+
+  auto reused = pool.allocate(16384);
+  EXPECT_EQ(addr, reused.get());
+  EXPECT_EQ(1, stats_.hit_.value());
+  EXPECT_EQ(0, pool.cachedBytes());
+  EXPECT_EQ(0, stats_.cached_bytes_.value());
+
+  pool.release(std::move(small), 4096);
+  pool.release(std::move(reused), 16384);
+  EXPECT_EQ(20480, pool.cachedBytes());
+}
+
+TEST_F(SliceStoragePoolTest, BoundedCache) {
+  SliceStoragePool pool(16384, stats_);
+
+  auto first = pool.allocate(16384);
+  auto second = pool.allocate(4096);
+  pool.release(std::move(first), 16384);
+  pool.release(std::move(second), 4096);
+  EXPECT_EQ(16384, pool.cachedBytes());
+  EXPECT_EQ(1, stats_.overflow_.value());
+}
+
+TEST_F(SliceStoragePoolTest, SetMaxCachedBytesTrims) {
+  SliceStoragePool pool(64 * 1024, stats_);
+
+  std::vector<SliceStoragePool::StoragePtr> storages;
+  for (uint64_t size : {4096, 8192, 16384, 16384}) {
+    storages.push_back(pool.allocate(size));
+  }
+  pool.release(std::move(storages[0]), 4096);
+  pool.release(std::move(storages[1]), 8192);
+  pool.release(std::move(storages[2]), 16384);
+  pool.release(std::move(storages[3]), 16384);
+  EXPECT_EQ(45056, pool.cachedBytes());
+
+  // The largest blocks are freed first.
+  pool.setMaxCachedBytes(12288);
+  EXPECT_EQ(12288, pool.cachedBytes());
+  EXPECT_EQ(12288, stats_.cached_bytes_.value());
+
+  pool.setMaxCachedBytes(0);
+  EXPECT_EQ(0, pool.cachedBytes());
+  EXPECT_EQ(0, stats_.cached_bytes_.value());
+
+  // Nothing is cached while the limit is zero.
+  pool.release(pool.allocate(4096), 4096);
+  EXPECT_EQ(0, pool.cachedBytes());
+}
+
+TEST_F(SliceStoragePoolTest, SlicesUseInstalledPool) {
+  SliceStoragePool pool(64 * 1024, stats_);
+  EXPECT_EQ(nullptr, SliceStoragePool::current());
+  pool.install();
+  EXPECT_EQ(&pool, SliceStoragePool::current());
+
+  {
+    OwnedImpl buffer;
+    buffer.add(std::string(100, 'a'));
+    buffer.add(std::string(Slice::default_slice_size_, 'b'));
+  }
+  EXPECT_EQ(2, stats_.miss_.value());
+  EXPECT_EQ(4096 + Slice::default_slice_size_, pool.cachedBytes());
+
+  {
+    OwnedImpl buffer;
+    buffer.add(std::string(100, 'a'));
+    auto reservation = buffer.reserveSingleSlice(Slice::default_slice_size_, true);
+    reservation.commit(100);
+    EXPECT_EQ(200, buffer.length());
+  }
+  EXPECT_EQ(2, stats_.hit_.value());
+
+  // Slices larger than the largest size class bypass the pool.
+  {
+    OwnedImpl buffer;
+    buffer.add(std::string(Slice::default_slice_size_ * 2, 'c'));
+  }
+  EXPECT_EQ(0, stats_.overflow_.value());
+  EXPECT_EQ(2, stats_.miss_.value());
+
+  pool.uninstall();
+  EXPECT_EQ(nullptr, SliceStoragePool::current());
+  {
+    OwnedImpl buffer;
+    buffer.add(std::string(100, 'a'));
+  }
+  EXPECT_EQ(2, stats_.miss_.value());
+  EXPECT_EQ(2, stats_.hit_.value());
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
@@ -324,5 +324,54 @@ TEST(UnionStringTest, All) {
   }
 }
 
+TEST(UnionStringTest, Borrowed) {
+  auto storage = std::make_shared<std::string>("Hello world  ");
+  std::weak_ptr<std::string> weak_storage = storage;
+
+  UnionString string;
+  string.setBorrowed(*storage, storage);
+  storage.reset();
+  EXPECT_TRUE(string.isReference());
+  EXPECT_TRUE(string.isBorrowed());
+  EXPECT_FALSE(weak_storage.expired());
+
+  // Trimming keeps the string borrowed.
+  string.rtrim();
+  EXPECT_EQ("Hello world", string.getStringView());
+  EXPECT_TRUE(string.isBorrowed());
+
+  // Moving moves the borrowed storage and empties the moved from string.
+  UnionString string2(std::move(string));
+  EXPECT_TRUE(string2.isBorrowed());
+  EXPECT_FALSE(string.isBorrowed()); // NOLINT
+  EXPECT_TRUE(string.empty());       // NOLINT
+  EXPECT_FALSE(weak_storage.expired());
+
+  // Mutating copies the string and releases the storage.
+  string2.append("!", 1);
+  EXPECT_EQ("Hello world!", string2.getStringView());
+  EXPECT_FALSE(string2.isReference());
+  EXPECT_FALSE(string2.isBorrowed());
+  EXPECT_TRUE(weak_storage.expired());
+
+  // Copying a borrowed string into itself.
+  storage = std::make_shared<std::string>("hello");
+  string2.setBorrowed(*storage, storage);
+  string2.setCopy(string2.getStringView());
+  storage.reset();
+  EXPECT_EQ("hello", string2.getStringView());
+  EXPECT_FALSE(string2.isBorrowed());
+
+  // Clearing releases the storage.
+  storage = std::make_shared<std::string>("hello");
+  weak_storage = storage;
+  string2.setBorrowed(*storage, storage);
+  storage.reset();
+  string2.clear();
+  EXPECT_TRUE(string2.empty());
+  EXPECT_FALSE(string2.isReference());
+  EXPECT_TRUE(weak_storage.expired());
+}
+
 } // namespace
 } // namespace Envoy
@@ -323,6 +323,162 @@ TEST(DeferredDeleteTest, DeferredDeleteAndPostOrdering) {
   dispatcher->run(Dispatcher::RunType::NonBlock);
 }
 
+class DispatcherBatchingTest : public testing::Test {
+protected:
+  DispatcherBatchingTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        dispatcher_impl_(static_cast<DispatcherImpl*>(dispatcher_.get())) {
+    evwatch_prepare_new(&dispatcher_impl_->base(), onWatcherReady, &prepare_watcher_);
+  }
+
+  void createCallback(std::function<void()> cb) {
+    callbacks_.emplace_back(dispatcher_->createSchedulableCallback(cb));
+  }
+
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+  DispatcherImpl* dispatcher_impl_;
+  ReadyWatcher prepare_watcher_;
+  std::vector<SchedulableCallbackPtr> callbacks_;
+};
+
+// Posted callbacks beyond the batch size are carried over to the next iteration of the event loop.
+TEST_F(DispatcherBatchingTest, PostCallbacksRunInBoundedBatches) {
+  dispatcher_impl_->enableBatching(2, std::chrono::hours(1));
+  ReadyWatcher watcher0;
+  ReadyWatcher watcher1;
+  ReadyWatcher watcher2;
+  // Posted callbacks are flushed before the event loop starts, post from one of them so that the
+  // others run in batches.
+  dispatcher_->post([&]() {
+    dispatcher_->post([&]() { watcher0.ready(); });
+    dispatcher_->post([&]() { watcher1.ready(); });
+    dispatcher_->post([&]() { watcher2.ready(); });
+  });
+
+  InSequence s;
+  EXPECT_CALL(prepare_watcher_, ready());
+  EXPECT_CALL(watcher0, ready());
+  EXPECT_CALL(watcher1, ready());
+  EXPECT_CALL(prepare_watcher_, ready());
+  EXPECT_CALL(watcher2, ready());
+  dispatcher_->run(Dispatcher::RunType::Block);
+}
+
+// A batch stops running callbacks once its latency budget is exhausted. With no budget at all,
+// a single callback runs per iteration of the event loop.
+TEST_F(DispatcherBatchingTest, LatencyBudget) {
+  dispatcher_impl_->enableBatching(100, std::chrono::microseconds(0));
+  ReadyWatcher watcher0;
+  ReadyWatcher watcher1;
+  dispatcher_->post([&]() {
+    dispatcher_->post([&]() { watcher0.ready(); });
+    dispatcher_->post([&]() { watcher1.ready(); });
+  });
+
+  InSequence s;
+  EXPECT_CALL(prepare_watcher_, ready());
+  EXPECT_CALL(watcher0, ready());
+  EXPECT_CALL(prepare_watcher_, ready());
+  EXPECT_CALL(watcher1, ready());
+  dispatcher_->run(Dispatcher::RunType::Block);
+}
+
+// Deferred deletions run first and in full, then posted callbacks and schedulable callbacks share
+// what is left of the batch.
+TEST_F(DispatcherBatchingTest, DeferredDeletePostAndSchedulableCallbacks) {
+  dispatcher_impl_->enableBatching(2, std::chrono::hours(1));
+  ReadyWatcher delete_watcher0;
+  ReadyWatcher delete_watcher1;
+  ReadyWatcher post_watcher;
+  ReadyWatcher watcher0;
+  ReadyWatcher watcher1;
+  ReadyWatcher watcher2;
+  createCallback([&]() {
+    watcher0.ready();
+    dispatcher_->deferredDelete(
+        std::make_unique<TestDeferredDeletable>([&]() -> void { delete_watcher0.ready(); }));
+    dispatcher_->deferredDelete(
+        std::make_unique<TestDeferredDeletable>([&]() -> void { delete_watcher1.ready(); }));
+    dispatcher_->post([&]() { post_watcher.ready(); });
+    callbacks_[1]->scheduleCallbackCurrentIteration();
+    callbacks_[2]->scheduleCallbackCurrentIteration();
+  });
+  createCallback([&]() { watcher1.ready(); });
+  createCallback([&]() { watcher2.ready(); });
+
+  callbacks_[0]->scheduleCallbackCurrentIteration();
+  EXPECT_TRUE(callbacks_[0]->enabled());
+
+  InSequence s;
+  EXPECT_CALL(prepare_watcher_, ready());
+  EXPECT_CALL(watcher0, ready());
+  EXPECT_CALL(watcher1, ready());
+  EXPECT_CALL(prepare_watcher_, ready());
+  EXPECT_CALL(delete_watcher0, ready());
+  EXPECT_CALL(delete_watcher1, ready());
+  EXPECT_CALL(post_watcher, ready());
+  EXPECT_CALL(watcher2, ready());
+  dispatcher_->run(Dispatcher::RunType::Block);
+  EXPECT_FALSE(callbacks_[0]->enabled());
+}
+
+TEST_F(DispatcherBatchingTest, ScheduleAndCancel) {
+  dispatcher_impl_->enableBatching(10, std::chrono::hours(1));
+  ReadyWatcher watcher0;
+  ReadyWatcher watcher3;
+  ReadyWatcher watcher4;
+  createCallback([&]() {
+    watcher0.ready();
+    callbacks_[1]->cancel();
+    callbacks_[2].reset();
+    callbacks_[3]->scheduleCallbackNextIteration();
+  });
+  createCallback([&]() { FAIL(); });
+  createCallback([&]() { FAIL(); });
+  createCallback([&]() { watcher3.ready(); });
+  createCallback([&]() {
+    watcher4.ready();
+    callbacks_[4]->scheduleCallbackCurrentIteration();
+    callbacks_[4]->cancel();
+  });
+
+  callbacks_[0]->scheduleCallbackCurrentIteration();
+  callbacks_[1]->scheduleCallbackCurrentIteration();
+  callbacks_[2]->scheduleCallbackCurrentIteration();
+  callbacks_[4]->scheduleCallbackCurrentIteration();
+  // Scheduling an enabled callback is a no-op.
+  callbacks_[0]->scheduleCallbackNextIteration();
+
+  // Next iteration callbacks are not batched.
+  InSequence s;
+  EXPECT_CALL(prepare_watcher_, ready());
+  EXPECT_CALL(watcher0, ready());
+  EXPECT_CALL(watcher4, ready());
+  EXPECT_CALL(prepare_watcher_, ready());
+  EXPECT_CALL(watcher3, ready());
+  dispatcher_->run(Dispatcher::RunType::Block);
+}
+
+TEST_F(DispatcherBatchingTest, RecordsBatchSize) {
+  NiceMock<Stats::MockStore> store;
+  dispatcher_impl_->enableBatching(2, std::chrono::hours(1));
+  dispatcher_->initializeStats(*store.rootScope(), "test.");
+  dispatcher_->post([&]() {
+    dispatcher_->post([]() {});
+    dispatcher_->post([]() {});
+    dispatcher_->post([]() {});
+  });
+
+  EXPECT_CALL(prepare_watcher_, ready()).Times(2);
+  EXPECT_CALL(store, deliverHistogramToSinks(_, _)).Times(testing::AnyNumber());
+  EXPECT_CALL(store, deliverHistogramToSinks(
+                         testing::Property(&Stats::Metric::name, "test.dispatcher.batch_size"), 2));
+  EXPECT_CALL(store, deliverHistogramToSinks(
+                         testing::Property(&Stats::Metric::name, "test.dispatcher.batch_size"), 1));
+  dispatcher_->run(Dispatcher::RunType::Block);
+}
+
 class DispatcherImplTest : public testing::Test {
 protected:
   DispatcherImplTest()
@@ -387,10 +543,19 @@ protected:
 // TODO(mergeconflict): We also need integration testing to validate that the expected histograms
 // are written when `enable_dispatcher_stats` is true. See issue #6582.
 TEST_F(DispatcherImplTest, InitializeStats) {
+  EXPECT_CALL(store_, histogram("test.dispatcher.batch_size", Stats::Histogram::Unit::Unspecified));
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.deferred_delete_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.events_per_wakeup", Stats::Histogram::Unit::Unspecified));
   EXPECT_CALL(store_,
               histogram("test.dispatcher.loop_duration_us", Stats::Histogram::Unit::Microseconds));
   EXPECT_CALL(store_,
               histogram("test.dispatcher.poll_delay_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.post_callbacks_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_, histogram("test.dispatcher.scheduled_callbacks_us",
+                                Stats::Histogram::Unit::Microseconds));
   dispatcher_->initializeStats(scope_, "test.");
 }
 
@@ -1510,6 +1675,19 @@ TEST_F(DispatcherWithWatchdogTest, PeriodicTouchTimer) {
   time_system_.advanceTimeAndRun(min_touch_interval_, *dispatcher_, Dispatcher::RunType::NonBlock);
 }
 
+// The periodic touch timer samples the event loop lag and CPU utilization of the dispatcher.
+TEST_F(DispatcherWithWatchdogTest, PeriodicTouchUpdatesLoad) {
+  EXPECT_CALL(*watchdog_, touch()).Times(2);
+  time_system_.advanceTimeAndRun(min_touch_interval_, *dispatcher_, Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(0, dispatcher_->load().event_loop_lag_us_);
+
+  // The timer runs 5s late when the event loop doesn't get to it in time.
+  time_system_.advanceTimeAndRun(min_touch_interval_ + std::chrono::seconds(5), *dispatcher_,
+                                 Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(5000000, dispatcher_->load().event_loop_lag_us_);
+  EXPECT_LE(dispatcher_->load().cpu_utilization_permille_, 1000);
+}
+
 TEST_F(DispatcherWithWatchdogTest, TouchBeforeEachPostCallback) {
   ReadyWatcher watcher1;
   ReadyWatcher watcher2;
@@ -0,0 +1,215 @@
+#include <chrono>
+
+#include "envoy/common/scope_tracker.h"
+#include "envoy/event/timer.h"
+
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/event/scaled_range_timer_manager_impl.h"
+
+#include "test/mocks/common.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+using testing::InSequence;
+
+class TimerWheelTest : public testing::Test {
+protected:
+  TimerWheelTest() {
+    scoped_runtime_.mergeValues({{"envoy.restart_features.dispatcher_timer_wheel", "true"}});
+    api_ = Api::createApiForTest(time_system_);
+    dispatcher_ = api_->allocateDispatcher("test_thread");
+  }
+
+  void advance(std::chrono::milliseconds duration) {
+    time_system_.advanceTimeAndRun(duration, *dispatcher_, Dispatcher::RunType::NonBlock);
+  }
+
+  TestScopedRuntime scoped_runtime_;
+  Event::SimulatedTimeSystem time_system_;
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+};
+
+TEST_F(TimerWheelTest, FiresAfterDelay) {
+  ReadyWatcher watcher;
+  TimerPtr timer = dispatcher_->createTimer([&]() { watcher.ready(); });
+  EXPECT_FALSE(timer->enabled());
+  timer->enableTimer(std::chrono::milliseconds(10));
+  EXPECT_TRUE(timer->enabled());
+
+  advance(std::chrono::milliseconds(9));
+  EXPECT_TRUE(timer->enabled());
+
+  EXPECT_CALL(watcher, ready());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_FALSE(timer->enabled());
+}
+
+TEST_F(TimerWheelTest, NeverFiresEarlyOnPartialTicks) {
+  ReadyWatcher watcher;
+  TimerPtr timer = dispatcher_->createTimer([&]() { watcher.ready(); });
+  time_system_.advanceTimeAndRun(std::chrono::microseconds(300), *dispatcher_,
+                                 Dispatcher::RunType::NonBlock);
+  timer->enableTimer(std::chrono::milliseconds(2));
+
+  advance(std::chrono::milliseconds(1));
+  time_system_.advanceTimeAndRun(std::chrono::microseconds(999), *dispatcher_,
+                                 Dispatcher::RunType::NonBlock);
+  EXPECT_TRUE(timer->enabled());
+
+  EXPECT_CALL(watcher, ready());
+  advance(std::chrono::milliseconds(1));
+}
+
+TEST_F(TimerWheelTest, ReenableLaterAndEarlier) {
+  ReadyWatcher watcher;
+  TimerPtr timer = dispatcher_->createTimer([&]() { watcher.ready(); });
+  timer->enableTimer(std::chrono::milliseconds(10));
+  advance(std::chrono::milliseconds(5));
+  // Pushing the deadline out leaves the timer in its slot until the wheel reaches it.
+  timer->enableTimer(std::chrono::milliseconds(10));
+  advance(std::chrono::milliseconds(9));
+  EXPECT_TRUE(timer->enabled());
+  EXPECT_CALL(watcher, ready());
+  advance(std::chrono::milliseconds(1));
+
+  timer->enableTimer(std::chrono::seconds(100));
+  timer->enableTimer(std::chrono::milliseconds(5));
+  advance(std::chrono::milliseconds(4));
+  EXPECT_CALL(watcher, ready());
+  advance(std::chrono::milliseconds(1));
+}
+
+TEST_F(TimerWheelTest, DisableAndDelete) {
+  ReadyWatcher watcher;
+  TimerPtr timer1 = dispatcher_->createTimer([&]() { watcher.ready(); });
+  TimerPtr timer2 = dispatcher_->createTimer([&]() { watcher.ready(); });
+  timer1->enableTimer(std::chrono::milliseconds(10));
+  timer2->enableTimer(std::chrono::milliseconds(10));
+  timer1->disableTimer();
+  EXPECT_FALSE(timer1->enabled());
+  timer2.reset();
+  advance(std::chrono::milliseconds(20));
+}
+
+// Timers far enough out to be placed in each level of the wheel, and beyond its range, are
+// cascaded down and fire on time.
+TEST_F(TimerWheelTest, CascadesThroughLevels) {
+  const std::vector<std::chrono::milliseconds> delays = {
+      std::chrono::milliseconds(200), std::chrono::milliseconds(300),
+      std::chrono::milliseconds(70000), std::chrono::hours(5), std::chrono::hours(24 * 30),
+      std::chrono::hours(24 * 60)};
+  std::vector<ReadyWatcher> watchers(delays.size());
+  std::vector<TimerPtr> timers;
+  for (size_t i = 0; i < delays.size(); i++) {
+    timers.push_back(dispatcher_->createTimer([&watchers, i]() { watchers[i].ready(); }));
+    timers.back()->enableTimer(delays[i]);
+  }
+
+  std::chrono::milliseconds elapsed{0};
+  for (size_t i = 0; i < delays.size(); i++) {
+    advance(delays[i] - elapsed - std::chrono::milliseconds(1));
+    EXPECT_TRUE(timers[i]->enabled());
+    EXPECT_CALL(watchers[i], ready());
+    advance(std::chrono::milliseconds(1));
+    EXPECT_FALSE(timers[i]->enabled());
+    elapsed = delays[i];
+  }
+}
+
+TEST_F(TimerWheelTest, FiresInDeadlineOrder) {
+  ReadyWatcher watcher1;
+  ReadyWatcher watcher2;
+  ReadyWatcher watcher3;
+  TimerPtr timer1 = dispatcher_->createTimer([&]() { watcher1.ready(); });
+  TimerPtr timer2 = dispatcher_->createTimer([&]() { watcher2.ready(); });
+  TimerPtr timer3 = dispatcher_->createTimer([&]() { watcher3.ready(); });
+  timer3->enableTimer(std::chrono::milliseconds(500));
+  timer2->enableTimer(std::chrono::milliseconds(5));
+  timer1->enableTimer(std::chrono::milliseconds(3));
+
+  InSequence s;
+  EXPECT_CALL(watcher1, ready());
+  EXPECT_CALL(watcher2, ready());
+  EXPECT_CALL(watcher3, ready());
+  advance(std::chrono::seconds(1));
+}
+
+TEST_F(TimerWheelTest, ReenableFromCallback) {
+  int fired = 0;
+  TimerPtr timer;
+  timer = dispatcher_->createTimer([&]() {
+    fired++;
+    timer->enableTimer(std::chrono::milliseconds(1));
+  });
+  timer->enableTimer(std::chrono::milliseconds(1));
+  for (int i = 1; i <= 300; i++) {
+    advance(std::chrono::milliseconds(1));
+    EXPECT_EQ(i, fired);
+  }
+}
+
+// Zero delay and high resolution timers are run by the underlying scheduler.
+TEST_F(TimerWheelTest, ZeroDelayAndHighResolution) {
+  ReadyWatcher watcher;
+  TimerPtr timer = dispatcher_->createTimer([&]() { watcher.ready(); });
+  timer->enableTimer(std::chrono::milliseconds(100));
+  timer->enableTimer(std::chrono::milliseconds(0));
+  EXPECT_TRUE(timer->enabled());
+  EXPECT_CALL(watcher, ready());
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  EXPECT_FALSE(timer->enabled());
+
+  timer->enableHRTimer(std::chrono::microseconds(500));
+  EXPECT_TRUE(timer->enabled());
+  time_system_.advanceTimeAndRun(std::chrono::microseconds(499), *dispatcher_,
+                                 Dispatcher::RunType::NonBlock);
+  EXPECT_CALL(watcher, ready());
+  time_system_.advanceTimeAndRun(std::chrono::microseconds(1), *dispatcher_,
+                                 Dispatcher::RunType::NonBlock);
+
+  // Moving back to the wheel disables the underlying timer.
+  timer->enableTimer(std::chrono::milliseconds(0));
+  timer->enableTimer(std::chrono::milliseconds(2));
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  EXPECT_CALL(watcher, ready());
+  advance(std::chrono::milliseconds(2));
+}
+
+TEST_F(TimerWheelTest, TracksScope) {
+  MockScopeTrackedObject scope;
+  TimerPtr timer = dispatcher_->createTimer([&]() {
+    EXPECT_FALSE(dispatcher_->trackedObjectStackIsEmpty());
+  });
+  timer->enableTimer(std::chrono::milliseconds(5), &scope);
+  advance(std::chrono::milliseconds(5));
+  EXPECT_TRUE(dispatcher_->trackedObjectStackIsEmpty());
+}
+
+TEST_F(TimerWheelTest, ScaledTimers) {
+  ScaledRangeTimerManagerImpl manager(*dispatcher_);
+  ReadyWatcher watcher;
+  TimerPtr timer = manager.createTimer(ScaledTimerMinimum(ScaledMinimum(UnitFloat(0.5))),
+                                       [&]() { watcher.ready(); });
+  timer->enableTimer(std::chrono::seconds(10));
+  manager.setScaleFactor(UnitFloat(0.5));
+
+  // The minimum elapses after 5s, then the rest of the range is scaled down by half.
+  advance(std::chrono::seconds(5));
+  advance(std::chrono::milliseconds(2499));
+  EXPECT_TRUE(timer->enabled());
+  EXPECT_CALL(watcher, ready());
+  advance(std::chrono::milliseconds(1));
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <string>
+
+#include "source/common/http/character_set_scanner.h"
+
+#include "test/test_common/test_random_generator.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+class CharacterSetScannerTest
+    : public testing::TestWithParam<CharacterSetScanner::Implementation> {
+protected:
+  CharacterSetScannerTest() : saved_(CharacterSetScanner::implementation()) {
+    CharacterSetScanner::setImplementation(GetParam());
+  }
+  ~CharacterSetScannerTest() override { CharacterSetScanner::setImplementation(saved_); }
+
+  // Checks the scanner against a lookup of each character of `str` in the table of `set`.
+  void expectMatchesTable(const CharacterSet& set, absl::string_view str) {
+    size_t first_not_of = str.size();
+    size_t first_of = str.size();
+    for (size_t i = 0; i < str.size(); ++i) {
+      const bool in_set = testCharInTable(set.table(), str[i]);
+      if (!in_set && first_not_of == str.size()) {
+        first_not_of = i;
+      }
+      if (in_set && first_of == str.size()) {
+        first_of = i;
+      }
+    }
+    EXPECT_EQ(first_not_of, set.findFirstNotOf(str)) << str;
+    EXPECT_EQ(first_of, set.findFirstOf(str)) << str;
+  }
+
+  const CharacterSetScanner::Implementation saved_;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Implementations, CharacterSetScannerTest,
+    testing::ValuesIn(CharacterSetScanner::supportedImplementations()),
+    [](const testing::TestParamInfo<CharacterSetScanner::Implementation>& info) {
+      std::string name(CharacterSetScanner::implementationName(info.param));
+      name.erase(std::remove(name.begin(), name.end(), '.'), name.end());
+      return name;
+    });
+
+TEST(CharacterSetTest, NibbleRows) {
+  EXPECT_TRUE(kCrLfCharacterSet.asciiOnly());
+  // '\n' is 0x0a and '\r' is 0x0d.
+  EXPECT_EQ(1, kCrLfCharacterSet.nibbleRows()[0xa]);
+  EXPECT_EQ(1, kCrLfCharacterSet.nibbleRows()[0xd]);
+  for (unsigned c = 0; c < 256; ++c) {
+    EXPECT_EQ(c == '\r' || c == '\n', kCrLfCharacterSet.contains(static_cast<char>(c)));
+  }
+}
+
+TEST_P(CharacterSetScannerTest, EveryPosition) {
+  // Put a single character out of the set at every position of strings spanning several blocks.
+  for (size_t length = 0; length < 100; ++length) {
+    for (size_t position = 0; position < length; ++position) {
+      for (char c : {' ', ':', '\0', '\x7f', '\x80', '\xff'}) {
+        std::string name(length, 'a');
+        name[position] = c;
+        expectMatchesTable(kGenericHeaderNameCharacterSet, name);
+      }
+      std::string value(length, 'a');
+      value[position] = '\n';
+      expectMatchesTable(kCrLfCharacterSet, value);
+    }
+    expectMatchesTable(kGenericHeaderNameCharacterSet, std::string(length, 'a'));
+    expectMatchesTable(kCrLfCharacterSet, std::string(length, 'a'));
+  }
+}
+
+TEST_P(CharacterSetScannerTest, AllCharacters) {
+  std::string all;
+  for (unsigned c = 0; c < 256; ++c) {
+    all.push_back(static_cast<char>(c));
+  }
+  for (size_t i = 0; i < all.size(); ++i) {
+    expectMatchesTable(kGenericHeaderNameCharacterSet, absl::string_view(all).substr(i));
+    expectMatchesTable(kCrLfCharacterSet, absl::string_view(all).substr(i));
+  }
+}
+
+TEST_P(CharacterSetScannerTest, RandomStrings) {
+  TestRandomGenerator rand;
+  for (int i = 0; i < 1000; ++i) {
+    std::string str(rand.random() % 200, '\0');
+    for (char& c : str) {
+      // Mostly header name characters, so that the scan goes past the first block.
+      c = rand.random() % 8 == 0 ? static_cast<char>(rand.random()) : 'a' + rand.random() % 26;
+    }
+    expectMatchesTable(kGenericHeaderNameCharacterSet, str);
+    expectMatchesTable(kCrLfCharacterSet, str);
+  }
+}
+
+TEST_P(CharacterSetScannerTest, ExtendedAsciiSet) {
+  // Sets with extended ASCII characters are scanned one character at a time.
+  constexpr CharacterSet set{std::array<uint32_t, 8>{0, 0, 0, 0, 0, 0, 0, 0xffffffff}};
+  EXPECT_FALSE(set.asciiOnly());
+  std::string str(64, '\xe0');
+  str[40] = 'a';
+  EXPECT_EQ(40U, set.findFirstNotOf(str));
+  EXPECT_EQ(0U, set.findFirstOf(str));
+  EXPECT_TRUE(set.containsAny(str));
+  EXPECT_FALSE(set.containsAll(str));
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
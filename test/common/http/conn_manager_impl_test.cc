@@ -59,6 +59,7 @@ TEST_F(HttpConnectionManagerImplTest, HeaderOnlyRequestAndResponse) {
       .Times(2)
       .WillRepeatedly(Invoke([&](Buffer::Instance& data) -> Http::Status {
         decoder_ = &conn_manager_->newStream(response_encoder_);
+        EXPECT_EQ(1, filter_callbacks_.connection_.dispatcher_.load_.active_streams_);
 
         // Test not charging stats on the second call.
         if (data.length() == 4) {
@@ -89,6 +90,7 @@ TEST_F(HttpConnectionManagerImplTest, HeaderOnlyRequestAndResponse) {
   EXPECT_EQ(1U, listener_stats_.downstream_rq_2xx_.value());
   EXPECT_EQ(1U, stats_.named_.downstream_rq_completed_.value());
   EXPECT_EQ(1U, listener_stats_.downstream_rq_completed_.value());
+  EXPECT_EQ(0, filter_callbacks_.connection_.dispatcher_.load_.active_streams_);
 }
 
 // Similar to HeaderOnlyRequestAndResponse but uses newStreamHandle and has
@@ -7,6 +7,9 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::Field;
+using testing::InSequence;
+using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
 
@@ -19,6 +22,8 @@ public:
   MockFilterChainOptions() = default;
 
   MOCK_METHOD(absl::optional<bool>, filterDisabled, (absl::string_view), (const));
+  MOCK_METHOD(const FilterChainTemplate*, filterChainTemplate,
+              (uint64_t, const std::function<FilterChainTemplate()>&), (const));
 };
 
 TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithRouteDisabled) {
@@ -84,6 +89,72 @@ TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithRouteDisabledAndDe
   }
 }
 
+TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithTemplate) {
+  NiceMock<MockFilterChainManager> manager;
+  NiceMock<MockFilterChainOptions> options;
+  FilterChainUtility::FilterFactoriesList filter_factories;
+
+  for (const auto& name : {"filter_0", "filter_1", "filter_2"}) {
+    auto provider =
+        std::make_unique<Filter::StaticFilterConfigProviderImpl<Filter::HttpFilterFactoryCb>>(
+            [](FilterChainFactoryCallbacks&) {}, name);
+    filter_factories.push_back({std::move(provider), name == std::string("filter_2")});
+  }
+
+  const uint64_t chain_id = FilterChainUtility::nextFilterChainId();
+  EXPECT_NE(chain_id, FilterChainUtility::nextFilterChainId());
+
+  {
+    // The template is built from the options and the filters disabled by default.
+    FilterChainTemplate filters;
+    EXPECT_CALL(options, filterDisabled("filter_0")).WillOnce(Return(absl::make_optional(true)));
+    EXPECT_CALL(options, filterDisabled("filter_1")).WillOnce(Return(absl::nullopt));
+    EXPECT_CALL(options, filterDisabled("filter_2")).WillOnce(Return(absl::nullopt));
+    EXPECT_CALL(options, filterChainTemplate(chain_id, _))
+        .WillOnce(Invoke([&](uint64_t, const std::function<FilterChainTemplate()>& build) {
+          filters = build();
+          return &filters;
+        }));
+    EXPECT_CALL(manager, applyFilterFactoryCb(Field(&FilterContext::config_name, "filter_1"), _));
+    FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories,
+                                                      chain_id);
+    EXPECT_EQ(FilterChainTemplate{1}, filters);
+  }
+
+  {
+    // Only the filters of the template are created, without looking up the options.
+    const FilterChainTemplate filters{0, 2};
+    EXPECT_CALL(options, filterDisabled(_)).Times(0);
+    EXPECT_CALL(options, filterChainTemplate(chain_id, _)).WillOnce(Return(&filters));
+    InSequence s;
+    EXPECT_CALL(manager, applyFilterFactoryCb(Field(&FilterContext::config_name, "filter_0"), _));
+    EXPECT_CALL(manager, applyFilterFactoryCb(Field(&FilterContext::config_name, "filter_2"), _));
+    FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories,
+                                                      chain_id);
+  }
+}
+
+TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithoutTemplate) {
+  NiceMock<MockFilterChainManager> manager;
+  NiceMock<MockFilterChainOptions> options;
+  FilterChainUtility::FilterFactoriesList filter_factories;
+
+  for (const auto& name : {"filter_0", "filter_1"}) {
+    auto provider =
+        std::make_unique<Filter::StaticFilterConfigProviderImpl<Filter::HttpFilterFactoryCb>>(
+            [](FilterChainFactoryCallbacks&) {}, name);
+    filter_factories.push_back({std::move(provider), false});
+  }
+
+  // The options keep no template, so the filters are looked up one by one.
+  EXPECT_CALL(options, filterChainTemplate(_, _)).WillOnce(Return(nullptr));
+  EXPECT_CALL(options, filterDisabled("filter_0")).WillOnce(Return(absl::make_optional(true)));
+  EXPECT_CALL(options, filterDisabled("filter_1")).WillOnce(Return(absl::nullopt));
+  EXPECT_CALL(manager, applyFilterFactoryCb(Field(&FilterContext::config_name, "filter_1"), _));
+  FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories,
+                                                    FilterChainUtility::nextFilterChainId());
+}
+
 } // namespace
 } // namespace Http
 } // namespace Envoy
@@ -0,0 +1,81 @@
+#include <cstdint>
+#include <list>
+#include <set>
+
+#include "source/common/http/header_map_arena.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+TEST(HeaderMapArenaTest, AllocationsAreAlignedAndDistinct) {
+  HeaderMapArena arena;
+  std::set<void*> allocations;
+  for (size_t size = 1; size < 200; size += 7) {
+    void* memory = arena.allocate(size, alignof(std::max_align_t));
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(memory) % alignof(std::max_align_t));
+    EXPECT_TRUE(allocations.insert(memory).second);
+  }
+  EXPECT_EQ(HeaderMapArena::DefaultInitialBlockSize, arena.bytesReserved());
+}
+
+TEST(HeaderMapArenaTest, GrowsByDoublingBlocks) {
+  HeaderMapArena arena(64);
+  EXPECT_EQ(0U, arena.bytesReserved());
+  arena.allocate(32, 8);
+  EXPECT_EQ(64U, arena.bytesReserved());
+  // Does not fit in the rest of the first block.
+  arena.allocate(32, 8);
+  EXPECT_EQ(64U + 128U, arena.bytesReserved());
+  // Larger than the next block.
+  arena.allocate(1000, 8);
+  EXPECT_LE(64U + 128U + 1000U, arena.bytesReserved());
+}
+
+TEST(HeaderMapArenaTest, ReusesFreedAllocationsOfTheSameSize) {
+  HeaderMapArena arena;
+  void* first = arena.allocate(40, 8);
+  void* second = arena.allocate(100, 8);
+  arena.deallocate(first, 40);
+  arena.deallocate(second, 100);
+  EXPECT_EQ(second, arena.allocate(100, 8));
+  EXPECT_EQ(first, arena.allocate(40, 8));
+  EXPECT_NE(first, arena.allocate(40, 8));
+}
+
+TEST(HeaderMapArenaTest, RepeatedAddAndRemoveDoesNotGrow) {
+  HeaderMapArena arena(256);
+  std::list<uint64_t, HeaderMapArenaAllocator<uint64_t>> list{
+      HeaderMapArenaAllocator<uint64_t>(&arena)};
+  for (uint64_t i = 0; i < 10; i++) {
+    list.push_back(i);
+  }
+  const uint64_t reserved = arena.bytesReserved();
+  for (uint64_t i = 0; i < 1000; i++) {
+    list.pop_front();
+    list.push_back(i);
+  }
+  EXPECT_EQ(reserved, arena.bytesReserved());
+  EXPECT_EQ(10U, list.size());
+}
+
+TEST(HeaderMapArenaTest, AllocatorWithoutArenaUsesHeap) {
+  HeaderMapArenaAllocator<uint64_t> allocator;
+  EXPECT_EQ(nullptr, allocator.arena());
+  uint64_t* memory = allocator.allocate(4);
+  memory[3] = 1;
+  allocator.deallocate(memory, 4);
+
+  HeaderMapArena arena;
+  HeaderMapArenaAllocator<uint64_t> arena_allocator(&arena);
+  HeaderMapArenaAllocator<char> rebound(arena_allocator);
+  EXPECT_EQ(&arena, rebound.arena());
+  EXPECT_TRUE(arena_allocator == rebound);
+  EXPECT_TRUE(allocator != rebound);
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
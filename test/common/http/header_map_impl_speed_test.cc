@@ -210,6 +210,34 @@ static void headerMapImplPopulate(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplPopulate);
 
+/**
+ * Measure the speed of creating the request headers and trailers of a stream, populating them
+ * with 30 headers and destroying them, with the entries allocated from the heap (Arg 0) or from
+ * a per stream HeaderMapArena (Arg 1).
+ */
+static void headerMapImplStreamLifetime(benchmark::State& state) {
+  const bool use_arena = state.range(0) != 0;
+  std::vector<std::pair<LowerCaseString, std::string>> headers_to_add;
+  for (size_t i = 0; i < 30; i++) {
+    headers_to_add.emplace_back(LowerCaseString("x-request-header-" + std::to_string(i)),
+                                "value " + std::to_string(i));
+  }
+  for (auto _ : state) { // NOLINT
+    HeaderMapArenaSharedPtr arena = use_arena ? std::make_shared<HeaderMapArena>() : nullptr;
+    auto headers = Http::RequestHeaderMapImpl::create(UINT32_MAX, UINT32_MAX, arena);
+    headers->setReferenceMethod(Headers::get().MethodValues.Get);
+    headers->setReferencePath("/");
+    headers->setReferenceHost("example.com");
+    for (const auto& key_value : headers_to_add) {
+      headers->addReference(key_value.first, key_value.second);
+    }
+    auto trailers = Http::RequestTrailerMapImpl::create(UINT32_MAX, UINT32_MAX, arena);
+    trailers->addReference(headers_to_add[0].first, headers_to_add[0].second);
+    benchmark::DoNotOptimize(headers->size() + trailers->size());
+  }
+}
+BENCHMARK(headerMapImplStreamLifetime)->Arg(0)->Arg(1);
+
 /**
  * Measure the speed of encoding headers as part of upgraded requests (HTTP/1 to HTTP/2)
  * @note The measured time for each iteration includes the time needed to add
@@ -611,6 +611,37 @@ TEST(HeaderMapImplTest, LargeCharInHeader) {
   EXPECT_EQ("value", headers.get(static_key)[0]->value().getStringView());
 }
 
+TEST(HeaderMapImplTest, ArenaBackedHeadersAndTrailers) {
+  auto arena = std::make_shared<HeaderMapArena>();
+  auto headers = RequestHeaderMapImpl::create(UINT32_MAX, UINT32_MAX, arena);
+  auto trailers = RequestTrailerMapImpl::create(UINT32_MAX, UINT32_MAX, arena);
+  EXPECT_EQ(arena.get(), headers->arena());
+  EXPECT_EQ(arena.get(), trailers->arena());
+
+  headers->setPath("/");
+  for (int i = 0; i < 20; i++) {
+    headers->addCopy(LowerCaseString(absl::StrCat("x-header-", i)), absl::StrCat("value-", i));
+  }
+  trailers->addCopy(LowerCaseString("grpc-status"), "0");
+  EXPECT_EQ(21U, headers->size());
+  EXPECT_EQ("value-7", headers->get(LowerCaseString("x-header-7"))[0]->value().getStringView());
+  EXPECT_EQ(1U, headers->remove(LowerCaseString("x-header-7")));
+  EXPECT_TRUE(headers->get(LowerCaseString("x-header-7")).empty());
+  EXPECT_EQ("/", headers->getPathValue());
+  EXPECT_EQ("0", trailers->get(LowerCaseString("grpc-status"))[0]->value().getStringView());
+
+  // Copies are allocated from the heap and do not keep the arena alive.
+  auto copy = createHeaderMap<RequestHeaderMapImpl>(*headers);
+  EXPECT_EQ(nullptr, copy->arena());
+  EXPECT_TRUE(*copy == *headers);
+
+  // The maps keep the arena alive after the stream released it.
+  arena.reset();
+  headers.reset();
+  EXPECT_EQ("0", trailers->get(LowerCaseString("grpc-status"))[0]->value().getStringView());
+  EXPECT_EQ(20U, copy->size());
+}
+
 TEST(HeaderMapImplTest, Iterate) {
   TestRequestHeaderMapImpl headers;
   headers.addCopy(LowerCaseString("hello"), "world");
@@ -1399,6 +1399,85 @@ TEST_P(Http1ServerConnectionImplTest, HostHeaderTranslation) {
   EXPECT_EQ(0U, buffer.length());
 }
 
+// With the runtime guard enabled, header names and values are borrowed from BalsaParser and
+// remain valid once the parser moved on to the next request.
+TEST_P(Http1ServerConnectionImplTest, BorrowedHeaderData) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.http1_borrow_header_data", "true"}});
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  Http::ResponseEncoder* response_encoder = nullptr;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoder = &encoder;
+        return decoder;
+      }));
+  std::vector<RequestHeaderMapSharedPtr> request_headers;
+  EXPECT_CALL(decoder, decodeHeaders_(_, true))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](RequestHeaderMapSharedPtr& headers, bool) {
+        request_headers.push_back(headers);
+      }));
+
+  Buffer::OwnedImpl buffer("GET /first HTTP/1.1\r\nx-custom: first value  \r\nX-Mixed: a\r\n\r\n");
+  EXPECT_TRUE(codec_->dispatch(buffer).ok());
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+  response_encoder->encodeHeaders(TestResponseHeaderMapImpl{{":status", "200"}}, true);
+
+  Buffer::OwnedImpl buffer2("GET /second HTTP/1.1\r\nx-custom: second value\r\n\r\n");
+  EXPECT_TRUE(codec_->dispatch(buffer2).ok());
+  ASSERT_EQ(2U, request_headers.size());
+
+  const HeaderEntry* first = request_headers[0]->get(LowerCaseString("x-custom"))[0];
+  EXPECT_EQ("x-custom", first->key().getStringView());
+  EXPECT_EQ("first value", first->value().getStringView());
+  EXPECT_EQ(parser_impl_ == Http1ParserImpl::BalsaParser, first->key().isBorrowed());
+  EXPECT_EQ(parser_impl_ == Http1ParserImpl::BalsaParser, first->value().isBorrowed());
+  // Names that are not lower case are copied.
+  const HeaderEntry* mixed = request_headers[0]->get(LowerCaseString("x-mixed"))[0];
+  EXPECT_EQ("x-mixed", mixed->key().getStringView());
+  EXPECT_FALSE(mixed->key().isBorrowed());
+  EXPECT_EQ("a", mixed->value().getStringView());
+  EXPECT_EQ("second value",
+            request_headers[1]->get(LowerCaseString("x-custom"))[0]->value().getStringView());
+}
+
+// With the runtime guard enabled, the headers and trailers of a request are allocated from one
+// arena, which the maps keep alive once the codec and its stream are destroyed.
+TEST_P(Http1ServerConnectionImplTest, HeaderMapArena) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.http_header_map_arena", "true"}});
+  codec_settings_.enable_trailers_ = true;
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  EXPECT_CALL(callbacks_, newStream(_, _)).WillOnce(ReturnRef(decoder));
+  RequestHeaderMapSharedPtr request_headers;
+  RequestTrailerMapPtr request_trailers;
+  EXPECT_CALL(decoder, decodeHeaders_(_, false))
+      .WillOnce(Invoke(
+          [&](RequestHeaderMapSharedPtr& headers, bool) { request_headers = headers; }));
+  EXPECT_CALL(decoder, decodeTrailers_(_)).WillOnce(Invoke([&](RequestTrailerMapPtr& trailers) {
+    request_trailers = std::move(trailers);
+  }));
+
+  Buffer::OwnedImpl buffer("POST / HTTP/1.1\r\nhost: host\r\ntransfer-encoding: chunked\r\n\r\n"
+                           "5\r\nHello\r\n0\r\nhello: world\r\n\r\n");
+  EXPECT_TRUE(codec_->dispatch(buffer).ok());
+  ASSERT_NE(nullptr, request_headers);
+  ASSERT_NE(nullptr, request_trailers);
+  const HeaderMapArena* arena = dynamic_cast<RequestHeaderMapImpl&>(*request_headers).arena();
+  EXPECT_NE(nullptr, arena);
+  EXPECT_EQ(arena, dynamic_cast<RequestTrailerMapImpl&>(*request_trailers).arena());
+
+  codec_.reset();
+  EXPECT_EQ("host", request_headers->getHostValue());
+  EXPECT_EQ("world", request_trailers->get(LowerCaseString("hello"))[0]->value().getStringView());
+}
+
 // Ensures that requests with invalid HTTP header values are properly rejected
 // when the runtime guard is enabled for the feature.
 TEST_P(Http1ServerConnectionImplTest, HeaderInvalidCharsRejection) {
@@ -2824,6 +2903,57 @@ TEST_P(Http1ClientConnectionImplTest, Reset) {
   request_encoder.getStream().resetStream(StreamResetReason::LocalReset);
 }
 
+// Verify that the responses to pipelined requests are delivered in order, including when they are
+// received in a single read.
+TEST_P(Http1ClientConnectionImplTest, PipelinedResponses) {
+  initialize();
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  NiceMock<MockResponseDecoder> response_decoder1;
+  Http::RequestEncoder& request_encoder1 = codec_->newStream(response_decoder1);
+  TestRequestHeaderMapImpl headers{{":method", "GET"}, {":path", "/"}, {":authority", "host"}};
+  EXPECT_TRUE(request_encoder1.encodeHeaders(headers, true).ok());
+  NiceMock<MockResponseDecoder> response_decoder2;
+  Http::RequestEncoder& request_encoder2 = codec_->newStream(response_decoder2);
+  EXPECT_TRUE(request_encoder2.encodeHeaders(headers, true).ok());
+  EXPECT_EQ("GET / HTTP/1.1\r\nhost: host\r\n\r\nGET / HTTP/1.1\r\nhost: host\r\n\r\n", output);
+
+  InSequence s;
+  EXPECT_CALL(response_decoder1, decodeHeaders_(_, false));
+  EXPECT_CALL(response_decoder1, decodeData(BufferStringEqual("hello"), false));
+  EXPECT_CALL(response_decoder1, decodeData(BufferStringEqual(""), true));
+  EXPECT_CALL(response_decoder2, decodeHeaders_(HeaderValueOf(Headers::get().Status, "503"), true));
+  Buffer::OwnedImpl response("HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello"
+                             "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n");
+  auto status = codec_->dispatch(response);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(0, response.length());
+}
+
+// Verify that resetting one of several pipelined requests resets all of them.
+TEST_P(Http1ClientConnectionImplTest, PipelinedReset) {
+  initialize();
+
+  NiceMock<MockResponseDecoder> response_decoder1;
+  Http::RequestEncoder& request_encoder1 = codec_->newStream(response_decoder1);
+  NiceMock<MockResponseDecoder> response_decoder2;
+  Http::RequestEncoder& request_encoder2 = codec_->newStream(response_decoder2);
+
+  Http::MockStreamCallbacks callbacks1;
+  request_encoder1.getStream().addCallbacks(callbacks1);
+  Http::MockStreamCallbacks callbacks2;
+  request_encoder2.getStream().addCallbacks(callbacks2);
+  EXPECT_CALL(callbacks1, onResetStream(StreamResetReason::LocalReset, _));
+  // Resetting the other request again while it is torn down is tolerated.
+  EXPECT_CALL(callbacks2, onResetStream(StreamResetReason::LocalReset, _))
+      .WillOnce(Invoke([&](StreamResetReason, absl::string_view) {
+        request_encoder2.getStream().resetStream(StreamResetReason::LocalReset);
+      }));
+  request_encoder1.getStream().resetStream(StreamResetReason::LocalReset);
+}
+
 // Verify that we correctly enable reads on the connection when the final response is
 // received.
 TEST_P(Http1ClientConnectionImplTest, FlowControlReadDisabledReenable) {
@@ -3161,6 +3291,44 @@ TEST_P(Http1ClientConnectionImplTest, ResponseWithTrailers) {
   EXPECT_TRUE(status.ok());
 }
 
+// With the runtime guard enabled, the headers and trailers of a response are allocated from one
+// arena, which the maps keep alive once the codec and its stream are destroyed.
+TEST_P(Http1ClientConnectionImplTest, HeaderMapArena) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.http_header_map_arena", "true"}});
+  codec_settings_.enable_trailers_ = true;
+  initialize();
+
+  NiceMock<MockResponseDecoder> response_decoder;
+  Http::RequestEncoder& request_encoder = codec_->newStream(response_decoder);
+  TestRequestHeaderMapImpl request_headers{
+      {":method", "GET"}, {":path", "/"}, {":authority", "host"}};
+  EXPECT_TRUE(request_encoder.encodeHeaders(request_headers, true).ok());
+
+  ResponseHeaderMapPtr response_headers;
+  ResponseTrailerMapPtr response_trailers;
+  EXPECT_CALL(response_decoder, decodeHeaders_(_, false))
+      .WillOnce(Invoke([&](ResponseHeaderMapPtr& headers, bool) {
+        response_headers = std::move(headers);
+      }));
+  EXPECT_CALL(response_decoder, decodeTrailers_(_))
+      .WillOnce(Invoke([&](ResponseTrailerMapPtr& trailers) {
+        response_trailers = std::move(trailers);
+      }));
+  Buffer::OwnedImpl response("HTTP/1.1 200 OK\r\ntransfer-encoding: chunked\r\n\r\n"
+                             "5\r\nHello\r\n0\r\nhello: world\r\n\r\n");
+  EXPECT_TRUE(codec_->dispatch(response).ok());
+  ASSERT_NE(nullptr, response_headers);
+  ASSERT_NE(nullptr, response_trailers);
+  const HeaderMapArena* arena = dynamic_cast<ResponseHeaderMapImpl&>(*response_headers).arena();
+  EXPECT_NE(nullptr, arena);
+  EXPECT_EQ(arena, dynamic_cast<ResponseTrailerMapImpl&>(*response_trailers).arena());
+
+  codec_.reset();
+  EXPECT_EQ("200", response_headers->getStatusValue());
+  EXPECT_EQ("world", response_trailers->get(LowerCaseString("hello"))[0]->value().getStringView());
+}
+
 TEST_P(Http1ClientConnectionImplTest, GiantPath) {
   initialize();
 
@@ -68,7 +68,9 @@ public:
             Upstream::ResourcePriority::Default, dispatcher, nullptr, nullptr, random_generator,
             state_,
             [](HttpConnPoolImplBase* pool) {
-              return std::make_unique<ActiveClient>(*pool, absl::nullopt);
+              return std::make_unique<ActiveClient>(
+                  *pool, absl::nullopt,
+                  pool->host()->cluster().http1Settings().max_pipelined_requests_);
             },
             [](Upstream::Host::CreateConnectionData&, HttpConnPoolImplBase*) {
               return nullptr; // Not used: createCodecClient overloaded.
@@ -411,6 +413,99 @@ TEST_F(Http1ConnPoolImplTest, MultipleRequestAndResponse) {
   dispatcher_.clearDeferredDeleteList();
 }
 
+/**
+ * Test that with pipelining a second request is sent on the connection once the first one has
+ * been encoded, before the first response is received.
+ */
+TEST_F(Http1ConnPoolImplTest, PipelinedRequests) {
+  InSequence s;
+  cluster_->http1_settings_.max_pipelined_requests_ = 2;
+
+  // Request 1 should kick off a new connection, which takes no further request until request 1
+  // has been encoded.
+  ActiveTestRequest r1(*this, 0, ActiveTestRequest::Type::CreateConnection);
+  CHECK_STATE(1 /*active*/, 0 /*pending*/, 0 /*capacity*/);
+  conn_pool_->expectEnableUpstreamReady();
+  r1.startRequest();
+  CHECK_STATE(1 /*active*/, 0 /*pending*/, 1 /*capacity*/);
+
+  // Request 2 is pipelined behind request 1.
+  ActiveTestRequest r2(*this, 0, ActiveTestRequest::Type::Immediate);
+  r2.startRequest();
+  CHECK_STATE(2 /*active*/, 0 /*pending*/, 0 /*capacity*/);
+  EXPECT_EQ(1U, cluster_->traffic_stats_->upstream_rq_pipelined_.value());
+
+  conn_pool_->expectEnableUpstreamReady();
+  r1.completeResponse(false);
+  CHECK_STATE(1 /*active*/, 0 /*pending*/, 1 /*capacity*/);
+  conn_pool_->expectEnableUpstreamReady();
+  r2.completeResponse(true);
+  CHECK_STATE(0 /*active*/, 0 /*pending*/, 2 /*capacity*/);
+
+  // Cause the connection to go away.
+  EXPECT_CALL(*conn_pool_, onClientDestroy());
+  conn_pool_->expectAndRunUpstreamReady();
+  conn_pool_->test_clients_[0].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  dispatcher_.clearDeferredDeleteList();
+}
+
+/**
+ * Test that a request pipelined behind a response which closes the connection is refused.
+ */
+TEST_F(Http1ConnPoolImplTest, PipelinedRequestRefusedOnConnectionClose) {
+  InSequence s;
+  cluster_->http1_settings_.max_pipelined_requests_ = 2;
+
+  ActiveTestRequest r1(*this, 0, ActiveTestRequest::Type::CreateConnection);
+  conn_pool_->expectEnableUpstreamReady();
+  r1.startRequest();
+  ActiveTestRequest r2(*this, 0, ActiveTestRequest::Type::Immediate);
+  r2.startRequest();
+
+  // The upstream does not process request 2 after responding to request 1 with 'connection: close'.
+  Http::MockStreamCallbacks stream_callbacks;
+  r2.request_encoder_.getStream().addCallbacks(stream_callbacks);
+  EXPECT_CALL(stream_callbacks, onResetStream(StreamResetReason::RemoteRefusedStreamReset, _));
+  EXPECT_CALL(*conn_pool_, onClientDestroy());
+  ResponseHeaderMapPtr response_headers(
+      new TestResponseHeaderMapImpl{{":status", "200"}, {"Connection", "Close"}});
+  r1.inner_decoder_->decodeHeaders(std::move(response_headers), true);
+  dispatcher_.clearDeferredDeleteList();
+}
+
+/**
+ * Test that a request pipelined behind a response which the upstream ends by closing the
+ * connection is reset as a connection termination rather than refused.
+ */
+TEST_F(Http1ConnPoolImplTest, PipelinedRequestResetOnRemoteClose) {
+  cluster_->http1_settings_.max_pipelined_requests_ = 2;
+
+  ActiveTestRequest r1(*this, 0, ActiveTestRequest::Type::CreateConnection);
+  conn_pool_->expectEnableUpstreamReady();
+  r1.startRequest();
+  ActiveTestRequest r2(*this, 0, ActiveTestRequest::Type::Immediate);
+  r2.startRequest();
+
+  r1.inner_decoder_->decodeHeaders(
+      ResponseHeaderMapPtr{new TestResponseHeaderMapImpl{{":status", "200"}}}, false);
+
+  // The closed connection delimits the body of response 1, without saying whether request 2 was
+  // processed.
+  Buffer::OwnedImpl empty_data;
+  EXPECT_CALL(*conn_pool_->test_clients_[0].codec_, dispatch(BufferEqual(&empty_data)))
+      .WillOnce(Invoke([&](Buffer::Instance& data) -> Http::Status {
+        // Simulate the onResponseComplete call to decodeData since dispatch is mocked out.
+        r1.inner_decoder_->decodeData(data, true);
+        return Http::okStatus();
+      }));
+  Http::MockStreamCallbacks stream_callbacks;
+  r2.request_encoder_.getStream().addCallbacks(stream_callbacks);
+  EXPECT_CALL(stream_callbacks, onResetStream(StreamResetReason::ConnectionTermination, _));
+  EXPECT_CALL(*conn_pool_, onClientDestroy());
+  conn_pool_->test_clients_[0].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  dispatcher_.clearDeferredDeleteList();
+}
+
 /**
  * Test when we overflow max pending requests.
  */
@@ -640,6 +640,39 @@ TEST_P(Http2CodecImplTest, ShutdownNotice) {
   driveToCompletion();
 }
 
+// With outbound frame coalescing enabled, the DATA frames of a response body are handed to the
+// connection with a single write and are sized to the congestion window of the connection.
+TEST_P(Http2CodecImplTest, CoalesceOutboundFrames) {
+  scoped_runtime_.mergeValues(
+      {{"envoy.reloadable_features.http2_coalesce_outbound_frames", "true"}});
+  ON_CALL(server_connection_, congestionWindowInBytes()).WillByDefault(Return(5000));
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  driveToCompletion();
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  response_encoder_->encodeHeaders(response_headers, false);
+  driveToCompletion();
+
+  EXPECT_CALL(server_connection_, write(_, _))
+      .WillOnce(Invoke(
+          [&](Buffer::Instance& data, bool) -> void { client_wrapper_->buffer_.add(data); }));
+  Buffer::OwnedImpl response_body(std::string(12000, 'b'));
+  response_encoder_->encodeData(response_body, true);
+  testing::Mock::VerifyAndClearExpectations(&server_connection_);
+
+  // 12000 bytes with a 5000 byte congestion window are sent as three DATA frames.
+  EXPECT_CALL(response_decoder_, decodeData(_, false)).Times(2);
+  EXPECT_CALL(response_decoder_, decodeData(_, true));
+  driveToCompletion();
+  EXPECT_TRUE(client_wrapper_->status_.ok());
+}
+
 TEST_P(Http2CodecImplTest, ProtocolErrorForTest) {
   initialize();
   EXPECT_EQ(absl::nullopt, request_encoder_->http1StreamEncoderOptions());
@@ -1085,6 +1118,67 @@ TEST_P(Http2CodecImplTest, TrailingHeaders) {
   driveToCompletion();
 }
 
+// With the runtime guard enabled, the headers and trailers received on a stream are allocated from
+// the arena of the stream, which the maps keep alive once the stream is destroyed.
+TEST_P(Http2CodecImplTest, HeaderMapArena) {
+  scoped_runtime_.mergeValues({{"envoy.reloadable_features.http_header_map_arena", "true"}});
+  initialize();
+
+  RequestHeaderMapSharedPtr request_headers;
+  RequestTrailerMapPtr request_trailers;
+  TestRequestHeaderMapImpl sent_request_headers;
+  HttpTestUtility::addDefaultHeaders(sent_request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false))
+      .WillOnce(Invoke(
+          [&](RequestHeaderMapSharedPtr& headers, bool) { request_headers = headers; }));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(sent_request_headers, false).ok());
+  driveToCompletion();
+  EXPECT_CALL(request_decoder_, decodeTrailers_(_))
+      .WillOnce(Invoke([&](RequestTrailerMapPtr& trailers) {
+        request_trailers = std::move(trailers);
+      }));
+  request_encoder_->encodeTrailers(TestRequestTrailerMapImpl{{"trailing", "request"}});
+  driveToCompletion();
+
+  ResponseHeaderMapPtr response_headers;
+  ResponseTrailerMapPtr response_trailers;
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false))
+      .WillOnce(Invoke([&](ResponseHeaderMapPtr& headers, bool) {
+        response_headers = std::move(headers);
+      }));
+  response_encoder_->encodeHeaders(TestResponseHeaderMapImpl{{":status", "200"}}, false);
+  driveToCompletion();
+  EXPECT_CALL(response_decoder_, decodeTrailers_(_))
+      .WillOnce(Invoke([&](ResponseTrailerMapPtr& trailers) {
+        response_trailers = std::move(trailers);
+      }));
+  response_encoder_->encodeTrailers(TestResponseTrailerMapImpl{{"trailing", "response"}});
+  driveToCompletion();
+
+  ASSERT_NE(nullptr, request_headers);
+  ASSERT_NE(nullptr, request_trailers);
+  ASSERT_NE(nullptr, response_headers);
+  ASSERT_NE(nullptr, response_trailers);
+  const HeaderMapArena* server_arena =
+      dynamic_cast<RequestHeaderMapImpl&>(*request_headers).arena();
+  const HeaderMapArena* client_arena =
+      dynamic_cast<ResponseHeaderMapImpl&>(*response_headers).arena();
+  EXPECT_NE(nullptr, server_arena);
+  EXPECT_NE(nullptr, client_arena);
+  EXPECT_EQ(server_arena, dynamic_cast<RequestTrailerMapImpl&>(*request_trailers).arena());
+  EXPECT_EQ(client_arena, dynamic_cast<ResponseTrailerMapImpl&>(*response_trailers).arena());
+
+  // Destroy the closed streams.
+  client_connection_.dispatcher_.clearDeferredDeleteList();
+  server_connection_.dispatcher_.clearDeferredDeleteList();
+  EXPECT_EQ(sent_request_headers.getPathValue(), request_headers->getPathValue());
+  EXPECT_EQ("request",
+            request_trailers->get(LowerCaseString("trailing"))[0]->value().getStringView());
+  EXPECT_EQ("200", response_headers->getStatusValue());
+  EXPECT_EQ("response",
+            response_trailers->get(LowerCaseString("trailing"))[0]->value().getStringView());
+}
+
 // When having empty trailers, codec submits empty buffer and end_stream instead.
 TEST_P(Http2CodecImplTest, IgnoreTrailingEmptyHeaders) {
   initialize();
@@ -401,6 +401,59 @@ TEST_F(IoUringImplTest, PrepareReadvQueueOverflow) {
   EXPECT_EQ(static_cast<char*>(iov3.iov_base)[1], 'f');
 }
 
+TEST_F(IoUringImplTest, PrepareRecvMultishotWithProvidedBuffers) {
+  if (!io_uring_->registerProvidedBuffers(4, 8)) {
+    GTEST_SKIP() << "provided buffer rings are not supported by the kernel";
+  }
+  os_fd_t fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+
+  auto dispatcher = api_->allocateDispatcher("test_thread");
+
+  os_fd_t event_fd = io_uring_->registerEventfd();
+  const Event::FileTriggerType trigger = Event::PlatformDefaultTriggerType;
+  std::string received;
+  int32_t completions_nr = 0;
+  bool more = false;
+  auto file_event = dispatcher->createFileEvent(
+      event_fd,
+      [this, &received, &completions_nr, &more](uint32_t) {
+        io_uring_->forEveryCompletion(
+            [this, &received, &completions_nr, &more](Request* user_data, int32_t res, bool) {
+              ASSERT_GT(res, 0);
+              const uint32_t flags = user_data->completionFlags();
+              ASSERT_TRUE(flags & IORING_CQE_F_BUFFER);
+              const uint16_t buffer_id = flags >> IORING_CQE_BUFFER_SHIFT;
+              received.append(reinterpret_cast<char*>(io_uring_->providedBuffer(buffer_id)), res);
+              io_uring_->recycleProvidedBuffer(buffer_id);
+              more = flags & IORING_CQE_F_MORE;
+              completions_nr++;
+            });
+        return absl::OkStatus();
+      },
+      trigger, Event::FileReadyType::Read);
+
+  int data = 1;
+  TestRequest request(data);
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->prepareRecvMultishot(fds[0], &request));
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->submit());
+
+  // The single request completes for each write, and the data larger than a provided buffer is
+  // split across buffers.
+  ASSERT_EQ(5, ::write(fds[1], "hello", 5));
+  waitForCondition(*dispatcher, [&received]() { return received == "hello"; });
+  ASSERT_EQ(12, ::write(fds[1], " again world", 12));
+  waitForCondition(*dispatcher, [&received]() { return received == "hello again world"; });
+  EXPECT_GE(completions_nr, 3);
+  EXPECT_TRUE(more);
+
+  // Disarm the request before it goes out of scope.
+  ::close(fds[1]);
+  ::close(fds[0]);
+  io_uring_->unregisterEventfd();
+  file_event.reset();
+}
+
 } // namespace
 } // namespace Io
 } // namespace Envoy
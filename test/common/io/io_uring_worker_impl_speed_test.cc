@@ -0,0 +1,164 @@
+// Compares reading from many connections per worker with the epoll based IoSocketHandleImpl and
+// with the io_uring worker, reading into per request buffers or into provided buffers with
+// multishot recv. Each iteration sends a small request on every connection and runs the event loop
+// until all of them have been read.
+//
+// Note: this should be run with --compilation_mode=opt. The number of system calls, which is what
+// the io_uring variants save, can be compared by running under `strace -c -f`.
+
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "source/common/io/io_uring_impl.h"
+#include "source/common/io/io_uring_worker_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+
+#include "test/benchmark/main.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Io {
+namespace {
+
+constexpr absl::string_view HttpRequest = "GET / HTTP/1.1\r\nhost: example.com\r\n\r\n";
+
+// A set of connected socket pairs. The benchmarks read from the first socket of each pair and
+// write the requests to the second one.
+class Connections {
+public:
+  explicit Connections(::benchmark::State& state) {
+    const uint64_t count = Envoy::benchmark::skipExpensiveBenchmarks() ? 64 : state.range(0);
+    // Two file descriptors per connection, with some room for the rest of the process.
+    rlimit limit;
+    getrlimit(RLIMIT_NOFILE, &limit);
+    if (limit.rlim_cur < 2 * count + 64) {
+      limit.rlim_cur = std::min<rlim_t>(limit.rlim_max, 2 * count + 64);
+      setrlimit(RLIMIT_NOFILE, &limit);
+    }
+    for (uint64_t i = 0; i < count; i++) {
+      os_fd_t fds[2];
+      if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) != 0) {
+        state.SkipWithError("not enough file descriptors for the connections");
+        return;
+      }
+      server_fds_.push_back(fds[0]);
+      client_fds_.push_back(fds[1]);
+    }
+  }
+
+  ~Connections() {
+    for (os_fd_t fd : client_fds_) {
+      ::close(fd);
+    }
+    // The server sockets are owned by the handles under test.
+  }
+
+  void sendRequests() {
+    for (os_fd_t fd : client_fds_) {
+      RELEASE_ASSERT(::write(fd, HttpRequest.data(), HttpRequest.size()) ==
+                         static_cast<ssize_t>(HttpRequest.size()),
+                     "");
+    }
+  }
+
+  uint64_t expectedBytes() const { return client_fds_.size() * HttpRequest.size(); }
+
+  std::vector<os_fd_t> server_fds_;
+  std::vector<os_fd_t> client_fds_;
+};
+
+void runUntil(Event::Dispatcher& dispatcher, const uint64_t& received, uint64_t expected) {
+  while (received < expected) {
+    dispatcher.run(Event::Dispatcher::RunType::NonBlock);
+  }
+}
+
+void epollRead(::benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Connections connections(state);
+  uint64_t received = 0;
+  std::vector<std::unique_ptr<Network::IoSocketHandleImpl>> handles;
+  for (os_fd_t fd : connections.server_fds_) {
+    auto handle = std::make_unique<Network::IoSocketHandleImpl>(fd);
+    handle->initializeFileEvent(
+        *dispatcher,
+        [&received, &handle = *handle](uint32_t) {
+          Buffer::OwnedImpl buffer;
+          while (true) {
+            Api::IoCallUint64Result result = handle.read(buffer, absl::nullopt);
+            if (!result.ok() || result.return_value_ == 0) {
+              break;
+            }
+            received += result.return_value_;
+          }
+          return absl::OkStatus();
+        },
+        Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+    handles.push_back(std::move(handle));
+  }
+
+  uint64_t expected = 0;
+  for (auto _ : state) { // NOLINT(clang-analyzer-deadcode.DeadStores)
+    connections.sendRequests();
+    expected += connections.expectedBytes();
+    runUntil(*dispatcher, received, expected);
+  }
+  state.SetItemsProcessed(state.iterations() * connections.server_fds_.size());
+}
+BENCHMARK(epollRead)->Arg(1000)->Arg(10000)->Unit(::benchmark::kMillisecond);
+
+void ioUringRead(::benchmark::State& state, uint32_t provided_buffer_count) {
+  if (!isIoUringSupported()) {
+    state.SkipWithError("io_uring is not supported");
+    return;
+  }
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Connections connections(state);
+  uint64_t received = 0;
+  {
+    // The rings are sized so that a completion for every connection fits in one event loop
+    // iteration.
+    IoUringWorkerImpl worker(16384, false, 4096, provided_buffer_count, 1000, *dispatcher);
+    if (provided_buffer_count > 0 && !worker.providedBuffersEnabled()) {
+      state.SkipWithError("io_uring provided buffers are not supported");
+      return;
+    }
+    std::vector<IoUringSocket*> sockets;
+    for (os_fd_t fd : connections.server_fds_) {
+      const size_t index = sockets.size();
+      sockets.push_back(&worker.addServerSocket(
+          fd,
+          [&received, &sockets, index](uint32_t) {
+            Buffer::Instance& buffer = sockets[index]->getReadParam()->buf_;
+            received += buffer.length();
+            buffer.drain(buffer.length());
+            return absl::OkStatus();
+          },
+          false));
+    }
+
+    uint64_t expected = 0;
+    for (auto _ : state) { // NOLINT(clang-analyzer-deadcode.DeadStores)
+      connections.sendRequests();
+      expected += connections.expectedBytes();
+      runUntil(*dispatcher, received, expected);
+    }
+    // The worker closes the sockets on destruction.
+  }
+  state.SetItemsProcessed(state.iterations() * connections.server_fds_.size());
+}
+
+void ioUringReadv(::benchmark::State& state) { ioUringRead(state, 0); }
+BENCHMARK(ioUringReadv)->Arg(1000)->Arg(10000)->Unit(::benchmark::kMillisecond);
+
+void ioUringMultishotRecv(::benchmark::State& state) { ioUringRead(state, 1024); }
+BENCHMARK(ioUringMultishotRecv)->Arg(1000)->Arg(10000)->Unit(::benchmark::kMillisecond);
+
+} // namespace
+} // namespace Io
+} // namespace Envoy
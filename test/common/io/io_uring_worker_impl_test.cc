@@ -693,6 +693,154 @@ TEST(IoUringWorkerImplTest, NoEnableReadOnConnectError) {
   delete static_cast<Request*>(connect_req);
 }
 
+TEST(IoUringWorkerImplTest, SubmissionBatching) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher, createFileEvent_(_, _, Event::PlatformDefaultTriggerType,
+                                           Event::FileReadyType::Read));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher);
+  auto* submit_cb = new NiceMock<Event::MockSchedulableCallback>(&dispatcher);
+  worker.enableSubmissionBatching();
+
+  os_fd_t fd;
+  SET_SOCKET_INVALID(fd);
+  auto& io_uring_socket = worker.addTestSocket(fd);
+
+  // Requests prepared outside of completion handling are submitted together at the end of the
+  // event loop iteration.
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(mock_io_uring, prepareShutdown(fd, SHUT_WR, _))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(*submit_cb, scheduleCallbackCurrentIteration()).Times(2);
+  EXPECT_CALL(mock_io_uring, submit()).Times(0);
+  Request* read_req = worker.submitReadRequest(io_uring_socket);
+  Request* shutdown_req = worker.submitShutdownRequest(io_uring_socket, SHUT_WR);
+  EXPECT_TRUE(submit_cb->enabled_);
+  testing::Mock::VerifyAndClearExpectations(&mock_io_uring);
+
+  EXPECT_CALL(mock_io_uring, submit());
+  submit_cb->invokeCallback();
+  delete read_req;
+  delete shutdown_req;
+
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  dynamic_cast<IoUringSocketTestImpl*>(worker.getSockets().front().get())->cleanupForTest();
+  EXPECT_EQ(0, worker.getNumOfSockets());
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+}
+
+TEST(IoUringWorkerImplTest, ServerSocketMultishotRecv) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher);
+
+  // The ring size is rounded up to a power of two.
+  EXPECT_CALL(mock_io_uring, registerProvidedBuffers(4, 8192)).WillOnce(Return(true));
+  EXPECT_TRUE(worker.enableProvidedBuffers(3));
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  // A read enabled server socket arms a multishot recv.
+  Request* recv_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&recv_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  IoUringSocket* socket = nullptr;
+  std::string read_data;
+  auto& io_uring_socket = worker.addServerSocket(
+      fd,
+      [&socket, &read_data](uint32_t events) {
+        EXPECT_EQ(Event::FileReadyType::Read, events);
+        Buffer::Instance& buf = socket->getReadParam()->buf_;
+        read_data.append(buf.toString());
+        buf.drain(buf.length());
+        return absl::OkStatus();
+      },
+      false);
+  socket = &io_uring_socket;
+
+  // The data is copied out of the provided buffer, which goes back to the kernel, and the
+  // multishot recv stays armed.
+  uint8_t provided_buffer[] = "Hello";
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&recv_req](const CompletionCb& cb) {
+        recv_req->setCompletionFlags(IORING_CQE_F_MORE | IORING_CQE_F_BUFFER |
+                                     (2 << IORING_CQE_BUFFER_SHIFT));
+        cb(recv_req, 5, false);
+      }));
+  EXPECT_CALL(mock_io_uring, providedBuffer(2)).WillOnce(Return(provided_buffer));
+  EXPECT_CALL(mock_io_uring, recycleProvidedBuffer(2));
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(_, _)).Times(0);
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("Hello", read_data);
+
+  // Disabling the read cancels the multishot recv.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(recv_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.disableRead();
+
+  // Once the multishot recv is done, a single read watches for the remote close.
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&recv_req, &cancel_req](const CompletionCb& cb) {
+        recv_req->setCompletionFlags(0);
+        cb(recv_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_NE(nullptr, read_req);
+
+  // Close the socket.
+  EXPECT_CALL(mock_io_uring, prepareCancel(read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.close(false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req, &cancel_req](const CompletionCb& cb) {
+        cb(read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
 } // namespace
 } // namespace Io
 } // namespace Envoy
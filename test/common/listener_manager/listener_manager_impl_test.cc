@@ -6306,6 +6306,40 @@ TEST_P(ListenerManagerImplWithRealFiltersTest, ReusePortListenerDisabled) {
   EXPECT_EQ(0, manager_->listeners().size());
 }
 
+TEST_P(ListenerManagerImplWithRealFiltersTest, ReusePortCpuBalance) {
+  auto listener = createIPv4Listener("CpuBalanceListener");
+  listener.mutable_connection_balance_config()->mutable_reuse_port_cpu_balance();
+  listener.mutable_enable_reuse_port()->set_value(false);
+  EXPECT_THROW_WITH_MESSAGE(addOrUpdateListener(listener), EnvoyException,
+                            "listener CpuBalanceListener: reuse_port_cpu_balance can only be used "
+                            "with TCP listeners that have enable_reuse_port set");
+
+  listener.mutable_enable_reuse_port()->set_value(true);
+  listener.mutable_address()->mutable_socket_address()->set_protocol(
+      envoy::config::core::v3::SocketAddress::UDP);
+  EXPECT_THROW_WITH_MESSAGE(addOrUpdateListener(listener), EnvoyException,
+                            "listener CpuBalanceListener: reuse_port_cpu_balance can only be used "
+                            "with TCP listeners that have enable_reuse_port set");
+  EXPECT_EQ(0, manager_->listeners().size());
+
+  if (default_bind_type != ListenerComponentFactory::BindType::ReusePort ||
+      !ENVOY_SOCKET_SO_ATTACH_REUSEPORT_CBPF.hasValue()) {
+    return;
+  }
+  listener.mutable_address()->mutable_socket_address()->set_protocol(
+      envoy::config::core::v3::SocketAddress::TCP);
+  listener.mutable_address()->mutable_socket_address()->set_port_value(0);
+  // The steering program is attached once the socket is listening.
+  expectCreateListenSocket(envoy::config::core::v3::SocketOption::STATE_LISTENING,
+                           /* expected_num_options */ 2, default_bind_type);
+  EXPECT_CALL(*listener_factory_.socket_,
+              setSocketOption(ENVOY_SOCKET_SO_ATTACH_REUSEPORT_CBPF.level(),
+                              ENVOY_SOCKET_SO_ATTACH_REUSEPORT_CBPF.option(), _, _))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  addOrUpdateListener(listener);
+  EXPECT_EQ(1, manager_->listeners().size());
+}
+
 // Envoy throws exceptions for UDP listener with dynamic filter config.
 TEST_P(ListenerManagerImplWithRealFiltersTest, UdpListenerWithDynamicFilterConfig) {
   auto listener = createIPv4Listener("UdpListener");
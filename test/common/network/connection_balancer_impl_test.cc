@@ -0,0 +1,101 @@
+#include "envoy/event/dispatcher.h"
+
+#include "source/common/network/connection_balancer_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class TestHandler : public BalancedConnectionHandler {
+public:
+  // BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  const Event::DispatcherLoad& load() const override { return load_; }
+  void post(ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(ConnectionSocketPtr&&, bool, bool) override {}
+
+  uint64_t num_connections_{};
+  Event::DispatcherLoad load_;
+};
+
+class LoadAwareConnectionBalancerTest : public testing::Test {
+protected:
+  void initialize(const std::string& yaml) {
+    envoy::config::listener::v3::Listener::ConnectionBalanceConfig::LoadAwareBalance config;
+    TestUtility::loadFromYaml(yaml, config);
+    balancer_ = std::make_unique<LoadAwareConnectionBalancerImpl>(config);
+    balancer_->registerHandler(handler1_);
+    balancer_->registerHandler(handler2_);
+  }
+
+  TestHandler handler1_;
+  TestHandler handler2_;
+  std::unique_ptr<LoadAwareConnectionBalancerImpl> balancer_;
+};
+
+TEST_F(LoadAwareConnectionBalancerTest, DefaultWeights) {
+  initialize("{}");
+  handler1_.num_connections_ = 2;
+  handler1_.load_.active_streams_ = 3;
+  handler1_.load_.event_loop_lag_us_ = 2500;
+  handler1_.load_.cpu_utilization_permille_ = 455;
+  // 2 connections + 3 streams + 10 * 2ms + 45%.
+  EXPECT_EQ(70, balancer_->handlerLoad(handler1_));
+  EXPECT_EQ(0, balancer_->handlerLoad(handler2_));
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, CustomWeights) {
+  initialize(R"EOF(
+connection_weight: 0
+active_stream_weight: 2
+event_loop_lag_weight: 1
+cpu_utilization_weight: 0
+)EOF");
+  handler1_.num_connections_ = 2;
+  handler1_.load_.active_streams_ = 3;
+  handler1_.load_.event_loop_lag_us_ = 2500;
+  handler1_.load_.cpu_utilization_permille_ = 455;
+  EXPECT_EQ(8, balancer_->handlerLoad(handler1_));
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, PicksLeastLoadedHandler) {
+  initialize("{}");
+  handler1_.load_.active_streams_ = 10;
+  EXPECT_EQ(&handler2_, &balancer_->pickTargetHandler(handler1_));
+  EXPECT_EQ(1, handler2_.num_connections_);
+  EXPECT_EQ(0, handler1_.num_connections_);
+
+  // Ties keep the connection on the accepting handler.
+  handler2_.load_.active_streams_ = 9;
+  EXPECT_EQ(&handler1_, &balancer_->pickTargetHandler(handler1_));
+  EXPECT_EQ(1, handler1_.num_connections_);
+  EXPECT_EQ(&handler2_, &balancer_->pickTargetHandler(handler2_));
+  EXPECT_EQ(2, handler2_.num_connections_);
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, HandoffThreshold) {
+  initialize("handoff_threshold: 5");
+  handler1_.load_.active_streams_ = 5;
+  EXPECT_EQ(&handler1_, &balancer_->pickTargetHandler(handler1_));
+  EXPECT_EQ(1, handler1_.num_connections_);
+
+  handler1_.load_.active_streams_ = 6;
+  EXPECT_EQ(&handler2_, &balancer_->pickTargetHandler(handler1_));
+  EXPECT_EQ(1, handler2_.num_connections_);
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, UnregisteredHandlerIsNotPicked) {
+  initialize("{}");
+  handler1_.load_.active_streams_ = 10;
+  balancer_->unregisterHandler(handler2_);
+  EXPECT_EQ(&handler1_, &balancer_->pickTargetHandler(handler1_));
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
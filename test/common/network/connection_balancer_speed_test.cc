@@ -0,0 +1,104 @@
+// Compares the connection balancers on a skewed workload: a few of the connections carry many
+// more streams than the others, as is typical of long lived HTTP/2 connections. Connections are
+// accepted by a random worker, as with SO_REUSEPORT, and each benchmark reports the ratio of the
+// most loaded worker's streams to the mean, besides the cost of picking a handler.
+
+#include <random>
+
+#include "envoy/event/dispatcher.h"
+
+#include "source/common/network/connection_balancer_impl.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+constexpr uint32_t NumWorkers = 8;
+constexpr uint32_t MaxConnections = 1024;
+// One in HeavyConnectionRatio connections carries HeavyConnectionStreams streams, the others one.
+constexpr uint32_t HeavyConnectionRatio = 16;
+constexpr uint64_t HeavyConnectionStreams = 100;
+
+class FakeHandler : public BalancedConnectionHandler {
+public:
+  // BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  const Event::DispatcherLoad& load() const override { return load_; }
+  void post(ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(ConnectionSocketPtr&&, bool, bool) override {}
+
+  std::atomic<uint64_t> num_connections_{};
+  Event::DispatcherLoad load_;
+};
+
+struct Connection {
+  FakeHandler* handler_;
+  uint64_t streams_;
+};
+
+void runSkewedWorkload(::benchmark::State& state, ConnectionBalancer& balancer) {
+  std::vector<FakeHandler> handlers(NumWorkers);
+  for (auto& handler : handlers) {
+    balancer.registerHandler(handler);
+  }
+  std::mt19937_64 rng(42);
+  std::vector<Connection> connections;
+  connections.reserve(MaxConnections);
+
+  for (auto _ : state) { // NOLINT(clang-analyzer-deadcode.DeadStores)
+    if (connections.size() == MaxConnections) {
+      // Close a random connection to make room for the new one.
+      const size_t index = rng() % connections.size();
+      Connection& closed = connections[index];
+      --closed.handler_->num_connections_;
+      closed.handler_->load_.active_streams_ -= closed.streams_;
+      closed = connections.back();
+      connections.pop_back();
+    }
+    FakeHandler& accepting = handlers[rng() % NumWorkers];
+    auto& target = static_cast<FakeHandler&>(balancer.pickTargetHandler(accepting));
+    const uint64_t streams = rng() % HeavyConnectionRatio == 0 ? HeavyConnectionStreams : 1;
+    target.load_.active_streams_ += streams;
+    connections.push_back({&target, streams});
+  }
+
+  uint64_t total_streams = 0;
+  uint64_t max_streams = 0;
+  for (auto& handler : handlers) {
+    const uint64_t streams = handler.load_.active_streams_;
+    total_streams += streams;
+    max_streams = std::max(max_streams, streams);
+    balancer.unregisterHandler(handler);
+  }
+  if (total_streams > 0) {
+    state.counters["max_to_mean_streams"] =
+        static_cast<double>(max_streams) * NumWorkers / total_streams;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void nopBalancer(::benchmark::State& state) {
+  NopConnectionBalancerImpl balancer;
+  runSkewedWorkload(state, balancer);
+}
+BENCHMARK(nopBalancer);
+
+void exactBalancer(::benchmark::State& state) {
+  ExactConnectionBalancerImpl balancer;
+  runSkewedWorkload(state, balancer);
+}
+BENCHMARK(exactBalancer);
+
+void loadAwareBalancer(::benchmark::State& state) {
+  LoadAwareConnectionBalancerImpl balancer(
+      envoy::config::listener::v3::Listener::ConnectionBalanceConfig::LoadAwareBalance{});
+  runSkewedWorkload(state, balancer);
+}
+BENCHMARK(loadAwareBalancer);
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -816,8 +816,10 @@ TEST_P(ConnectionImplTest, ServerResetClose) {
 
 struct MockConnectionStats {
   Connection::ConnectionStats toBufferStats() {
-    return {rx_total_,   rx_current_,   tx_total_,
-            tx_current_, &bind_errors_, &delayed_close_timeouts_};
+    return {rx_total_,     rx_current_,
+            tx_total_,     tx_current_,
+            &bind_errors_, &delayed_close_timeouts_,
+            nullptr,       nullptr};
   }
 
   StrictMock<Stats::MockCounter> rx_total_;
@@ -830,8 +832,10 @@ struct MockConnectionStats {
 
 struct NiceMockConnectionStats {
   Connection::ConnectionStats toBufferStats() {
-    return {rx_total_,   rx_current_,   tx_total_,
-            tx_current_, &bind_errors_, &delayed_close_timeouts_};
+    return {rx_total_,     rx_current_,
+            tx_total_,     tx_current_,
+            &bind_errors_, &delayed_close_timeouts_,
+            nullptr,       nullptr};
   }
 
   NiceMock<Stats::MockCounter> rx_total_;
@@ -3819,6 +3823,38 @@ TEST_F(MockTransportConnectionImplTest, HalfCloseWrite) {
   connection_->write(buffer, true);
 }
 
+// Test that a flushed close waits for the bytes that the transport socket writes from outside the
+// write buffer, such as spliced bytes.
+TEST_F(MockTransportConnectionImplTest, FlushWriteWaitsForTransportPendingBytes) {
+  initializeConnection();
+  uint64_t pending_bytes = 10;
+  ON_CALL(*transport_socket_, canFlushClose()).WillByDefault(Return(true));
+  ON_CALL(*transport_socket_, pendingWriteBytes()).WillByDefault(Invoke([&pending_bytes]() {
+    return pending_bytes;
+  }));
+
+  EXPECT_CALL(callbacks_, onEvent(_)).Times(0);
+  connection_->close(ConnectionCloseType::FlushWrite);
+  EXPECT_EQ(Connection::State::Closing, connection_->state());
+
+  EXPECT_CALL(*transport_socket_, doWrite(_, _))
+      .WillOnce(Invoke([&pending_bytes](Buffer::Instance&, bool) -> IoResult {
+        pending_bytes = 4;
+        return {PostIoAction::KeepOpen, 6, false};
+      }));
+  EXPECT_TRUE(file_ready_cb_(Event::FileReadyType::Write).ok());
+  EXPECT_EQ(Connection::State::Closing, connection_->state());
+
+  EXPECT_CALL(*transport_socket_, doWrite(_, _))
+      .WillOnce(Invoke([&pending_bytes](Buffer::Instance&, bool) -> IoResult {
+        pending_bytes = 0;
+        return {PostIoAction::KeepOpen, 4, false};
+      }));
+  EXPECT_CALL(callbacks_, onEvent(ConnectionEvent::LocalClose));
+  EXPECT_TRUE(file_ready_cb_(Event::FileReadyType::Write).ok());
+  EXPECT_EQ(Connection::State::Closed, connection_->state());
+}
+
 TEST_F(MockTransportConnectionImplTest, ReadMultipleEndStream) {
   initializeConnection();
   std::shared_ptr<MockReadFilter> read_filter(new NiceMock<MockReadFilter>());
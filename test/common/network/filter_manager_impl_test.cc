@@ -117,6 +117,26 @@ TEST_F(NetworkFilterManagerTest, All) {
   manager.onWrite();
 }
 
+TEST_F(NetworkFilterManagerTest, HasSingleDataFilter) {
+  FilterManagerImpl manager(connection_, socket_);
+  EXPECT_FALSE(manager.hasSingleDataFilter());
+
+  auto read_filter = std::make_shared<NiceMock<MockReadFilter>>();
+  manager.addReadFilter(read_filter);
+  EXPECT_TRUE(manager.hasSingleDataFilter());
+
+  auto other_read_filter = std::make_shared<NiceMock<MockReadFilter>>();
+  manager.addReadFilter(other_read_filter);
+  EXPECT_FALSE(manager.hasSingleDataFilter());
+
+  // Removed filters no longer see the data.
+  manager.removeReadFilter(other_read_filter);
+  EXPECT_TRUE(manager.hasSingleDataFilter());
+
+  manager.addWriteFilter(std::make_shared<NiceMock<MockWriteFilter>>());
+  EXPECT_FALSE(manager.hasSingleDataFilter());
+}
+
 TEST_F(NetworkFilterManagerTest, ConnectionClosedBeforeRunningFilter) {
   InSequence s;
 
@@ -1,3 +1,8 @@
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#endif
+
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_error_impl.h"
@@ -5,6 +10,7 @@
 #include "source/common/network/listen_socket_impl.h"
 
 #include "test/mocks/api/mocks.h"
+#include "test/mocks/event/mocks.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/network_utility.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
@@ -225,6 +231,234 @@ TEST(IoSocketHandleImpl, DroppedUdpDatagramsMsg) {
   EXPECT_EQ(dropped_packets, 5);
 }
 
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+// Returns a recvmsg() result carrying a zero copy notification for the sends first to last.
+Api::SysCallSizeResult zeroCopyNotification(msghdr* msg_hdr, uint32_t first, uint32_t last,
+                                            bool copied) {
+  sock_extended_err err{};
+  err.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+  err.ee_code = copied ? SO_EE_CODE_ZEROCOPY_COPIED : 0;
+  err.ee_info = first;
+  err.ee_data = last;
+  struct cmsghdr* cmsg = reinterpret_cast<struct cmsghdr*>(msg_hdr->msg_control);
+  cmsg->cmsg_level = SOL_IP;
+  cmsg->cmsg_type = IP_RECVERR;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(err));
+  memcpy(CMSG_DATA(cmsg), &err, sizeof(err));
+  msg_hdr->msg_controllen = CMSG_SPACE(sizeof(err));
+  return {0, 0};
+}
+
+TEST(IoSocketHandleImpl, ZeroCopySend) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  IoSocketHandleImpl io_handle(42);
+
+  EXPECT_CALL(os_sys_calls, setsockopt_(42, SOL_SOCKET, SO_ZEROCOPY, _, _)).WillOnce(Return(0));
+  ASSERT_TRUE(io_handle.enableZeroCopySend(1024));
+  EXPECT_TRUE(io_handle.zeroCopySendEnabled());
+
+  // Small writes are copied.
+  Buffer::OwnedImpl small("hello");
+  EXPECT_CALL(os_sys_calls, send(42, _, 5, 0)).WillOnce(Return(Api::SysCallSizeResult{5, 0}));
+  EXPECT_EQ(5, io_handle.write(small).return_value_);
+
+  // Large writes are sent without copying and their memory is kept until the kernel is done.
+  const std::string data(2048, 'a');
+  bool released = false;
+  auto fragment = OwnedBufferFragmentImpl::create(
+      data, [&released](const OwnedBufferFragmentImpl*) { released = true; });
+  Buffer::OwnedImpl large;
+  large.addBufferFragment(*fragment);
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{2048, 0}));
+  EXPECT_EQ(2048, io_handle.write(large).return_value_);
+  EXPECT_EQ(0, large.length());
+  EXPECT_FALSE(released);
+
+  EXPECT_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillOnce(Invoke([](os_fd_t, msghdr* msg_hdr, int) {
+        return zeroCopyNotification(msg_hdr, 0, 0, false);
+      }));
+  IoSocketHandleImpl::ZeroCopySendStats stats = io_handle.processZeroCopySendCompletions();
+  EXPECT_TRUE(released);
+  EXPECT_EQ(1, stats.completed_);
+  EXPECT_EQ(0, stats.fallbacks_);
+
+  // Nothing is pending, the error queue is not read anymore.
+  EXPECT_CALL(os_sys_calls, recvmsg(_, _, _)).Times(0);
+  stats = io_handle.processZeroCopySendCompletions();
+  EXPECT_EQ(0, stats.completed_);
+
+  // Writes are copied when the kernel can't track more zero copy sends.
+  Buffer::OwnedImpl retry(data);
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, ENOBUFS}));
+  EXPECT_CALL(os_sys_calls, send(42, _, 2048, 0)).WillOnce(Return(Api::SysCallSizeResult{2048, 0}));
+  EXPECT_EQ(2048, io_handle.write(retry).return_value_);
+  stats = io_handle.processZeroCopySendCompletions();
+  EXPECT_EQ(0, stats.completed_);
+  EXPECT_EQ(1, stats.fallbacks_);
+}
+
+TEST(IoSocketHandleImpl, ZeroCopySendCopiedByKernel) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  IoSocketHandleImpl io_handle(42);
+  ASSERT_TRUE(io_handle.enableZeroCopySend(1));
+
+  // Two sends, the second one only partially accepted.
+  Buffer::OwnedImpl buffer("hello world");
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{6, 0}))
+      .WillOnce(Return(Api::SysCallSizeResult{3, 0}));
+  EXPECT_EQ(6, io_handle.write(buffer).return_value_);
+  EXPECT_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}));
+  EXPECT_EQ(3, io_handle.write(buffer).return_value_);
+  EXPECT_EQ("ld", buffer.toString());
+
+  // A single notification covers both sends, which the kernel copied, e.g. over loopback.
+  EXPECT_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillOnce(Invoke([](os_fd_t, msghdr* msg_hdr, int) {
+        return zeroCopyNotification(msg_hdr, 0, 1, true);
+      }));
+  const IoSocketHandleImpl::ZeroCopySendStats stats = io_handle.processZeroCopySendCompletions();
+  EXPECT_EQ(0, stats.completed_);
+  EXPECT_EQ(2, stats.fallbacks_);
+}
+
+TEST(IoSocketHandleImpl, ZeroCopySendUnsupported) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  IoSocketHandleImpl io_handle(42);
+  ASSERT_TRUE(io_handle.enableZeroCopySend(1));
+
+  // The socket rejects MSG_ZEROCOPY, the write is copied and so are all further writes.
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EOPNOTSUPP}));
+  EXPECT_CALL(os_sys_calls, send(42, _, 5, 0)).WillOnce(Return(Api::SysCallSizeResult{5, 0}));
+  EXPECT_EQ(5, io_handle.write(buffer).return_value_);
+
+  buffer.add("world");
+  EXPECT_CALL(os_sys_calls, send(42, _, 5, 0)).WillOnce(Return(Api::SysCallSizeResult{5, 0}));
+  EXPECT_EQ(5, io_handle.write(buffer).return_value_);
+  EXPECT_EQ(1, io_handle.processZeroCopySendCompletions().fallbacks_);
+
+  // Other errors are returned to the caller.
+  IoSocketHandleImpl other_handle(43);
+  ASSERT_TRUE(other_handle.enableZeroCopySend(1));
+  buffer.add("hello");
+  EXPECT_CALL(os_sys_calls, sendmsg(43, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EPIPE}));
+  EXPECT_EQ(EPIPE, other_handle.write(buffer).err_->getSystemErrorCode());
+  EXPECT_EQ(5, buffer.length());
+
+  // Zero copy sends can also be disabled explicitly.
+  other_handle.disableZeroCopySend();
+  EXPECT_CALL(os_sys_calls, send(43, _, 5, 0)).WillOnce(Return(Api::SysCallSizeResult{5, 0}));
+  EXPECT_EQ(5, other_handle.write(buffer).return_value_);
+}
+
+TEST(IoSocketHandleImpl, ZeroCopySendPendingAtClose) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  IoSocketHandleImpl io_handle(42);
+  ASSERT_TRUE(io_handle.enableZeroCopySend(1));
+
+  const std::string data(2048, 'a');
+  bool released = false;
+  auto fragment = OwnedBufferFragmentImpl::create(
+      data, [&released](const OwnedBufferFragmentImpl*) { released = true; });
+  Buffer::OwnedImpl buffer;
+  buffer.addBufferFragment(*fragment);
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{2048, 0}));
+  EXPECT_EQ(2048, io_handle.write(buffer).return_value_);
+
+  // The send has not completed when the handle is closed, so the socket is only shut down and the
+  // slices stay alive.
+  EXPECT_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}));
+  EXPECT_CALL(os_sys_calls, shutdown(42, ENVOY_SHUT_RDWR));
+  EXPECT_CALL(os_sys_calls, close(42)).Times(0);
+  EXPECT_TRUE(io_handle.close().ok());
+  EXPECT_FALSE(io_handle.isOpen());
+  EXPECT_FALSE(released);
+
+  // Another handle of the thread polls the closed socket, which is closed once its send completed.
+  IoSocketHandleImpl other_handle(43);
+  ASSERT_TRUE(other_handle.enableZeroCopySend(1024));
+  Buffer::OwnedImpl small("hello");
+  EXPECT_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}))
+      .WillOnce(Invoke([](os_fd_t, msghdr* msg_hdr, int) {
+        return zeroCopyNotification(msg_hdr, 0, 0, false);
+      }));
+  EXPECT_CALL(os_sys_calls, send(43, _, 5, 0)).WillRepeatedly(Return(Api::SysCallSizeResult{5, 0}));
+  EXPECT_EQ(5, other_handle.write(small).return_value_);
+  EXPECT_FALSE(released);
+
+  EXPECT_CALL(os_sys_calls, close(42));
+  small.add("hello");
+  EXPECT_EQ(5, other_handle.write(small).return_value_);
+  EXPECT_TRUE(released);
+}
+
+TEST(IoSocketHandleImpl, ZeroCopySendPendingAtCloseReapedByFileEvent) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  NiceMock<Event::MockDispatcher> dispatcher;
+  IoSocketHandleImpl io_handle(42);
+  ASSERT_TRUE(io_handle.enableZeroCopySend(1));
+  EXPECT_CALL(dispatcher, createFileEvent_(42, _, _, _))
+      .WillOnce(Return(new NiceMock<Event::MockFileEvent>()));
+  io_handle.initializeFileEvent(
+      dispatcher, [](uint32_t) { return absl::OkStatus(); }, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read | Event::FileReadyType::Write);
+
+  const std::string data(2048, 'a');
+  bool released = false;
+  auto fragment = OwnedBufferFragmentImpl::create(
+      data, [&released](const OwnedBufferFragmentImpl*) { released = true; });
+  Buffer::OwnedImpl buffer;
+  buffer.addBufferFragment(*fragment);
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{2048, 0}));
+  EXPECT_EQ(2048, io_handle.write(buffer).return_value_);
+
+  // Closing the handle with the send pending watches the error queue of the socket.
+  Event::FileReadyCb closed_cb;
+  EXPECT_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}));
+  EXPECT_CALL(os_sys_calls, shutdown(42, ENVOY_SHUT_RDWR));
+  EXPECT_CALL(dispatcher, createFileEvent_(42, _, _, Event::FileReadyType::Read))
+      .WillOnce(Invoke([&closed_cb](os_fd_t, Event::FileReadyCb cb, Event::FileTriggerType,
+                                    uint32_t) -> Event::FileEvent* {
+        closed_cb = cb;
+        return new NiceMock<Event::MockFileEvent>();
+      }));
+  EXPECT_CALL(os_sys_calls, close(42)).Times(0);
+  EXPECT_TRUE(io_handle.close().ok());
+  EXPECT_FALSE(released);
+
+  // Without any other zero copy traffic on the thread, the socket is closed once the event reports
+  // that its send completed.
+  EXPECT_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}))
+      .WillOnce(Invoke([](os_fd_t, msghdr* msg_hdr, int) {
+        return zeroCopyNotification(msg_hdr, 0, 0, false);
+      }));
+  EXPECT_TRUE(closed_cb(Event::FileReadyType::Read).ok());
+  EXPECT_FALSE(released);
+
+  EXPECT_CALL(os_sys_calls, close(42));
+  EXPECT_TRUE(closed_cb(Event::FileReadyType::Read).ok());
+  EXPECT_TRUE(released);
+}
+#endif
+
 TEST(IoSocketHandleImpl, DroppedUdpDatagramsMmsg) {
   NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
   auto os_calls =
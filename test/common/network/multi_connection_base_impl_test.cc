@@ -756,7 +756,8 @@ TEST_F(MultiConnectionBaseImplTest, SetConnectionStats) {
   StrictMock<Stats::MockCounter> delayed_close_timeouts;
 
   Connection::ConnectionStats cs = {rx_total,   rx_current,   tx_total,
-                                    tx_current, &bind_errors, &delayed_close_timeouts};
+                                    tx_current, &bind_errors, &delayed_close_timeouts,
+                                    nullptr,    nullptr};
   EXPECT_CALL(*createdConnections()[0], setConnectionStats(_))
       .WillOnce(Invoke([&](const Connection::ConnectionStats& s) -> void { EXPECT_EQ(&s, &cs); }));
   impl_->setConnectionStats(cs);
@@ -774,7 +775,8 @@ TEST_F(MultiConnectionBaseImplTest, SetConnectionStats) {
 
   // Verify that setConnectionStats calls are delegated to the remaining connection.
   Connection::ConnectionStats cs2 = {rx_total,   rx_current,   tx_total,
-                                     tx_current, &bind_errors, &delayed_close_timeouts};
+                                     tx_current, &bind_errors, &delayed_close_timeouts,
+                                     nullptr,    nullptr};
   EXPECT_CALL(*createdConnections()[1], setConnectionStats(_))
       .WillOnce(Invoke([&](const Connection::ConnectionStats& s) -> void { EXPECT_EQ(&s, &cs2); }));
   impl_->setConnectionStats(cs2);
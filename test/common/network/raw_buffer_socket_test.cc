@@ -1,10 +1,23 @@
+#include <sys/socket.h>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/raw_buffer_socket.h"
 #include "source/common/network/transport_socket_options_impl.h"
 
+#include "test/mocks/network/io_handle.h"
+#include "test/mocks/network/mocks.h"
 #include "test/test_common/network_utility.h"
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+
 namespace Envoy {
 namespace Network {
 
@@ -19,5 +32,114 @@ TEST(RawBufferSocketFactory, RawBufferSocketFactory) {
   EXPECT_GT(keys.size(), 0);
 }
 
+#if defined(__linux__)
+
+class RawBufferSocketSpliceTest : public testing::Test {
+protected:
+  void SetUp() override {
+    int fds[2];
+    RELEASE_ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0, "");
+    source_peer_ = std::make_unique<IoSocketHandleImpl>(fds[0]);
+    source_local_ = std::make_unique<IoSocketHandleImpl>(fds[1]);
+    RELEASE_ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0, "");
+    sink_local_ = std::make_unique<IoSocketHandleImpl>(fds[0]);
+    sink_peer_ = std::make_unique<IoSocketHandleImpl>(fds[1]);
+
+    // The sockets are driven through mock handles, so that waking up the sink can be observed.
+    ON_CALL(source_io_handle_, fdDoNotUse()).WillByDefault(Return(source_local_->fdDoNotUse()));
+    ON_CALL(sink_io_handle_, fdDoNotUse()).WillByDefault(Return(sink_local_->fdDoNotUse()));
+    ON_CALL(sink_io_handle_, write(_)).WillByDefault(Invoke([this](Buffer::Instance& buffer) {
+      return sink_local_->write(buffer);
+    }));
+    ON_CALL(source_callbacks_, ioHandle()).WillByDefault(ReturnRef(source_io_handle_));
+    ON_CALL(sink_callbacks_, ioHandle()).WillByDefault(ReturnRef(sink_io_handle_));
+    source_.setTransportSocketCallbacks(source_callbacks_);
+    sink_.setTransportSocketCallbacks(sink_callbacks_);
+
+    pipe_ = SplicePipe::create();
+    ASSERT_NE(nullptr, pipe_);
+    source_.setSplicePipes(pipe_, nullptr);
+    sink_.setSplicePipes(nullptr, pipe_);
+  }
+
+  std::string readAvailable(IoHandle& io_handle) {
+    Buffer::OwnedImpl buffer;
+    io_handle.read(buffer, 1024);
+    return buffer.toString();
+  }
+
+  IoHandlePtr source_peer_;
+  IoHandlePtr source_local_;
+  IoHandlePtr sink_local_;
+  IoHandlePtr sink_peer_;
+  NiceMock<MockIoHandle> source_io_handle_;
+  NiceMock<MockIoHandle> sink_io_handle_;
+  NiceMock<MockTransportSocketCallbacks> source_callbacks_;
+  NiceMock<MockTransportSocketCallbacks> sink_callbacks_;
+  SplicePipeSharedPtr pipe_;
+  RawBufferSocket source_;
+  RawBufferSocket sink_;
+};
+
+// Bytes read by the source are moved into the pipe instead of the read buffer, and are written out
+// by the sink ahead of its write buffer.
+TEST_F(RawBufferSocketSpliceTest, MovesBytesThroughPipe) {
+  Buffer::OwnedImpl data("hello");
+  ASSERT_TRUE(source_peer_->write(data).ok());
+
+  EXPECT_CALL(sink_io_handle_, activateFileEvents(Event::FileReadyType::Write)).Times(2);
+  Buffer::OwnedImpl read_buffer;
+  IoResult result = source_.doRead(read_buffer);
+  EXPECT_EQ(PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(5, result.bytes_processed_);
+  EXPECT_FALSE(result.end_stream_read_);
+  EXPECT_EQ(0, read_buffer.length());
+  EXPECT_EQ(5, sink_.pendingWriteBytes());
+
+  // The source does not read more while the sink has not drained the pipe.
+  data.add("again");
+  ASSERT_TRUE(source_peer_->write(data).ok());
+  result = source_.doRead(read_buffer);
+  EXPECT_EQ(0, result.bytes_processed_);
+  EXPECT_EQ(5, sink_.pendingWriteBytes());
+
+  // Draining the pipe resumes reading on the source.
+  EXPECT_CALL(source_callbacks_, setTransportSocketIsReadable());
+  Buffer::OwnedImpl write_buffer("world");
+  result = sink_.doWrite(write_buffer, false);
+  EXPECT_EQ(PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(10, result.bytes_processed_);
+  EXPECT_EQ(0, sink_.pendingWriteBytes());
+  EXPECT_EQ("helloworld", readAvailable(*sink_peer_));
+
+  EXPECT_CALL(sink_io_handle_, activateFileEvents(Event::FileReadyType::Write));
+  result = source_.doRead(read_buffer);
+  EXPECT_EQ(5, result.bytes_processed_);
+  EXPECT_CALL(source_callbacks_, setTransportSocketIsReadable());
+  result = sink_.doWrite(write_buffer, false);
+  EXPECT_EQ(5, result.bytes_processed_);
+  EXPECT_EQ("again", readAvailable(*sink_peer_));
+
+  // The end of stream is reported once the pipe is empty.
+  source_peer_->close();
+  result = source_.doRead(read_buffer);
+  EXPECT_EQ(0, result.bytes_processed_);
+  EXPECT_TRUE(result.end_stream_read_);
+}
+
+// A closed socket no longer wakes up its peer, and is no longer woken up by it.
+TEST_F(RawBufferSocketSpliceTest, CloseUnregistersFromPipe) {
+  sink_.closeSocket(ConnectionEvent::LocalClose);
+  Buffer::OwnedImpl data("hello");
+  ASSERT_TRUE(source_peer_->write(data).ok());
+
+  EXPECT_CALL(sink_io_handle_, activateFileEvents(_)).Times(0);
+  Buffer::OwnedImpl read_buffer;
+  EXPECT_EQ(5, source_.doRead(read_buffer).bytes_processed_);
+  EXPECT_EQ(0, sink_.pendingWriteBytes());
+}
+
+#endif
+
 } // namespace Network
 } // namespace Envoy
@@ -0,0 +1,87 @@
+#include "source/common/network/reuse_port_cpu_steering_option_impl.h"
+
+#include "test/common/network/socket_option_test.h"
+
+#include "gtest/gtest.h"
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+using testing::Return;
+
+class ReusePortCpuSteeringOptionImplTest : public SocketOptionTest {};
+
+TEST_F(ReusePortCpuSteeringOptionImplTest, IgnoresOptionOnDifferentState) {
+  ReusePortCpuSteeringOptionImpl socket_option{4};
+  EXPECT_CALL(socket_, setSocketOption(_, _, _, _)).Times(0);
+  EXPECT_TRUE(
+      socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_PREBIND));
+  EXPECT_TRUE(socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_BOUND));
+  EXPECT_FALSE(socket_option.getOptionDetails(socket_,
+                                              envoy::config::core::v3::SocketOption::STATE_BOUND));
+}
+
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+TEST_F(ReusePortCpuSteeringOptionImplTest, AttachesProgram) {
+  ReusePortCpuSteeringOptionImpl socket_option{4};
+  EXPECT_TRUE(socket_option.isSupported());
+  EXPECT_CALL(socket_, setSocketOption(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, _, sizeof(sock_fprog)))
+      .WillOnce(Invoke([](int, int, const void* optval, socklen_t) -> Api::SysCallIntResult {
+        const auto* program = static_cast<const sock_fprog*>(optval);
+        EXPECT_EQ(3, program->len);
+        // The program loads the CPU, takes it modulo the number of workers and returns it.
+        EXPECT_EQ(static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU), program->filter[0].k);
+        EXPECT_EQ(BPF_ALU | BPF_MOD | BPF_K, program->filter[1].code);
+        EXPECT_EQ(4U, program->filter[1].k);
+        EXPECT_EQ(BPF_RET | BPF_A, program->filter[2].code);
+        return {0, 0};
+      }));
+  EXPECT_TRUE(
+      socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_LISTENING));
+
+  auto details = socket_option.getOptionDetails(
+      socket_, envoy::config::core::v3::SocketOption::STATE_LISTENING);
+  ASSERT_TRUE(details.has_value());
+  EXPECT_EQ(ENVOY_SOCKET_SO_ATTACH_REUSEPORT_CBPF, details->name_);
+  EXPECT_EQ("4", details->value_);
+}
+
+TEST_F(ReusePortCpuSteeringOptionImplTest, FailsOnSyscallFailure) {
+  ReusePortCpuSteeringOptionImpl socket_option{4};
+  EXPECT_CALL(socket_, setSocketOption(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{-1, EINVAL}));
+  EXPECT_LOG_CONTAINS(
+      "warn", "Attaching the reuse port CPU steering program to socket failed",
+      EXPECT_FALSE(socket_option.setOption(
+          socket_, envoy::config::core::v3::SocketOption::STATE_LISTENING)));
+}
+#else
+TEST_F(ReusePortCpuSteeringOptionImplTest, Unsupported) {
+  ReusePortCpuSteeringOptionImpl socket_option{4};
+  EXPECT_FALSE(socket_option.isSupported());
+  EXPECT_FALSE(
+      socket_option.setOption(socket_, envoy::config::core::v3::SocketOption::STATE_LISTENING));
+}
+#endif
+
+TEST_F(ReusePortCpuSteeringOptionImplTest, HashKeyDependsOnNumberOfWorkers) {
+  std::vector<uint8_t> hash1;
+  std::vector<uint8_t> hash2;
+  std::vector<uint8_t> hash3;
+  ReusePortCpuSteeringOptionImpl(4).hashKey(hash1);
+  ReusePortCpuSteeringOptionImpl(4).hashKey(hash2);
+  ReusePortCpuSteeringOptionImpl(8).hashKey(hash3);
+  EXPECT_EQ(hash1, hash2);
+  if (ENVOY_SOCKET_SO_ATTACH_REUSEPORT_CBPF.hasValue()) {
+    EXPECT_NE(hash1, hash3);
+  }
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
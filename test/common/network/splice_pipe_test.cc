@@ -0,0 +1,111 @@
+#include <sys/socket.h>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/network/splice_pipe.h"
+
+#include "test/mocks/network/io_handle.h"
+#include "test/mocks/network/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+#if defined(__linux__)
+
+class SplicePipeTest : public testing::Test {
+protected:
+  // Returns a non-blocking stream socket pair, owned by IoSocketHandleImpl.
+  static std::pair<IoHandlePtr, IoHandlePtr> socketPair() {
+    int fds[2];
+    RELEASE_ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0, "");
+    return {std::make_unique<IoSocketHandleImpl>(fds[0]),
+            std::make_unique<IoSocketHandleImpl>(fds[1])};
+  }
+
+  static void writeAll(IoHandle& io_handle, absl::string_view data) {
+    Buffer::OwnedImpl buffer(data);
+    while (buffer.length() > 0) {
+      ASSERT_TRUE(io_handle.write(buffer).ok());
+    }
+  }
+
+  static std::string readAvailable(IoHandle& io_handle) {
+    Buffer::OwnedImpl buffer;
+    io_handle.read(buffer, 1024);
+    return buffer.toString();
+  }
+};
+
+TEST_F(SplicePipeTest, MovesBytesBetweenSockets) {
+  auto [source_local, source_peer] = socketPair();
+  auto [sink_local, sink_peer] = socketPair();
+  SplicePipeSharedPtr pipe = SplicePipe::create();
+  ASSERT_NE(nullptr, pipe);
+
+  // Nothing to read yet.
+  Api::IoCallUint64Result result = pipe->fillFrom(*source_local);
+  ASSERT_FALSE(result.ok());
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+  EXPECT_EQ(0, pipe->pendingBytes());
+
+  writeAll(*source_peer, "hello world");
+  result = pipe->fillFrom(*source_local);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(11, result.return_value_);
+  EXPECT_EQ(11, pipe->pendingBytes());
+
+  result = pipe->drainTo(*sink_local);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(11, result.return_value_);
+  EXPECT_EQ(0, pipe->pendingBytes());
+  EXPECT_EQ("hello world", readAvailable(*sink_peer));
+
+  // End of stream is reported as a zero byte read.
+  source_peer->close();
+  result = pipe->fillFrom(*source_local);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(0, result.return_value_);
+}
+
+TEST_F(SplicePipeTest, WakesUpPeers) {
+  SplicePipeSharedPtr pipe = SplicePipe::create();
+  ASSERT_NE(nullptr, pipe);
+  MockTransportSocketCallbacks source;
+  MockTransportSocketCallbacks sink;
+  MockIoHandle sink_io_handle;
+  EXPECT_CALL(sink, ioHandle()).WillRepeatedly(ReturnRef(sink_io_handle));
+  pipe->setSource(&source);
+  pipe->setSink(&sink);
+
+  EXPECT_CALL(sink_io_handle, activateFileEvents(Event::FileReadyType::Write));
+  pipe->onSourceFilled();
+
+  EXPECT_CALL(source, setTransportSocketIsReadable());
+  pipe->onSinkDrained();
+
+  // The source only gets woken up if it stopped reading.
+  EXPECT_CALL(source, setTransportSocketIsReadable()).Times(0);
+  pipe->onSinkDrained();
+
+  // A closed peer is never touched.
+  pipe->setSink(nullptr);
+  pipe->setSource(nullptr);
+  pipe->onSourceFilled();
+  pipe->onSinkDrained();
+}
+
+#else
+
+TEST(SplicePipeTest, NotSupported) { EXPECT_EQ(nullptr, SplicePipe::create()); }
+
+#endif
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -143,6 +143,27 @@ TEST_P(UdpListenerImplTest, UseActualDstUdp) {
   dispatcher_->run(Event::Dispatcher::RunType::Block);
 }
 
+/**
+ * Tests that onReadComplete() is called once the datagrams of a read event have been delivered.
+ */
+TEST_P(UdpListenerImplTest, ReadCompleteAfterData) {
+  setup();
+
+  const std::string first("first");
+  client_.write(first, *send_to_addr_);
+
+  testing::InSequence s;
+  EXPECT_CALL(listener_callbacks_, onReadReady());
+  EXPECT_CALL(listener_callbacks_, onData(_)).WillOnce(Invoke([&](const UdpRecvData& data) {
+    EXPECT_EQ(data.buffer_->toString(), first);
+  }));
+  EXPECT_CALL(listener_callbacks_, onReadComplete()).WillOnce(Invoke([&]() {
+    dispatcher_->exit();
+  }));
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+}
+
 // Test a large datagram that gets dropped using recvmsg or recvmmsg if supported.
 TEST_P(UdpListenerImplTest, LargeDatagramRecvmmsg) {
   setup();
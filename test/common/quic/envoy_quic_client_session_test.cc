@@ -158,7 +158,8 @@ public:
     envoy_quic_session_->OnConfigNegotiated();
     envoy_quic_session_->addConnectionCallbacks(network_connection_callbacks_);
     envoy_quic_session_->setConnectionStats(
-        {read_total_, read_current_, write_total_, write_current_, nullptr, nullptr});
+        {read_total_, read_current_, write_total_, write_current_, nullptr, nullptr,
+         nullptr, nullptr});
     EXPECT_EQ(&read_total_, &quic_connection_->connectionStats().read_total_);
   }
 
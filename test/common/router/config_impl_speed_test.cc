@@ -6,6 +6,7 @@
 
 #include "test/mocks/server/instance.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -76,6 +77,76 @@ static RouteConfiguration genRouteConfig(benchmark::State& state,
   return route_config;
 }
 
+/**
+ * Generates a route config with `n` routes that cycle through prefix, exact path and regex
+ * matchers, followed by a catch all route. Requests for the last shelf match the last route
+ * before the catch all route.
+ */
+static RouteConfiguration genMixedRouteConfig(benchmark::State& state) {
+  RouteConfiguration route_config;
+  VirtualHost* v_host = route_config.add_virtual_hosts();
+  v_host->set_name("default");
+  v_host->add_domains("*");
+
+  for (int i = 0; i < state.range(0); ++i) {
+    Route* route = v_host->add_routes();
+    route->mutable_direct_response()->set_status(200);
+    RouteMatch* match = route->mutable_match();
+
+    switch (i % 3) {
+    case 0:
+      match->set_prefix(absl::StrCat("/shelves/shelf_", i, "/"));
+      break;
+    case 1:
+      match->set_path(absl::StrCat("/shelves/shelf_", i, "/route_", i));
+      break;
+    default: {
+      envoy::type::matcher::v3::RegexMatcher* regex = match->mutable_safe_regex();
+      regex->mutable_google_re2();
+      regex->set_regex(absl::StrCat("^/shelves/shelf_", i, "/route_[0-9]+$"));
+      break;
+    }
+    }
+  }
+
+  Route* catch_all = v_host->add_routes();
+  catch_all->mutable_direct_response()->set_status(404);
+  catch_all->mutable_match()->set_prefix("/");
+
+  return route_config;
+}
+
+/**
+ * Generates a route config with `n` suffix wildcard domains spread over 100 virtual hosts, and a
+ * default virtual host. The domains are label wildcards of the form *.tenant-x.example.com if
+ * `label_wildcards` is set, and of the form *-tenant-x.example.com otherwise.
+ */
+static RouteConfiguration genWildcardDomainRouteConfig(benchmark::State& state,
+                                                       bool label_wildcards) {
+  RouteConfiguration route_config;
+  constexpr int num_virtual_hosts = 100;
+  for (int i = 0; i < num_virtual_hosts; ++i) {
+    VirtualHost* v_host = route_config.add_virtual_hosts();
+    v_host->set_name(absl::StrCat("tenants_", i));
+    Route* route = v_host->add_routes();
+    route->mutable_match()->set_prefix("/");
+    route->mutable_direct_response()->set_status(200);
+  }
+  for (int i = 0; i < state.range(0); ++i) {
+    route_config.mutable_virtual_hosts(i % num_virtual_hosts)
+        ->add_domains(absl::StrCat(label_wildcards ? "*." : "*-", "tenant-", i, ".example.com"));
+  }
+
+  VirtualHost* default_host = route_config.add_virtual_hosts();
+  default_host->set_name("default");
+  default_host->add_domains("*");
+  Route* route = default_host->add_routes();
+  route->mutable_match()->set_prefix("/");
+  route->mutable_direct_response()->set_status(404);
+
+  return route_config;
+}
+
 /**
  * Generates a route config using matcher tree semantics with n entries.
  */
@@ -204,8 +275,12 @@ static RouteConfiguration genPrefixMatcherTreeRouteConfig(benchmark::State& stat
  * We then time how long it takes for the request to be matched against the
  * last route.
  */
-static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type) {
+static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type,
+                             bool compiled = false) {
   // Setup router for benchmarking.
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.router_compiled_route_matcher",
+                               compiled ? "true" : "false"}});
   Api::ApiPtr api = Api::createApiForTest();
   NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
   NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
@@ -256,6 +331,78 @@ static void bmRouteTableSizeWithRegexMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex);
 }
 
+/**
+ * The same benchmarks as above, with the routes found through the compiled route matcher.
+ */
+static void bmCompiledRouteTableSizeWithPathPrefixMatch(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPrefix, true);
+}
+
+static void bmCompiledRouteTableSizeWithExactPathMatch(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPath, true);
+}
+
+static void bmCompiledRouteTableSizeWithRegexMatch(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex, true);
+}
+
+/**
+ * Benchmark a route table that mixes prefix, exact path and regex matchers, with the request
+ * matching the last route before the catch all route. state.range(1) selects the compiled route
+ * matcher.
+ */
+static void bmMixedRouteTable(benchmark::State& state) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.router_compiled_route_matcher",
+                               state.range(1) != 0 ? "true" : "false"}});
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  std::shared_ptr<ConfigImpl> config =
+      *ConfigImpl::create(genMixedRouteConfig(state), factory_context,
+                          ProtobufMessage::getNullValidationVisitor(), true);
+
+  const int last_route_num = state.range(0) - 1;
+  const Http::TestRequestHeaderMapImpl headers = genRequestHeaders(last_route_num);
+  for (auto _ : state) { // NOLINT
+    config->route(headers, stream_info, 0);
+  }
+}
+
+/**
+ * Benchmark the virtual host lookup of requests for many tenants against a route config with
+ * state.range(0) wildcard domains. state.range(1) selects label wildcards (*.tenant-x.example.com)
+ * or other wildcards (*-tenant-x.example.com).
+ */
+static void bmWildcardDomainLookup(benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  const bool label_wildcards = state.range(1) != 0;
+  std::shared_ptr<ConfigImpl> config =
+      *ConfigImpl::create(genWildcardDomainRouteConfig(state, label_wildcards), factory_context,
+                          ProtobufMessage::getNullValidationVisitor(), true);
+
+  // Spread the requests over the tenants with a prime stride.
+  std::vector<Http::TestRequestHeaderMapImpl> requests;
+  for (int64_t i = 0; i < 1000; ++i) {
+    requests.push_back(Http::TestRequestHeaderMapImpl{
+        {":authority", absl::StrCat("app", label_wildcards ? "." : "-", "tenant-",
+                                    (i * 7919) % state.range(0), ".example.com")},
+        {":method", "GET"},
+        {":path", "/"},
+        {"x-forwarded-proto", "http"}});
+  }
+
+  size_t i = 0;
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(config->virtualHostExists(requests[i++ % requests.size()]));
+  }
+}
+
 /**
  * Benchmark matcher tree route matching performance with exact path matchers in the form of:
  * - /shelves/shelf_1/route_1
@@ -314,6 +461,20 @@ static void bmRouteTableSizeWithPrefixMatcherTree(benchmark::State& state) {
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmCompiledRouteTableSizeWithPathPrefixMatch)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 2 << 13}})
+    ->Arg(10000);
+BENCHMARK(bmCompiledRouteTableSizeWithExactPathMatch)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 2 << 13}})
+    ->Arg(10000);
+BENCHMARK(bmCompiledRouteTableSizeWithRegexMatch)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 2 << 13}})
+    ->Arg(10000);
+BENCHMARK(bmMixedRouteTable)->ArgsProduct({{100, 1000, 10000}, {0, 1}});
+BENCHMARK(bmWildcardDomainLookup)->ArgsProduct({{1000, 10000, 100000, 1000000}, {1, 0}});
 
 BENCHMARK(bmRouteTableSizeWithExactMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithPrefixMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
@@ -65,7 +65,7 @@ public:
                  Server::Configuration::ServerFactoryContext& factory_context,
                  bool validate_clusters_default, absl::Status& creation_status)
       : ConfigImpl(config, factory_context, ProtobufMessage::getNullValidationVisitor(),
-                   validate_clusters_default, creation_status),
+                   validate_clusters_default, false, nullptr, creation_status),
         config_(config) {}
 
   void setupRouteConfig(const Http::RequestHeaderMap& headers, uint64_t random_value) const {
@@ -359,6 +359,168 @@ class RouteMatcherTest : public testing::Test,
                          public ConfigImplTestBase,
                          public TestScopedRuntime {};
 
+// Verifies that looking routes up through the route path index gives the same result as walking
+// the routes in order.
+TEST_F(RouteMatcherTest, CompiledRouteMatcher) {
+  const std::string yaml = R"EOF(
+ignore_path_parameters_in_path_matching: true
+virtual_hosts:
+- name: default
+  domains: ["*"]
+  routes:
+  - match: { prefix: "/api/v1/users", headers: [{ name: x-canary, present_match: true }] }
+    route: { cluster: canary }
+  - match: { path: "/api/v1/users" }
+    route: { cluster: users_exact }
+  - match: { prefix: "/API/V2", case_sensitive: false }
+    route: { cluster: v2_insensitive }
+  - match: { safe_regex: { regex: "^/api/v1/users/[0-9]+$" } }
+    route: { cluster: user_by_id }
+  - match: { safe_regex: { regex: ".*/admin" } }
+    route: { cluster: admin }
+  - match: { path_separated_prefix: "/api/v1/items" }
+    route: { cluster: items }
+  - match: { prefix: "/api/v1" }
+    route: { cluster: v1 }
+  - match: { path: "/Exact", case_sensitive: false }
+    route: { cluster: exact_insensitive }
+  - match: { prefix: "/" }
+    route: { cluster: default }
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"canary", "users_exact", "v2_insensitive", "user_by_id", "admin", "items", "v1",
+       "exact_insensitive", "default"},
+      {});
+
+  const std::vector<std::string> paths{"/api/v1/users",
+                                       "/api/v1/users?x=1",
+                                       "/api/v1/users;param",
+                                       "/api/v1/users/42",
+                                       "/api/v1/users/42#fragment",
+                                       "/api/v1/users/abc",
+                                       "/api/v2/list",
+                                       "/Api/V2",
+                                       "/api/v1/items",
+                                       "/api/v1/items/1",
+                                       "/api/v1/itemsx",
+                                       "/foo/admin",
+                                       "/exact",
+                                       "/other",
+                                       "/"};
+
+  std::vector<std::string> expected;
+  {
+    TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                          creation_status_);
+    for (const std::string& path : paths) {
+      expected.push_back(config.route(genHeaders("www.lyft.com", path, "GET"), 0)
+                             ->routeEntry()
+                             ->clusterName());
+    }
+  }
+
+  mergeValues({{"envoy.reloadable_features.router_compiled_route_matcher", "true"}});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+  for (size_t i = 0; i < paths.size(); ++i) {
+    EXPECT_EQ(expected[i], config.route(genHeaders("www.lyft.com", paths[i], "GET"), 0)
+                               ->routeEntry()
+                               ->clusterName())
+        << paths[i];
+  }
+  EXPECT_EQ("users_exact", expected[1]);
+  EXPECT_EQ("user_by_id", expected[4]);
+  EXPECT_EQ("v2_insensitive", expected[7]);
+  EXPECT_EQ("v1", expected[10]);
+
+  Http::TestRequestHeaderMapImpl canary_headers =
+      genHeaders("www.lyft.com", "/api/v1/users", "GET");
+  canary_headers.addCopy("x-canary", "true");
+  EXPECT_EQ("canary", config.route(canary_headers, 0)->routeEntry()->clusterName());
+
+  // The evaluation status reflects the position of the route among all routes, not among the
+  // candidates of the index.
+  std::vector<std::string> clusters{"default", "v1", "items"};
+  RouteConstSharedPtr accepted_route = config.route(
+      [&clusters](RouteConstSharedPtr route,
+                  RouteEvalStatus route_eval_status) -> RouteMatchStatus {
+        EXPECT_FALSE(clusters.empty());
+        EXPECT_EQ(clusters.back(), route->routeEntry()->clusterName());
+        clusters.pop_back();
+        if (clusters.empty()) {
+          EXPECT_EQ(route_eval_status, RouteEvalStatus::NoMoreRoutes);
+          return RouteMatchStatus::Accept;
+        }
+        EXPECT_EQ(route_eval_status, RouteEvalStatus::HasMoreRoutes);
+        return RouteMatchStatus::Continue;
+      },
+      genHeaders("www.lyft.com", "/api/v1/items/1", "GET"));
+  EXPECT_EQ("default", accepted_route->routeEntry()->clusterName());
+}
+
+TEST_F(RouteMatcherTest, IncrementalRebuild) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- name: foo
+  domains: ["foo.com"]
+  routes:
+  - match: { prefix: "/a" }
+    route: { cluster: a }
+  - match: { prefix: "/b" }
+    route: { cluster: b }
+- name: bar
+  domains: ["bar.com"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: bar }
+)EOF";
+
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  auto create = [&](const envoy::config::route::v3::RouteConfiguration& route_config,
+                    const ConfigImpl* previous) {
+    auto config_or_error =
+        ConfigImpl::createIncremental(route_config, factory_context_,
+                                      ProtobufMessage::getNullValidationVisitor(), false, previous);
+    EXPECT_TRUE(config_or_error.ok());
+    return config_or_error.value();
+  };
+  auto route = [&](const ConfigImpl& config, const std::string& host, const std::string& path) {
+    return config.route(genHeaders(host, path, "GET"), stream_info, 0);
+  };
+
+  envoy::config::route::v3::RouteConfiguration route_config = parseRouteConfigurationFromYaml(yaml);
+  std::shared_ptr<ConfigImpl> first = create(route_config, nullptr);
+  EXPECT_EQ(0, first->reusedBytes());
+
+  // Only the second route of the first virtual host changes.
+  route_config.mutable_virtual_hosts(0)->mutable_routes(1)->mutable_route()->set_cluster("c");
+  std::shared_ptr<ConfigImpl> second = create(route_config, first.get());
+  EXPECT_EQ(route(*first, "bar.com", "/"), route(*second, "bar.com", "/"));
+  EXPECT_EQ(route(*first, "foo.com", "/a"), route(*second, "foo.com", "/a"));
+  EXPECT_EQ(&route(*first, "foo.com", "/a")->virtualHost(),
+            &route(*second, "foo.com", "/b")->virtualHost());
+  EXPECT_NE(route(*first, "foo.com", "/b"), route(*second, "foo.com", "/b"));
+  EXPECT_EQ("c", route(*second, "foo.com", "/b")->routeEntry()->clusterName());
+  EXPECT_EQ(route_config.virtual_hosts(1).ByteSizeLong() +
+                route_config.virtual_hosts(0).routes(0).ByteSizeLong(),
+            second->reusedBytes());
+
+  // A change outside of the virtual hosts rebuilds everything.
+  route_config.mutable_max_direct_response_body_size_bytes()->set_value(1024);
+  std::shared_ptr<ConfigImpl> third = create(route_config, second.get());
+  EXPECT_NE(route(*second, "bar.com", "/"), route(*third, "bar.com", "/"));
+  EXPECT_EQ(0, third->reusedBytes());
+
+  // Configs which validate clusters are never reused.
+  route_config.mutable_validate_clusters()->set_value(true);
+  factory_context_.cluster_manager_.initializeClusters({"a", "c", "bar"}, {});
+  std::shared_ptr<ConfigImpl> fourth = create(route_config, third.get());
+  std::shared_ptr<ConfigImpl> fifth = create(route_config, fourth.get());
+  EXPECT_NE(route(*fourth, "bar.com", "/"), route(*fifth, "bar.com", "/"));
+  EXPECT_EQ(0, fifth->reusedBytes());
+}
+
 TEST_F(RouteMatcherTest, TestConnectRoutes) {
   const std::string yaml = R"EOF(
 virtual_hosts:
@@ -1234,6 +1396,70 @@ virtual_hosts:
             config.route(genHeaders("example.com", "/", "GET"), 0)->routeEntry()->clusterName());
 }
 
+// Wildcards with a fixed part starting or ending at a label boundary are stored apart from the
+// other wildcards, the longest match wins across both.
+TEST_F(RouteMatcherTest, TestRoutesWithLabelAndOtherWildcards) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: label_suffix
+    domains: ["*.baz.com"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "label_suffix" }
+  - name: other_suffix
+    domains: ["*-bar.baz.com"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "other_suffix" }
+  - name: longer_label_suffix
+    domains: ["*.foo-bar.baz.com"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "longer_label_suffix" }
+  - name: label_prefix
+    domains: ["api.*"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "label_prefix" }
+  - name: other_prefix
+    domains: ["api.v1-*"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "other_prefix" }
+  - name: longer_label_prefix
+    domains: ["api.v1.*"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "longer_label_prefix" }
+  - name: default
+    domains: ["*"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "default" }
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"label_suffix", "other_suffix", "longer_label_suffix", "label_prefix", "other_prefix",
+       "longer_label_prefix", "default"},
+      {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+  auto cluster = [&config](const std::string& host) {
+    return config.route(genHeaders(host, "/", "GET"), 0)->routeEntry()->clusterName();
+  };
+
+  EXPECT_EQ("label_suffix", cluster("a.b.baz.com"));
+  EXPECT_EQ("other_suffix", cluster("foo-bar.baz.com"));
+  EXPECT_EQ("longer_label_suffix", cluster("a.foo-bar.baz.com"));
+  EXPECT_EQ("label_suffix", cluster("A.BAZ.COM"));
+  EXPECT_EQ("default", cluster(".baz.com"));
+  EXPECT_EQ("label_prefix", cluster("api.v2.com"));
+  EXPECT_EQ("other_prefix", cluster("api.v1-beta"));
+  EXPECT_EQ("longer_label_prefix", cluster("api.v1.com"));
+  EXPECT_EQ("default", cluster("api."));
+  EXPECT_EQ("default", cluster("example.com"));
+}
+
 TEST_F(RouteMatcherTest, TestRoutesWithInvalidRegex) {
   std::string invalid_route = R"EOF(
 virtual_hosts:
@@ -11170,6 +11396,120 @@ virtual_hosts:
   EXPECT_TRUE(route5->filterDisabled("test.filter").value());
 }
 
+TEST_F(PerFilterConfigsTest, WeightedClusterFilterDisabledTest) {
+  const std::string yaml = R"EOF(
+typed_per_filter_config:
+  other.filter:
+    "@type":  type.googleapis.com/envoy.config.route.v3.FilterConfig
+    disabled: true
+virtual_hosts:
+  - name: bar
+    domains: ["host1"]
+    routes:
+      - match: { prefix: "/" }
+        route:
+          weighted_clusters:
+            clusters:
+              # test.filter will be enabled for this cluster because this config
+              # will override the route level config.
+              - name: baz
+                weight: 50
+                typed_per_filter_config:
+                  test.filter:
+                    "@type": type.googleapis.com/envoy.config.route.v3.FilterConfig
+                    config: {}
+              # test.filter will be disabled for this cluster because of the route level config.
+              - name: qux
+                weight: 50
+        typed_per_filter_config:
+          test.filter:
+            "@type": type.googleapis.com/envoy.config.route.v3.FilterConfig
+            disabled: true
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"baz", "qux"}, {});
+
+  const TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                              creation_status_);
+
+  const auto route1 = config.route(genHeaders("host1", "/", "GET"), 0);
+  EXPECT_EQ("baz", route1->routeEntry()->clusterName());
+  EXPECT_FALSE(route1->filterDisabled("test.filter").value());
+  // other.filter is disabled for both clusters by the global route config.
+  EXPECT_TRUE(route1->filterDisabled("other.filter").value());
+  EXPECT_EQ(route1->filterDisabled("unknown.filter"), absl::nullopt);
+
+  const auto route2 = config.route(genHeaders("host1", "/", "GET"), 60);
+  EXPECT_EQ("qux", route2->routeEntry()->clusterName());
+  EXPECT_TRUE(route2->filterDisabled("test.filter").value());
+  EXPECT_TRUE(route2->filterDisabled("other.filter").value());
+}
+
+TEST_F(PerFilterConfigsTest, FilterChainTemplateTest) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: bar
+    domains: ["host1"]
+    routes:
+      - match: { prefix: "/disabled" }
+        route: { cluster: baz }
+        typed_per_filter_config:
+          test.filter:
+            "@type": type.googleapis.com/envoy.config.route.v3.FilterConfig
+            disabled: true
+      - match: { prefix: "/foo" }
+        route: { cluster: baz }
+      - match: { prefix: "/" }
+        route: { cluster: baz }
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"baz"}, {});
+
+  const TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                              creation_status_);
+
+  const auto disabled_route = config.route(genHeaders("host1", "/disabled", "GET"), 0);
+  const auto foo_route = config.route(genHeaders("host1", "/foo", "GET"), 0);
+  const auto default_route = config.route(genHeaders("host1", "/", "GET"), 0);
+
+  const uint64_t chain_id = 1;
+  int builds = 0;
+  auto build_from = [&builds](const RouteConstSharedPtr& route) {
+    return [&builds, route]() {
+      builds++;
+      const bool disabled = route->filterDisabled("test.filter").value_or(false);
+      return Http::FilterChainTemplate{disabled ? 1U : 0U};
+    };
+  };
+
+  // The template is built the first time the filter chain is used with the route.
+  const Http::FilterChainTemplate* disabled_template =
+      disabled_route->filterChainTemplate(chain_id, build_from(disabled_route));
+  ASSERT_NE(nullptr, disabled_template);
+  EXPECT_EQ(Http::FilterChainTemplate{1}, *disabled_template);
+  EXPECT_EQ(1, builds);
+  EXPECT_EQ(disabled_template,
+            disabled_route->filterChainTemplate(chain_id, build_from(disabled_route)));
+  EXPECT_EQ(1, builds);
+
+  // Routes without overrides of their own share the template of their virtual host.
+  const Http::FilterChainTemplate* foo_template =
+      foo_route->filterChainTemplate(chain_id, build_from(foo_route));
+  ASSERT_NE(nullptr, foo_template);
+  EXPECT_EQ(Http::FilterChainTemplate{0}, *foo_template);
+  EXPECT_EQ(2, builds);
+  EXPECT_EQ(foo_template, default_route->filterChainTemplate(chain_id, build_from(default_route)));
+  EXPECT_EQ(2, builds);
+
+  // Another filter chain has templates of its own.
+  const uint64_t other_chain_id = 2;
+  EXPECT_NE(foo_template,
+            default_route->filterChainTemplate(other_chain_id, build_from(default_route)));
+  EXPECT_EQ(3, builds);
+  EXPECT_EQ(foo_template, foo_route->filterChainTemplate(chain_id, build_from(foo_route)));
+  EXPECT_EQ(3, builds);
+}
+
 class RouteMatchOverrideTest : public testing::Test, public ConfigImplTestBase {};
 
 TEST_F(RouteMatchOverrideTest, VerifyAllMatchableRoutes) {
@@ -335,6 +335,59 @@ TEST_F(RdsImplTest, Basic) {
   EXPECT_TRUE(scope_.findGaugeByString("foo.rds.foo_route_config.config_reload_time_ms"));
 }
 
+// Validate that an update reuses the routes of the unchanged virtual hosts when incremental
+// rebuilds are enabled.
+TEST_F(RdsImplTest, IncrementalRebuild) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.rds_incremental_route_config_rebuild", "true"}});
+  setup();
+
+  const std::string response_yaml = R"EOF(
+version_info: "{}"
+resources:
+- "@type": type.googleapis.com/envoy.config.route.v3.RouteConfiguration
+  name: foo_route_config
+  virtual_hosts:
+  - name: foo
+    domains: ["foo"]
+    routes:
+    - match: {{ prefix: "/" }}
+      route: {{ cluster: foo }}
+  - name: bar
+    domains: ["bar"]
+    routes:
+    - match: {{ prefix: "/" }}
+      route: {{ cluster: {} }}
+)EOF";
+  auto response1 = TestUtility::parseYaml<envoy::service::discovery::v3::DiscoveryResponse>(
+      fmt::format(response_yaml, "1", "bar"));
+  const auto decoded_resources =
+      TestUtility::decodeResources<envoy::config::route::v3::RouteConfiguration>(response1);
+  EXPECT_CALL(init_watcher_, ready());
+  EXPECT_TRUE(
+      rds_callbacks_->onConfigUpdate(decoded_resources.refvec_, response1.version_info()).ok());
+  RouteConstSharedPtr foo_route = route({{":authority", "foo"}, {":path", "/"}});
+  RouteConstSharedPtr bar_route = route({{":authority", "bar"}, {":path", "/"}});
+  EXPECT_EQ(0UL, scope_.counter("foo.rds.foo_route_config.config_reused_bytes").value());
+
+  auto response2 = TestUtility::parseYaml<envoy::service::discovery::v3::DiscoveryResponse>(
+      fmt::format(response_yaml, "2", "baz"));
+  const auto decoded_resources_2 =
+      TestUtility::decodeResources<envoy::config::route::v3::RouteConfiguration>(response2);
+  EXPECT_TRUE(
+      rds_callbacks_->onConfigUpdate(decoded_resources_2.refvec_, response2.version_info()).ok());
+  EXPECT_EQ(foo_route, route({{":authority", "foo"}, {":path", "/"}}));
+  EXPECT_NE(bar_route, route({{":authority", "bar"}, {":path", "/"}}));
+  EXPECT_EQ("baz", route({{":authority", "bar"}, {":path", "/"}})->routeEntry()->clusterName());
+
+  const auto& route_config = dynamic_cast<const envoy::config::route::v3::RouteConfiguration&>(
+      decoded_resources_2.refvec_[0].get().resource());
+  EXPECT_EQ(route_config.virtual_hosts(0).ByteSizeLong(),
+            scope_.counter("foo.rds.foo_route_config.config_reused_bytes").value());
+  EXPECT_EQ(2UL, scope_.counter("foo.rds.foo_route_config.config_reload").value());
+}
+
 // validate there will be exception throw when unknown factory found for per virtualhost typed
 // config.
 TEST_F(RdsImplTest, UnknownFacotryForPerVirtualHostTypedConfig) {
@@ -0,0 +1,87 @@
+#include <vector>
+
+#include "source/common/router/route_path_index.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+std::vector<uint32_t> candidates(const RoutePathIndex& index, absl::string_view path) {
+  std::vector<uint32_t> result;
+  index.forEachCandidate(path, [&result](uint32_t route) {
+    result.push_back(route);
+    return true;
+  });
+  return result;
+}
+
+TEST(RoutePathIndexTest, Empty) {
+  RoutePathIndex index;
+  EXPECT_EQ(0, index.size());
+  EXPECT_TRUE(candidates(index, "/foo").empty());
+}
+
+TEST(RoutePathIndexTest, CandidatesInRouteOrder) {
+  RoutePathIndex index;
+  index.addPrefix("/foo/bar");         // 0
+  index.addExact("/foo/bar/baz");      // 1
+  index.addUnindexed();                // 2
+  index.addPrefix("/foo");             // 3
+  index.addPrefix("/other");           // 4
+  index.addExact("/foo");              // 5
+  index.addPrefix("");                 // 6
+  index.addRegex("^/foo/[a-z]+/baz$"); // 7
+  index.addRegex("/foo/.*");           // 8
+  index.addPrefix("/foo/bar");         // 9
+  EXPECT_EQ(10, index.size());
+
+  EXPECT_EQ((std::vector<uint32_t>{0, 1, 2, 3, 6, 7, 8, 9}), candidates(index, "/foo/bar/baz"));
+  EXPECT_EQ((std::vector<uint32_t>{0, 2, 3, 6, 7, 8, 9}), candidates(index, "/foo/bar"));
+  EXPECT_EQ((std::vector<uint32_t>{2, 3, 5, 6, 8}), candidates(index, "/foo"));
+  EXPECT_EQ((std::vector<uint32_t>{2, 4, 6, 8}), candidates(index, "/other/path"));
+  EXPECT_EQ((std::vector<uint32_t>{2, 6, 8}), candidates(index, "/"));
+  // Prefixes and exact paths are case sensitive.
+  EXPECT_EQ((std::vector<uint32_t>{2, 6, 8}), candidates(index, "/FOO/bar"));
+}
+
+TEST(RoutePathIndexTest, StopsWhenCallbackReturnsFalse) {
+  RoutePathIndex index;
+  index.addPrefix("/a");
+  index.addUnindexed();
+  index.addPrefix("/a/b");
+
+  std::vector<uint32_t> visited;
+  index.forEachCandidate("/a/b", [&visited](uint32_t route) {
+    visited.push_back(route);
+    return route < 1;
+  });
+  EXPECT_EQ((std::vector<uint32_t>{0, 1}), visited);
+}
+
+TEST(RoutePathIndexTest, RegexLiteralPrefix) {
+  EXPECT_EQ("/shelves/", RoutePathIndex::regexLiteralPrefix("^/shelves/[^/]+/route_1$"));
+  EXPECT_EQ("/api/v1", RoutePathIndex::regexLiteralPrefix("^/api/v1\\.0/.*"));
+  EXPECT_EQ("/api/v1/items", RoutePathIndex::regexLiteralPrefix("^/api/v1/items"));
+  // A character followed by a quantifier that allows zero repetitions is optional.
+  EXPECT_EQ("/api/v", RoutePathIndex::regexLiteralPrefix("^/api/v1?/items"));
+  EXPECT_EQ("/api/v", RoutePathIndex::regexLiteralPrefix("^/api/v1*/items"));
+  EXPECT_EQ("/api/v", RoutePathIndex::regexLiteralPrefix("^/api/v1{0,2}/items"));
+  // A character followed by '+' appears at least once.
+  EXPECT_EQ("/api/v1", RoutePathIndex::regexLiteralPrefix("^/api/v1+/items"));
+  // Not anchored.
+  EXPECT_EQ("", RoutePathIndex::regexLiteralPrefix("/api/v1/items"));
+  // Alternation.
+  EXPECT_EQ("", RoutePathIndex::regexLiteralPrefix("^/api/v1|/api/v2"));
+  EXPECT_EQ("", RoutePathIndex::regexLiteralPrefix("^(/api/v1|/api/v2)"));
+  // Flags.
+  EXPECT_EQ("", RoutePathIndex::regexLiteralPrefix("^(?i)/api"));
+  EXPECT_EQ("", RoutePathIndex::regexLiteralPrefix("^.*"));
+  EXPECT_EQ("", RoutePathIndex::regexLiteralPrefix("^"));
+  EXPECT_EQ("", RoutePathIndex::regexLiteralPrefix(""));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
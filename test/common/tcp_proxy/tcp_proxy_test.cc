@@ -827,6 +827,21 @@ TEST_P(TcpProxyTest, ReceiveBeforeConnectSetToFalse) {
   upstream_callbacks_->onUpstreamData(response, false);
 }
 
+// Mock connections do not use the raw buffer transport socket, so the connection is proxied through
+// the connection buffers.
+TEST_P(TcpProxyTest, SplicePassthroughFallback) {
+  envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy config = defaultConfig();
+  config.set_splice_passthrough(true);
+  setup(1, config);
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(0U, config_->stats().downstream_cx_splice_total_.value());
+  EXPECT_EQ(1U, config_->stats().downstream_cx_splice_fallback_total_.value());
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(*upstream_connections_.at(0), write(BufferEqual(&buffer), _));
+  filter_->onData(buffer, false);
+}
+
 TEST_P(TcpProxyTest, DownstreamDisconnectRemote) {
   setup(1);
 
@@ -0,0 +1,186 @@
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/tls/ktls.h"
+
+#include "test/mocks/network/io_handle.h"
+#include "test/test_common/environment.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+using testing::_;
+using testing::StrictMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+TEST(KtlsTest, IsSupported) {
+  // TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256.
+  const SSL_CIPHER* aes_128_gcm = SSL_get_cipher_by_value(0xc02f);
+  // TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA.
+  const SSL_CIPHER* aes_128_cbc = SSL_get_cipher_by_value(0xc013);
+  ASSERT_NE(nullptr, aes_128_gcm);
+  ASSERT_NE(nullptr, aes_128_cbc);
+#if defined(__linux__)
+  EXPECT_TRUE(Ktls::isSupported(TLS1_2_VERSION, aes_128_gcm));
+#else
+  EXPECT_FALSE(Ktls::isSupported(TLS1_2_VERSION, aes_128_gcm));
+#endif
+  EXPECT_FALSE(Ktls::isSupported(TLS1_2_VERSION, aes_128_cbc));
+  EXPECT_FALSE(Ktls::isSupported(TLS1_3_VERSION, aes_128_gcm));
+  EXPECT_FALSE(Ktls::isSupported(TLS1_2_VERSION, nullptr));
+}
+
+// A TLS connection over a loopback TCP connection, kTLS requiring TCP sockets.
+class KtlsConnectionTest : public testing::TestWithParam<std::string> {
+protected:
+  void SetUp() override {
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(listener, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t address_len = sizeof(address);
+    ASSERT_EQ(0, ::bind(listener, reinterpret_cast<sockaddr*>(&address), address_len));
+    ASSERT_EQ(0, ::listen(listener, 1));
+    ASSERT_EQ(0, ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &address_len));
+    client_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    ASSERT_GE(client_fd_, 0);
+    ::connect(client_fd_, reinterpret_cast<sockaddr*>(&address), address_len);
+    server_fd_ = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK);
+    ::close(listener);
+    ASSERT_GE(server_fd_, 0);
+    server_handle_ = std::make_unique<Network::IoSocketHandleImpl>(server_fd_);
+  }
+
+  void TearDown() override { ::close(client_fd_); }
+
+  void handshake(uint16_t max_version) {
+    bssl::UniquePtr<SSL_CTX> server_ctx(SSL_CTX_new(TLS_method()));
+    bssl::UniquePtr<SSL_CTX> client_ctx(SSL_CTX_new(TLS_method()));
+    const std::string cert_path =
+        TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_cert.pem");
+    const std::string key_path =
+        TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_key.pem");
+    ASSERT_EQ(1, SSL_CTX_use_certificate_file(server_ctx.get(), cert_path.c_str(),
+                                              SSL_FILETYPE_PEM));
+    ASSERT_EQ(1,
+              SSL_CTX_use_PrivateKey_file(server_ctx.get(), key_path.c_str(), SSL_FILETYPE_PEM));
+    ASSERT_EQ(1, SSL_CTX_set_max_proto_version(client_ctx.get(), max_version));
+    ASSERT_EQ(1, SSL_CTX_set_strict_cipher_list(client_ctx.get(), GetParam().c_str()));
+
+    server_ssl_.reset(SSL_new(server_ctx.get()));
+    SSL_set_fd(server_ssl_.get(), server_fd_);
+    SSL_set_accept_state(server_ssl_.get());
+    client_ssl_.reset(SSL_new(client_ctx.get()));
+    SSL_set_fd(client_ssl_.get(), client_fd_);
+    SSL_set_connect_state(client_ssl_.get());
+
+    for (int i = 0; i < 50; i++) {
+      const int client_rc = SSL_do_handshake(client_ssl_.get());
+      const int server_rc = SSL_do_handshake(server_ssl_.get());
+      if (client_rc == 1 && server_rc == 1) {
+        return;
+      }
+    }
+    FAIL() << "handshake did not complete";
+  }
+
+  // Reads from the client until `length` bytes are decrypted or the connection is closed.
+  std::string clientRead(size_t length) {
+    std::string data;
+    char buffer[4096];
+    for (int i = 0; i < 1000 && data.size() < length; i++) {
+      const int rc = SSL_read(client_ssl_.get(), buffer, sizeof(buffer));
+      if (rc > 0) {
+        data.append(buffer, rc);
+      } else if (SSL_get_error(client_ssl_.get(), rc) != SSL_ERROR_WANT_READ) {
+        break;
+      }
+    }
+    return data;
+  }
+
+  int server_fd_{-1};
+  int client_fd_{-1};
+  std::unique_ptr<Network::IoSocketHandleImpl> server_handle_;
+  bssl::UniquePtr<SSL> server_ssl_;
+  bssl::UniquePtr<SSL> client_ssl_;
+};
+
+INSTANTIATE_TEST_SUITE_P(Ciphers, KtlsConnectionTest,
+                         testing::Values("ECDHE-RSA-AES128-GCM-SHA256",
+                                         "ECDHE-RSA-AES256-GCM-SHA384",
+                                         "ECDHE-RSA-CHACHA20-POLY1305"));
+
+TEST_P(KtlsConnectionTest, TransmitOffload) {
+  handshake(TLS1_2_VERSION);
+
+  // Records sent by BoringSSL before the offload are followed by the kernel's.
+  ASSERT_EQ(5, SSL_write(server_ssl_.get(), "hello", 5));
+  EXPECT_EQ("hello", clientRead(5));
+
+  const absl::Status status = Ktls::enableTx(server_ssl_.get(), *server_handle_);
+  if (absl::IsUnavailable(status) || absl::IsUnimplemented(status)) {
+    GTEST_SKIP() << "kernel TLS is not available: " << status;
+  }
+  ASSERT_TRUE(status.ok()) << status;
+
+  // Plaintext written to the socket is encrypted by the kernel.
+  const std::string data(100000, 'a');
+  size_t written = 0;
+  std::string received;
+  while (written < data.size() || received.size() < data.size()) {
+    if (written < data.size()) {
+      const ssize_t rc = ::send(server_fd_, data.data() + written, data.size() - written, 0);
+      if (rc > 0) {
+        written += rc;
+      }
+    }
+    received += clientRead(std::min<size_t>(4096, data.size() - received.size()));
+  }
+  EXPECT_EQ(data, received);
+
+  // The client keeps writing through the user space connection.
+  ASSERT_EQ(5, SSL_write(client_ssl_.get(), "world", 5));
+  char buffer[5];
+  int rc = -1;
+  for (int i = 0; i < 100 && rc <= 0; i++) {
+    rc = SSL_read(server_ssl_.get(), buffer, sizeof(buffer));
+  }
+  ASSERT_EQ(5, rc);
+  EXPECT_EQ("world", absl::string_view(buffer, 5));
+
+  EXPECT_TRUE(Ktls::sendCloseNotify(*server_handle_).ok());
+  for (int i = 0; i < 100; i++) {
+    rc = SSL_read(client_ssl_.get(), buffer, sizeof(buffer));
+    if (SSL_get_error(client_ssl_.get(), rc) != SSL_ERROR_WANT_READ) {
+      break;
+    }
+  }
+  EXPECT_EQ(SSL_ERROR_ZERO_RETURN, SSL_get_error(client_ssl_.get(), rc));
+}
+
+TEST_P(KtlsConnectionTest, Tls13IsNotOffloaded) {
+  handshake(TLS1_3_VERSION);
+  if (SSL_version(server_ssl_.get()) != TLS1_3_VERSION) {
+    GTEST_SKIP() << "TLS 1.3 was not negotiated";
+  }
+
+  // The connection is left untouched.
+  StrictMock<Network::MockIoHandle> io_handle;
+  EXPECT_CALL(io_handle, setOption(_, _, _, _)).Times(0);
+  EXPECT_TRUE(absl::IsUnimplemented(Ktls::enableTx(server_ssl_.get(), io_handle)));
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,158 @@
+// Compares the throughput of writes encrypted by BoringSSL, the way SslSocket does it, with writes
+// of plaintext to a socket whose transmit direction has been offloaded to kernel TLS. The
+// connection runs over loopback TCP, and the reader decrypts with BoringSSL in both cases.
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/tls/ktls.h"
+
+#include "test/test_common/environment.h"
+
+#include "benchmark/benchmark.h"
+#include "openssl/ssl.h"
+#include "tools/cpp/runfiles/runfiles.h"
+
+namespace Envoy {
+namespace Extensions::TransportSockets::Tls {
+
+// Creates a connected pair of non-blocking loopback TCP sockets.
+static void tcpSocketPair(int sockets[2]) {
+  const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+  RELEASE_ASSERT(listener >= 0, "socket");
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t address_len = sizeof(address);
+  RELEASE_ASSERT(::bind(listener, reinterpret_cast<sockaddr*>(&address), address_len) == 0,
+                 "bind");
+  RELEASE_ASSERT(::listen(listener, 1) == 0, "listen");
+  RELEASE_ASSERT(::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &address_len) == 0,
+                 "getsockname");
+  sockets[1] = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  RELEASE_ASSERT(sockets[1] >= 0, "socket");
+  ::connect(sockets[1], reinterpret_cast<sockaddr*>(&address), address_len);
+  sockets[0] = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK);
+  RELEASE_ASSERT(sockets[0] >= 0, "accept");
+  ::close(listener);
+}
+
+static void handshake(SSL* client, SSL* server) {
+  for (int i = 0; i < 50; i++) {
+    const int client_rc = SSL_do_handshake(client);
+    const int server_rc = SSL_do_handshake(server);
+    if (client_rc == 1 && server_rc == 1) {
+      return;
+    }
+  }
+  PANIC("handshake did not complete");
+}
+
+static void addFullSlices(Buffer::Instance& buffer, unsigned num_slices) {
+  for (unsigned i = 0; i < num_slices; i++) {
+    Buffer::Reservation reservation = buffer.reserveForRead();
+    memset(reservation.slices()[0].mem_, 'a', reservation.slices()[0].len_);
+    reservation.commit(reservation.slices()[0].len_);
+  }
+}
+
+// Drains everything readable from the server connection.
+static void drainServer(SSL* server) {
+  static uint8_t read_buf[1024 * 1024];
+  while (SSL_read(server, read_buf, sizeof(read_buf)) > 0) {
+  }
+}
+
+static void testThroughput(benchmark::State& state) {
+  const bool ktls = state.range(0);
+  const unsigned num_slices = state.range(1);
+
+  std::string error;
+  std::unique_ptr<bazel::tools::cpp::runfiles::Runfiles> runfiles(
+      bazel::tools::cpp::runfiles::Runfiles::Create("ktls_throughput_benchmark", &error));
+  Envoy::TestEnvironment::setRunfiles(runfiles.get());
+
+  int sockets[2];
+  tcpSocketPair(sockets);
+  // The client socket is closed by its handle.
+  Network::IoSocketHandleImpl client_handle(sockets[1]);
+
+  bssl::UniquePtr<SSL_CTX> server_ctx(SSL_CTX_new(TLS_method()));
+  bssl::UniquePtr<SSL_CTX> client_ctx(SSL_CTX_new(TLS_method()));
+  std::string cert_path =
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_cert.pem");
+  std::string key_path =
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_key.pem");
+  RELEASE_ASSERT(
+      SSL_CTX_use_certificate_file(server_ctx.get(), cert_path.c_str(), SSL_FILETYPE_PEM) > 0,
+      "SSL_CTX_use_certificate_file");
+  RELEASE_ASSERT(
+      SSL_CTX_use_PrivateKey_file(server_ctx.get(), key_path.c_str(), SSL_FILETYPE_PEM) > 0,
+      "SSL_CTX_use_PrivateKey_file");
+  // Use a protocol version and cipher that can be offloaded in both cases, for a fair comparison.
+  SSL_CTX_set_max_proto_version(client_ctx.get(), TLS1_2_VERSION);
+  SSL_CTX_set_strict_cipher_list(client_ctx.get(), "ECDHE-RSA-AES128-GCM-SHA256");
+
+  bssl::UniquePtr<SSL> server_ssl(SSL_new(server_ctx.get()));
+  SSL_set_fd(server_ssl.get(), sockets[0]);
+  SSL_set_accept_state(server_ssl.get());
+  bssl::UniquePtr<SSL> client_ssl(SSL_new(client_ctx.get()));
+  SSL_set_fd(client_ssl.get(), sockets[1]);
+  SSL_set_connect_state(client_ssl.get());
+  handshake(client_ssl.get(), server_ssl.get());
+
+  if (ktls) {
+    const absl::Status status = Ktls::enableTx(client_ssl.get(), client_handle);
+    if (!status.ok()) {
+      state.SkipWithError(std::string(status.message()).c_str());
+      ::close(sockets[0]);
+      return;
+    }
+  }
+
+  uint64_t bytes_written = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    state.PauseTiming();
+    Buffer::OwnedImpl write_buf;
+    addFullSlices(write_buf, num_slices);
+    bytes_written += write_buf.length();
+    state.ResumeTiming();
+
+    while (write_buf.length() > 0) {
+      if (ktls) {
+        // As SslSocket does once the transmit direction is offloaded.
+        Api::IoCallUint64Result result = client_handle.write(write_buf);
+        RELEASE_ASSERT(result.ok() || result.wouldBlock(), "write");
+        if (result.ok()) {
+          continue;
+        }
+      } else {
+        // As SslSocket does otherwise.
+        const size_t len = std::min<uint64_t>(write_buf.length(), 16384);
+        const int rc = SSL_write(client_ssl.get(), write_buf.linearize(len), len);
+        if (rc > 0) {
+          write_buf.drain(rc);
+          continue;
+        }
+        RELEASE_ASSERT(SSL_get_error(client_ssl.get(), rc) == SSL_ERROR_WANT_WRITE, "SSL_write");
+      }
+      // The socket buffers are full, let the reader catch up.
+      drainServer(server_ssl.get());
+    }
+    drainServer(server_ssl.get());
+  }
+  state.counters["throughput"] = benchmark::Counter(bytes_written, benchmark::Counter::kIsRate);
+
+  ::close(sockets[0]);
+}
+
+BENCHMARK(testThroughput)
+    ->Unit(::benchmark::kMicrosecond)
+    ->ArgNames({"ktls", "slices"})
+    ->ArgsProduct({{0, 1}, {1, 10, 100}});
+
+} // namespace Extensions::TransportSockets::Tls
+} // namespace Envoy
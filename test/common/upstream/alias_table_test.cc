@@ -0,0 +1,72 @@
+#include <vector>
+
+#include "source/common/upstream/alias_table.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+// Returns how often each index is picked when the random values are swept evenly over every
+// column of the table and coin_steps coin values for each column.
+std::vector<double> pickFrequencies(const AliasTable& table, uint32_t coin_steps) {
+  std::vector<double> frequencies(table.size());
+  const uint64_t columns = table.size();
+  for (uint64_t column = 0; column < columns; ++column) {
+    // The smallest low 32 bits that map to the column.
+    const uint64_t low = ((column << 32) + columns - 1) / columns;
+    for (uint64_t coin = 0; coin < coin_steps; ++coin) {
+      const uint64_t high = (coin << 32) / coin_steps;
+      frequencies[table.pick((high << 32) | low)] += 1.0 / (columns * coin_steps);
+    }
+  }
+  return frequencies;
+}
+
+TEST(AliasTableTest, Empty) {
+  EXPECT_TRUE(AliasTable().empty());
+  EXPECT_TRUE(AliasTable(0, [](size_t) { return 1.0; }).empty());
+  EXPECT_TRUE(AliasTable(3, [](size_t) { return 0.0; }).empty());
+}
+
+TEST(AliasTableTest, SingleEntry) {
+  const AliasTable table(1, [](size_t) { return 5.0; });
+  ASSERT_EQ(1, table.size());
+  EXPECT_EQ(0, table.pick(0));
+  EXPECT_EQ(0, table.pick(UINT64_MAX));
+}
+
+TEST(AliasTableTest, EqualWeights) {
+  const AliasTable table(4, [](size_t) { return 3.0; });
+  // Every column picks itself.
+  for (uint32_t column = 0; column < 4; ++column) {
+    EXPECT_EQ(column, table.pick((uint64_t(column) << 30) | (UINT64_MAX << 32)));
+  }
+}
+
+TEST(AliasTableTest, Weighted) {
+  const std::vector<double> weights{1, 2, 3, 4, 0, 10};
+  const AliasTable table(weights.size(), [&weights](size_t i) { return weights[i]; });
+  ASSERT_EQ(weights.size(), table.size());
+
+  const std::vector<double> frequencies = pickFrequencies(table, 1000);
+  for (size_t i = 0; i < weights.size(); ++i) {
+    EXPECT_NEAR(weights[i] / 20, frequencies[i], 0.001) << i;
+  }
+}
+
+TEST(AliasTableTest, SkewedWeights) {
+  // One heavy object and many light ones.
+  const AliasTable table(1000, [](size_t i) { return i == 0 ? 999.0 : 1.0; });
+
+  const std::vector<double> frequencies = pickFrequencies(table, 10000);
+  EXPECT_NEAR(999.0 / 1998, frequencies[0], 0.001);
+  for (size_t i = 1; i < frequencies.size(); ++i) {
+    EXPECT_NEAR(1.0 / 1998, frequencies[i], 0.0001) << i;
+  }
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
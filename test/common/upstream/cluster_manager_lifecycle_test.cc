@@ -2458,6 +2458,93 @@ TEST_P(ClusterManagerLifecycleTest, CrossPriorityHostMapSyncTest) {
       cluster.prioritySet().crossPriorityHostMap());
 }
 
+// Test that a membership only update that cancels a pending merged update is not delivered to the
+// workers as a membership only update, since it also delivers the merged update.
+TEST_P(ClusterManagerLifecycleTest, MembershipOnlyUpdateCancelsMergedUpdate) {
+  std::string yaml = R"EOF(
+  static_resources:
+    clusters:
+    - name: cluster_1
+      connect_timeout: 0.250s
+      type: STATIC
+      lb_policy: ROUND_ROBIN
+      load_assignment:
+        cluster_name: cluster_1
+        endpoints:
+        - lb_endpoints:
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.1
+                  port_value: 11001
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.1
+                  port_value: 11002
+      common_lb_config:
+        update_merge_window: 3s
+  )EOF";
+  create(parseBootstrapFromV3Yaml(yaml));
+
+  Event::MockTimer* timer = new NiceMock<Event::MockTimer>(&factory_.dispatcher_);
+  Cluster& cluster = cluster_manager_->activeClusters().begin()->second;
+  HostVectorSharedPtr hosts(
+      new HostVector(cluster.prioritySet().hostSetsPerPriority()[0]->hosts()));
+  HostsPerLocalitySharedPtr hosts_per_locality = std::make_shared<HostsPerLocalityImpl>();
+  HostVector hosts_added;
+  HostVector hosts_removed;
+  auto update_hosts = [&](bool membership_update_only) {
+    PrioritySet::UpdateHostsParams params =
+        updateHostsParams(hosts, hosts_per_locality,
+                          std::make_shared<const HealthyHostVector>(*hosts), hosts_per_locality);
+    params.membership_update_only = membership_update_only;
+    cluster.prioritySet().updateHosts(0, std::move(params), {}, hosts_added, hosts_removed, 123,
+                                      absl::nullopt, absl::nullopt);
+  };
+  auto worker_membership_update_only = [this]() {
+    return cluster_manager_->getThreadLocalCluster("cluster_1")
+        ->prioritySet()
+        .hostSetsPerPriority()[0]
+        ->membershipUpdateOnly();
+  };
+
+  // A membership only update is delivered immediately as such.
+  hosts_removed.push_back((*hosts)[0]);
+  update_hosts(true);
+  EXPECT_EQ(1, factory_.stats_.counter("cluster_manager.cluster_updated").value());
+  EXPECT_TRUE(worker_membership_update_only());
+
+  // A health check update is merged.
+  hosts_removed.clear();
+  (*hosts)[1]->healthFlagSet(Host::HealthFlag::FAILED_ACTIVE_HC);
+  update_hosts(false);
+  EXPECT_EQ(1, factory_.stats_.counter("cluster_manager.cluster_updated").value());
+  EXPECT_TRUE(timer->enabled_);
+
+  // The next membership only update cancels the merged update and delivers it too.
+  hosts_added.push_back((*hosts)[0]);
+  update_hosts(true);
+  EXPECT_EQ(2, factory_.stats_.counter("cluster_manager.cluster_updated").value());
+  EXPECT_EQ(1, factory_.stats_.counter("cluster_manager.update_merge_cancelled").value());
+  EXPECT_FALSE(worker_membership_update_only());
+
+  // Updates delivered by the merge timer are never membership only updates.
+  hosts_added.clear();
+  update_hosts(true);
+  EXPECT_EQ(2, factory_.stats_.counter("cluster_manager.cluster_updated").value());
+  timer->invokeCallback();
+  EXPECT_EQ(1, factory_.stats_.counter("cluster_manager.cluster_updated_via_merge").value());
+  EXPECT_FALSE(worker_membership_update_only());
+
+  // Once no merged update is pending, membership only updates are delivered as such again.
+  time_system_.advanceTimeWait(std::chrono::seconds(60));
+  hosts_removed.push_back((*hosts)[0]);
+  update_hosts(true);
+  EXPECT_EQ(3, factory_.stats_.counter("cluster_manager.cluster_updated").value());
+  EXPECT_TRUE(worker_membership_update_only());
+}
+
 // Make sure the drainConnections() with a predicate can correctly exclude a host.
 TEST_P(ClusterManagerLifecycleTest, DrainConnectionsPredicate) {
   const std::string yaml = R"EOF(
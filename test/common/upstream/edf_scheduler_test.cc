@@ -151,6 +151,74 @@ TEST_F(EdfSchedulerTest, ExpiredPeekedIsNotPicked) {
   EXPECT_TRUE(sched.pickAndAdd([](const double&) { return 1; }) == nullptr);
 }
 
+// Validate that removed entries are not picked.
+TEST_F(EdfSchedulerTest, Removed) {
+  EdfScheduler<uint32_t> sched;
+  auto first_entry = std::make_shared<uint32_t>(37);
+  auto second_entry = std::make_shared<uint32_t>(42);
+  auto third_entry = std::make_shared<uint32_t>(43);
+  sched.add(1, first_entry);
+  sched.add(1, second_entry);
+  sched.add(1, third_entry);
+  sched.remove(second_entry);
+  EXPECT_FALSE(sched.empty());
+
+  for (int i = 0; i < 6; ++i) {
+    auto p = sched.pickAndAdd([](const double&) { return 1; });
+    EXPECT_EQ(i % 2 == 0 ? 37 : 43, *p);
+  }
+}
+
+// Validate that a removed entry that was already peeked is not picked.
+TEST_F(EdfSchedulerTest, RemovedPeekedIsNotPicked) {
+  EdfScheduler<uint32_t> sched;
+  auto first_entry = std::make_shared<uint32_t>(37);
+  auto second_entry = std::make_shared<uint32_t>(42);
+  sched.add(1, first_entry);
+  sched.add(1, second_entry);
+
+  EXPECT_EQ(37, *sched.peekAgain([](const double&) { return 1; }));
+  sched.remove(first_entry);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(42, *sched.pickAndAdd([](const double&) { return 1; }));
+  }
+}
+
+// Validate that an entry can be added back after it was removed.
+TEST_F(EdfSchedulerTest, RemovedAndAddedBack) {
+  EdfScheduler<uint32_t> sched;
+  auto first_entry = std::make_shared<uint32_t>(37);
+  auto second_entry = std::make_shared<uint32_t>(42);
+  sched.add(1, first_entry);
+  sched.add(1, second_entry);
+  sched.remove(first_entry);
+  sched.add(1, first_entry);
+
+  for (int i = 0; i < 4; ++i) {
+    auto p = sched.pickAndAdd([](const double&) { return 1; });
+    EXPECT_EQ(i % 2 == 0 ? 42 : 37, *p);
+  }
+}
+
+// Validate that removed entries are compacted away, including entries destroyed after their
+// removal.
+TEST_F(EdfSchedulerTest, RemovedAreCompacted) {
+  EdfScheduler<uint32_t> sched;
+  auto first_entry = std::make_shared<uint32_t>(37);
+  auto second_entry = std::make_shared<uint32_t>(42);
+  sched.add(1, first_entry);
+  sched.add(1, second_entry);
+  sched.remove(first_entry);
+  first_entry.reset();
+  EXPECT_FALSE(sched.empty());
+
+  EXPECT_EQ(42, *sched.pickAndAdd([](const double&) { return 1; }));
+  sched.remove(second_entry);
+  EXPECT_TRUE(sched.empty());
+  EXPECT_EQ(nullptr, sched.pickAndAdd([](const double&) { return 1; }));
+  EXPECT_EQ(nullptr, sched.peekAgain([](const double&) { return 1; }));
+}
+
 TEST_F(EdfSchedulerTest, ManyPeekahead) {
   EdfScheduler<uint32_t> sched1;
   EdfScheduler<uint32_t> sched2;
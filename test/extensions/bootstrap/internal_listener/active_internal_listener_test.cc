@@ -307,6 +307,7 @@ public:
       return hand_off_restored_destination_connections_;
     }
     uint32_t perConnectionBufferLimitBytes() const override { return 0; }
+    uint32_t zeroCopySendMinBytes() const override { return 0; }
     std::chrono::milliseconds listenerFiltersTimeout() const override {
       return listener_filters_timeout_;
     }
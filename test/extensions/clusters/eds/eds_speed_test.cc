@@ -17,6 +17,7 @@
 #include "source/extensions/config_subscription/grpc/grpc_mux_impl.h"
 #include "source/extensions/config_subscription/grpc/grpc_subscription_impl.h"
 #include "source/extensions/config_subscription/grpc/xds_mux/grpc_mux_impl.h"
+#include "source/extensions/load_balancing_policies/round_robin/round_robin_lb.h"
 #include "source/server/transport_socket_config_impl.h"
 
 #include "test/benchmark/main.h"
@@ -148,12 +149,94 @@ public:
     // this is what we're actually testing:
     validation_visitor_.setSkipValidation(ignore_unknown_dynamic_fields);
 
+    auto response = makeResponse(cluster_load_assignment);
+    state_.ResumeTiming();
+    receiveResponse(std::move(response));
+    ASSERT(cluster_->prioritySet().hostSetsPerPriority()[1]->hostsPerLocality().get()[0].size() ==
+           num_hosts);
+  }
+
+  // Applies an EDS update that replaces one in a hundred of num_hosts weighted endpoints spread
+  // over four localities, and propagates it to num_workers worker priority sets with round robin
+  // load balancers the way the cluster manager posts host set updates to its workers. Only the
+  // propagation to the workers is timed.
+  void membershipChurnHelper(size_t num_hosts, size_t num_workers) {
+    state_.PauseTiming();
+
+    const auto load_assignment = [num_hosts](size_t first_host) {
+      envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+      cluster_load_assignment.set_cluster_name("fare");
+      for (uint32_t zone = 0; zone < 4; ++zone) {
+        auto* endpoints = cluster_load_assignment.add_endpoints();
+        endpoints->mutable_locality()->set_zone(fmt::format("zone-{}", zone));
+        endpoints->mutable_load_balancing_weight()->set_value(1);
+        // Hosts keep their locality and weight across updates.
+        for (size_t i = first_host + (zone + 4 - first_host % 4) % 4; i < first_host + num_hosts;
+             i += 4) {
+          auto* lb_endpoint = endpoints->add_lb_endpoints();
+          lb_endpoint->set_health_status(envoy::config::core::v3::HEALTHY);
+          lb_endpoint->mutable_load_balancing_weight()->set_value(1 + i % 3);
+          auto* socket_address =
+              lb_endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address();
+          socket_address->set_address("10.0.1." + std::to_string(i / 60000));
+          socket_address->set_port_value((1000 + i) % 60000);
+        }
+      }
+      return cluster_load_assignment;
+    };
+
+    HostVector hosts_added;
+    HostVector hosts_removed;
+    auto update_cb = cluster_->prioritySet().addPriorityUpdateCb(
+        [&hosts_added, &hosts_removed](uint32_t, const HostVector& added,
+                                       const HostVector& removed) {
+          hosts_added = added;
+          hosts_removed = removed;
+          return absl::OkStatus();
+        });
+
+    std::vector<std::unique_ptr<PrioritySetImpl>> worker_priority_sets;
+    const auto propagate = [this, &worker_priority_sets, &hosts_added, &hosts_removed]() {
+      const HostSet& host_set = *cluster_->prioritySet().hostSetsPerPriority()[0];
+      for (auto& priority_set : worker_priority_sets) {
+        priority_set->updateHosts(0, HostSetImpl::updateHostsParams(host_set),
+                                  host_set.localityWeights(), hosts_added, hosts_removed,
+                                  random_.random(), absl::nullopt, absl::nullopt,
+                                  cluster_->prioritySet().crossPriorityHostMap());
+      }
+    };
+
+    validation_visitor_.setSkipValidation(true);
+    receiveResponse(makeResponse(load_assignment(0)));
+    std::vector<LoadBalancerPtr> worker_lbs;
+    for (size_t i = 0; i < num_workers; ++i) {
+      worker_priority_sets.push_back(std::make_unique<PrioritySetImpl>());
+    }
+    propagate();
+    for (auto& priority_set : worker_priority_sets) {
+      worker_lbs.push_back(std::make_unique<RoundRobinLoadBalancer>(
+          *priority_set, nullptr, lb_stats_, server_context_.runtime_loader_, random_, 50,
+          envoy::extensions::load_balancing_policies::round_robin::v3::RoundRobin(),
+          server_context_.time_system_));
+    }
+
+    receiveResponse(makeResponse(load_assignment(num_hosts / 100)));
+    ASSERT(hosts_added.size() == num_hosts / 100 && hosts_removed.size() == num_hosts / 100);
+    state_.ResumeTiming();
+    propagate();
+  }
+
+  std::unique_ptr<envoy::service::discovery::v3::DiscoveryResponse>
+  makeResponse(const envoy::config::endpoint::v3::ClusterLoadAssignment& cluster_load_assignment) {
     auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
     response->set_type_url(type_url_);
     response->set_version_info(fmt::format("version-{}", version_++));
     auto* resource = response->mutable_resources()->Add();
     resource->PackFrom(cluster_load_assignment);
-    state_.ResumeTiming();
+    return response;
+  }
+
+  void receiveResponse(std::unique_ptr<envoy::service::discovery::v3::DiscoveryResponse> response) {
     if (use_unified_mux_) {
       dynamic_cast<Config::XdsMux::GrpcMuxSotw&>(*grpc_mux_)
           .grpcStreamForTest()
@@ -163,8 +246,6 @@ public:
           .grpcStreamForTest()
           .onReceiveMessage(std::move(response));
     }
-    ASSERT(cluster_->prioritySet().hostSetsPerPriority()[1]->hostsPerLocality().get()[0].size() ==
-           num_hosts);
   }
 
   NiceMock<Server::Configuration::MockServerFactoryContext> server_context_;
@@ -176,6 +257,8 @@ public:
   uint64_t version_{};
   bool initialized_{};
   Stats::Scope& scope_{*stats_.rootScope()};
+  ClusterLbStatNames lb_stat_names_{stats_.symbolTable()};
+  ClusterLbStats lb_stats_{lb_stat_names_, scope_};
   Config::SubscriptionStats subscription_stats_;
   Ssl::MockContextManager ssl_context_manager_;
   envoy::config::cluster::v3::Cluster eds_cluster_;
@@ -245,3 +328,24 @@ static void healthOnlyUpdate(State& state) {
 }
 
 BENCHMARK(healthOnlyUpdate)->Ranges({{1, 100000}, {false, true}})->Unit(benchmark::kMillisecond);
+
+// Propagates an EDS update that replaces 1% of the endpoints of a weighted cluster to 8 workers,
+// with and without in-place load balancer delta updates.
+static void membershipChurnUpdate(State& state) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logging_state(spdlog::level::warn,
+                                       Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  Envoy::TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.edf_lb_host_set_delta_updates",
+                               state.range(1) ? "true" : "false"}});
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    Envoy::Upstream::EdsSpeedTest speed_test(state, false);
+    uint32_t endpoints = skipExpensiveBenchmarks() ? 100 : state.range(0);
+
+    speed_test.membershipChurnHelper(endpoints, 8);
+  }
+}
+
+BENCHMARK(membershipChurnUpdate)
+    ->Ranges({{1000, 20000}, {false, true}})
+    ->Unit(benchmark::kMillisecond);
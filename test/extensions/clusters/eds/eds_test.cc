@@ -389,6 +389,44 @@ TEST_F(EdsTest, EndpointWeightChangeCausesRebuild) {
   EXPECT_EQ(new_hosts[0]->weight(), 31);
 }
 
+// Verify that host sets report whether an update only added and removed hosts.
+TEST_F(EdsTest, MembershipUpdateOnly) {
+  envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+  cluster_load_assignment.set_cluster_name("fare");
+  auto* endpoints = cluster_load_assignment.add_endpoints();
+  auto add_endpoint = [endpoints](int port) {
+    auto* endpoint = endpoints->add_lb_endpoints();
+    auto* socket_address =
+        endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address();
+    socket_address->set_address("1.2.3.4");
+    socket_address->set_port_value(port);
+    return endpoint;
+  };
+  add_endpoint(80);
+
+  initialize();
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  const auto& host_set = *cluster_->prioritySet().hostSetsPerPriority()[0];
+  EXPECT_TRUE(host_set.membershipUpdateOnly());
+
+  // Adding and removing hosts is a membership-only update.
+  add_endpoint(81);
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(2, host_set.hosts().size());
+  EXPECT_TRUE(host_set.membershipUpdateOnly());
+  endpoints->mutable_lb_endpoints()->DeleteSubrange(0, 1);
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(1, host_set.hosts().size());
+  EXPECT_TRUE(host_set.membershipUpdateOnly());
+
+  // Changing the weight of a host that is kept is not.
+  endpoints->mutable_lb_endpoints(0)->mutable_load_balancing_weight()->set_value(2);
+  add_endpoint(82);
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_EQ(2, host_set.hosts().size());
+  EXPECT_FALSE(host_set.membershipUpdateOnly());
+}
+
 // Verify that host weight changes cause a full rebuild.
 TEST_F(EdsTest, DualStackEndpoint) {
   envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
@@ -2,6 +2,7 @@
 #include "envoy/extensions/access_loggers/file/v3/file.pb.h"
 #include "envoy/extensions/filters/udp/udp_proxy/v3/udp_proxy.pb.h"
 #include "envoy/extensions/filters/udp/udp_proxy/v3/udp_proxy.pb.validate.h"
+#include "envoy/extensions/udp_packet_writer/v3/udp_gso_batch_writer_factory.pb.h"
 
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/common/hash.h"
@@ -19,6 +20,7 @@
 #include "test/extensions/filters/udp/udp_proxy/session_filters/psc_setter.pb.h"
 #include "test/mocks/api/mocks.h"
 #include "test/mocks/http/stream_encoder.h"
+#include "test/mocks/network/mocks.h"
 #include "test/mocks/network/socket.h"
 #include "test/mocks/server/factory_context.h"
 #include "test/mocks/server/listener_factory_context.h"
@@ -28,6 +30,7 @@
 #include "test/mocks/upstream/host.h"
 #include "test/mocks/upstream/load_balancer_context.h"
 #include "test/mocks/upstream/thread_local_cluster.h"
+#include "test/test_common/registry.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 
 #include "gmock/gmock.h"
@@ -103,6 +106,39 @@ Api::IoCallUint64Result makeError(int sys_errno) {
   return {0, Network::IoSocketError::create(sys_errno)};
 }
 
+// Creates the given writer for the next upstream socket, in place of the GSO batch writer.
+class TestUdpPacketWriterFactoryFactory : public Network::UdpPacketWriterFactoryFactory,
+                                          public Network::UdpPacketWriterFactory {
+public:
+  // Network::UdpPacketWriterFactoryFactory
+  std::string name() const override { return "envoy.udp_packet_writer.gso"; }
+  Network::UdpPacketWriterFactoryPtr
+  createUdpPacketWriterFactory(const envoy::config::core::v3::TypedExtensionConfig&) override {
+    return std::make_unique<ForwardingFactory>(*this);
+  }
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<envoy::extensions::udp_packet_writer::v3::UdpGsoBatchWriterFactory>();
+  }
+
+  // Network::UdpPacketWriterFactory
+  Network::UdpPacketWriterPtr createUdpPacketWriter(Network::IoHandle&, Stats::Scope&) override {
+    return std::move(writer_);
+  }
+
+  std::unique_ptr<NiceMock<Network::MockUdpPacketWriter>> writer_{
+      std::make_unique<NiceMock<Network::MockUdpPacketWriter>>()};
+
+private:
+  struct ForwardingFactory : public Network::UdpPacketWriterFactory {
+    explicit ForwardingFactory(Network::UdpPacketWriterFactory& parent) : parent_(parent) {}
+    Network::UdpPacketWriterPtr createUdpPacketWriter(Network::IoHandle& io_handle,
+                                                      Stats::Scope& scope) override {
+      return parent_.createUdpPacketWriter(io_handle, scope);
+    }
+    Network::UdpPacketWriterFactory& parent_;
+  };
+};
+
 class UdpProxyFilterBase : public testing::Test {
 public:
   UdpProxyFilterBase() {
@@ -785,6 +821,104 @@ matcher:
   EXPECT_EQ(output_.front(), "fake_cluster 0 5 0 0 1");
 }
 
+// Verify that with a batch mode upstream packet writer, the datagrams of a session are written to
+// the writer as they are received and flushed at the end of the read event.
+TEST_F(UdpProxyFilterTest, BatchedUpstreamWrites) {
+  TestUdpPacketWriterFactoryFactory writer_factory;
+  Registry::InjectFactory<Network::UdpPacketWriterFactoryFactory> registration(writer_factory);
+  Network::MockUdpPacketWriter& writer = *writer_factory.writer_;
+
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+upstream_packet_writer_config:
+  name: envoy.udp_packet_writer.gso
+  typed_config:
+    '@type': type.googleapis.com/envoy.extensions.udp_packet_writer.v3.UdpGsoBatchWriterFactory
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  EXPECT_CALL(*test_sessions_[0].idle_timer_, enableTimer(_, _)).Times(2);
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, connect(_));
+  ON_CALL(writer, isBatchMode()).WillByDefault(Return(true));
+  {
+    InSequence s;
+    EXPECT_CALL(writer, writePacket(_, nullptr, _))
+        .WillOnce(Invoke([this](const Buffer::Instance& buffer, const Network::Address::Ip*,
+                                const Network::Address::Instance& peer_address) {
+          EXPECT_EQ("hello", buffer.toString());
+          EXPECT_EQ(peer_address, *upstream_address_);
+          return makeNoError(buffer.length());
+        }));
+    EXPECT_CALL(writer, writePacket(_, nullptr, _))
+        .WillOnce(Invoke([](const Buffer::Instance& buffer, const Network::Address::Ip*,
+                            const Network::Address::Instance&) {
+          EXPECT_EQ("world", buffer.toString());
+          return makeNoError(buffer.length());
+        }));
+    EXPECT_CALL(writer, flush()).WillOnce(InvokeWithoutArgs([]() { return makeNoError(10); }));
+  }
+
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world");
+  filter_->onReadComplete();
+  EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
+  EXPECT_EQ(2, TestUtility::findCounter(factory_context_.server_factory_context_.cluster_manager_
+                                            .thread_local_cluster_.cluster_.info_->stats_store_,
+                                        "udp.sess_tx_datagrams")
+                   ->value());
+
+  // Nothing is pending, so the next read event does not flush.
+  EXPECT_CALL(writer, flush()).Times(0);
+  filter_->onReadComplete();
+}
+
+// Verify that datagrams buffered by the upstream packet writer are flushed when the session is
+// removed, and that write errors are counted.
+TEST_F(UdpProxyFilterTest, BatchedUpstreamWritesFlushedOnSessionRemoval) {
+  TestUdpPacketWriterFactoryFactory writer_factory;
+  Registry::InjectFactory<Network::UdpPacketWriterFactoryFactory> registration(writer_factory);
+  Network::MockUdpPacketWriter& writer = *writer_factory.writer_;
+
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+upstream_packet_writer_config:
+  name: envoy.udp_packet_writer.gso
+  typed_config:
+    '@type': type.googleapis.com/envoy.extensions.udp_packet_writer.v3.UdpGsoBatchWriterFactory
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  EXPECT_CALL(*test_sessions_[0].idle_timer_, enableTimer(_, _)).Times(2);
+  ON_CALL(writer, isBatchMode()).WillByDefault(Return(true));
+  EXPECT_CALL(writer, writePacket(_, _, _))
+      .WillOnce(InvokeWithoutArgs([]() { return makeNoError(5); }))
+      .WillOnce(InvokeWithoutArgs([]() { return makeError(SOCKET_ERROR_AGAIN); }));
+  EXPECT_CALL(writer, setWritable());
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world");
+  EXPECT_EQ(1, TestUtility::findCounter(factory_context_.server_factory_context_.cluster_manager_
+                                            .thread_local_cluster_.cluster_.info_->stats_store_,
+                                        "udp.sess_tx_errors")
+                   ->value());
+
+  EXPECT_CALL(writer, flush()).WillOnce(InvokeWithoutArgs([]() { return makeNoError(5); }));
+  filter_.reset();
+}
+
 // No upstream host handling.
 TEST_F(UdpProxyFilterTest, NoUpstreamHost) {
   InSequence s;
@@ -47,6 +47,13 @@ public:
   static double slowStartMinWeightPercent(const EdfLoadBalancerBase& edf_lb) {
     return edf_lb.slow_start_min_weight_percent_;
   }
+  static const EdfScheduler<Host>* healthyHostsScheduler(EdfLoadBalancerBase& edf_lb,
+                                                         uint32_t priority) {
+    return edf_lb
+        .scheduler_[EdfLoadBalancerBase::HostsSource(
+            priority, EdfLoadBalancerBase::HostsSource::SourceType::HealthyHosts)]
+        .edf_.get();
+  }
 };
 
 class TestZoneAwareLoadBalancer : public ZoneAwareLoadBalancerBase {
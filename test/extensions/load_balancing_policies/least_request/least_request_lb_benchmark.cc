@@ -7,11 +7,19 @@ namespace Envoy {
 namespace Upstream {
 namespace {
 
+using LeastRequestConfig =
+    envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest;
+
 class LeastRequestTester : public BaseTester {
 public:
-  LeastRequestTester(uint64_t num_hosts, uint32_t choice_count) : BaseTester(num_hosts) {
-    envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  LeastRequestTester(uint64_t num_hosts, uint32_t choice_count,
+                     uint32_t weighted_subset_percent = 0, uint32_t weight = 0,
+                     LeastRequestConfig::SelectionMethod selection_method =
+                         LeastRequestConfig::N_CHOICES)
+      : BaseTester(num_hosts, weighted_subset_percent, weight) {
+    LeastRequestConfig lr_lb_config;
     lr_lb_config.mutable_choice_count()->set_value(choice_count);
+    lr_lb_config.set_selection_method(selection_method);
     lb_ =
         std::make_unique<LeastRequestLoadBalancer>(priority_set_, &local_priority_set_, stats_,
                                                    runtime_, random_, 50, lr_lb_config, simTime());
@@ -62,6 +70,36 @@ BENCHMARK(benchmarkLeastRequestLoadBalancerChooseHost)
     ->Args({100, 100, 1000000})
     ->Unit(::benchmark::kMillisecond);
 
+// Compares the EDF scheduler used by N_CHOICES on weighted hosts with the alias table sampling of
+// WEIGHTED_N_CHOICES, on large host sets where half of the hosts have a higher weight.
+void benchmarkLeastRequestLoadBalancerWeightedChooseHost(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const auto selection_method = static_cast<LeastRequestConfig::SelectionMethod>(state.range(1));
+  const uint64_t keys_to_simulate = state.range(2);
+
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 10000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    LeastRequestTester tester(num_hosts, 2, 50, 4, selection_method);
+    TestLoadBalancerContext context;
+    state.ResumeTiming();
+
+    for (uint64_t i = 0; i < keys_to_simulate; ++i) {
+      ::benchmark::DoNotOptimize(tester.lb_->chooseHost(&context).host);
+    }
+  }
+}
+BENCHMARK(benchmarkLeastRequestLoadBalancerWeightedChooseHost)
+    ->Args({10000, LeastRequestConfig::N_CHOICES, 100000})
+    ->Args({10000, LeastRequestConfig::WEIGHTED_N_CHOICES, 100000})
+    ->Args({50000, LeastRequestConfig::N_CHOICES, 100000})
+    ->Args({50000, LeastRequestConfig::WEIGHTED_N_CHOICES, 100000})
+    ->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
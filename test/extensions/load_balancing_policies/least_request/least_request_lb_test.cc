@@ -367,6 +367,209 @@ TEST_P(LeastRequestLoadBalancerTest, WeightImbalanceCallbacks) {
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_.chooseHost(nullptr).host);
 }
 
+TEST_P(LeastRequestLoadBalancerTest, WeightedNChoices) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", 3)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  lr_lb_config.set_selection_method(
+      envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::
+          WEIGHTED_N_CHOICES);
+  LeastRequestLoadBalancer lb_2{priority_set_, nullptr, stats_,       runtime_,
+                                random_,       50,      lr_lb_config, simTime()};
+
+  // The low 32 bits of each sample pick a column of the alias table. With weights 1 and 3 the
+  // first column picks hosts[0] for coin values below one half and hosts[1] otherwise, and the
+  // second column always picks hosts[1].
+  const uint64_t first_column = 0;
+  const uint64_t second_column = 0x80000000;
+
+  // Both hosts are sampled and idle, so the first sample is kept.
+  EXPECT_CALL(random_, random())
+      .Times(3)
+      .WillOnce(Return(0))
+      .WillOnce(Return(first_column))
+      .WillOnce(Return(second_column));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_2.chooseHost(nullptr).host);
+
+  // The sample with fewer active requests per unit of weight wins.
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(1);
+  EXPECT_CALL(random_, random())
+      .Times(3)
+      .WillOnce(Return(0))
+      .WillOnce(Return(first_column))
+      .WillOnce(Return(second_column));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_2.chooseHost(nullptr).host);
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(2);
+  EXPECT_CALL(random_, random())
+      .Times(3)
+      .WillOnce(Return(0))
+      .WillOnce(Return(first_column))
+      .WillOnce(Return(second_column));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_2.chooseHost(nullptr).host);
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(3);
+  EXPECT_CALL(random_, random())
+      .Times(3)
+      .WillOnce(Return(0))
+      .WillOnce(Return(first_column))
+      .WillOnce(Return(second_column));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_2.chooseHost(nullptr).host);
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(5);
+  EXPECT_CALL(random_, random())
+      .Times(3)
+      .WillOnce(Return(0))
+      .WillOnce(Return(first_column))
+      .WillOnce(Return(second_column));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_2.chooseHost(nullptr).host);
+
+  // The high 32 bits of a sample choose between a column and its alias.
+  EXPECT_CALL(random_, random())
+      .Times(3)
+      .WillOnce(Return(0))
+      .WillOnce(Return(first_column | (uint64_t(3) << 62)))
+      .WillOnce(Return(second_column));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_2.chooseHost(nullptr).host);
+}
+
+TEST_P(LeastRequestLoadBalancerTest, WeightedNChoicesWithoutActiveRequestBias) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", 3)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  lr_lb_config.set_selection_method(
+      envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::
+          WEIGHTED_N_CHOICES);
+  lr_lb_config.mutable_active_request_bias()->set_runtime_key("ar_bias");
+  lr_lb_config.mutable_active_request_bias()->set_default_value(1.0);
+  EXPECT_CALL(runtime_.snapshot_, getDouble("ar_bias", 1.0)).WillRepeatedly(Return(0.0));
+  LeastRequestLoadBalancer lb_2{priority_set_, nullptr, stats_,       runtime_,
+                                random_,       50,      lr_lb_config, simTime()};
+
+  // The active request bias does not apply: the samples are still compared by their active
+  // requests.
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(5);
+  EXPECT_CALL(random_, random())
+      .Times(3)
+      .WillOnce(Return(0))
+      .WillOnce(Return(0))
+      .WillOnce(Return(0x80000000));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_2.chooseHost(nullptr).host);
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(0);
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(2);
+  EXPECT_CALL(random_, random())
+      .Times(3)
+      .WillOnce(Return(0))
+      .WillOnce(Return(0x80000000))
+      .WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_2.chooseHost(nullptr).host);
+}
+
+TEST_P(LeastRequestLoadBalancerTest, WeightedNChoicesEqualWeights) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 2),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", 2)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  lr_lb_config.set_selection_method(
+      envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::
+          WEIGHTED_N_CHOICES);
+  LeastRequestLoadBalancer lb_2{priority_set_, nullptr, stats_,       runtime_,
+                                random_,       50,      lr_lb_config, simTime()};
+
+  // Without a weight difference the hosts are sampled uniformly, as with N_CHOICES.
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(1);
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(2);
+  EXPECT_CALL(random_, random())
+      .Times(3)
+      .WillOnce(Return(0))
+      .WillOnce(Return(0))
+      .WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_2.chooseHost(nullptr).host);
+
+  // Adding a heavier host switches to weighted sampling. The last column of the alias table only
+  // picks the heavier host, which is then the only sample even though it has more active requests.
+  hostSet().healthy_hosts_.push_back(makeTestHost(info_, "tcp://127.0.0.1:82", 4));
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({hostSet().healthy_hosts_.back()}, {});
+  hostSet().healthy_hosts_[2]->stats().rq_active_.set(3);
+  EXPECT_CALL(random_, random()).Times(3).WillRepeatedly(Return(UINT32_MAX));
+  EXPECT_EQ(hostSet().healthy_hosts_[2], lb_2.chooseHost(nullptr).host);
+}
+
+TEST_P(LeastRequestLoadBalancerTest, WeightedNChoicesDistribution) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", 3)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  lr_lb_config.set_selection_method(
+      envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::
+          WEIGHTED_N_CHOICES);
+  auto random = Random::RandomGeneratorImpl();
+  LeastRequestLoadBalancer lb{priority_set_, nullptr, stats_,       runtime_,
+                              random,        50,      lr_lb_config, simTime()};
+
+  // Idle hosts are picked in proportion to their weights, the weights not being counted a second
+  // time when the samples are compared.
+  const size_t num_selections = 100000;
+  size_t host_1_counts = 0;
+  for (size_t i = 0; i < num_selections; ++i) {
+    if (lb.chooseHost(nullptr).host == hostSet().healthy_hosts_[1]) {
+      ++host_1_counts;
+    }
+  }
+  EXPECT_NEAR(0.75, static_cast<double>(host_1_counts) / num_selections, 0.01);
+  EXPECT_NEAR(0.25, static_cast<double>(num_selections - host_1_counts) / num_selections, 0.01);
+}
+
+TEST_P(LeastRequestLoadBalancerTest, WeightedNChoicesLoadedDistribution) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", 3)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  lr_lb_config.set_selection_method(
+      envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::
+          WEIGHTED_N_CHOICES);
+  auto random = Random::RandomGeneratorImpl();
+  LeastRequestLoadBalancer lb{priority_set_, nullptr, stats_,       runtime_,
+                              random,        50,      lr_lb_config, simTime()};
+
+  const auto host_1_share = [&]() {
+    const size_t num_selections = 100000;
+    size_t host_1_counts = 0;
+    for (size_t i = 0; i < num_selections; ++i) {
+      if (lb.chooseHost(nullptr).host == hostSet().healthy_hosts_[1]) {
+        ++host_1_counts;
+      }
+    }
+    return static_cast<double>(host_1_counts) / num_selections;
+  };
+
+  // The heavier host has more active requests but fewer per unit of weight, so the lighter host
+  // is only picked when both samples are the lighter host: 0.25 * 0.25.
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(1);
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(2);
+  EXPECT_NEAR(1 - 0.0625, host_1_share(), 0.01);
+
+  // Both hosts have the same active requests per unit of weight, so the first sample is kept and
+  // the hosts are picked in proportion to their weights.
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(3);
+  EXPECT_NEAR(0.75, host_1_share(), 0.01);
+
+  // The heavier host has more active requests per unit of weight, so it is only picked when both
+  // samples are the heavier host: 0.75 * 0.75.
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(4);
+  EXPECT_NEAR(0.5625, host_1_share(), 0.01);
+}
+
 TEST_P(LeastRequestLoadBalancerTest, SlowStartWithDefaultParams) {
   envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
   LeastRequestLoadBalancer lb_2{priority_set_, nullptr, stats_,       runtime_,
@@ -1,3 +1,6 @@
+#include <deque>
+#include <random>
+
 #include "source/extensions/load_balancing_policies/maglev/maglev_lb.h"
 
 #include "test/benchmark/main.h"
@@ -9,10 +12,15 @@ namespace {
 
 class MaglevTester : public BaseTester {
 public:
-  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0)
+  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0,
+               uint32_t hash_balance_factor = 0)
       : BaseTester(num_hosts, weighted_subset_percent, weight) {
+    if (hash_balance_factor > 0) {
+      config_.mutable_consistent_hashing_lb_config()->mutable_hash_balance_factor()->set_value(
+          hash_balance_factor);
+    }
     maglev_lb_ = std::make_unique<MaglevLoadBalancer>(priority_set_, stats_, stats_scope_, runtime_,
-                                                      random_, 50, config_);
+                                                      random_, 50, config_, simTime());
   }
 
   envoy::extensions::load_balancing_policies::maglev::v3::Maglev config_;
@@ -180,6 +188,81 @@ BENCHMARK(benchmarkMaglevLoadBalancerWeighted)
     ->Args({500, 95, 75, 25, 10000})
     ->Unit(::benchmark::kMillisecond);
 
+// Sends requests for Zipf distributed keys, keeping the last num_hosts * 4 of them active on their
+// hosts, and reports how far the busiest host is above the mean number of requests per host. A
+// hash_balance_factor of 0 disables bounded loads.
+void benchmarkMaglevLoadBalancerZipfBoundedLoad(::benchmark::State& state) {
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    const uint64_t num_hosts = state.range(0);
+    const uint64_t hash_balance_factor = state.range(1);
+    const double zipf_exponent = state.range(2) / 100.0;
+    const uint64_t requests_to_simulate = state.range(3);
+    const uint64_t num_keys = 10000;
+
+    MaglevTester tester(num_hosts, 0, 0, hash_balance_factor);
+    ASSERT_TRUE(tester.maglev_lb_->initialize().ok());
+    LoadBalancerPtr lb = tester.maglev_lb_->factory()->create(tester.lb_params_);
+
+    // Key i is requested with a probability proportional to 1 / (i + 1)^zipf_exponent.
+    std::vector<double> key_cdf;
+    key_cdf.reserve(num_keys);
+    double total_weight = 0;
+    for (uint64_t i = 0; i < num_keys; i++) {
+      total_weight += 1.0 / std::pow(i + 1, zipf_exponent);
+      key_cdf.push_back(total_weight);
+    }
+    std::mt19937_64 random(0);
+    std::uniform_real_distribution<double> uniform(0, total_weight);
+
+    Stats::Gauge& cluster_rq_active = tester.info_->trafficStats()->upstream_rq_active_;
+    std::deque<HostConstSharedPtr> active_requests;
+    absl::node_hash_map<std::string, uint64_t> hit_counter;
+    TestLoadBalancerContext context;
+    state.ResumeTiming();
+
+    for (uint64_t i = 0; i < requests_to_simulate; i++) {
+      if (active_requests.size() == num_hosts * 4) {
+        active_requests.front()->stats().rq_active_.dec();
+        cluster_rq_active.dec();
+        active_requests.pop_front();
+      }
+
+      const uint64_t key = std::min<uint64_t>(
+          std::upper_bound(key_cdf.begin(), key_cdf.end(), uniform(random)) - key_cdf.begin(),
+          num_keys - 1);
+      context.hash_key_ = hashInt(key);
+      HostConstSharedPtr host = lb->chooseHost(&context).host;
+      host->stats().rq_active_.inc();
+      cluster_rq_active.inc();
+      active_requests.push_back(host);
+      hit_counter[host->address()->asString()] += 1;
+    }
+
+    state.PauseTiming();
+    uint64_t max_hits = 0;
+    for (const auto& pair : hit_counter) {
+      max_hits = std::max(pair.second, max_hits);
+    }
+    state.counters["max_mean_load_ratio"] =
+        static_cast<double>(max_hits) * num_hosts / requests_to_simulate;
+    for (const auto& host : active_requests) {
+      host->stats().rq_active_.dec();
+      cluster_rq_active.dec();
+    }
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(benchmarkMaglevLoadBalancerZipfBoundedLoad)
+    ->Args({500, 0, 100, 100000})
+    ->Args({500, 125, 100, 100000})
+    ->Args({500, 150, 100, 100000})
+    ->Args({500, 200, 100, 100000})
+    ->Args({500, 0, 120, 100000})
+    ->Args({500, 125, 120, 100000})
+    ->Args({500, 200, 120, 100000})
+    ->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
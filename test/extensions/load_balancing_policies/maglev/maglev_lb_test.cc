@@ -73,7 +73,7 @@ public:
 
   void createLb() {
     lb_ = std::make_unique<MaglevLoadBalancer>(priority_set_, stats_, *stats_store_.rootScope(),
-                                               runtime_, random_, 50, config_);
+                                               runtime_, random_, 50, config_, simTime());
   }
 
   void init(uint64_t table_size, bool locality_weighted_balancing = false) {
@@ -606,6 +606,74 @@ TEST_F(MaglevLoadBalancerTest, LocalityWeightedLopsided) {
   EXPECT_EQ(MaglevTable::DefaultTableSize - 1023, counts[0]);
 }
 
+// Refreshes that leave the hashed hosts of a priority unchanged keep the priority's table, while
+// membership, health and hash key changes build a new one.
+TEST_F(MaglevLoadBalancerTest, SkipUnchangedTableBuilds) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.thread_aware_lb_skip_unchanged_table_builds", "true"}});
+
+  host_set_.hosts_ = {makeTestHostWithHashKey(info_, "90", "tcp://127.0.0.1:90"),
+                      makeTestHostWithHashKey(info_, "91", "tcp://127.0.0.1:91"),
+                      makeTestHostWithHashKey(info_, "92", "tcp://127.0.0.1:92")};
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  host_set_.runCallbacks({}, {});
+  init(7);
+
+  Stats::Counter& table_builds = stats_store_.counterFromString("maglev_lb.table_builds");
+  Stats::Counter& table_builds_skipped =
+      stats_store_.counterFromString("maglev_lb.table_builds_skipped");
+  EXPECT_EQ(1, table_builds.value());
+  EXPECT_EQ(0, table_builds_skipped.value());
+
+  const auto assignments = [this]() {
+    LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+    std::vector<HostConstSharedPtr> hosts;
+    for (uint32_t i = 0; i < 7; ++i) {
+      TestLoadBalancerContext context(i);
+      hosts.push_back(lb->chooseHost(&context).host);
+    }
+    return hosts;
+  };
+  const std::vector<HostConstSharedPtr> initial_assignments = assignments();
+
+  // An update to another priority leaves the table of priority 0 alone.
+  MockHostSet& failover_host_set = *priority_set_.getMockHostSet(1);
+  failover_host_set.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80")};
+  failover_host_set.healthy_hosts_ = failover_host_set.hosts_;
+  failover_host_set.runCallbacks({}, {});
+  EXPECT_EQ(2, table_builds.value());
+  EXPECT_EQ(1, table_builds_skipped.value());
+  EXPECT_EQ(initial_assignments, assignments());
+
+  // A host becoming unhealthy removes it from the hashed hosts.
+  host_set_.healthy_hosts_ = {host_set_.hosts_[0], host_set_.hosts_[1]};
+  host_set_.runCallbacks({}, {});
+  EXPECT_EQ(3, table_builds.value());
+  EXPECT_EQ(2, table_builds_skipped.value());
+  for (const auto& host : assignments()) {
+    EXPECT_NE(host_set_.hosts_[2], host);
+  }
+
+  // Replacing a host's metadata may change its hash key, so the table is built again.
+  envoy::config::core::v3::Metadata metadata;
+  Config::Metadata::mutableMetadataValue(metadata, Config::MetadataFilters::get().ENVOY_LB,
+                                         Config::MetadataEnvoyLbKeys::get().HASH_KEY)
+      .set_string_value("93");
+  host_set_.hosts_[0]->metadata(
+      std::make_shared<const envoy::config::core::v3::Metadata>(metadata));
+  host_set_.runCallbacks({}, {});
+  EXPECT_EQ(4, table_builds.value());
+  EXPECT_EQ(3, table_builds_skipped.value());
+
+  // Without the runtime guard every refresh builds every table.
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.thread_aware_lb_skip_unchanged_table_builds", "false"}});
+  host_set_.runCallbacks({}, {});
+  EXPECT_EQ(6, table_builds.value());
+  EXPECT_EQ(3, table_builds_skipped.value());
+}
+
 TEST(TypedMaglevLbConfigTest, TypedMaglevLbConfigTest) {
   {
     envoy::config::cluster::v3::Cluster::MaglevLbConfig legacy;
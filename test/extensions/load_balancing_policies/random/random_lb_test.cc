@@ -48,6 +48,46 @@ TEST_P(RandomLoadBalancerTest, Normal) {
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
 }
 
+TEST_P(RandomLoadBalancerTest, Weighted) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.lb_alias_table_weighted_random", "true"}});
+  init();
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", 3)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  // The low 32 bits of the random value pick a column of the alias table. With weights 1 and 3
+  // the first column picks hosts[0] for high 32 bits below one half and hosts[1] otherwise, and
+  // the second column always picks hosts[1].
+  EXPECT_CALL(random_, random()).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
+  EXPECT_CALL(random_, random()).WillOnce(Return(uint64_t(3) << 62));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0x80000000));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+
+  // Once the weights are equal the hosts are picked uniformly again.
+  hostSet().healthy_hosts_ = {hostSet().healthy_hosts_[0],
+                              makeTestHost(info_, "tcp://127.0.0.1:82", 1)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {});
+  EXPECT_CALL(random_, random()).WillOnce(Return(3));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+}
+
+TEST_P(RandomLoadBalancerTest, WeightsIgnoredWithoutRuntimeFeature) {
+  init();
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", 3)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(uint64_t(3) << 62));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
+}
+
 TEST_P(RandomLoadBalancerTest, FailClusterOnPanic) {
   config_.mutable_locality_lb_config()->mutable_zone_aware_lb_config()->set_fail_traffic_on_panic(
       true);
@@ -13,7 +13,8 @@ public:
     envoy::extensions::load_balancing_policies::ring_hash::v3::RingHash config;
     config.mutable_minimum_ring_size()->set_value(min_ring_size);
     ring_hash_lb_ = std::make_unique<RingHashLoadBalancer>(priority_set_, stats_, stats_scope_,
-                                                           runtime_, random_, 50, config);
+                                                           runtime_, random_, 50, config,
+                                                           simTime());
   }
 
   std::unique_ptr<RingHashLoadBalancer> ring_hash_lb_;
@@ -67,7 +67,7 @@ public:
     }
 
     lb_ = std::make_unique<RingHashLoadBalancer>(priority_set_, stats_, *stats_store_.rootScope(),
-                                                 runtime_, random_, 50, config_);
+                                                 runtime_, random_, 50, config_, simTime());
     EXPECT_TRUE(lb_->initialize().ok());
   }
 
@@ -102,7 +102,7 @@ INSTANTIATE_TEST_SUITE_P(RingHashPrimaryOrFailover, RingHashFailoverTest, ::test
 
 TEST_P(RingHashLoadBalancerTest, ChooseHostBeforeInit) {
   lb_ = std::make_unique<RingHashLoadBalancer>(priority_set_, stats_, *stats_store_.rootScope(),
-                                               runtime_, random_, 50, config_);
+                                               runtime_, random_, 50, config_, simTime());
   EXPECT_EQ(nullptr, lb_->factory()->create(lb_params_)->chooseHost(nullptr).host);
 }
 
@@ -500,6 +500,74 @@ TEST_P(RoundRobinLoadBalancerTest, WeightedInitializationPicksAllHosts) {
   }
 }
 
+// Validate that hosts added and removed by membership-only updates are applied to the existing EDF
+// scheduler.
+TEST_P(RoundRobinLoadBalancerTest, WeightedMembershipDelta) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.edf_lb_host_set_delta_updates", "true"}});
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", 2)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().membership_update_only_ = true;
+  init(false);
+  auto& edf_lb = dynamic_cast<EdfLoadBalancerBase&>(*lb_);
+  const EdfScheduler<Host>* scheduler = EdfLoadBalancerBasePeer::healthyHostsScheduler(edf_lb, 0);
+  ASSERT_NE(nullptr, scheduler);
+
+  hostSet().healthy_hosts_.push_back(makeTestHost(info_, "tcp://127.0.0.1:82", 3));
+  hostSet().hosts_.push_back(hostSet().healthy_hosts_.back());
+  hostSet().runCallbacks({hostSet().healthy_hosts_.back()}, {});
+  EXPECT_EQ(scheduler, EdfLoadBalancerBasePeer::healthyHostsScheduler(edf_lb, 0));
+  absl::flat_hash_map<HostConstSharedPtr, uint32_t> host_picked_count_map;
+  for (int i = 0; i < 600; ++i) {
+    host_picked_count_map[lb_->chooseHost(nullptr).host]++;
+  }
+  EXPECT_NEAR(100, host_picked_count_map[hostSet().healthy_hosts_[0]], 2);
+  EXPECT_NEAR(200, host_picked_count_map[hostSet().healthy_hosts_[1]], 2);
+  EXPECT_NEAR(300, host_picked_count_map[hostSet().healthy_hosts_[2]], 2);
+
+  HostVector removed_hosts = {hostSet().hosts_[2]};
+  hostSet().healthy_hosts_.pop_back();
+  hostSet().hosts_.pop_back();
+  hostSet().runCallbacks({}, removed_hosts);
+  EXPECT_EQ(scheduler, EdfLoadBalancerBasePeer::healthyHostsScheduler(edf_lb, 0));
+  host_picked_count_map.clear();
+  for (int i = 0; i < 300; ++i) {
+    host_picked_count_map[lb_->chooseHost(nullptr).host]++;
+  }
+  EXPECT_EQ(0, host_picked_count_map[removed_hosts[0]]);
+  EXPECT_NEAR(100, host_picked_count_map[hostSet().healthy_hosts_[0]], 2);
+  EXPECT_NEAR(200, host_picked_count_map[hostSet().healthy_hosts_[1]], 2);
+}
+
+// Validate that membership-only updates keep equally weighted hosts on the unweighted pick path
+// until a host with a different weight is added.
+TEST_P(RoundRobinLoadBalancerTest, UnweightedMembershipDelta) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.edf_lb_host_set_delta_updates", "true"}});
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
+                              makeTestHost(info_, "tcp://127.0.0.1:81")};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().membership_update_only_ = true;
+  init(false);
+  auto& edf_lb = dynamic_cast<EdfLoadBalancerBase&>(*lb_);
+
+  hostSet().healthy_hosts_.push_back(makeTestHost(info_, "tcp://127.0.0.1:82"));
+  hostSet().hosts_.push_back(hostSet().healthy_hosts_.back());
+  hostSet().runCallbacks({hostSet().healthy_hosts_.back()}, {});
+  EXPECT_EQ(nullptr, EdfLoadBalancerBasePeer::healthyHostsScheduler(edf_lb, 0));
+  absl::flat_hash_map<HostConstSharedPtr, uint32_t> host_picked_count_map;
+  for (int i = 0; i < 3; ++i) {
+    host_picked_count_map[lb_->chooseHost(nullptr).host]++;
+  }
+  EXPECT_EQ(3, host_picked_count_map.size());
+
+  hostSet().healthy_hosts_.push_back(makeTestHost(info_, "tcp://127.0.0.1:83", 2));
+  hostSet().hosts_.push_back(hostSet().healthy_hosts_.back());
+  hostSet().runCallbacks({hostSet().healthy_hosts_.back()}, {});
+  EXPECT_NE(nullptr, EdfLoadBalancerBasePeer::healthyHostsScheduler(edf_lb, 0));
+}
+
 TEST_P(RoundRobinLoadBalancerTest, MaxUnhealthyPanic) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
                               makeTestHost(info_, "tcp://127.0.0.1:81")};
@@ -1141,6 +1209,79 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareNoMatchingZones) {
   EXPECT_EQ(5U, stats_.lb_zone_routing_cross_zone_.value());
 }
 
+TEST_P(RoundRobinLoadBalancerTest, ZoneAwareNoMatchingZonesAliasTable) {
+  if (&hostSet() == &failover_host_set_) { // P = 1 does not support zone-aware routing.
+    return;
+  }
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.lb_alias_table_weighted_random", "true"}});
+  envoy::config::core::v3::Locality zone_a;
+  zone_a.set_zone("A");
+  envoy::config::core::v3::Locality zone_b;
+  zone_b.set_zone("B");
+  envoy::config::core::v3::Locality zone_c;
+  zone_c.set_zone("C");
+  envoy::config::core::v3::Locality zone_d;
+  zone_d.set_zone("D");
+  envoy::config::core::v3::Locality zone_e;
+  zone_e.set_zone("E");
+  envoy::config::core::v3::Locality zone_f;
+  zone_f.set_zone("F");
+  HostVectorSharedPtr upstream_hosts(
+      new HostVector({makeTestHost(info_, "tcp://127.0.0.1:80", zone_d),
+                      makeTestHost(info_, "tcp://127.0.0.1:81", zone_e),
+                      makeTestHost(info_, "tcp://127.0.0.1:82", zone_f)}));
+  HostVectorSharedPtr local_hosts(
+      new HostVector({makeTestHost(info_, "tcp://127.0.0.1:0", zone_a),
+                      makeTestHost(info_, "tcp://127.0.0.1:1", zone_b),
+                      makeTestHost(info_, "tcp://127.0.0.1:2", zone_c)}));
+
+  HostsPerLocalitySharedPtr upstream_hosts_per_locality =
+      makeHostsPerLocality({{makeTestHost(info_, "tcp://127.0.0.1:80", zone_d)},
+                            {makeTestHost(info_, "tcp://127.0.0.1:81", zone_e)},
+                            {makeTestHost(info_, "tcp://127.0.0.1:82", zone_f)}},
+                           true);
+
+  HostsPerLocalitySharedPtr local_hosts_per_locality =
+      makeHostsPerLocality({{makeTestHost(info_, "tcp://127.0.0.1:0", zone_a)},
+                            {makeTestHost(info_, "tcp://127.0.0.1:1", zone_b)},
+                            {makeTestHost(info_, "tcp://127.0.0.1:2", zone_c)}});
+
+  EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.healthy_panic_threshold", 50))
+      .WillRepeatedly(Return(50));
+  EXPECT_CALL(runtime_.snapshot_, featureEnabled("upstream.zone_routing.enabled", 100))
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.zone_routing.force_local_zone.min_size", 0))
+      .WillRepeatedly(Return(0));
+  EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.zone_routing.min_cluster_size", 6))
+      .WillRepeatedly(Return(3));
+
+  hostSet().healthy_hosts_ = *upstream_hosts;
+  hostSet().hosts_ = *upstream_hosts;
+  hostSet().healthy_hosts_per_locality_ = upstream_hosts_per_locality;
+  init(true);
+  updateHosts(local_hosts, local_hosts_per_locality);
+
+  // Every locality has the same residual capacity, so the low 32 bits of the random value pick
+  // the locality.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(1U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_CALL(random_, random())
+      .WillOnce(Return(0))
+      .WillOnce(Return(0))
+      .WillOnce(Return(0x60000000));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[1][0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(2U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_CALL(random_, random())
+      .WillOnce(Return(0))
+      .WillOnce(Return(0))
+      .WillOnce(Return(0xffffffff));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[2][0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(3U, stats_.lb_zone_routing_cross_zone_.value());
+}
+
 TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareNotEnoughLocalZones) {
   if (&hostSet() == &failover_host_set_) { // P = 1 does not support zone-aware routing.
     return;
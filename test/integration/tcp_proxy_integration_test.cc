@@ -1891,4 +1891,103 @@ TEST_P(TcpProxyReceiveBeforeConnectIntegrationTest, UpstreamBufferHighWatermark)
   EXPECT_EQ(downstream_resumes, 1);
 }
 
+// A read filter that sees the data of the connection and passes it on.
+class PassthroughFilter : public Network::ReadFilter {
+public:
+  Network::FilterStatus onData(Buffer::Instance&, bool) override {
+    return Network::FilterStatus::Continue;
+  }
+  Network::FilterStatus onNewConnection() override { return Network::FilterStatus::Continue; }
+  void initializeReadFilterCallbacks(Network::ReadFilterCallbacks&) override {}
+};
+
+class PassthroughFilterFactory : public Extensions::NetworkFilters::Common::FactoryBase<
+                                     test::integration::tcp_proxy::PassthroughFilterConfig> {
+public:
+  PassthroughFilterFactory() : FactoryBase("test.passthrough") {}
+
+private:
+  Network::FilterFactoryCb
+  createFilterFactoryFromProtoTyped(const test::integration::tcp_proxy::PassthroughFilterConfig&,
+                                    Server::Configuration::FactoryContext&) override {
+    return [](Network::FilterManager& filter_manager) -> void {
+      filter_manager.addReadFilter(std::make_shared<PassthroughFilter>());
+    };
+  }
+};
+
+class TcpProxySpliceIntegrationTest : public TcpProxyIntegrationTest {
+public:
+  TcpProxySpliceIntegrationTest() {
+    config_helper_.addConfigModifier([](envoy::config::bootstrap::v3::Bootstrap& bootstrap) {
+      auto* filter_chain =
+          bootstrap.mutable_static_resources()->mutable_listeners(0)->mutable_filter_chains(0);
+      // The TCP proxy is the last filter of the chain.
+      auto* config_blob =
+          filter_chain->mutable_filters(filter_chain->filters_size() - 1)->mutable_typed_config();
+      auto tcp_proxy_config =
+          MessageUtil::anyConvert<envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy>(
+              *config_blob);
+      tcp_proxy_config.set_splice_passthrough(true);
+      config_blob->PackFrom(tcp_proxy_config);
+    });
+  }
+
+  uint64_t tcpProxyCounter(absl::string_view name) {
+    return test_server_->counter(absl::StrCat("tcp.tcpproxy_stats.", name))->value();
+  }
+
+  // Proxies data in both directions and checks that all of it arrives, including the data written
+  // by the upstream right before it closes.
+  void proxyData() {
+    initialize();
+    IntegrationTcpClientPtr tcp_client = makeTcpConnection(lookupPort("tcp_proxy"));
+    FakeRawConnectionPtr fake_upstream_connection;
+    ASSERT_TRUE(fake_upstreams_[0]->waitForRawConnection(fake_upstream_connection));
+
+    ASSERT_TRUE(tcp_client->write("hello"));
+    ASSERT_TRUE(fake_upstream_connection->waitForData(5));
+    ASSERT_TRUE(fake_upstream_connection->write("world"));
+    tcp_client->waitForData("world");
+
+    const std::string data(1024 * 1024, 'a');
+    ASSERT_TRUE(fake_upstream_connection->write(data, true));
+    ASSERT_TRUE(fake_upstream_connection->close());
+    tcp_client->waitForData("world" + data);
+    tcp_client->waitForHalfClose();
+    tcp_client->close();
+  }
+
+  PassthroughFilterFactory factory_;
+  Registry::InjectFactory<Server::Configuration::NamedNetworkFilterConfigFactory> register_factory_{
+      factory_};
+};
+
+INSTANTIATE_TEST_SUITE_P(TcpProxyIntegrationTestParams, TcpProxySpliceIntegrationTest,
+                         testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
+                         TestUtility::ipTestParamsToString);
+
+TEST_P(TcpProxySpliceIntegrationTest, SplicePassthrough) {
+  proxyData();
+#if defined(__linux__)
+  EXPECT_EQ(1, tcpProxyCounter("downstream_cx_splice_total"));
+  EXPECT_EQ(0, tcpProxyCounter("downstream_cx_splice_fallback_total"));
+#else
+  EXPECT_EQ(0, tcpProxyCounter("downstream_cx_splice_total"));
+  EXPECT_EQ(1, tcpProxyCounter("downstream_cx_splice_fallback_total"));
+#endif
+}
+
+// Another filter that sees the data of the downstream connection requires the buffered path.
+TEST_P(TcpProxySpliceIntegrationTest, SplicePassthroughFallbackWithOtherFilter) {
+  config_helper_.addNetworkFilter(R"EOF(
+    name: test.passthrough
+    typed_config:
+      "@type": type.googleapis.com/test.integration.tcp_proxy.PassthroughFilterConfig
+)EOF");
+  proxyData();
+  EXPECT_EQ(0, tcpProxyCounter("downstream_cx_splice_total"));
+  EXPECT_EQ(1, tcpProxyCounter("downstream_cx_splice_fallback_total"));
+}
+
 } // namespace Envoy
@@ -106,6 +106,8 @@ public:
     return impl_.approximateMonotonicTime();
   }
 
+  DispatcherLoad& load() override { return impl_.load(); }
+
   void updateApproximateMonotonicTime() override { impl_.updateApproximateMonotonicTime(); }
 
   bool isThreadSafe() const override { return impl_.isThreadSafe(); }
@@ -243,6 +243,7 @@ public:
   MOCK_METHOD(void, onData, (UdpRecvData && data));
   MOCK_METHOD(void, onDatagramsDropped, (uint32_t dropped));
   MOCK_METHOD(void, onReadReady, ());
+  MOCK_METHOD(void, onReadComplete, ());
   MOCK_METHOD(void, onWriteReady, (const Socket& socket));
   MOCK_METHOD(void, onReceiveError, (Api::IoError::IoErrorCode err));
   MOCK_METHOD(Network::UdpPacketWriter&, udpPacketWriter, ());
@@ -501,6 +502,7 @@ public:
   MOCK_METHOD(bool, bindToPort, (), (const));
   MOCK_METHOD(bool, handOffRestoredDestinationConnections, (), (const));
   MOCK_METHOD(uint32_t, perConnectionBufferLimitBytes, (), (const));
+  MOCK_METHOD(uint32_t, zeroCopySendMinBytes, (), (const));
   MOCK_METHOD(std::chrono::milliseconds, listenerFiltersTimeout, (), (const));
   MOCK_METHOD(bool, continueOnListenerFiltersTimeout, (), (const));
   MOCK_METHOD(Stats::Scope&, listenerScope, ());
@@ -696,6 +698,7 @@ public:
 
   MOCK_METHOD(Network::FilterStatus, onData, (UdpRecvData&));
   MOCK_METHOD(Network::FilterStatus, onReceiveError, (Api::IoError::IoErrorCode));
+  MOCK_METHOD(void, onReadComplete, ());
 };
 
 class MockUdpListenerFilterManager : public UdpListenerFilterManager {
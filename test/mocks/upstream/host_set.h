@@ -51,6 +51,7 @@ public:
     overprovisioning_factor_ = overprovisioning_factor;
   }
   bool weightedPriorityHealth() const override { return weighted_priority_health_; }
+  bool membershipUpdateOnly() const override { return membership_update_only_; }
 
   HostVector hosts_;
   HostVector healthy_hosts_;
@@ -65,6 +66,7 @@ public:
   uint32_t priority_{};
   uint32_t overprovisioning_factor_{};
   bool weighted_priority_health_{false};
+  bool membership_update_only_{false};
   bool run_in_panic_mode_ = false;
 };
 } // namespace Upstream
@@ -194,6 +194,40 @@ TEST_P(ActiveUdpListenerTest, MultipleFiltersOnReceiveErrorStopIteration) {
   active_listener_->onReceiveError(Api::IoError::IoErrorCode::UnknownError);
 }
 
+TEST_P(ActiveUdpListenerTest, MultipleFiltersOnReadComplete) {
+  setup();
+
+  // Every filter is told that the read event is complete, whatever its onData() status was.
+  auto* test_filter = new NiceMock<Network::MockUdpListenerReadFilter>(cb_);
+  EXPECT_CALL(*test_filter, onReadComplete());
+  auto* test_filter2 = new NiceMock<Network::MockUdpListenerReadFilter>(cb_);
+  EXPECT_CALL(*test_filter2, onReadComplete());
+
+  active_listener_->addReadFilter(Network::UdpListenerReadFilterPtr{test_filter});
+  active_listener_->addReadFilter(Network::UdpListenerReadFilterPtr{test_filter2});
+
+  active_listener_->onReadComplete();
+}
+
+TEST_P(ActiveUdpListenerTest, PostedDataCompletesRead) {
+  setup();
+
+  auto* test_filter = new NiceMock<Network::MockUdpListenerReadFilter>(cb_);
+  active_listener_->addReadFilter(Network::UdpListenerReadFilterPtr{test_filter});
+
+  // A datagram posted from another worker is not followed by a local read event, so the read is
+  // completed right after it is delivered.
+  EXPECT_CALL(dispatcher_, isThreadSafe()).WillOnce(Return(false));
+  EXPECT_CALL(conn_handler_, getUdpListenerCallbacks(_, _))
+      .WillOnce(Return(Network::UdpListenerCallbacksOptRef(*active_listener_)));
+  testing::InSequence s;
+  EXPECT_CALL(*test_filter, onData(_)).WillOnce(Return(Network::FilterStatus::Continue));
+  EXPECT_CALL(*test_filter, onReadComplete());
+
+  Network::UdpRecvData data;
+  active_listener_->post(std::move(data));
+}
+
 } // namespace
 } // namespace Server
 } // namespace Envoy